@@ -241,6 +241,68 @@ void simple_smul_float(int m, int n,
   return;
 }
 
+void simple_trsml_float(int m, int n,
+			float* a, int a_row_stride, int a_col_stride,
+			float* b, int b_row_stride, int b_col_stride) {
+  int i, j, p;
+  for (i = 0; i < m; i++) {
+    for (j = 0; j < n; j++) {
+      for (p = 0; p < i; p++) {
+	B(i, j) = B(i, j) - A(i, p) * B(p, j);
+      }
+      B(i, j) = B(i, j) / A(i, i);
+    }
+  }
+}
+
+void simple_add_complex(int m, int n,
+			double _Complex *a, int a_row_stride, int a_col_stride,
+			double _Complex *b, int b_row_stride, int b_col_stride) {
+  int i, j;
+  for (i = 0; i < m; i++)	{
+    for (j = 0; j < n; j++)	{
+      B(i, j) += A(i, j);
+    }
+  }
+  return;
+}
+
+void simple_smul_complex(int m, int n,
+			 double _Complex *scalar,
+			 double _Complex *a, int a_row_stride, int a_col_stride) {
+  int i, j;
+  for (i = 0; i < m; i++)	{
+    for (j = 0; j < n; j++)	{
+      A(i, j) = A(i, j) * *scalar;
+    }
+  }
+  return;
+}
+
+void simple_add_complex_float(int m, int n,
+			      float _Complex *a, int a_row_stride, int a_col_stride,
+			      float _Complex *b, int b_row_stride, int b_col_stride) {
+  int i, j;
+  for (i = 0; i < m; i++)	{
+    for (j = 0; j < n; j++)	{
+      B(i, j) += A(i, j);
+    }
+  }
+  return;
+}
+
+void simple_smul_complex_float(int m, int n,
+			       float _Complex *scalar,
+			       float _Complex *a, int a_row_stride, int a_col_stride) {
+  int i, j;
+  for (i = 0; i < m; i++)	{
+    for (j = 0; j < n; j++)	{
+      A(i, j) = A(i, j) * *scalar;
+    }
+  }
+  return;
+}
+
 double diff_buffer(int size, double *buf1, double *buf2) {
   int i;
   double diff = 0.0;
@@ -322,6 +384,48 @@ void test_buffer_diff_float(int size, float *a, float *b, char *test_name)	{
 	}
 }
 
+// Elements are compared relative to their magnitude, or absolutely
+// when they are smaller than one
+void test_buffer_diff_rel(int size, double *a, double *b, double tol, char *test_name)	{
+	int i, num_off = 0;
+	double max_err = 0.0;
+	for (i = 0; i < size; i++)	{
+		double scale = fabs(a[i]) > fabs(b[i]) ? fabs(a[i]) : fabs(b[i]);
+		double err = fabs(a[i] - b[i]) / (scale > 1.0 ? scale : 1.0);
+		if (!(err <= tol))	{
+			num_off++;
+		}
+		if (err > max_err)	{
+			max_err = err;
+		}
+	}
+	if (num_off != 0)	{
+		printf("\n\nERROR in %s: %d of %d elements off, max relative error = %e\n\n", test_name, num_off, size, max_err);
+	} else {
+		printf("%s PASSED\n", test_name);
+	}
+}
+
+void test_buffer_diff_rel_float(int size, float *a, float *b, float tol, char *test_name)	{
+	int i, num_off = 0;
+	float max_err = 0.0;
+	for (i = 0; i < size; i++)	{
+		float scale = fabsf(a[i]) > fabsf(b[i]) ? fabsf(a[i]) : fabsf(b[i]);
+		float err = fabsf(a[i] - b[i]) / (scale > 1.0f ? scale : 1.0f);
+		if (!(err <= tol))	{
+			num_off++;
+		}
+		if (err > max_err)	{
+			max_err = err;
+		}
+	}
+	if (num_off != 0)	{
+		printf("\n\nERROR in %s: %d of %d elements off, max relative error = %e\n\n", test_name, num_off, size, max_err);
+	} else {
+		printf("%s PASSED\n", test_name);
+	}
+}
+
 void print_mat(int m, int n, double *a, int a_row_stride, int a_col_stride)	{
 	int i, j;
 	for (i = 0; i < m; i++)	{
@@ -355,3 +459,34 @@ unsigned long long rdtsc()
 
    return ((unsigned long long)a) | (((unsigned long long)d) << 32);
 }
+
+static int compare_cycles(const void *a, const void *b)	{
+	long long x = *(const long long *) a;
+	long long y = *(const long long *) b;
+	return (x > y) - (x < y);
+}
+
+// Median of the first n samples and a distribution-free ~95%
+// confidence interval for it, taken from the order statistics
+// n/2 -/+ sqrt(n). scratch must hold n values; samples is unchanged
+void median_and_ci(int n, long long *samples, long long *scratch,
+		   long long *ci_low, long long *median, long long *ci_high)	{
+	int half_width = 0;
+	int lo, hi;
+	memcpy(scratch, samples, n * sizeof(long long));
+	qsort(scratch, n, sizeof(long long), compare_cycles);
+	while ((half_width + 1) * (half_width + 1) <= n)	{
+		half_width++;
+	}
+	lo = n / 2 - half_width;
+	hi = n / 2 + half_width;
+	if (lo < 0)	{
+		lo = 0;
+	}
+	if (hi > n - 1)	{
+		hi = n - 1;
+	}
+	*ci_low = scratch[lo];
+	*median = scratch[n / 2];
+	*ci_high = scratch[hi];
+}
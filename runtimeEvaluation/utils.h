@@ -77,6 +77,26 @@ void simple_smul_float(int m, int n,
 	float *scalar,
 	float *a, int a_row_stride, int a_col_stride);
 
+void simple_trsml_float(int m, int n,
+			float* a, int a_row_stride, int a_col_stride,
+			float* b, int b_row_stride, int b_col_stride);
+
+void simple_add_complex(int m, int n,
+	double _Complex *a, int a_row_stride, int a_col_stride,
+	double _Complex *b, int b_row_stride, int b_col_stride);
+
+void simple_smul_complex(int m, int n,
+	double _Complex *scalar,
+	double _Complex *a, int a_row_stride, int a_col_stride);
+
+void simple_add_complex_float(int m, int n,
+	float _Complex *a, int a_row_stride, int a_col_stride,
+	float _Complex *b, int b_row_stride, int b_col_stride);
+
+void simple_smul_complex_float(int m, int n,
+	float _Complex *scalar,
+	float _Complex *a, int a_row_stride, int a_col_stride);
+
 void copy_double(int m, int n,
 		 double* a,
 		 int a_row_stride, int a_col_stride,
@@ -103,6 +123,10 @@ void test_buffer_diff(int size, double* a, double* b, char *test_name);
 
 void test_buffer_diff_float(int size, float *a, float *b, char *test_name);
 
+void test_buffer_diff_rel(int size, double *a, double *b, double tol, char *test_name);
+
+void test_buffer_diff_rel_float(int size, float *a, float *b, float tol, char *test_name);
+
 void test_mats_diff(int m, int n, double* a, int a_row_stride, int a_col_stride, double* b, int b_row_stride, int b_col_stride, char *test_name);
 
 void print_mat(int m, int n, double* a, int a_row_stride, int a_col_stride);
@@ -112,4 +136,7 @@ void reset_values(int size, double* a, double* b, double* c, double* c_copy);
 
 unsigned long long rdtsc();
 
+void median_and_ci(int n, long long *samples, long long *scratch,
+		   long long *ci_low, long long *median, long long *ci_high);
+
 #endif
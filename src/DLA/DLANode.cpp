@@ -604,6 +604,11 @@ bool DLANode::InputIsResidual(ConnNum num) const {
     || (IsInputRowVector(num) && (GetInputNumCols(num) < GetVecRegWidth()));
 }
 
+bool DLANode::InputIsVecRegAligned(ConnNum num) const {
+  CheckInputNum(num);
+  return InputDataType(num).m_alignment % arch->VecRegBytes(GetDataType()) == 0;
+}
+
 bool DLANode::InputIsContiguous(ConnNum num) const {
   CheckInputNum(num);
 
@@ -125,6 +125,7 @@ class DLANode : public Node
   int GetInputColStride(ConnNum num) const;
 
   bool InputIsContiguous(ConnNum num) const;
+  bool InputIsVecRegAligned(ConnNum num) const;
   bool InputsAreSameSize(ConnNum left, ConnNum right) const;
 
   bool InputNIsMultipleOfVecRegWidth(ConnNum num) const;
@@ -70,6 +70,7 @@ InputNode::InputNode(string name,
   string colStrideVar = name + "ColStride";
   
   m_dataTypeInfo = DataTypeInfo(rowStrideVal, colStrideVal, numRowsVar, numColsVar, rowStrideVar, colStrideVar, dataType);
+  m_dataTypeInfo.m_alignment = max(inputAlignment, m_dataTypeInfo.m_alignment);
   
   m_rowStrideVal = rowStrideVal;
   m_colStrideVal = colStrideVal;
@@ -88,6 +89,7 @@ InputNode::InputNode(NodeType type, Size m, Size n, string name,
 m_msize(NULL), m_nsize(NULL)
 {
   m_dataTypeInfo = DataTypeInfo(rowStrideVal, colStrideVal, numRowsVar, numColsVar, rowStrideVar, colStrideVar, dataType);
+  m_dataTypeInfo.m_alignment = max(inputAlignment, m_dataTypeInfo.m_alignment);
   
   m_rowStrideVal = rowStrideVal;
   m_colStrideVal = colStrideVal;
@@ -103,6 +105,8 @@ string InputNode::DataDeclaration()
     return "double *" + m_varName.str();
   } else if (m_dataTypeInfo.m_type == REAL_SINGLE) {
     return "float *" + m_varName.str();
+  } else if (IsComplex(m_dataTypeInfo.m_type)) {
+    return ElemTypeName(m_dataTypeInfo.m_type) + " *" + m_varName.str();
   } else {
     LOG_FAIL("bad datatype in InputNode::DataDeclaration");
     throw;
@@ -23,9 +23,26 @@
 
 #if DOLLDLA
 
+static unsigned int ElemBytes(Type type)
+{
+  unsigned int componentBytes = ComponentType(type) == REAL_SINGLE ? sizeof(float) : sizeof(double);
+  return IsComplex(type) ? 2 * componentBytes : componentBytes;
+}
+
+static unsigned int GreatestCommonDivisor(unsigned int a, unsigned int b)
+{
+  while (b != 0) {
+    unsigned int rem = a % b;
+    a = b;
+    b = rem;
+  }
+  return a;
+}
+
 DataTypeInfo::DataTypeInfo()
   : m_rowStride(BADSTRIDE),
-    m_colStride(BADSTRIDE)
+    m_colStride(BADSTRIDE),
+    m_alignment(1)
 {
   m_rowStride = BADSTRIDE;
   m_colStride = BADSTRIDE;
@@ -41,7 +58,8 @@ DataTypeInfo::DataTypeInfo(Size rowStrideVal, Size colStrideVal,
     m_numColsVar(numColsVar),
     m_rowStrideVar(rowStrideVar),
     m_colStrideVar(colStrideVar),
-    m_type(type)
+    m_type(type),
+    m_alignment(ElemBytes(type))
 {
   if (m_rowStrideVal == 1) {
     m_rowStride = UNITSTRIDE;
@@ -68,9 +86,35 @@ DataTypeInfo& DataTypeInfo::operator=(const DataTypeInfo &rhs)
   m_rowStrideVar = rhs.m_rowStrideVar;
   m_colStrideVar = rhs.m_colStrideVar;
   m_type = rhs.m_type;
+  m_alignment = rhs.m_alignment;
   return *this;
 }
 
+// Size generic code gets its strides at runtime, so only a unit
+// stride says anything about the address of an offset element
+static unsigned int OffsetAlignment(unsigned int alignment, Type type,
+				    Size count, Stride stride, Size strideVal)
+{
+  if (count == 0) {
+    return alignment;
+  }
+  if (!IsUnitStride(stride) && sizeGeneric) {
+    return GreatestCommonDivisor(alignment, ElemBytes(type));
+  }
+  unsigned int offsetBytes = (unsigned int) (count * strideVal) * ElemBytes(type);
+  return GreatestCommonDivisor(alignment, offsetBytes);
+}
+
+unsigned int DataTypeInfo::RowOffsetAlignment(Size numRows) const
+{
+  return OffsetAlignment(m_alignment, m_type, numRows, m_rowStride, m_rowStrideVal);
+}
+
+unsigned int DataTypeInfo::ColOffsetAlignment(Size numCols) const
+{
+  return OffsetAlignment(m_alignment, m_type, numCols, m_colStride, m_colStrideVal);
+}
+
 string DataTypeInfo::ToString() {
   string dataStr = "Num rows var name: " + m_numRowsVar + "\n";
   dataStr += "Num cols var name: " + m_numColsVar + "\n";
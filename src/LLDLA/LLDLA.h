@@ -34,6 +34,11 @@
 
 using namespace std;
 
+// Real flops per complex element operation, used to scale
+// the cost of abstract ops on complex operands
+#define COMPLEXADDFLOPS 2
+#define COMPLEXMULFLOPS 6
+
 enum Stride { UNITSTRIDE,
 	      NONUNITSTRIDE,
 	      BADSTRIDE };
@@ -72,6 +77,9 @@ class DataTypeInfo
 
   Type m_type;
 
+  // Bytes the address of the first element is known to be a multiple of
+  unsigned int m_alignment;
+
   DataTypeInfo();
   DataTypeInfo(Size rowStrideVal, Size colStrideVal,
 	       string numRowsVar, string numColsVar,
@@ -80,6 +88,11 @@ class DataTypeInfo
 
   DataTypeInfo& operator=(const DataTypeInfo& rhs);
   string ToString();
+
+  // Alignment of the element numRows rows down or numCols columns
+  // to the right of the first one
+  unsigned int RowOffsetAlignment(Size numRows) const;
+  unsigned int ColOffsetAlignment(Size numCols) const;
 };
 
 #endif // DOLLDLA
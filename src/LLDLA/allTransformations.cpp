@@ -30,8 +30,11 @@
 #include "mvmulToVVDot.h"
 #include "mvmulPack.h"
 #include "pack.h"
+#include "packedPanel.h"
+#include "parallelizeLoop.h"
 #include "packToCopyAndZero.h"
 #include "partition.h"
+#include "peelToAlignment.h"
 #include "recombine.h"
 #include "regLoadStore.h"
 #include "residualSVMulToRegArith.h"
@@ -48,6 +51,8 @@
 #include "residualSVMulAddToRegArith.h"
 #include "svmulPackResidualToVRW.h"
 #include "svmulSplitToMainAndResidual.h"
+#include "svmulToPlanarRegArith.h"
+#include "trsml.h"
 #include "unpack.h"
 #include "unpackToPartAndCopy.h"
 #include "vmmul.h"
@@ -61,21 +66,43 @@
 #include "vvdot.h"
 #include "vvdotPackToMultipleOfMu.h"
 #include "vvdotSplitToMainAndResidual.h"
+#include "prefetchStreamingLoads.h"
+#include "storeToStreamStore.h"
 
 #define DOCOMPACTLOOPUNROLLING 0
 #define DO2MUTRANSFORMATIONS 0
 #define DO3MUTRANSFORMATIONS 0
 #define DO16MUTRANSFORMATIONS 0
 #define DOLARGEMUTRANSFORMATIONS 0
+#define DOCACHEBLOCKINGTRANSFORMATIONS 1
 
 #define DOPARTIALLOOPUNROLLING 1
 #define PARTIALUNROLLINGSTARTCOEF 2
 #define PARTIALUNROLLINGENDCOEF 32
 
+#define DOPREFETCHING 1
+#define PREFETCHSTARTLINES 8
+#define PREFETCHENDLINES 32
+#define DOSTREAMSTORES 1
+#define DOALIGNMENTPEELING 1
+
 #if DOCOMPACTLOOPUNROLLING + DOPARTIALLOOPUNROLLING > 1
 do you really want to do compact unrolling and partial unrolling?
 #endif
 
+void AddGemmCacheBlockingTrans(Type type) {
+  Universe::AddTrans(Gemm::GetClass(), new MMulSplitAlongM(ABSLAYER, ABSLAYER, type, arch->MCBlockSize(type)), LLDLALOOPPHASE);
+  Universe::AddTrans(Gemm::GetClass(), new MMulSplitAlongP(ABSLAYER, ABSLAYER, type, arch->KCBlockSize(type)), LLDLALOOPPHASE);
+  Universe::AddTrans(Gemm::GetClass(), new MMulSplitAlongN(ABSLAYER, ABSLAYER, type, arch->NCBlockSize(type)), LLDLALOOPPHASE);
+
+  Universe::AddTrans(Gemm::GetClass(), new MMulCacheBlockLoopExp(ABSLAYER, ABSLAYER, DIMM, type), LLDLALOOPPHASE);
+  Universe::AddTrans(Gemm::GetClass(), new MMulCacheBlockLoopExp(ABSLAYER, ABSLAYER, DIMK, type), LLDLALOOPPHASE);
+  Universe::AddTrans(Gemm::GetClass(), new MMulCacheBlockLoopExp(ABSLAYER, ABSLAYER, DIMN, type), LLDLALOOPPHASE);
+
+  Universe::AddTrans(Gemm::GetClass(), new PackGemmPanel(ABSLAYER, ABSLAYER, 0, type), LLDLALOOPPHASE);
+  Universe::AddTrans(Gemm::GetClass(), new PackGemmPanel(ABSLAYER, ABSLAYER, 1, type), LLDLALOOPPHASE);
+}
+
 void AddGemmTrans() {
   Universe::AddTrans(Gemm::GetClass(), new MMulToMVMul(ABSLAYER, ABSLAYER), LLDLALOOPPHASE);
 
@@ -92,6 +119,14 @@ void AddGemmTrans() {
   Universe::AddTrans(Gemm::GetClass(), new MMulLoopExp(ABSLAYER, ABSLAYER, DIMM, LLDLAMuDouble, REAL_DOUBLE), LLDLALOOPPHASE);
   Universe::AddTrans(Gemm::GetClass(), new MMulLoopExp(ABSLAYER, ABSLAYER, DIMN, LLDLAMuDouble, REAL_DOUBLE), LLDLALOOPPHASE);
   Universe::AddTrans(Gemm::GetClass(), new MMulLoopExp(ABSLAYER, ABSLAYER, DIMK, LLDLAMuDouble, REAL_DOUBLE), LLDLALOOPPHASE);
+
+#if DOCACHEBLOCKINGTRANSFORMATIONS
+  // Packed panels are sized for the problem being searched
+  if (!sizeGeneric) {
+    AddGemmCacheBlockingTrans(REAL_SINGLE);
+    AddGemmCacheBlockingTrans(REAL_DOUBLE);
+  }
+#endif // DOCACHEBLOCKINGTRANSFORMATIONS
   
   return;
 }
@@ -136,19 +171,57 @@ void AddSMMulTrans() {
 }
 
 void AddUnrollingTrans() {
-  if (DOPARTIALLOOPUNROLLING) {
+  // Unrolling needs iteration counts that are known at generation time
+  if (DOPARTIALLOOPUNROLLING && !sizeGeneric) {
     for (unsigned int mult = PARTIALUNROLLINGSTARTCOEF; mult <= PARTIALUNROLLINGENDCOEF; mult += 2) {
       Universe::AddTrans(SplitSingleIter::GetClass(), new PartiallyUnrollLoop(mult), LLDLALOOPUNROLLPHASE);
     }
   }
 }
 
+void AddParallelizationTrans() {
+  Universe::AddTrans(SplitSingleIter::GetClass(), new ParallelizeLoop(STATICPARALLELLOOP), LLDLALOOPUNROLLPHASE);
+  Universe::AddTrans(SplitSingleIter::GetClass(), new ParallelizeLoop(DYNAMICPARALLELLOOP), LLDLALOOPUNROLLPHASE);
+}
+
+void AddPrefetchTrans() {
+  if (DOPREFETCHING) {
+    for (unsigned int lines = PREFETCHSTARTLINES; lines <= PREFETCHENDLINES; lines *= 4) {
+      Universe::AddTrans(LoadToRegs::GetClass(), new PrefetchStreamingLoads(lines * CACHELINEBYTES, PREFETCHT0), LLDLALOOPUNROLLPHASE);
+      Universe::AddTrans(LoadToRegs::GetClass(), new PrefetchStreamingLoads(lines * CACHELINEBYTES, PREFETCHT1), LLDLALOOPUNROLLPHASE);
+      Universe::AddTrans(LoadToRegs::GetClass(), new PrefetchStreamingLoads(lines * CACHELINEBYTES, PREFETCHNTA), LLDLALOOPUNROLLPHASE);
+    }
+  }
+}
+
+void AddStreamStoreTrans() {
+  if (DOSTREAMSTORES) {
+    Universe::AddTrans(StoreFromRegs::GetClass(), new StoreToStreamStore(ABSLAYER, ABSLAYER), LLDLALOOPUNROLLPHASE);
+  }
+}
+
+void AddPeelingTrans() {
+  // Head lengths are only known at runtime
+  if (DOALIGNMENTPEELING && sizeGeneric) {
+    Universe::AddTrans(VAdd::GetClass(), new PeelToAlignment(ABSLAYER, ABSLAYER, VAdd::GetClass(), COLVECTOR), LLDLALOOPPHASE);
+    Universe::AddTrans(VAdd::GetClass(), new PeelToAlignment(ABSLAYER, ABSLAYER, VAdd::GetClass(), ROWVECTOR), LLDLALOOPPHASE);
+    Universe::AddTrans(SVMul::GetClass(), new PeelToAlignment(ABSLAYER, ABSLAYER, SVMul::GetClass(), COLVECTOR), LLDLALOOPPHASE);
+    Universe::AddTrans(SVMul::GetClass(), new PeelToAlignment(ABSLAYER, ABSLAYER, SVMul::GetClass(), ROWVECTOR), LLDLALOOPPHASE);
+    Universe::AddTrans(SVMulAdd::GetClass(), new PeelToAlignment(ABSLAYER, ABSLAYER, SVMulAdd::GetClass(), COLVECTOR), LLDLALOOPPHASE);
+    Universe::AddTrans(SVMulAdd::GetClass(), new PeelToAlignment(ABSLAYER, ABSLAYER, SVMulAdd::GetClass(), ROWVECTOR), LLDLALOOPPHASE);
+  }
+}
+
 void AddSVMulTrans() {
     Universe::AddTrans(SVMul::GetClass(), new SVMulLoopRef(ABSLAYER, ABSLAYER, COLVECTOR), LLDLALOOPPHASE);
     Universe::AddTrans(SVMul::GetClass(), new SVMulLoopRef(ABSLAYER, ABSLAYER, ROWVECTOR), LLDLALOOPPHASE);
 
     Universe::AddTrans(SVMul::GetClass(), new VRWSVMulToRegArith(ABSLAYER, ABSLAYER), LLDLALOOPPHASE);
 
+    // Complex only, the search weighs these against the interleaved loops
+    Universe::AddTrans(SVMul::GetClass(), new SVMulToPlanarRegArith(ABSLAYER, ABSLAYER, COLVECTOR), LLDLALOOPPHASE);
+    Universe::AddTrans(SVMul::GetClass(), new SVMulToPlanarRegArith(ABSLAYER, ABSLAYER, ROWVECTOR), LLDLALOOPPHASE);
+
     Universe::AddTrans(SVMul::GetClass(), new ResidualSVMulToRegArith(ABSLAYER, ABSLAYER), LLDLALOOPPHASE);
 
     Universe::AddTrans(SVMul::GetClass(), new SVMulSplitToMainAndResidual(ABSLAYER, ABSLAYER, ROWVECTOR), LLDLALOOPPHASE);
@@ -196,6 +269,17 @@ void AddSVMulAddTrans() {
   Universe::AddTrans(SVMulAdd::GetClass(), new SVMulAddSplitToMainAndResidual(ABSLAYER, ABSLAYER, ROWVECTOR), LLDLALOOPPHASE);
 }
 
+void AddTRSMLTrans() {
+  Universe::AddTrans(TRSML::GetClass(), new TRSMLLoopExp(ABSLAYER, ABSLAYER, REAL_SINGLE), LLDLALOOPPHASE);
+  Universe::AddTrans(TRSML::GetClass(), new TRSMLLoopExp(ABSLAYER, ABSLAYER, REAL_DOUBLE), LLDLALOOPPHASE);
+
+  Universe::AddTrans(TRSML::GetClass(), new TRSMLNegateRHS(ABSLAYER, ABSLAYER), LLDLALOOPPHASE);
+  Universe::AddTrans(TRSML::GetClass(), new TRSMLSplitAlongM(ABSLAYER, ABSLAYER), LLDLALOOPPHASE);
+  Universe::AddTrans(TRSML::GetClass(), new TRSMLToSVMul(ABSLAYER, ABSLAYER), LLDLALOOPPHASE);
+
+  return;
+}
+
 void AddTransposeTrans() {
   Universe::AddTrans(LLDLATranspose::GetClass(), new LLDLATransposeLowerLayer(ABSLAYER, LLDLAMIDLAYER), LLDLALOOPPHASE);
   Universe::AddTrans(LLDLATranspose::GetClass(), new LLDLATransposeLowerLayer(LLDLAMIDLAYER, LLDLAPRIMITIVELAYER), LLDLALOOPPHASE);
@@ -277,7 +361,7 @@ void AddTransformations() {
   AddVMMulTrans();
   AddVAddTrans();
   AddSVMulAddTrans();
-
+  AddTRSMLTrans();
 
   AddPrimPhaseConversions();
   AddArchSpecificTrans();
@@ -285,6 +369,10 @@ void AddTransformations() {
 
   AddTransposeTrans();
   AddUnrollingTrans();
+  AddParallelizationTrans();
+  AddPrefetchTrans();
+  AddStreamStoreTrans();
+  AddPeelingTrans();
   AddSetToZeroTrans();
 }
 
@@ -26,6 +26,52 @@
 
 #include "logging.h"
 
+//Complex elements are addressed through a pointer to their real
+// and imaginary parts
+static string ComponentPtr(Type type, string memPtr)
+{
+  return "((" + ElemTypeName(ComponentType(type)) + "*) (" + memPtr + "))";
+}
+
+//Lanes of the real register union complex registers are made of
+static string LaneName(Type type)
+{
+  return ComponentType(type) == REAL_SINGLE ? "f" : "d";
+}
+
+//Copies numElems complex elements stride apart into consecutive
+// lane pairs of a register, and back out
+static string ComplexElemCopiesIn(Type type, string memPtr, string receivingLoc, string stride, int numElems)
+{
+  string copies = "";
+  string lanes = LaneName(type);
+  for (int i = 0; i < numElems; i++) {
+    string elemPtr = ComponentPtr(type, memPtr + " + " + std::to_string((long long int) i) + " * " + stride);
+    copies += receivingLoc + "." + lanes + "[" + std::to_string((long long int) (2 * i)) + "] = " + elemPtr + "[0]; "
+      + receivingLoc + "." + lanes + "[" + std::to_string((long long int) (2 * i + 1)) + "] = " + elemPtr + "[1]; ";
+  }
+  return copies;
+}
+
+static string ComplexElemCopiesOut(Type type, string memPtr, string startingLoc, string stride, int numElems)
+{
+  string copies = "";
+  string lanes = LaneName(type);
+  for (int i = 0; i < numElems; i++) {
+    string elemPtr = ComponentPtr(type, memPtr + " + " + std::to_string((long long int) i) + " * " + stride);
+    copies += elemPtr + "[0] = " + startingLoc + "." + lanes + "[" + std::to_string((long long int) (2 * i)) + "]; "
+      + elemPtr + "[1] = " + startingLoc + "." + lanes + "[" + std::to_string((long long int) (2 * i + 1)) + "]; ";
+  }
+  return copies;
+}
+
+//Drops the trailing newline so several statements fit in a block
+static string OneLine(string code)
+{
+  code.erase(code.find_last_not_of("\n") + 1);
+  return code;
+}
+
 int Architecture::VecRegWidth(Type type)
 {
   //  cout << "Getting reg width\n";
@@ -35,6 +81,8 @@ int Architecture::VecRegWidth(Type type)
   } else if (type == REAL_DOUBLE) {
     //    cout << "Type is double\n";
     return DVecRegWidth();
+  } else if (IsComplex(type)) {
+    return VecRegWidth(ComponentType(type)) / 2;
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -48,6 +96,10 @@ string Architecture::VecRegTypeDec(Type type)
     return SVecRegTypeDec();
   } else if (type == REAL_DOUBLE) {
     return DVecRegTypeDec();
+  } else if (IsComplex(type)) {
+    string regType = TypeName(type);
+    return VecRegTypeDec(ComponentType(type))
+      + "typedef struct {\n\t" + regType + " re;\n\t" + regType + " im;\n} " + PlanarTypeName(type) + ";\n";
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -61,6 +113,8 @@ string Architecture::TypeName(Type type)
     return STypeName();
   } else if (type == REAL_DOUBLE) {
     return DTypeName();
+  } else if (IsComplex(type)) {
+    return TypeName(ComponentType(type));
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -74,6 +128,8 @@ string Architecture::AddCode(Type type, string operand1, string operand2, string
     return SAddCode(operand1, operand2, result);
   } else if (type == REAL_DOUBLE) {
     return DAddCode(operand1, operand2, result);
+  } else if (IsComplex(type)) {
+    return AddCode(ComponentType(type), operand1, operand2, result);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -87,6 +143,10 @@ string Architecture::MulCode(Type type, string operand1, string operand2, string
     return SMulCode(operand1, operand2, result);
   } else if (type == REAL_DOUBLE) {
     return DMulCode(operand1, operand2, result);
+  } else if (type == COMPLEX_SINGLE) {
+    return CMulCode(operand1, operand2, result);
+  } else if (type == COMPLEX_DOUBLE) {
+    return ZMulCode(operand1, operand2, result);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -100,6 +160,10 @@ string Architecture::FMACode(Type type, string operand1, string operand2, string
     return SFMACode(operand1, operand2, operand3, result);
   } else if (type == REAL_DOUBLE) {
     return DFMACode(operand1, operand2, operand3, result);
+  } else if (type == COMPLEX_SINGLE) {
+    return CFMACode(operand1, operand2, operand3, result);
+  } else if (type == COMPLEX_DOUBLE) {
+    return ZFMACode(operand1, operand2, operand3, result);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -113,6 +177,8 @@ string Architecture::StridedLoad(Type type, string memPtr, string receivingLoc,
     return SStridedLoad(memPtr, receivingLoc, stride);
   } else if (type == REAL_DOUBLE) {
     return DStridedLoad(memPtr, receivingLoc, stride);
+  } else if (IsComplex(type)) {
+    return ComplexElemCopiesIn(type, memPtr, receivingLoc, stride, VecRegWidth(type)) + "\n";
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -126,6 +192,8 @@ string Architecture::PackedLoad(Type type, string memPtr, string receivingLoc, s
     return SPackedLoad(memPtr, receivingLoc, stride, residual);
   } else if (type == REAL_DOUBLE) {
     return DPackedLoad(memPtr, receivingLoc, stride, residual);
+  } else if (IsComplex(type)) {
+    return ZeroVar(type, receivingLoc) + ComplexElemCopiesIn(type, memPtr, receivingLoc, stride, residual);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -133,12 +201,51 @@ string Architecture::PackedLoad(Type type, string memPtr, string receivingLoc, s
   }
 }
 
+string PrefetchHintToStr(PrefetchHint hint)
+{
+  switch(hint) {
+  case(PREFETCHT0):
+    return "T0";
+  case(PREFETCHT1):
+    return "T1";
+  case(PREFETCHNTA):
+    return "NTA";
+  default:
+    cout << "ERROR: Bad hint in PrefetchHintToStr" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+string Architecture::Prefetch(string memPtr, int byteDistance, PrefetchHint hint)
+{
+  return "_mm_prefetch( ((const char *) " + memPtr + ") + " + std::to_string((long long int) byteDistance) +
+    ", _MM_HINT_" + PrefetchHintToStr(hint) + " );\n";
+}
+
 string Architecture::ContiguousLoad(Type type, string memPtr, string receivingLoc)
 {
   if (type == REAL_SINGLE) {
     return SContiguousLoad(memPtr, receivingLoc);
   } else if (type == REAL_DOUBLE) {
     return DContiguousLoad(memPtr, receivingLoc);
+  } else if (IsComplex(type)) {
+    return ContiguousLoad(ComponentType(type), ComponentPtr(type, memPtr), receivingLoc);
+  } else {
+    cout << "Error: VecRegWidth bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+string Architecture::AlignedLoad(Type type, string memPtr, string receivingLoc)
+{
+  if (type == REAL_SINGLE) {
+    return SAlignedLoad(memPtr, receivingLoc);
+  } else if (type == REAL_DOUBLE) {
+    return DAlignedLoad(memPtr, receivingLoc);
+  } else if (IsComplex(type)) {
+    return AlignedLoad(ComponentType(type), ComponentPtr(type, memPtr), receivingLoc);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -152,6 +259,10 @@ string Architecture::DuplicateLoad(Type type, string memPtr, string receivingLoc
     return SDuplicateLoad(memPtr, receivingLoc);
   } else if (type == REAL_DOUBLE) {
     return DDuplicateLoad(memPtr, receivingLoc);
+  } else if (type == COMPLEX_SINGLE) {
+    return CDuplicateLoad(memPtr, receivingLoc);
+  } else if (type == COMPLEX_DOUBLE) {
+    return ZDuplicateLoad(memPtr, receivingLoc);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -165,6 +276,15 @@ string Architecture::AccumCode(Type type, string memPtr, string startingLoc)
     return SAccumCode(memPtr, startingLoc);
   } else if (type == REAL_DOUBLE) {
     return DAccumCode(memPtr, startingLoc);
+  } else if (IsComplex(type)) {
+    string lanes = LaneName(type);
+    string realSum = "", imagSum = "";
+    for (int i = 0; i < VecRegWidth(type); i++) {
+      realSum += (i > 0 ? " + " : "") + startingLoc + "." + lanes + "[" + std::to_string((long long int) (2 * i)) + "]";
+      imagSum += (i > 0 ? " + " : "") + startingLoc + "." + lanes + "[" + std::to_string((long long int) (2 * i + 1)) + "]";
+    }
+    return ComponentPtr(type, memPtr) + "[0] += " + realSum + "; "
+      + ComponentPtr(type, memPtr) + "[1] += " + imagSum + ";\n";
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -178,6 +298,23 @@ string Architecture::ContiguousStore(Type type, string memPtr, string startingLo
     return SContiguousStore(memPtr, startingLoc);
   } else if (type == REAL_DOUBLE) {
     return DContiguousStore(memPtr, startingLoc);
+  } else if (IsComplex(type)) {
+    return ContiguousStore(ComponentType(type), ComponentPtr(type, memPtr), startingLoc);
+  } else {
+    cout << "Error: VecRegWidth bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+string Architecture::AlignedStore(Type type, string memPtr, string startingLoc)
+{
+  if (type == REAL_SINGLE) {
+    return SAlignedStore(memPtr, startingLoc);
+  } else if (type == REAL_DOUBLE) {
+    return DAlignedStore(memPtr, startingLoc);
+  } else if (IsComplex(type)) {
+    return AlignedStore(ComponentType(type), ComponentPtr(type, memPtr), startingLoc);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -191,6 +328,8 @@ string Architecture::StridedStore(Type type, string memPtr, string startingLoc,
     return SStridedStore(memPtr, startingLoc, stride);
   } else if (type == REAL_DOUBLE) {
     return DStridedStore(memPtr, startingLoc, stride);
+  } else if (IsComplex(type)) {
+    return ComplexElemCopiesOut(type, memPtr, startingLoc, stride, VecRegWidth(type)) + "\n";
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -198,11 +337,43 @@ string Architecture::StridedStore(Type type, string memPtr, string startingLoc,
   }
 }
 
+string Architecture::StreamStore(Type type, string memPtr, string startingLoc, bool isAligned)
+{
+  string streamStore, regularStore;
+  if (type == REAL_SINGLE) {
+    streamStore = SStreamStore(memPtr, startingLoc);
+  } else if (type == REAL_DOUBLE) {
+    streamStore = DStreamStore(memPtr, startingLoc);
+  } else if (IsComplex(type)) {
+    streamStore = StreamStore(ComponentType(type), ComponentPtr(type, memPtr), startingLoc, true);
+  } else {
+    cout << "Error: VecRegWidth bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+  if (isAligned) {
+    return streamStore;
+  }
+  regularStore = ContiguousStore(type, memPtr, startingLoc);
+  streamStore.erase(streamStore.find_last_not_of("\n") + 1);
+  regularStore.erase(regularStore.find_last_not_of("\n") + 1);
+  string vecBytes = std::to_string((long long int) VecRegBytes(type));
+  return "if ( !(((size_t) " + memPtr + ") & (" + vecBytes + " - 1)) ) { "
+    + streamStore + " } else { " + regularStore + " }\n";
+}
+
+string Architecture::StoreFence()
+{
+  return "_mm_sfence();\n";
+}
+
 string Architecture::UnpackStore(Type type, string memPtr, string startingLoc, string stride, int residual) {
   if (type == REAL_SINGLE) {
     return SUnpackStore(memPtr, startingLoc, stride, residual);
   } else if (type == REAL_DOUBLE) {
     return DUnpackStore(memPtr, startingLoc, stride, residual);
+  } else if (IsComplex(type)) {
+    return ComplexElemCopiesOut(type, memPtr, startingLoc, stride, residual);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -216,6 +387,8 @@ string Architecture::ZeroVar(Type type, string varName)
     return SZeroVar(varName);
   } else if (type == REAL_DOUBLE) {
     return DZeroVar(varName);
+  } else if (IsComplex(type)) {
+    return ZeroVar(ComponentType(type), varName);
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -229,6 +402,8 @@ double Architecture::FlopsPerCycle(Type type)
     return SFlopsPerCycle();
   } else if (type == REAL_DOUBLE) {
     return DFlopsPerCycle();
+  } else if (IsComplex(type)) {
+    return FlopsPerCycle(ComponentType(type));
   } else {
     cout << "Error: VecRegWidth bad type\n";
     LOG_FAIL("Replacement for call to throw;");
@@ -236,6 +411,163 @@ double Architecture::FlopsPerCycle(Type type)
   }
 }
 
+int Architecture::ElemBytes(Type type)
+{
+  if (type == REAL_SINGLE) {
+    return sizeof(float);
+  } else if (type == REAL_DOUBLE) {
+    return sizeof(double);
+  } else if (IsComplex(type)) {
+    return 2 * ElemBytes(ComponentType(type));
+  } else {
+    cout << "Error: ElemBytes bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+int Architecture::VecRegBytes(Type type)
+{
+  return VecRegWidth(type) * ElemBytes(type);
+}
+
+int Architecture::PlanarVecRegWidth(Type type)
+{
+  if (!IsComplex(type)) {
+    cout << "Error: PlanarVecRegWidth of a real type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+  return 2 * VecRegWidth(type);
+}
+
+string Architecture::PlanarTypeName(Type type)
+{
+  if (type == COMPLEX_SINGLE) {
+    return "cvec_planar_reg";
+  } else if (type == COMPLEX_DOUBLE) {
+    return "zvec_planar_reg";
+  } else {
+    cout << "Error: PlanarTypeName bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+string Architecture::Deinterleave(Type type, string first, string second, string realLoc, string imagLoc)
+{
+  if (type == COMPLEX_SINGLE) {
+    return CDeinterleave(first, second, realLoc, imagLoc);
+  } else if (type == COMPLEX_DOUBLE) {
+    return ZDeinterleave(first, second, realLoc, imagLoc);
+  } else {
+    cout << "Error: Deinterleave bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+string Architecture::Interleave(Type type, string realLoc, string imagLoc, string first, string second)
+{
+  if (type == COMPLEX_SINGLE) {
+    return CInterleave(realLoc, imagLoc, first, second);
+  } else if (type == COMPLEX_DOUBLE) {
+    return ZInterleave(realLoc, imagLoc, first, second);
+  } else {
+    cout << "Error: Interleave bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+// A planar register is filled from two interleaved registers worth
+// of memory, the second VecRegWidth(type) elements after the first
+string Architecture::PlanarContiguousLoad(Type type, string memPtr, string receivingLoc)
+{
+  string secondPtr = "(" + memPtr + ") + " + std::to_string((long long int) VecRegWidth(type));
+  return "{ " + TypeName(type) + " planar_lo, planar_hi; "
+    + OneLine(ContiguousLoad(type, memPtr, "planar_lo")) + " "
+    + OneLine(ContiguousLoad(type, secondPtr, "planar_hi")) + " "
+    + OneLine(Deinterleave(type, "planar_lo", "planar_hi", receivingLoc + ".re", receivingLoc + ".im")) + " }\n";
+}
+
+string Architecture::PlanarStridedLoad(Type type, string memPtr, string receivingLoc, string stride)
+{
+  string secondPtr = "(" + memPtr + ") + " + std::to_string((long long int) VecRegWidth(type)) + " * " + stride;
+  return "{ " + TypeName(type) + " planar_lo, planar_hi; "
+    + OneLine(StridedLoad(type, memPtr, "planar_lo", stride)) + " "
+    + OneLine(StridedLoad(type, secondPtr, "planar_hi", stride)) + " "
+    + OneLine(Deinterleave(type, "planar_lo", "planar_hi", receivingLoc + ".re", receivingLoc + ".im")) + " }\n";
+}
+
+string Architecture::PlanarDuplicateLoad(Type type, string memPtr, string receivingLoc)
+{
+  return OneLine(DuplicateLoad(ComponentType(type), ComponentPtr(type, memPtr), receivingLoc + ".re")) + " "
+    + DuplicateLoad(ComponentType(type), ComponentPtr(type, memPtr) + " + 1", receivingLoc + ".im");
+}
+
+string Architecture::PlanarContiguousStore(Type type, string memPtr, string startingLoc)
+{
+  string secondPtr = "(" + memPtr + ") + " + std::to_string((long long int) VecRegWidth(type));
+  return "{ " + TypeName(type) + " planar_lo, planar_hi; "
+    + OneLine(Interleave(type, startingLoc + ".re", startingLoc + ".im", "planar_lo", "planar_hi")) + " "
+    + OneLine(ContiguousStore(type, memPtr, "planar_lo")) + " "
+    + OneLine(ContiguousStore(type, secondPtr, "planar_hi")) + " }\n";
+}
+
+string Architecture::PlanarStridedStore(Type type, string memPtr, string startingLoc, string stride)
+{
+  string secondPtr = "(" + memPtr + ") + " + std::to_string((long long int) VecRegWidth(type)) + " * " + stride;
+  return "{ " + TypeName(type) + " planar_lo, planar_hi; "
+    + OneLine(Interleave(type, startingLoc + ".re", startingLoc + ".im", "planar_lo", "planar_hi")) + " "
+    + OneLine(StridedStore(type, memPtr, "planar_lo", stride)) + " "
+    + OneLine(StridedStore(type, secondPtr, "planar_hi", stride)) + " }\n";
+}
+
+string Architecture::PlanarMulCode(Type type, string operand1, string operand2, string result)
+{
+  if (type == COMPLEX_SINGLE) {
+    return CPlanarMulCode(operand1, operand2, result);
+  } else if (type == COMPLEX_DOUBLE) {
+    return ZPlanarMulCode(operand1, operand2, result);
+  } else {
+    cout << "Error: PlanarMulCode bad type\n";
+    LOG_FAIL("Replacement for call to throw;");
+    throw;
+  }
+}
+
+// Rounds down to a multiple of the register width, but never below it
+static int RoundToRegMultiple(int size, int regWidth)
+{
+  return max(regWidth, size - (size % regWidth));
+}
+
+// Block sizes follow the BLIS analytical model with register blocks
+// of VecRegWidth x VecRegWidth: a KC x NR sliver of B takes half of
+// L1, an MC x KC block of A half of L2 and a KC x NC panel of B half
+// of L3, leaving the other half of each level for the streamed operands
+int Architecture::KCBlockSize(Type type)
+{
+  int regWidth = VecRegWidth(type);
+  int kc = (L1Bytes() / 2) / (regWidth * ElemBytes(type));
+  return RoundToRegMultiple(kc, regWidth);
+}
+
+int Architecture::MCBlockSize(Type type)
+{
+  int regWidth = VecRegWidth(type);
+  int mc = (L2Bytes() / 2) / (KCBlockSize(type) * ElemBytes(type));
+  return RoundToRegMultiple(mc, regWidth);
+}
+
+int Architecture::NCBlockSize(Type type)
+{
+  int regWidth = VecRegWidth(type);
+  int nc = (L3Bytes() / 2) / (KCBlockSize(type) * ElemBytes(type));
+  return RoundToRegMultiple(nc, regWidth);
+}
+
 string Architecture::SPackedLoad(string memPtr, string receivingLoc, string stride, int residual) {
   string loadCode = SZeroVar(receivingLoc);
   for (int i = 0; i < residual; i++) {
@@ -279,6 +611,11 @@ string AMDEngSample::CompileString(string executableName, string testFileName)
   return compileStr;
 }
 
+string AMDEngSample::OpenMPFlag()
+{
+  return "-fopenmp";
+}
+
 double AMDEngSample::SFlopsPerCycle()
 {
   return 16.0;
@@ -294,6 +631,31 @@ double AMDEngSample::CyclesPerSecond()
   return 3.7e9;
 }
 
+int AMDEngSample::L1Bytes()
+{
+  return 16 * 1024;
+}
+
+int AMDEngSample::L2Bytes()
+{
+  return 2 * 1024 * 1024;
+}
+
+int AMDEngSample::L3Bytes()
+{
+  return 8 * 1024 * 1024;
+}
+
+int AMDEngSample::NumVecRegs()
+{
+  return 16;
+}
+
+int AMDEngSample::NumCores()
+{
+  return 4;
+}
+
 int AMDEngSample::SVecRegWidth()
 {
   return 4;
@@ -338,6 +700,11 @@ string AMDEngSample::SContiguousLoad(string memPtr, string receivingLoc)
   return receivingLoc + ".v = _mm_loadu_ps( " + memPtr + " );\n";
 }
 
+string AMDEngSample::SAlignedLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm_load_ps( " + memPtr + " );\n";
+}
+
 string AMDEngSample::SDuplicateLoad(string memPtr, string receivingLoc)
 {
   return receivingLoc + ".v = _mm_load_ps1( " + memPtr + " );\n";
@@ -356,6 +723,11 @@ string AMDEngSample::SContiguousStore(string memPtr, string startingLoc)
   return "_mm_storeu_ps( " + memPtr + ", " + startingLoc + ".v );\n";
 }
 
+string AMDEngSample::SAlignedStore(string memPtr, string startingLoc)
+{
+  return "_mm_store_ps( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string AMDEngSample::SStridedStore(string memPtr, string startingLoc, string stride)
 {
   return "*" + memPtr + " = " + startingLoc + ".f[0]; "
@@ -364,6 +736,11 @@ string AMDEngSample::SStridedStore(string memPtr, string startingLoc, string str
     + "*(" + memPtr + " + 3 * " + stride + ") = " + startingLoc + ".f[3];\n";
 }
 
+string AMDEngSample::SStreamStore(string memPtr, string startingLoc)
+{
+  return "_mm_stream_ps( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string AMDEngSample::SZeroVar(string varName)
 {
   return varName + ".v = _mm_setzero_ps();\n";
@@ -411,6 +788,11 @@ string AMDEngSample::DContiguousLoad(string memPtr, string receivingLoc)
   return receivingLoc + ".v = _mm_loadu_pd( " + memPtr + " );\n";
 }
 
+string AMDEngSample::DAlignedLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm_load_pd( " + memPtr + " );\n";
+}
+
 string AMDEngSample::DStridedLoad(string memPtr, string receivingLoc, string stride)
 {
   return receivingLoc + ".d[0] = *(" + memPtr + "); "
@@ -427,17 +809,101 @@ string AMDEngSample::DContiguousStore(string memPtr, string startingLoc)
   return "_mm_storeu_pd( " + memPtr + ", " + startingLoc + ".v );\n";
 }
 
+string AMDEngSample::DAlignedStore(string memPtr, string startingLoc)
+{
+  return "_mm_store_pd( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string AMDEngSample::DStridedStore(string memPtr, string startingLoc, string stride)
 {
   return "*" + memPtr + " = " + startingLoc + ".d[0]; "
     + "*(" + memPtr + " + " + stride + ") = " + startingLoc + ".d[1];\n";
 }
 
+string AMDEngSample::DStreamStore(string memPtr, string startingLoc)
+{
+  return "_mm_stream_pd( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string AMDEngSample::DZeroVar(string varName)
 {
   return varName + ".v = _mm_setzero_pd();\n";
 }
 
+// The swapped product is subtracted from the real lanes and added
+// to the imaginary lanes: (ar*br - ai*bi, ai*br + ar*bi)
+string AMDEngSample::CMulCode(string operand1, string operand2, string result)
+{
+  return result + ".v = _mm_fmaddsub_ps( " + operand1 + ".v, _mm_moveldup_ps( " + operand2 + ".v ), "
+    + "_mm_mul_ps( _mm_shuffle_ps( " + operand1 + ".v, " + operand1 + ".v, 0xB1 ), _mm_movehdup_ps( " + operand2 + ".v ) ) );\n";
+}
+
+string AMDEngSample::CFMACode(string operand1, string operand2, string operand3, string result)
+{
+  return result + ".v = _mm_fmaddsub_ps( " + operand1 + ".v, _mm_moveldup_ps( " + operand2 + ".v ), "
+    + "_mm_fmaddsub_ps( _mm_shuffle_ps( " + operand1 + ".v, " + operand1 + ".v, 0xB1 ), _mm_movehdup_ps( " + operand2 + ".v ), " + operand3 + ".v ) );\n";
+}
+
+string AMDEngSample::CDuplicateLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm_castpd_ps( _mm_loaddup_pd( (double const *) (" + memPtr + ") ) );\n";
+}
+
+string AMDEngSample::CDeinterleave(string first, string second, string realLoc, string imagLoc)
+{
+  return realLoc + ".v = _mm_shuffle_ps( " + first + ".v, " + second + ".v, 0x88 ); "
+    + imagLoc + ".v = _mm_shuffle_ps( " + first + ".v, " + second + ".v, 0xDD );\n";
+}
+
+string AMDEngSample::CInterleave(string realLoc, string imagLoc, string first, string second)
+{
+  return first + ".v = _mm_unpacklo_ps( " + realLoc + ".v, " + imagLoc + ".v ); "
+    + second + ".v = _mm_unpackhi_ps( " + realLoc + ".v, " + imagLoc + ".v );\n";
+}
+
+string AMDEngSample::CPlanarMulCode(string operand1, string operand2, string result)
+{
+  return "{ __m128 planar_re = _mm_fmsub_ps( " + operand1 + ".re.v, " + operand2 + ".re.v, _mm_mul_ps( " + operand1 + ".im.v, " + operand2 + ".im.v ) ); "
+    + result + ".im.v = _mm_fmadd_ps( " + operand1 + ".re.v, " + operand2 + ".im.v, _mm_mul_ps( " + operand1 + ".im.v, " + operand2 + ".re.v ) ); "
+    + result + ".re.v = planar_re; }\n";
+}
+
+string AMDEngSample::ZMulCode(string operand1, string operand2, string result)
+{
+  return result + ".v = _mm_fmaddsub_pd( " + operand1 + ".v, _mm_movedup_pd( " + operand2 + ".v ), "
+    + "_mm_mul_pd( _mm_shuffle_pd( " + operand1 + ".v, " + operand1 + ".v, 0x1 ), _mm_unpackhi_pd( " + operand2 + ".v, " + operand2 + ".v ) ) );\n";
+}
+
+string AMDEngSample::ZFMACode(string operand1, string operand2, string operand3, string result)
+{
+  return result + ".v = _mm_fmaddsub_pd( " + operand1 + ".v, _mm_movedup_pd( " + operand2 + ".v ), "
+    + "_mm_fmaddsub_pd( _mm_shuffle_pd( " + operand1 + ".v, " + operand1 + ".v, 0x1 ), _mm_unpackhi_pd( " + operand2 + ".v, " + operand2 + ".v ), " + operand3 + ".v ) );\n";
+}
+
+string AMDEngSample::ZDuplicateLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm_loadu_pd( (double const *) (" + memPtr + ") );\n";
+}
+
+string AMDEngSample::ZDeinterleave(string first, string second, string realLoc, string imagLoc)
+{
+  return realLoc + ".v = _mm_unpacklo_pd( " + first + ".v, " + second + ".v ); "
+    + imagLoc + ".v = _mm_unpackhi_pd( " + first + ".v, " + second + ".v );\n";
+}
+
+string AMDEngSample::ZInterleave(string realLoc, string imagLoc, string first, string second)
+{
+  return first + ".v = _mm_unpacklo_pd( " + realLoc + ".v, " + imagLoc + ".v ); "
+    + second + ".v = _mm_unpackhi_pd( " + realLoc + ".v, " + imagLoc + ".v );\n";
+}
+
+string AMDEngSample::ZPlanarMulCode(string operand1, string operand2, string result)
+{
+  return "{ __m128d planar_re = _mm_fmsub_pd( " + operand1 + ".re.v, " + operand2 + ".re.v, _mm_mul_pd( " + operand1 + ".im.v, " + operand2 + ".im.v ) ); "
+    + result + ".im.v = _mm_fmadd_pd( " + operand1 + ".re.v, " + operand2 + ".im.v, _mm_mul_pd( " + operand1 + ".im.v, " + operand2 + ".re.v ) ); "
+    + result + ".re.v = planar_re; }\n";
+}
+
 string Stampede::CompileString(string executableName, string testFileName)
 {
   string compileStr = "icc -O3 -xhost -ip -ipo -fargument-noalias-global -o ";
@@ -445,11 +911,41 @@ string Stampede::CompileString(string executableName, string testFileName)
   return compileStr;
 }
 
+string Stampede::OpenMPFlag()
+{
+  return "-openmp";
+}
+
 double Stampede::CyclesPerSecond()
 {
   return 2.7e9;
 }
 
+int Stampede::L1Bytes()
+{
+  return 32 * 1024;
+}
+
+int Stampede::L2Bytes()
+{
+  return 256 * 1024;
+}
+
+int Stampede::L3Bytes()
+{
+  return 20 * 1024 * 1024;
+}
+
+int Stampede::NumVecRegs()
+{
+  return 16;
+}
+
+int Stampede::NumCores()
+{
+  return 16;
+}
+
 double Stampede::DFlopsPerCycle()
 {
   return 8.0;
@@ -509,6 +1005,11 @@ string Stampede::SContiguousLoad(string memPtr, string receivingLoc)
   return receivingLoc + ".v = _mm256_loadu_ps( " + memPtr + " );\n";
 }
 
+string Stampede::SAlignedLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm256_load_ps( " + memPtr + " );\n";
+}
+
 string Stampede::SDuplicateLoad(string memPtr, string receivingLoc)
 {
   return receivingLoc + ".v = _mm256_broadcast_ss( " + memPtr + " );\n";
@@ -531,6 +1032,11 @@ string Stampede::SContiguousStore(string memPtr, string startingLoc)
   return "_mm256_storeu_ps( " + memPtr + ", " + startingLoc + ".v );\n";
 }
 
+string Stampede::SAlignedStore(string memPtr, string startingLoc)
+{
+  return "_mm256_store_ps( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string Stampede::SStridedStore(string memPtr, string startingLoc, string stride)
 {
   return "*" + memPtr + " = " + startingLoc + ".f[0]; "
@@ -543,6 +1049,11 @@ string Stampede::SStridedStore(string memPtr, string startingLoc, string stride)
     + "*(" + memPtr + " + 7 * " + stride + ") = " + startingLoc + ".f[7];\n";
 }
 
+string Stampede::SStreamStore(string memPtr, string startingLoc)
+{
+  return "_mm256_stream_ps( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string Stampede::SZeroVar(string varName)
 {
   return varName + ".v = _mm256_setzero_ps();\n";
@@ -593,6 +1104,11 @@ string Stampede::DContiguousLoad(string memPtr, string receivingLoc)
   return receivingLoc + ".v = _mm256_loadu_pd( " + memPtr + " );\n";
 }
 
+string Stampede::DAlignedLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm256_load_pd( " + memPtr + " );\n";
+}
+
 string Stampede::DStridedLoad(string memPtr, string receivingLoc, string stride)
 {
   return receivingLoc + ".d[0] = *(" + memPtr + "); "
@@ -611,6 +1127,11 @@ string Stampede::DContiguousStore(string memPtr, string startingLoc)
   return "_mm256_storeu_pd( " + memPtr + ", " + startingLoc + ".v );\n";
 }
 
+string Stampede::DAlignedStore(string memPtr, string startingLoc)
+{
+  return "_mm256_store_pd( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string Stampede::DStridedStore(string memPtr, string startingLoc, string stride)
 {
   return "*" + memPtr + " = " + startingLoc + ".d[0]; "
@@ -619,11 +1140,89 @@ string Stampede::DStridedStore(string memPtr, string startingLoc, string stride)
     + "*(" + memPtr + " + 3 * " + stride + ") = " + startingLoc + ".d[3];\n";
 }
 
+string Stampede::DStreamStore(string memPtr, string startingLoc)
+{
+  return "_mm256_stream_pd( " + memPtr + ", " + startingLoc + ".v );\n";
+}
+
 string Stampede::DZeroVar(string varName)
 {
   return varName + ".v = _mm256_setzero_pd();\n";
 }
 
+// No FMA, the swapped product goes through addsub instead
+string Stampede::CMulCode(string operand1, string operand2, string result)
+{
+  return result + ".v = _mm256_addsub_ps( _mm256_mul_ps( " + operand1 + ".v, _mm256_moveldup_ps( " + operand2 + ".v ) ), "
+    + "_mm256_mul_ps( _mm256_permute_ps( " + operand1 + ".v, 0xB1 ), _mm256_movehdup_ps( " + operand2 + ".v ) ) );\n";
+}
+
+string Stampede::CFMACode(string operand1, string operand2, string operand3, string result)
+{
+  return result + ".v = _mm256_addsub_ps( _mm256_add_ps( _mm256_mul_ps( " + operand1 + ".v, _mm256_moveldup_ps( " + operand2 + ".v ) ), " + operand3 + ".v ), "
+    + "_mm256_mul_ps( _mm256_permute_ps( " + operand1 + ".v, 0xB1 ), _mm256_movehdup_ps( " + operand2 + ".v ) ) );\n";
+}
+
+string Stampede::CDuplicateLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm256_castpd_ps( _mm256_broadcast_sd( (double const *) (" + memPtr + ") ) );\n";
+}
+
+string Stampede::CDeinterleave(string first, string second, string realLoc, string imagLoc)
+{
+  return realLoc + ".v = _mm256_shuffle_ps( " + first + ".v, " + second + ".v, 0x88 ); "
+    + imagLoc + ".v = _mm256_shuffle_ps( " + first + ".v, " + second + ".v, 0xDD );\n";
+}
+
+string Stampede::CInterleave(string realLoc, string imagLoc, string first, string second)
+{
+  return first + ".v = _mm256_unpacklo_ps( " + realLoc + ".v, " + imagLoc + ".v ); "
+    + second + ".v = _mm256_unpackhi_ps( " + realLoc + ".v, " + imagLoc + ".v );\n";
+}
+
+string Stampede::CPlanarMulCode(string operand1, string operand2, string result)
+{
+  return "{ __m256 planar_re = _mm256_sub_ps( _mm256_mul_ps( " + operand1 + ".re.v, " + operand2 + ".re.v ), _mm256_mul_ps( " + operand1 + ".im.v, " + operand2 + ".im.v ) ); "
+    + result + ".im.v = _mm256_add_ps( _mm256_mul_ps( " + operand1 + ".re.v, " + operand2 + ".im.v ), _mm256_mul_ps( " + operand1 + ".im.v, " + operand2 + ".re.v ) ); "
+    + result + ".re.v = planar_re; }\n";
+}
+
+string Stampede::ZMulCode(string operand1, string operand2, string result)
+{
+  return result + ".v = _mm256_addsub_pd( _mm256_mul_pd( " + operand1 + ".v, _mm256_movedup_pd( " + operand2 + ".v ) ), "
+    + "_mm256_mul_pd( _mm256_permute_pd( " + operand1 + ".v, 0x5 ), _mm256_permute_pd( " + operand2 + ".v, 0xF ) ) );\n";
+}
+
+string Stampede::ZFMACode(string operand1, string operand2, string operand3, string result)
+{
+  return result + ".v = _mm256_addsub_pd( _mm256_add_pd( _mm256_mul_pd( " + operand1 + ".v, _mm256_movedup_pd( " + operand2 + ".v ) ), " + operand3 + ".v ), "
+    + "_mm256_mul_pd( _mm256_permute_pd( " + operand1 + ".v, 0x5 ), _mm256_permute_pd( " + operand2 + ".v, 0xF ) ) );\n";
+}
+
+string Stampede::ZDuplicateLoad(string memPtr, string receivingLoc)
+{
+  return receivingLoc + ".v = _mm256_broadcast_pd( (__m128d const *) (" + memPtr + ") );\n";
+}
+
+string Stampede::ZDeinterleave(string first, string second, string realLoc, string imagLoc)
+{
+  return realLoc + ".v = _mm256_unpacklo_pd( " + first + ".v, " + second + ".v ); "
+    + imagLoc + ".v = _mm256_unpackhi_pd( " + first + ".v, " + second + ".v );\n";
+}
+
+string Stampede::ZInterleave(string realLoc, string imagLoc, string first, string second)
+{
+  return first + ".v = _mm256_unpacklo_pd( " + realLoc + ".v, " + imagLoc + ".v ); "
+    + second + ".v = _mm256_unpackhi_pd( " + realLoc + ".v, " + imagLoc + ".v );\n";
+}
+
+string Stampede::ZPlanarMulCode(string operand1, string operand2, string result)
+{
+  return "{ __m256d planar_re = _mm256_sub_pd( _mm256_mul_pd( " + operand1 + ".re.v, " + operand2 + ".re.v ), _mm256_mul_pd( " + operand1 + ".im.v, " + operand2 + ".im.v ) ); "
+    + result + ".im.v = _mm256_add_pd( _mm256_mul_pd( " + operand1 + ".re.v, " + operand2 + ".im.v ), _mm256_mul_pd( " + operand1 + ".im.v, " + operand2 + ".re.v ) ); "
+    + result + ".re.v = planar_re; }\n";
+}
+
 string HaswellMacbook::CompileString(string executableName, string testFileName)
 {
   string compileStr = "clang -O3 -mavx -march=native -mfma -funroll-loops -o ";
@@ -631,11 +1230,21 @@ string HaswellMacbook::CompileString(string executableName, string testFileName)
   return compileStr;
 }
 
+string HaswellMacbook::OpenMPFlag()
+{
+  return "-fopenmp";
+}
+
 double HaswellMacbook::CyclesPerSecond()
 {
   return 1.4e9;
 }
 
+int HaswellMacbook::NumCores()
+{
+  return 2;
+}
+
 double HaswellMacbook::DFlopsPerCycle()
 {
   return 16.0;
@@ -655,4 +1264,46 @@ string HaswellMacbook::DFMACode(string operand1, string operand2, string operand
   return result + ".v = _mm256_fmadd_pd( " + operand1 + ".v, " + operand2 + ".v, " + operand3 + ".v );\n";
 }
 
+// a*b is fmaddsub(a, dup(re b), swap(a)*dup(im b)).  For a*b + c the
+// addend is folded into the swapped product, fmaddsub(swap(a), dup(im b), c)
+// is (ai*bi - cr, ar*bi + ci), so the outer fmaddsub yields
+// (ar*br - ai*bi + cr, ai*br + ar*bi + ci)
+string HaswellMacbook::CMulCode(string operand1, string operand2, string result)
+{
+  return result + ".v = _mm256_fmaddsub_ps( " + operand1 + ".v, _mm256_moveldup_ps( " + operand2 + ".v ), "
+    + "_mm256_mul_ps( _mm256_permute_ps( " + operand1 + ".v, 0xB1 ), _mm256_movehdup_ps( " + operand2 + ".v ) ) );\n";
+}
+
+string HaswellMacbook::CFMACode(string operand1, string operand2, string operand3, string result)
+{
+  return result + ".v = _mm256_fmaddsub_ps( " + operand1 + ".v, _mm256_moveldup_ps( " + operand2 + ".v ), "
+    + "_mm256_fmaddsub_ps( _mm256_permute_ps( " + operand1 + ".v, 0xB1 ), _mm256_movehdup_ps( " + operand2 + ".v ), " + operand3 + ".v ) );\n";
+}
+
+string HaswellMacbook::CPlanarMulCode(string operand1, string operand2, string result)
+{
+  return "{ __m256 planar_re = _mm256_fmsub_ps( " + operand1 + ".re.v, " + operand2 + ".re.v, _mm256_mul_ps( " + operand1 + ".im.v, " + operand2 + ".im.v ) ); "
+    + result + ".im.v = _mm256_fmadd_ps( " + operand1 + ".re.v, " + operand2 + ".im.v, _mm256_mul_ps( " + operand1 + ".im.v, " + operand2 + ".re.v ) ); "
+    + result + ".re.v = planar_re; }\n";
+}
+
+string HaswellMacbook::ZMulCode(string operand1, string operand2, string result)
+{
+  return result + ".v = _mm256_fmaddsub_pd( " + operand1 + ".v, _mm256_movedup_pd( " + operand2 + ".v ), "
+    + "_mm256_mul_pd( _mm256_permute_pd( " + operand1 + ".v, 0x5 ), _mm256_permute_pd( " + operand2 + ".v, 0xF ) ) );\n";
+}
+
+string HaswellMacbook::ZFMACode(string operand1, string operand2, string operand3, string result)
+{
+  return result + ".v = _mm256_fmaddsub_pd( " + operand1 + ".v, _mm256_movedup_pd( " + operand2 + ".v ), "
+    + "_mm256_fmaddsub_pd( _mm256_permute_pd( " + operand1 + ".v, 0x5 ), _mm256_permute_pd( " + operand2 + ".v, 0xF ), " + operand3 + ".v ) );\n";
+}
+
+string HaswellMacbook::ZPlanarMulCode(string operand1, string operand2, string result)
+{
+  return "{ __m256d planar_re = _mm256_fmsub_pd( " + operand1 + ".re.v, " + operand2 + ".re.v, _mm256_mul_pd( " + operand1 + ".im.v, " + operand2 + ".im.v ) ); "
+    + result + ".im.v = _mm256_fmadd_pd( " + operand1 + ".re.v, " + operand2 + ".im.v, _mm256_mul_pd( " + operand1 + ".im.v, " + operand2 + ".re.v ) ); "
+    + result + ".re.v = planar_re; }\n";
+}
+
 #endif // DOLLDLA
@@ -27,6 +27,15 @@
 #include "avx.h"
 #include "isaExtension.h"
 
+#define CACHELINEBYTES 64
+
+// Cache level a software prefetch brings its line into
+enum PrefetchHint { PREFETCHT0,
+		    PREFETCHT1,
+		    PREFETCHNTA };
+
+string PrefetchHintToStr(PrefetchHint hint);
+
 class Architecture
 {
  protected:
@@ -45,11 +54,14 @@ class Architecture
   virtual string SFMACode(string operand1, string operand2, string operand3, string result) = 0;
   virtual string SAccumCode(string memPtr, string startinLoc) = 0;
   virtual string SContiguousLoad(string memPtr, string receivingLoc) = 0;
+  virtual string SAlignedLoad(string memPtr, string receivingLoc) = 0;
   virtual string SStridedLoad(string memPtr, string receivingLoc, string stride) = 0;
   virtual string SPackedLoad(string memPtr, string receivingLoc, string stride, int residual);
   virtual string SDuplicateLoad(string memPtr, string receivingLoc) = 0;
   virtual string SContiguousStore(string memPtr, string startingLoc) = 0;
+  virtual string SAlignedStore(string memPtr, string startingLoc) = 0;
   virtual string SStridedStore(string memPtr, string startingLoc, string stride) = 0;
+  virtual string SStreamStore(string memPtr, string startingLoc) = 0;
   virtual string SUnpackStore(string memPtr, string startingLoc, string stride, int residual);
   virtual string SZeroVar(string varName) = 0;
   virtual double SFlopsPerCycle() = 0;
@@ -63,20 +75,47 @@ class Architecture
   virtual string DFMACode(string operand1, string operand2, string operand3, string result) = 0;
   virtual string DAccumCode(string memPtr, string startinLoc) = 0;
   virtual string DContiguousLoad(string memPtr, string receivingLoc) = 0;
+  virtual string DAlignedLoad(string memPtr, string receivingLoc) = 0;
   virtual string DStridedLoad(string memPtr, string receivingLoc, string stride) = 0;
   virtual string DPackedLoad(string memPtr, string receivingLoc, string stride, int residual);
   virtual string DDuplicateLoad(string memPtr, string receivingLoc) = 0;
   virtual string DContiguousStore(string memPtr, string startingLoc) = 0;
+  virtual string DAlignedStore(string memPtr, string startingLoc) = 0;
   virtual string DStridedStore(string memPtr, string startingLoc, string stride) = 0;
+  virtual string DStreamStore(string memPtr, string startingLoc) = 0;
   virtual string DUnpackStore(string memPtr, string startingLoc, string stride, int residual);
   virtual string DZeroVar(string varName) = 0;
   virtual double DFlopsPerCycle() = 0;
 
+  // Complex single and double precision, interleaved registers
+  // are the real registers holding real and imaginary parts in
+  // alternating lanes.  Planar registers are a pair of real
+  // registers, one of real parts and one of imaginary parts
+  virtual string CMulCode(string operand1, string operand2, string result) = 0;
+  virtual string CFMACode(string operand1, string operand2, string operand3, string result) = 0;
+  virtual string CDuplicateLoad(string memPtr, string receivingLoc) = 0;
+  virtual string CDeinterleave(string first, string second, string realLoc, string imagLoc) = 0;
+  virtual string CInterleave(string realLoc, string imagLoc, string first, string second) = 0;
+  virtual string CPlanarMulCode(string operand1, string operand2, string result) = 0;
+
+  virtual string ZMulCode(string operand1, string operand2, string result) = 0;
+  virtual string ZFMACode(string operand1, string operand2, string operand3, string result) = 0;
+  virtual string ZDuplicateLoad(string memPtr, string receivingLoc) = 0;
+  virtual string ZDeinterleave(string first, string second, string realLoc, string imagLoc) = 0;
+  virtual string ZInterleave(string realLoc, string imagLoc, string first, string second) = 0;
+  virtual string ZPlanarMulCode(string operand1, string operand2, string result) = 0;
+
   // Compilation
   virtual string CompileString(string executableName, string testFileName) = 0;
+  virtual string OpenMPFlag() = 0;
 
   // Performance
   virtual double CyclesPerSecond() = 0;
+  virtual int L1Bytes() = 0;
+  virtual int L2Bytes() = 0;
+  virtual int L3Bytes() = 0;
+  virtual int NumVecRegs() = 0;
+  virtual int NumCores() = 0;
 
   // General
   int VecRegWidth(Type type);
@@ -87,14 +126,43 @@ class Architecture
   string FMACode(Type type, string operand1, string operand2, string operand3, string result);
   string AccumCode(Type type, string memPtr, string startingLoc);
   string ContiguousLoad(Type type, string memPtr, string receivingLoc);
+  // memPtr must be a multiple of VecRegBytes(type)
+  string AlignedLoad(Type type, string memPtr, string receivingLoc);
   string StridedLoad(Type type, string memPtr, string receivingLoc, string stride);
   string PackedLoad(Type type, string memPtr, string receivingLoc, string stride, int residual);
   string DuplicateLoad(Type type, string memPtr, string receivingLoc);
   string ContiguousStore(Type type, string memPtr, string startingLoc);
+  // memPtr must be a multiple of VecRegBytes(type)
+  string AlignedStore(Type type, string memPtr, string startingLoc);
   string StridedStore(Type type, string memPtr, string startingLoc, string stride);
+  // Non-temporal store when memPtr is vector aligned, regular store
+  // otherwise.  The alignment check is skipped when it is known to pass
+  string StreamStore(Type type, string memPtr, string startingLoc, bool isAligned = false);
+  string StoreFence();
   string UnpackStore(Type type, string memPtr, string startingLoc, string stride, int residual);
   string ZeroVar(Type type, string varName);
   double FlopsPerCycle(Type type);
+  string Prefetch(string memPtr, int byteDistance, PrefetchHint hint);
+
+  // Planar complex registers, each holds 2 * VecRegWidth(type)
+  // elements in an order only the planar loads and stores know
+  int PlanarVecRegWidth(Type type);
+  string PlanarTypeName(Type type);
+  string PlanarContiguousLoad(Type type, string memPtr, string receivingLoc);
+  string PlanarStridedLoad(Type type, string memPtr, string receivingLoc, string stride);
+  string PlanarDuplicateLoad(Type type, string memPtr, string receivingLoc);
+  string PlanarContiguousStore(Type type, string memPtr, string startingLoc);
+  string PlanarStridedStore(Type type, string memPtr, string startingLoc, string stride);
+  string PlanarMulCode(Type type, string operand1, string operand2, string result);
+  string Deinterleave(Type type, string first, string second, string realLoc, string imagLoc);
+  string Interleave(Type type, string realLoc, string imagLoc, string first, string second);
+
+  // Cache blocking, all multiples of VecRegWidth(type)
+  int ElemBytes(Type type);
+  int VecRegBytes(Type type);
+  int KCBlockSize(Type type);
+  int MCBlockSize(Type type);
+  int NCBlockSize(Type type);
 
 };
 
@@ -110,10 +178,13 @@ class AMDEngSample : public Architecture
   virtual string SFMACode(string operand1, string operand2, string operand3, string result);
   virtual string SAccumCode(string memPtr, string startingLoc);
   virtual string SContiguousLoad(string memPtr, string receivingLoc);
+  virtual string SAlignedLoad(string memPtr, string receivingLoc);
   virtual string SStridedLoad(string memPtr, string receivingLoc, string stride);
   virtual string SDuplicateLoad(string memPtr, string receivingLoc);
   virtual string SContiguousStore(string memPtr, string startingLoc);
+  virtual string SAlignedStore(string memPtr, string startingLoc);
   virtual string SStridedStore(string memPtr, string startingLoc, string stride);
+  virtual string SStreamStore(string memPtr, string startingLoc);
   virtual string SZeroVar(string varName);
   virtual double SFlopsPerCycle();
 
@@ -126,15 +197,40 @@ class AMDEngSample : public Architecture
   virtual string DFMACode(string operand1, string operand2, string operand3, string result);
   virtual string DAccumCode(string memPtr, string startinLoc);
   virtual string DContiguousLoad(string memPtr, string receivingLoc);
+  virtual string DAlignedLoad(string memPtr, string receivingLoc);
   virtual string DStridedLoad(string memPtr, string receivingLoc, string stride);
   virtual string DDuplicateLoad(string memPtr, string receivingLoc);
   virtual string DContiguousStore(string memPtr, string startingLoc);
+  virtual string DAlignedStore(string memPtr, string startingLoc);
   virtual string DStridedStore(string memPtr, string startingLoc, string stride);
+  virtual string DStreamStore(string memPtr, string startingLoc);
   virtual string DZeroVar(string varName);
   virtual double DFlopsPerCycle();
 
+  // Complex single precision
+  virtual string CMulCode(string operand1, string operand2, string result);
+  virtual string CFMACode(string operand1, string operand2, string operand3, string result);
+  virtual string CDuplicateLoad(string memPtr, string receivingLoc);
+  virtual string CDeinterleave(string first, string second, string realLoc, string imagLoc);
+  virtual string CInterleave(string realLoc, string imagLoc, string first, string second);
+  virtual string CPlanarMulCode(string operand1, string operand2, string result);
+
+  // Complex double precision
+  virtual string ZMulCode(string operand1, string operand2, string result);
+  virtual string ZFMACode(string operand1, string operand2, string operand3, string result);
+  virtual string ZDuplicateLoad(string memPtr, string receivingLoc);
+  virtual string ZDeinterleave(string first, string second, string realLoc, string imagLoc);
+  virtual string ZInterleave(string realLoc, string imagLoc, string first, string second);
+  virtual string ZPlanarMulCode(string operand1, string operand2, string result);
+
   virtual string CompileString(string executableName, string testFileName);
+  virtual string OpenMPFlag();
   virtual double CyclesPerSecond();
+  virtual int L1Bytes();
+  virtual int L2Bytes();
+  virtual int L3Bytes();
+  virtual int NumVecRegs();
+  virtual int NumCores();
 
 };
 
@@ -152,10 +248,13 @@ class Stampede : public Architecture
   virtual string SFMACode(string operand1, string operand2, string operand3, string result);
   virtual string SAccumCode(string memPtr, string startingLoc);
   virtual string SContiguousLoad(string memPtr, string receivingLoc);
+  virtual string SAlignedLoad(string memPtr, string receivingLoc);
   virtual string SStridedLoad(string memPtr, string receivingLoc, string stride);
   virtual string SDuplicateLoad(string memPtr, string receivingLoc);
   virtual string SContiguousStore(string memPtr, string startingLoc);
+  virtual string SAlignedStore(string memPtr, string startingLoc);
   virtual string SStridedStore(string memPtr, string startingLoc, string stride);
+  virtual string SStreamStore(string memPtr, string startingLoc);
   virtual string SZeroVar(string varName);
   virtual double SFlopsPerCycle();
 
@@ -168,16 +267,41 @@ class Stampede : public Architecture
   virtual string DFMACode(string operand1, string operand2, string operand3, string result);
   virtual string DAccumCode(string memPtr, string startinLoc);
   virtual string DContiguousLoad(string memPtr, string receivingLoc);
+  virtual string DAlignedLoad(string memPtr, string receivingLoc);
   virtual string DStridedLoad(string memPtr, string receivingLoc, string stride);
   virtual string DDuplicateLoad(string memPtr, string receivingLoc);
   virtual string DContiguousStore(string memPtr, string startingLoc);
+  virtual string DAlignedStore(string memPtr, string startingLoc);
   virtual string DStridedStore(string memPtr, string startingLoc, string stride);
+  virtual string DStreamStore(string memPtr, string startingLoc);
   virtual string DZeroVar(string varName);
   virtual double DFlopsPerCycle();
 
+  // Complex single precision
+  virtual string CMulCode(string operand1, string operand2, string result);
+  virtual string CFMACode(string operand1, string operand2, string operand3, string result);
+  virtual string CDuplicateLoad(string memPtr, string receivingLoc);
+  virtual string CDeinterleave(string first, string second, string realLoc, string imagLoc);
+  virtual string CInterleave(string realLoc, string imagLoc, string first, string second);
+  virtual string CPlanarMulCode(string operand1, string operand2, string result);
+
+  // Complex double precision
+  virtual string ZMulCode(string operand1, string operand2, string result);
+  virtual string ZFMACode(string operand1, string operand2, string operand3, string result);
+  virtual string ZDuplicateLoad(string memPtr, string receivingLoc);
+  virtual string ZDeinterleave(string first, string second, string realLoc, string imagLoc);
+  virtual string ZInterleave(string realLoc, string imagLoc, string first, string second);
+  virtual string ZPlanarMulCode(string operand1, string operand2, string result);
+
   // Compilation
   virtual string CompileString(string executableName, string testFileName);
+  virtual string OpenMPFlag();
   virtual double CyclesPerSecond();
+  virtual int L1Bytes();
+  virtual int L2Bytes();
+  virtual int L3Bytes();
+  virtual int NumVecRegs();
+  virtual int NumCores();
 
 };
 
@@ -192,12 +316,36 @@ class HaswellMacbook : public Stampede
   virtual string DFMACode(string operand1, string operand2, string operand3, string result);
   virtual double DFlopsPerCycle();
 
+  // Complex multiplies use fmaddsub instead of addsub
+  virtual string CMulCode(string operand1, string operand2, string result);
+  virtual string CFMACode(string operand1, string operand2, string operand3, string result);
+  virtual string CPlanarMulCode(string operand1, string operand2, string result);
+  virtual string ZMulCode(string operand1, string operand2, string result);
+  virtual string ZFMACode(string operand1, string operand2, string operand3, string result);
+  virtual string ZPlanarMulCode(string operand1, string operand2, string result);
+
   // Compilation
   virtual string CompileString(string executableName, string testFileName);
+  virtual string OpenMPFlag();
   virtual double CyclesPerSecond();
+  virtual int NumCores();
 
 };
 
 extern Architecture* arch;
 
+// Threads generated code runs with, from LLDLA_NUM_THREADS
+extern unsigned int numThreads;
+
+// Generated code reads its sizes at runtime and handles residuals
+// with a switch over every residual size, from LLDLA_SIZE_GENERIC
+extern bool sizeGeneric;
+
+// Bytes every input operand is promised to be aligned to, from
+// LLDLA_ALIGNMENT.  The default is what the runtime evaluation
+// harness allocates with
+#define DEFAULTINPUTALIGNMENT 16
+#define MAXINPUTALIGNMENT 32
+extern unsigned int inputAlignment;
+
 #endif // DOLLDLA
@@ -40,6 +40,10 @@ AVX::AVX() {
 }
 
 string AVX::MaskRegisterDeclaration(Type dataType, string varName, unsigned int residualSize) {
+  // Complex elements mask both lanes of each residual element
+  if (IsComplex(dataType)) {
+    return MaskRegisterDeclaration(ComponentType(dataType), varName, 2 * residualSize);
+  }
   string varDecl = "__m256i " + varName + " = ";
   int numEnts = arch->VecRegWidth(dataType);
   string opName;
@@ -66,6 +70,36 @@ string AVX::MaskRegisterDeclaration(Type dataType, string varName, unsigned int
   return varDecl;
 }
 
+string AVX::MaskedLoadCode(Type dataType, string memPtr, string maskVarName, string receivingLoc) {
+  if (IsComplex(dataType)) {
+    return MaskedLoadCode(ComponentType(dataType), "(" + ElemTypeName(ComponentType(dataType)) + "*) (" + memPtr + ")", maskVarName, receivingLoc);
+  }
+  string assignOpName;
+  if (dataType == REAL_SINGLE) {
+    assignOpName = "_mm256_maskload_ps";
+  } else if (dataType == REAL_DOUBLE) {
+    assignOpName = "_mm256_maskload_pd";
+  } else {
+    throw;
+  }
+  return receivingLoc + ". v = " + assignOpName + "( " + memPtr + " , " + maskVarName + " );\n";
+}
+
+string AVX::MaskedStoreCode(Type dataType, string memPtr, string maskVarName, string startingLoc) {
+  if (IsComplex(dataType)) {
+    return MaskedStoreCode(ComponentType(dataType), "(" + ElemTypeName(ComponentType(dataType)) + "*) (" + memPtr + ")", maskVarName, startingLoc);
+  }
+  string assignOpName;
+  if (dataType == REAL_SINGLE) {
+    assignOpName = "_mm256_maskstore_ps";
+  } else if (dataType == REAL_DOUBLE) {
+    assignOpName = "_mm256_maskstore_pd";
+  } else {
+    throw;
+  }
+  return assignOpName + "( " + memPtr + " , " + maskVarName + " , " + startingLoc + ".v );\n";
+}
+
 string AVX::GlobalDeclarations() {  
   return "";
 }
@@ -31,6 +31,8 @@ class AVX : public ISAExtension {
   AVX();
 
   static string MaskRegisterDeclaration(Type dataType, string varName, unsigned int residualSize);
+  static string MaskedLoadCode(Type dataType, string memPtr, string maskVarName, string receivingLoc);
+  static string MaskedStoreCode(Type dataType, string memPtr, string maskVarName, string startingLoc);
   virtual string SetupFunc();
   virtual string GlobalDeclarations();
 };
@@ -28,6 +28,7 @@
 #include <assert.h>
 
 #include "benchmarkStats.h"
+#include "kernelLibrary.h"
 #include "miscellaneousExamples.h"
 #include "multiBLASExamples.h"
 #include "problemInstance.h"
@@ -275,6 +276,72 @@ void LGenCompareL2Benchmark(Type type, int mBase, int mInc, int nBase, int nInc,
   cout << "\n------------------- LGen comparison level 2 benchmark ---------------------------\n";
 }
 
+void DotProductLibrary(Type type, vector<int> ms) {
+  cout << "--------------------- dot product kernel library -----------------------------\n\n";
+  string libName = KernelLibraryName(type, "dot");
+  KernelLibrary library(libName, type);
+  BenchmarkStats benchStats(libName);
+  for (auto m : ms) {
+    RealPSet* test = DotTest(type, m);
+    ProblemInstance dotProd;
+    dotProd.SetName("dotProd");
+    dotProd.SetType(type);
+    dotProd.AddDimension(m, "m");
+    auto pStats = RunProblemWithRTE(1, test, &dotProd, &library);
+    benchStats.AddProblemInstanceStats(pStats);
+  }
+  benchStats.PrettyPrintStats();
+  benchStats.WriteToFiles("benchmarks");
+  library.WriteFiles("kernelLibraries");
+  cout << "\n------------------- end dot product kernel library ---------------------------\n";
+}
+
+void GemvLibrary(Type type, bool transpose, vector<int> ms, vector<int> ns) {
+  cout << "--------------------- gemv kernel library -----------------------------\n\n";
+  string libName = KernelLibraryName(type, transpose ? "gemv_t" : "gemv");
+  KernelLibrary library(libName, type);
+  BenchmarkStats benchStats(libName);
+  for (auto m : ms) {
+    for (auto n : ns) {
+      RealPSet* test = Gemv(type, transpose, m, n);
+      ProblemInstance gemv;
+      gemv.SetName("gemv");
+      gemv.SetType(type);
+      gemv.AddDimension(m, "m");
+      gemv.AddDimension(n, "n");
+      auto pStats = RunProblemWithRTE(1, test, &gemv, &library);
+      benchStats.AddProblemInstanceStats(pStats);
+    }
+  }
+  benchStats.PrettyPrintStats();
+  benchStats.WriteToFiles("benchmarks");
+  library.WriteFiles("kernelLibraries");
+  cout << "\n------------------- end gemv kernel library ---------------------------\n";
+}
+
+void MAddLibrary(Type type, vector<int> ms, vector<int> ns) {
+  cout << "--------------------- madd kernel library -----------------------------\n\n";
+  string libName = KernelLibraryName(type, "madd");
+  KernelLibrary library(libName, type);
+  BenchmarkStats benchStats(libName);
+  for (auto m : ms) {
+    for (auto n : ns) {
+      RealPSet* test = MAddTest(type, m, n);
+      ProblemInstance madd;
+      madd.SetName("madd");
+      madd.SetType(type);
+      madd.AddDimension(m, "m");
+      madd.AddDimension(n, "n");
+      auto pStats = RunProblemWithRTE(1, test, &madd, &library);
+      benchStats.AddProblemInstanceStats(pStats);
+    }
+  }
+  benchStats.PrettyPrintStats();
+  benchStats.WriteToFiles("benchmarks");
+  library.WriteFiles("kernelLibraries");
+  cout << "\n------------------- end madd kernel library ---------------------------\n";
+}
+
 void RunDotProdBenchmarks() {
   DotProductBenchmark(REAL_SINGLE, 128, 128, 10);
   DotProductBenchmark(REAL_DOUBLE, 128, 128, 10);
@@ -36,6 +36,13 @@ void SVMulBenchmark(Type type, VecType vecType, int m, int mInc, int iters);
 void ColVAddBenchmark(Type type, int m, int increment, int numIters);
 void MAddBenchmark(Type type, int mBase, int mInc, int nBase, int nInc, int numIters);
 void DotProductBenchmark(Type type, int m, int increment, int numIters);
+
+//Kernel libraries keep the best implementation for each size in the
+// sweep and write them with a dispatch function to kernelLibraries/
+void DotProductLibrary(Type type, vector<int> ms);
+void GemvLibrary(Type type, bool transpose, vector<int> ms, vector<int> ns);
+void MAddLibrary(Type type, vector<int> ms, vector<int> ns);
+
 void RunDotProdBenchmarks();
 void RunAxpyBenchmarks();
 void RunGemvBenchmarks();
@@ -125,6 +125,9 @@ unsigned int GetBenchmarkNumber() {
   cout << "     9 -> LGen level 1 comparison (y := alpha*x + beta*(y + z))" << endl;
   cout << "    10 -> LGen level 2 comparison (y := (A + B^T)*x)" << endl;
   cout << "    11 -> LGen level 3 comparison (C := alpha*(A0 + A1)^T*B + beta*C)" << endl;
+  cout << "    12 -> Dot product kernel library" << endl;
+  cout << "    13 -> Gemv kernel library" << endl;
+  cout << "    14 -> MAdd kernel library" << endl;
   cout << "select one of the options listed above: ";
   unsigned int benchmarkOption;
   cin >> benchmarkOption;
@@ -158,6 +161,35 @@ void LGenLevel3ComparisonMenu() {
   LGenLevel3Comparison(type, ms, ns, ps);
 }
 
+void DotProductLibraryMenu() {
+  Type type;
+  vector<int> ms;
+  type = PromptUserForType();
+  ms = PromptUserForDimension("M");
+  DotProductLibrary(type, ms);
+}
+
+void GemvLibraryMenu() {
+  Type type;
+  vector<int> ms, ns;
+  cout << "Transpose A? (T = yes) (N = no): ";
+  char transChar;
+  cin >> transChar;
+  type = PromptUserForType();
+  ms = PromptUserForDimension("M");
+  ns = PromptUserForDimension("N");
+  GemvLibrary(type, transChar == 'T', ms, ns);
+}
+
+void MAddLibraryMenu() {
+  Type type;
+  vector<int> ms, ns;
+  type = PromptUserForType();
+  ms = PromptUserForDimension("M");
+  ns = PromptUserForDimension("N");
+  MAddLibrary(type, ms, ns);
+}
+
 void SVMulAddBenchmarkMenu() {
  Type type;
   int m, inc, iters;
@@ -275,6 +307,15 @@ void RunBenchmarkNumber(unsigned int num) {
   case(11):
     LGenLevel3ComparisonMenu();
     break;
+  case(12):
+    DotProductLibraryMenu();
+    break;
+  case(13):
+    GemvLibraryMenu();
+    break;
+  case(14):
+    MAddLibraryMenu();
+    break;
   default:
     cout << "Error: " << num << " is not a valid benchmark number" << endl;
     break;
@@ -0,0 +1,541 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmarkSuite.h"
+
+#if DOLLDLA
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#include "blasExamples.h"
+#include "driverUtils.h"
+#include "miscellaneousExamples.h"
+#include "problemRunner.h"
+#include "singleOperationExamples.h"
+#include "sizeGeneric.h"
+
+typedef RealPSet* (*SuiteBuilder)(Type type, const string &flags, const vector<int> &dims);
+
+//An operation that can be named in a suite file.  Each character
+// of m_flagKinds is 'T' for an N/T transpose flag or 'V' for a C/R
+// vector flag
+struct SuiteOperation {
+  string m_name;
+  string m_opName;
+  string m_flagKinds;
+  vector<string> m_dimNames;
+  SuiteBuilder m_builder;
+};
+
+static const vector<SuiteOperation>& SuiteOperations() {
+  static const vector<SuiteOperation> ops = {
+    {"dot", "dxt_dot", "", {"m"},
+     [](Type type, const string &flags, const vector<int> &dims) { return DotTest(type, dims[0]); }},
+    {"madd", "dxt_madd", "", {"m", "n"},
+     [](Type type, const string &flags, const vector<int> &dims) { return MAddTest(type, dims[0], dims[1]); }},
+    {"mvmul", "dxt_mvmul", "T", {"m", "n"},
+     [](Type type, const string &flags, const vector<int> &dims) { return MVMulTest(type, flags[0] == 'T', dims[0], dims[1]); }},
+    {"svmul", "dxt_sv_mul", "V", {"m"},
+     [](Type type, const string &flags, const vector<int> &dims) { return SVMulTest(type, CharToVecType(flags[0]), dims[0]); }},
+    {"vmmul", "dxt_vmmul", "", {"m", "n"},
+     [](Type type, const string &flags, const vector<int> &dims) { return VMMulTest(type, dims[0], dims[1]); }},
+    {"smmul", "dxt_smmul", "", {"m", "n"},
+     [](Type type, const string &flags, const vector<int> &dims) { return SMMulTest(type, dims[0], dims[1]); }},
+    {"vadd", "dxt_vadd", "V", {"m"},
+     [](Type type, const string &flags, const vector<int> &dims) { return VAddTest(type, CharToVecType(flags[0]), dims[0]); }},
+    {"mmmul", "dxt_mmul", "", {"m", "n", "p"},
+     [](Type type, const string &flags, const vector<int> &dims) { return MMMulTest(type, dims[0], dims[1], dims[2]); }},
+    {"gemm", "dxt_gemm", "TT", {"m", "n", "p"},
+     [](Type type, const string &flags, const vector<int> &dims) { return GemmTest(type, CharToTrans(flags[0]), CharToTrans(flags[1]), dims[0], dims[1], dims[2]); }},
+    {"gemv", "dxt_gemv", "T", {"m", "n"},
+     [](Type type, const string &flags, const vector<int> &dims) { return Gemv(type, flags[0] == 'T', dims[0], dims[1]); }},
+    {"axpy", "dxt_saxpy", "V", {"m"},
+     [](Type type, const string &flags, const vector<int> &dims) { return Axpy(type, CharToVecType(flags[0]), dims[0]); }},
+    {"trsml", "dxt_trsml", "", {"m", "n"},
+     [](Type type, const string &flags, const vector<int> &dims) { return TRSMLTest(type, dims[0], dims[1]); }}
+  };
+  return ops;
+}
+
+static const SuiteOperation& FindSuiteOperation(string name) {
+  for (const auto &op : SuiteOperations()) {
+    if (op.m_name == name) {
+      return op;
+    }
+  }
+  cout << "ERROR: Unknown benchmark suite operation " << name << endl;
+  LOG_FAIL("replacement for throw call");
+  throw;
+}
+
+static bool ValidFlag(char flagKind, char flag) {
+  if (flagKind == 'T') {
+    return flag == 'N' || flag == 'T';
+  }
+  return flag == 'C' || flag == 'R';
+}
+
+static int SweepValue(string str, string line) {
+  char* end;
+  long val = strtol(str.c_str(), &end, 10);
+  if (str.empty() || *end != '\0' || val <= 0) {
+    cout << "ERROR: Bad size " << str << " in benchmark suite line \"" << line << "\"" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  return val;
+}
+
+//Expands "m" or "start:end[:increment]"
+static vector<int> ParseSweep(string sweep, string line) {
+  vector<string> parts;
+  std::stringstream sweepStream(sweep);
+  string part;
+  while (std::getline(sweepStream, part, ':')) {
+    parts.push_back(part);
+  }
+  if (parts.empty() || parts.size() > 3) {
+    cout << "ERROR: Bad sweep " << sweep << " in benchmark suite line \"" << line << "\"" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  int start = SweepValue(parts[0], line);
+  int end = parts.size() > 1 ? SweepValue(parts[1], line) : start;
+  int inc = parts.size() > 2 ? SweepValue(parts[2], line) : 1;
+  if (end < start) {
+    cout << "ERROR: Empty sweep " << sweep << " in benchmark suite line \"" << line << "\"" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  vector<int> vals;
+  for (int val = start; val <= end; val += inc) {
+    vals.push_back(val);
+  }
+  return vals;
+}
+
+static vector<string> SplitCSVLine(string line) {
+  vector<string> fields;
+  std::stringstream lineStream(line);
+  string field;
+  while (std::getline(lineStream, field, ',')) {
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+static string NumStr(double val) {
+  return std::to_string((long double) val);
+}
+
+BenchmarkSuite::BenchmarkSuite(string suiteFileName)
+  : m_name("benchmark_suite"), m_outputDir("benchmarks")
+{
+  ReadSuiteFile(suiteFileName);
+}
+
+void BenchmarkSuite::ReadSuiteFile(string fileName) {
+  std::ifstream suiteFile(fileName);
+  if (!suiteFile) {
+    cout << "ERROR: Could not open benchmark suite " << fileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  string line;
+  while (std::getline(suiteFile, line)) {
+    string contents = line.substr(0, line.find('#'));
+    std::stringstream lineStream(contents);
+    vector<string> words;
+    string word;
+    while (lineStream >> word) {
+      words.push_back(word);
+    }
+    if (words.empty()) {
+      continue;
+    }
+
+    if (words[0] == "name" || words[0] == "output") {
+      if (words.size() != 2) {
+	cout << "ERROR: Bad benchmark suite line \"" << line << "\"" << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
+      }
+      if (words[0] == "name") {
+	m_name = NoWhitespace(words[1]);
+      } else {
+	m_outputDir = words[1];
+      }
+      continue;
+    }
+
+    BenchmarkSuiteEntry entry;
+    entry.m_library = words[0] == "library";
+    entry.m_genericLibrary = entry.m_library && words.size() > 1 && words[1] == "generic";
+    if (entry.m_library) {
+      words.erase(words.begin(), words.begin() + (entry.m_genericLibrary ? 2 : 1));
+      if (words.empty()) {
+	cout << "ERROR: Bad benchmark suite line \"" << line << "\"" << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
+      }
+    }
+
+    const SuiteOperation &op = FindSuiteOperation(words[0]);
+    unsigned int numFlags = op.m_flagKinds.size();
+    if (words.size() != 2 + numFlags + op.m_dimNames.size()) {
+      cout << "ERROR: " << op.m_name << " takes " << numFlags << " flag(s), a type and "
+	   << op.m_dimNames.size() << " size(s) in benchmark suite line \"" << line << "\"" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+
+    entry.m_op = op.m_name;
+    for (unsigned int i = 0; i < numFlags; ++i) {
+      if (words[1 + i].size() != 1 || !ValidFlag(op.m_flagKinds[i], words[1 + i][0])) {
+	cout << "ERROR: Bad flag " << words[1 + i] << " in benchmark suite line \"" << line << "\"" << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
+      }
+      entry.m_flags += words[1 + i];
+    }
+    string typeWord = words[1 + numFlags];
+    if (typeWord != "F" && typeWord != "D") {
+      cout << "ERROR: Bad type " << typeWord << " in benchmark suite line \"" << line << "\"" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    entry.m_typeChar = typeWord[0];
+    for (unsigned int i = 2 + numFlags; i < words.size(); ++i) {
+      entry.m_dimSweeps.push_back(ParseSweep(words[i], line));
+    }
+    m_entries.push_back(entry);
+  }
+
+  if (m_entries.empty()) {
+    cout << "ERROR: Benchmark suite " << fileName << " has no benchmarks" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+string BenchmarkSuite::ResultKey(const BenchmarkSuiteEntry &entry, const vector<int> &dimValues) {
+  const SuiteOperation &op = FindSuiteOperation(entry.m_op);
+  string key = entry.m_op + "_";
+  if (!entry.m_flags.empty()) {
+    key += entry.m_flags + "_";
+  }
+  key += entry.m_typeChar;
+  for (unsigned int i = 0; i < dimValues.size(); ++i) {
+    key += "_" + op.m_dimNames[i] + std::to_string((long long int) dimValues[i]);
+  }
+  if (sizeGeneric) {
+    key += "_generic";
+  }
+  return key;
+}
+
+void BenchmarkSuite::Run() {
+  for (const auto &entry : m_entries) {
+    RunEntry(entry);
+  }
+}
+
+void BenchmarkSuite::RunEntry(const BenchmarkSuiteEntry &entry) {
+  if (!entry.m_library) {
+    RunSweep(entry, NULL);
+    return;
+  }
+
+  Type type = CharToType(entry.m_typeChar);
+  string opName = entry.m_op;
+  if (!entry.m_flags.empty()) {
+    opName += "_" + entry.m_flags;
+    std::transform(opName.begin(), opName.end(), opName.begin(), ::tolower);
+  }
+  string libName = KernelLibraryName(type, opName);
+
+  bool withGeneric = false;
+  if (entry.m_genericLibrary) {
+    bool wasSizeGeneric = sizeGeneric;
+    sizeGeneric = true;
+    KernelLibrary genericLibrary(libName, type);
+    RunSweep(entry, &genericLibrary);
+    sizeGeneric = wasSizeGeneric;
+    if (genericLibrary.NumKernels() > 0) {
+      genericLibrary.WriteFiles("kernelLibraries");
+      withGeneric = true;
+    } else {
+      cout << "No size of " << libName << " can be searched size-generically, "
+	   << "so it does not fall back to a generic library" << endl;
+    }
+  }
+
+  bool wasSizeGeneric = sizeGeneric;
+  sizeGeneric = false;
+  KernelLibrary library(libName, type, withGeneric);
+  RunSweep(entry, &library);
+  sizeGeneric = wasSizeGeneric;
+  library.WriteFiles("kernelLibraries");
+}
+
+//Runs every combination of the entry's swept dimensions, skipping
+// the ones a size-generic search refuses when sizeGeneric is set
+void BenchmarkSuite::RunSweep(const BenchmarkSuiteEntry &entry, KernelLibrary* library) {
+  Type type = CharToType(entry.m_typeChar);
+  vector<unsigned int> pos(entry.m_dimSweeps.size(), 0);
+  while (true) {
+    vector<int> dimValues;
+    for (unsigned int i = 0; i < pos.size(); ++i) {
+      dimValues.push_back(entry.m_dimSweeps[i][pos[i]]);
+    }
+    if (!sizeGeneric || SizeGenericDimensionsOK(type, dimValues)) {
+      RunInstance(entry, dimValues, library);
+    }
+
+    int dim = pos.size() - 1;
+    while (dim >= 0 && ++pos[dim] == entry.m_dimSweeps[dim].size()) {
+      pos[dim] = 0;
+      --dim;
+    }
+    if (dim < 0) {
+      return;
+    }
+  }
+}
+
+void BenchmarkSuite::RunInstance(const BenchmarkSuiteEntry &entry, const vector<int> &dimValues, KernelLibrary* library) {
+  const SuiteOperation &op = FindSuiteOperation(entry.m_op);
+  Type type = CharToType(entry.m_typeChar);
+  string key = ResultKey(entry, dimValues);
+  cout << "--------------------- Benchmark suite: " << key << " ---------------------\n";
+
+  ProblemInstance problemInstance;
+  problemInstance.SetName(op.m_opName);
+  problemInstance.SetType(type);
+  for (unsigned int i = 0; i < dimValues.size(); ++i) {
+    problemInstance.AddDimension(dimValues[i], op.m_dimNames[i]);
+  }
+
+  RealPSet* algPSet = op.m_builder(type, entry.m_flags, dimValues);
+
+  auto searchStart = std::chrono::steady_clock::now();
+  LLDLAUniverse* uni = RunProblem(1, algPSet, &problemInstance);
+  auto searchEnd = std::chrono::steady_clock::now();
+  ProblemInstanceStats* stats = RuntimeEvaluation(1, uni, &problemInstance, library);
+  auto evalEnd = std::chrono::steady_clock::now();
+  delete uni;
+
+  BenchmarkSuiteResult result;
+  result.m_key = key;
+  result.m_op = entry.m_op;
+  result.m_flags = entry.m_flags;
+  result.m_typeChar = entry.m_typeChar;
+  result.m_dimNames = op.m_dimNames;
+  result.m_dimValues = dimValues;
+  result.m_numImpls = stats->NumImplementations();
+  result.m_bestAvgFlopsPerCycle = stats->GetBestAvgFlopsPerCycle();
+  result.m_bestAvgPercentOfPeak = stats->GetBestAvgPercentOfPeak();
+  result.m_bestMedianFlopsPerCycle = stats->GetBestMedianFlopsPerCycle();
+  result.m_bestMedianPercentOfPeak = stats->GetBestMedianPercentOfPeak();
+  result.m_searchSeconds = std::chrono::duration<double>(searchEnd - searchStart).count();
+  result.m_evaluationSeconds = std::chrono::duration<double>(evalEnd - searchEnd).count();
+  result.m_hasBaseline = false;
+  result.m_baselineFlopsPerCycle = 0;
+  result.m_regression = false;
+  m_results.push_back(result);
+
+  delete stats;
+}
+
+//Best median flops/cycle by key from a results.csv
+std::map<string, double> BenchmarkSuite::ReadBaseline(string baselineFileName) {
+  std::ifstream baselineFile(baselineFileName);
+  if (!baselineFile) {
+    cout << "ERROR: Could not open benchmark baseline " << baselineFileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  string line;
+  std::getline(baselineFile, line);
+  vector<string> titles = SplitCSVLine(line);
+  int keyCol = -1, flopsCol = -1;
+  for (unsigned int i = 0; i < titles.size(); ++i) {
+    if (titles[i] == "key") {
+      keyCol = i;
+    } else if (titles[i] == "best_median_flops_per_cycle") {
+      flopsCol = i;
+    }
+  }
+  if (keyCol < 0 || flopsCol < 0) {
+    cout << "ERROR: " << baselineFileName << " is not a benchmark suite results.csv" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  std::map<string, double> baseline;
+  while (std::getline(baselineFile, line)) {
+    vector<string> fields = SplitCSVLine(line);
+    if (fields.size() > (unsigned int) std::max(keyCol, flopsCol)) {
+      baseline[fields[keyCol]] = atof(fields[flopsCol].c_str());
+    }
+  }
+  return baseline;
+}
+
+unsigned int BenchmarkSuite::CompareToBaseline(string baselineFileName, double threshold) {
+  std::map<string, double> baseline = ReadBaseline(baselineFileName);
+  unsigned int numRegressions = 0;
+
+  cout << "--------------------- Comparison against " << baselineFileName << " ---------------------\n";
+  for (auto &result : m_results) {
+    auto find = baseline.find(result.m_key);
+    if (find == baseline.end()) {
+      cout << result.m_key << ": no baseline\n";
+      continue;
+    }
+    result.m_hasBaseline = true;
+    result.m_baselineFlopsPerCycle = find->second;
+    double change = 0;
+    if (find->second > 0) {
+      change = (result.m_bestMedianFlopsPerCycle - find->second) / find->second;
+    }
+    result.m_regression = change < -threshold;
+    if (result.m_regression) {
+      ++numRegressions;
+    }
+    cout << (result.m_regression ? "REGRESSION " : "") << result.m_key << ": "
+	 << find->second << " -> " << result.m_bestMedianFlopsPerCycle << " flops/cycle ("
+	 << change * 100 << "%)\n";
+  }
+  cout << numRegressions << " regression(s) beyond " << threshold * 100 << "%\n";
+  return numRegressions;
+}
+
+string BenchmarkSuite::CSVColumnTitles() {
+  return "key,op,flags,type,dims,num_impls,best_avg_flops_per_cycle,best_avg_percent_of_peak,"
+    "best_median_flops_per_cycle,best_median_percent_of_peak,search_seconds,evaluation_seconds,"
+    "baseline_median_flops_per_cycle,regression";
+}
+
+string BenchmarkSuite::CSVLine(const BenchmarkSuiteResult &result) {
+  string dims = "";
+  for (unsigned int i = 0; i < result.m_dimValues.size(); ++i) {
+    dims += (i ? ";" : "") + result.m_dimNames[i] + "=" + std::to_string((long long int) result.m_dimValues[i]);
+  }
+  string line = result.m_key + "," + result.m_op + "," + result.m_flags + ",";
+  line += string(1, result.m_typeChar) + "," + dims + ",";
+  line += std::to_string((long long int) result.m_numImpls) + ",";
+  line += NumStr(result.m_bestAvgFlopsPerCycle) + ",";
+  line += NumStr(result.m_bestAvgPercentOfPeak) + ",";
+  line += NumStr(result.m_bestMedianFlopsPerCycle) + ",";
+  line += NumStr(result.m_bestMedianPercentOfPeak) + ",";
+  line += NumStr(result.m_searchSeconds) + ",";
+  line += NumStr(result.m_evaluationSeconds) + ",";
+  line += (result.m_hasBaseline ? NumStr(result.m_baselineFlopsPerCycle) : "") + ",";
+  line += result.m_regression ? "1" : "0";
+  return line;
+}
+
+string BenchmarkSuite::JSONObject(const BenchmarkSuiteResult &result) {
+  string dims = "";
+  for (unsigned int i = 0; i < result.m_dimValues.size(); ++i) {
+    dims += (i ? ", \"" : "\"") + result.m_dimNames[i] + "\": " + std::to_string((long long int) result.m_dimValues[i]);
+  }
+  string obj = "    {\n";
+  obj += "      \"key\": \"" + result.m_key + "\",\n";
+  obj += "      \"op\": \"" + result.m_op + "\",\n";
+  obj += "      \"flags\": \"" + result.m_flags + "\",\n";
+  obj += "      \"type\": \"" + string(1, result.m_typeChar) + "\",\n";
+  obj += "      \"dims\": {" + dims + "},\n";
+  obj += "      \"num_impls\": " + std::to_string((long long int) result.m_numImpls) + ",\n";
+  obj += "      \"best_avg_flops_per_cycle\": " + NumStr(result.m_bestAvgFlopsPerCycle) + ",\n";
+  obj += "      \"best_avg_percent_of_peak\": " + NumStr(result.m_bestAvgPercentOfPeak) + ",\n";
+  obj += "      \"best_median_flops_per_cycle\": " + NumStr(result.m_bestMedianFlopsPerCycle) + ",\n";
+  obj += "      \"best_median_percent_of_peak\": " + NumStr(result.m_bestMedianPercentOfPeak) + ",\n";
+  obj += "      \"search_seconds\": " + NumStr(result.m_searchSeconds) + ",\n";
+  obj += "      \"evaluation_seconds\": " + NumStr(result.m_evaluationSeconds) + ",\n";
+  obj += "      \"baseline_median_flops_per_cycle\": " + (result.m_hasBaseline ? NumStr(result.m_baselineFlopsPerCycle) : string("null")) + ",\n";
+  obj += "      \"regression\": " + string(result.m_regression ? "true" : "false") + "\n";
+  obj += "    }";
+  return obj;
+}
+
+void BenchmarkSuite::WriteCSV(string path) {
+  std::ofstream csv(path);
+  csv << CSVColumnTitles() << endl;
+  for (const auto &result : m_results) {
+    csv << CSVLine(result) << endl;
+  }
+  csv.close();
+}
+
+void BenchmarkSuite::WriteJSON(string path) {
+  std::ofstream json(path);
+  json << "{\n";
+  json << "  \"suite\": \"" << m_name << "\",\n";
+  json << "  \"results\": [\n";
+  for (unsigned int i = 0; i < m_results.size(); ++i) {
+    json << JSONObject(m_results[i]) << (i + 1 < m_results.size() ? ",\n" : "\n");
+  }
+  json << "  ]\n";
+  json << "}\n";
+  json.close();
+}
+
+//Writes results.csv and results.json to a new time stamped
+// directory under the output directory and returns its path
+string BenchmarkSuite::WriteResults() {
+  struct stat st = {0};
+  if (stat(m_outputDir.c_str(), &st) == -1) {
+    mkdir(m_outputDir.c_str(), 0700);
+  }
+  string path = m_outputDir + "/" + m_name + DateAndTimeString();
+  if (stat(path.c_str(), &st) == -1) {
+    mkdir(path.c_str(), 0700);
+  } else {
+    cout << "ERROR: " << path << " already exists!" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  WriteCSV(path + "/results.csv");
+  WriteJSON(path + "/results.json");
+  return path;
+}
+
+unsigned int RunBenchmarkSuite(string suiteFileName, string baselineFileName, double threshold) {
+  BenchmarkSuite suite(suiteFileName);
+  suite.Run();
+  unsigned int numRegressions = 0;
+  if (!baselineFileName.empty()) {
+    numRegressions = suite.CompareToBaseline(baselineFileName, threshold);
+  }
+  string path = suite.WriteResults();
+  cout << "Benchmark suite results written to " << path << endl;
+  return numRegressions;
+}
+
+#endif // DOLLDLA
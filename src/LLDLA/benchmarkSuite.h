@@ -0,0 +1,122 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCHMARK_SUITE_H_
+#define BENCHMARK_SUITE_H_
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "kernelLibrary.h"
+#include "problemInstanceStats.h"
+
+#define DEFAULTREGRESSIONTHRESHOLD 0.05
+
+//One line of a suite file: an operation, its flags, a datatype and
+// a sweep of values for every dimension
+struct BenchmarkSuiteEntry {
+  string m_op;
+  string m_flags;
+  char m_typeChar;
+  vector<vector<int>> m_dimSweeps;
+  bool m_library;
+  bool m_genericLibrary;
+};
+
+//Results for one problem size, keyed so runs of the same suite
+// can be lined up against each other
+struct BenchmarkSuiteResult {
+  string m_key;
+  string m_op;
+  string m_flags;
+  char m_typeChar;
+  vector<string> m_dimNames;
+  vector<int> m_dimValues;
+  unsigned int m_numImpls;
+  double m_bestAvgFlopsPerCycle;
+  double m_bestAvgPercentOfPeak;
+  double m_bestMedianFlopsPerCycle;
+  double m_bestMedianPercentOfPeak;
+  double m_searchSeconds;
+  double m_evaluationSeconds;
+  bool m_hasBaseline;
+  double m_baselineFlopsPerCycle;
+  bool m_regression;
+};
+
+//Runs a suite of LLDLA benchmarks without any interaction.
+// A suite file has one directive or benchmark per line and '#'
+// starts a comment:
+//
+//   name nightly
+//   output benchmarks
+//   dot D 8:64:8
+//   madd F 4:16:4 8
+//   gemv N D 8 8:32:8
+//   library generic madd D 4:32:4 19:35:8
+//
+// A benchmark line is the operation, its flags (N/T, C/R), the
+// datatype (F/D) and one value or start:end[:increment] sweep per
+// dimension.  Every combination of the swept sizes is run.
+// A line starting with "library" also collects the best kernel for
+// every size into a kernel library written to kernelLibraries.  With
+// "library generic" the sizes a size-generic search accepts are first
+// searched size-generically into <library>_generic, which the
+// size-specific library then falls back to.
+// Results are written as results.csv and results.json, and a
+// results.csv from an earlier run can be used as the baseline.
+// A size regresses when its best median flops/cycle drops by more
+// than the threshold fraction of the baseline's
+class BenchmarkSuite {
+ private:
+  string m_name;
+  string m_outputDir;
+  vector<BenchmarkSuiteEntry> m_entries;
+  vector<BenchmarkSuiteResult> m_results;
+
+  void ReadSuiteFile(string fileName);
+  void RunEntry(const BenchmarkSuiteEntry &entry);
+  void RunSweep(const BenchmarkSuiteEntry &entry, KernelLibrary* library);
+  void RunInstance(const BenchmarkSuiteEntry &entry, const vector<int> &dimValues, KernelLibrary* library);
+  string ResultKey(const BenchmarkSuiteEntry &entry, const vector<int> &dimValues);
+  std::map<string, double> ReadBaseline(string baselineFileName);
+  string CSVColumnTitles();
+  string CSVLine(const BenchmarkSuiteResult &result);
+  string JSONObject(const BenchmarkSuiteResult &result);
+  void WriteCSV(string path);
+  void WriteJSON(string path);
+
+ public:
+  BenchmarkSuite(string suiteFileName);
+
+  void Run();
+  unsigned int CompareToBaseline(string baselineFileName, double threshold);
+  string WriteResults();
+};
+
+//Returns the number of regressions against the baseline, which is
+// skipped when baselineFileName is empty
+unsigned int RunBenchmarkSuite(string suiteFileName, string baselineFileName, double threshold);
+
+#endif // DOLLDLA
+
+#endif // BENCHMARK_SUITE_H_
@@ -24,7 +24,7 @@ RealPSet* TRSMLTest(Type dataType, int m, int n) {
 			 1, m,
 			 dataType);
 
-  auto trsml = new TRSML(LLDLAPRIMITIVELAYER);
+  auto trsml = new TRSML(ABSLAYER);
   trsml->AddInputs(4,
 		   Ain, 0,
 		   Bin, 0);
@@ -200,6 +200,7 @@ RealPSet* Gemv(Type dataType, bool transpose, int m, int n)
 			    m, 1,
 			    1, m,
 			    dataType);
+  vIn->SetGenericSizes(yIn->DataType(0).m_numRowsVar, "1");
 
   InputNode* AIn;
   if (transpose) {
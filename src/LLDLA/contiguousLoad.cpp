@@ -35,7 +35,8 @@ void ContiguousLoad::Prop() {
   if (!IsValidCost(m_cost)) {
     DLANode::Prop();
     SanityCheckInputDimensions();
-    m_cost = costModel->ContigVecLoadCost();
+    m_cost = costModel->OpCost(CONTIGLOADOP, GetDataType())
+      + costModel->SplitLineCost(GetDataType(), InputDataType(0).m_alignment);
   }
 }
 
@@ -44,7 +45,11 @@ void ContiguousLoad::PrintCode(IndStream& out) {
   string loadStr = GetNameStr(0);
 
   out.Indent();
-  *out << arch->ContiguousLoad(GetDataType(), toLoadName, loadStr);
+  if (InputIsVecRegAligned(0)) {
+    *out << arch->AlignedLoad(GetDataType(), toLoadName, loadStr);
+  } else {
+    *out << arch->ContiguousLoad(GetDataType(), toLoadName, loadStr);
+  }
 }
 
 #endif // DOLLDLA
@@ -0,0 +1,297 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "costModel.h"
+
+#if DOLLDLA
+
+#include <fstream>
+#include <sstream>
+
+#include "runnerUtils.h"
+
+string CostModelOpToStr(CostModelOp op)
+{
+  switch(op) {
+  case(CONTIGLOADOP):
+    return "contig_load";
+  case(CONTIGSTOREOP):
+    return "contig_store";
+  case(STRIDEDLOADOP):
+    return "strided_load";
+  case(STRIDEDSTOREOP):
+    return "strided_store";
+  case(PACKEDLOADOP):
+    return "packed_load";
+  case(UNPACKSTOREOP):
+    return "unpack_store";
+  case(MASKEDLOADOP):
+    return "masked_load";
+  case(MASKEDSTOREOP):
+    return "masked_store";
+  case(DUPLICATELOADOP):
+    return "duplicate_load";
+  case(ZEROOP):
+    return "zero";
+  case(ADDOP):
+    return "add";
+  case(MULOP):
+    return "mul";
+  case(FMAOP):
+    return "fma";
+  case(ACCUMOP):
+    return "accum";
+  default:
+    cout << "ERROR: Bad op in CostModelOpToStr" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+bool IsMemoryOp(CostModelOp op)
+{
+  switch(op) {
+  case(ZEROOP):
+  case(ADDOP):
+  case(MULOP):
+  case(FMAOP):
+    return false;
+  default:
+    return true;
+  }
+}
+
+string ResidencyToStr(Residency residency)
+{
+  switch(residency) {
+  case(L1RESIDENT):
+    return "L1";
+  case(L2RESIDENT):
+    return "L2";
+  default:
+    cout << "ERROR: Bad residency in ResidencyToStr" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+Cost CostModel::ForkJoinCost(unsigned int numThreads)
+{
+  if (numThreads <= 1) {
+    return 0;
+  }
+  // The closing barrier grows with the size of the team
+  return FORKJOINCYCLES + FORKJOINCYCLESPERTHREAD * numThreads;
+}
+
+Cost CostModel::DynamicChunkCost()
+{
+  return DYNAMICCHUNKCYCLES;
+}
+
+Cost CostModel::PrefetchCost()
+{
+  return PREFETCHCYCLES;
+}
+
+Cost CostModel::SplitLineCost(Type type, unsigned int alignment)
+{
+  unsigned int vecBytes = arch->VecRegBytes(type);
+  if (alignment % vecBytes == 0 || CACHELINEBYTES % alignment != 0) {
+    return 0;
+  }
+  // Every offset into a line that is a multiple of alignment is
+  // taken to be equally likely
+  int numOffsets = CACHELINEBYTES / alignment;
+  int numSplits = 0;
+  for (int i = 0; i < numOffsets; ++i) {
+    if (i * alignment + vecBytes > CACHELINEBYTES) {
+      ++numSplits;
+    }
+  }
+  return SPLITLINECYCLES * numSplits / (double) numOffsets;
+}
+
+// Reproduces the hand picked costs LLDLA has always used, so
+// search results are unchanged when no cost table is present
+Cost BasicCostModel::OpCost(CostModelOp op, Type type)
+{
+  switch(op) {
+  case(CONTIGLOADOP):
+  case(MASKEDLOADOP):
+  case(MASKEDSTOREOP):
+    return 20;
+  case(CONTIGSTOREOP):
+    return 100;
+  case(STRIDEDLOADOP):
+  case(PACKEDLOADOP):
+    return arch->VecRegWidth(type) * 20;
+  case(STRIDEDSTOREOP):
+  case(UNPACKSTOREOP):
+    return arch->VecRegWidth(type) * 100;
+  default:
+    return 0;
+  }
+}
+
+CalibratedCostModel::CalibratedCostModel()
+{
+  for (int i = 0; i < NUMRESIDENCIES; i++) {
+    m_residencyBytes[i] = 0;
+  }
+}
+
+bool CalibratedCostModel::TableExists(string fileName)
+{
+  std::ifstream tableStream(fileName);
+  return tableStream.good();
+}
+
+string CalibratedCostModel::EntryKey(CostModelOp op, Type type, Residency residency)
+{
+  return CostModelOpToStr(op) + " " + TypeToStr(type) + " " + ResidencyToStr(residency);
+}
+
+Residency CalibratedCostModel::CurrentResidency()
+{
+  if (m_residencyBytes[L1RESIDENT] > 0 && m_workingSetBytes > m_residencyBytes[L1RESIDENT]) {
+    return L2RESIDENT;
+  }
+  return L1RESIDENT;
+}
+
+bool CalibratedCostModel::HasEntry(CostModelOp op, Type type, Residency residency)
+{
+  return m_table.find(EntryKey(op, type, residency)) != m_table.end();
+}
+
+void CalibratedCostModel::SetEntry(CostModelOp op, Type type, Residency residency, CostEntry entry)
+{
+  m_table[EntryKey(op, type, residency)] = entry;
+}
+
+void CalibratedCostModel::SetResidencyBytes(Residency residency, double bytes)
+{
+  m_residencyBytes[residency] = bytes;
+}
+
+const CostEntry& CalibratedCostModel::GetEntry(CostModelOp op, Type type)
+{
+  Residency residency = IsMemoryOp(op) ? CurrentResidency() : L1RESIDENT;
+  auto entry = m_table.find(EntryKey(op, type, residency));
+  if (entry == m_table.end() && residency != L1RESIDENT) {
+    entry = m_table.find(EntryKey(op, type, L1RESIDENT));
+  }
+  if (entry == m_table.end()) {
+    cout << "ERROR: No cost table entry for " << EntryKey(op, type, residency) << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  return entry->second;
+}
+
+// Complex ops are priced from the entries of their component type,
+// a complex register holds the same number of components
+static double ComplexOpScale(CostModelOp op, Type type)
+{
+  if (IsComplex(type) && (op == MULOP || op == FMAOP)) {
+    return COMPLEXMULCOMPONENTOPS;
+  }
+  return 1;
+}
+
+Cost CalibratedCostModel::OpCost(CostModelOp op, Type type)
+{
+  return ComplexOpScale(op, type) * GetEntry(op, ComponentType(type)).m_throughput;
+}
+
+Cost CalibratedCostModel::OpLatency(CostModelOp op, Type type)
+{
+  return ComplexOpScale(op, type) * GetEntry(op, ComponentType(type)).m_latency;
+}
+
+void CalibratedCostModel::ReadTable(string fileName)
+{
+  std::ifstream tableStream(fileName);
+  if (!tableStream.is_open()) {
+    cout << "ERROR: Could not open cost table " << fileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  std::map<string, Residency> residencies;
+  for (int i = 0; i < NUMRESIDENCIES; i++) {
+    residencies[ResidencyToStr((Residency) i)] = (Residency) i;
+  }
+
+  string line;
+  while (getline(tableStream, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream lineStream(line);
+    string first;
+    lineStream >> first;
+    if (first == "residency") {
+      string residencyName;
+      double bytes;
+      lineStream >> residencyName >> bytes;
+      if (lineStream.fail() || residencies.find(residencyName) == residencies.end()) {
+	cout << "ERROR: Bad residency line in cost table: " << line << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
+      }
+      m_residencyBytes[residencies[residencyName]] = bytes;
+    } else {
+      string typeName, residencyName;
+      Cost latency, throughput;
+      lineStream >> typeName >> residencyName >> latency >> throughput;
+      if (lineStream.fail()) {
+	cout << "ERROR: Bad entry in cost table: " << line << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
+      }
+      m_table[first + " " + typeName + " " + residencyName] = CostEntry(latency, throughput);
+    }
+  }
+  tableStream.close();
+}
+
+void CalibratedCostModel::WriteTable(string fileName)
+{
+  std::ofstream tableStream(fileName);
+  if (!tableStream.is_open()) {
+    cout << "ERROR: Could not create cost table " << fileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  tableStream << "# LLDLA cost table, costs are in cycles per operation" << endl;
+  tableStream << "# op type residency latency throughput" << endl;
+  for (int i = 0; i < NUMRESIDENCIES; i++) {
+    tableStream << "residency " << ResidencyToStr((Residency) i) << " " << m_residencyBytes[i] << endl;
+  }
+  for (auto entry : m_table) {
+    tableStream << entry.first << " " << entry.second.m_latency << " " << entry.second.m_throughput << endl;
+  }
+  tableStream.close();
+}
+
+#endif // DOLLDLA
@@ -19,18 +19,136 @@
     along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#pragma once
+
+#include "LLDLA.h"
+
 #if DOLLDLA
 
+#include <map>
+
+#define LLDLACOSTTABLEFILE "runtimeEvaluation/lldla_cost_table.txt"
+
+// Typical OpenMP runtime overheads on a single socket
+#define FORKJOINCYCLES 2000
+#define FORKJOINCYCLESPERTHREAD 100
+#define DYNAMICCHUNKCYCLES 200
+
+// A software prefetch takes a load port slot but nothing waits on it
+#define PREFETCHCYCLES 1
+
+// Extra cycles for a vector access that straddles two cache lines
+#define SPLITLINECYCLES 1
+
+// The calibration only measures real types, an interleaved complex
+// multiply is taken to cost this many of its component type multiplies
+#define COMPLEXMULCOMPONENTOPS 3
+
+// Register level operations that LLDLA nodes charge for in Prop
+enum CostModelOp { CONTIGLOADOP,
+		   CONTIGSTOREOP,
+		   STRIDEDLOADOP,
+		   STRIDEDSTOREOP,
+		   PACKEDLOADOP,
+		   UNPACKSTOREOP,
+		   MASKEDLOADOP,
+		   MASKEDSTOREOP,
+		   DUPLICATELOADOP,
+		   ZEROOP,
+		   ADDOP,
+		   MULOP,
+		   FMAOP,
+		   ACCUMOP,
+		   NUMCOSTMODELOPS };
+
+// Where the operands of a memory operation are expected to live
+enum Residency { L1RESIDENT,
+		 L2RESIDENT,
+		 NUMRESIDENCIES };
+
+string CostModelOpToStr(CostModelOp op);
+bool IsMemoryOp(CostModelOp op);
+string ResidencyToStr(Residency residency);
+
 class CostModel {
+ protected:
+  double m_workingSetBytes;
+
  public:
-  virtual int ContigVecLoadCost() = 0;
-  virtual int ContigVecStoreCost() = 0;
+  CostModel() : m_workingSetBytes(0) {}
+  virtual ~CostModel() {}
+  // Steady state cost of one instance of op, used by Prop
+  virtual Cost OpCost(CostModelOp op, Type type) = 0;
+  // Cycles until the result of op can be consumed
+  virtual Cost OpLatency(CostModelOp op, Type type) { return OpCost(op, type); }
+  // Total size of the operands of the problem being generated,
+  // used to decide which level of cache the data lives in
+  void SetWorkingSetBytes(double bytes) { m_workingSetBytes = bytes; }
+  double WorkingSetBytes() { return m_workingSetBytes; }
+  // Cycles to start and join a team of numThreads threads
+  virtual Cost ForkJoinCost(unsigned int numThreads);
+  // Cycles for a thread to claim the next chunk of a dynamically
+  // scheduled loop
+  virtual Cost DynamicChunkCost();
+  // Cycles to issue one software prefetch
+  virtual Cost PrefetchCost();
+  // Expected cache line split penalty of a contiguous vector access
+  // whose address is only known to be a multiple of alignment
+  virtual Cost SplitLineCost(Type type, unsigned int alignment);
+  // A streaming store issues like a regular store, what it saves is
+  // memory traffic that only the runtime evaluator can see
+  virtual Cost StreamStoreCost(Type type) { return OpCost(CONTIGSTOREOP, type); }
+  // Store of a whole register back to its operand by StoreFromRegs
+  virtual Cost RegStoreCost(Type type, bool contiguous)
+  { return OpCost(contiguous ? CONTIGSTOREOP : STRIDEDSTOREOP, type); }
+
+  Cost ContigVecLoadCost(Type type) { return OpCost(CONTIGLOADOP, type); }
+  Cost ContigVecStoreCost(Type type) { return OpCost(CONTIGSTOREOP, type); }
 };
 
 class BasicCostModel : public CostModel {
  public:
-  virtual int ContigVecLoadCost() { return 20; }
-  virtual int ContigVecStoreCost() { return 100; }
+  virtual Cost OpCost(CostModelOp op, Type type);
+  // StoreFromRegs has always been free in the hand picked costs
+  virtual Cost RegStoreCost(Type type, bool contiguous) { return 0; }
+};
+
+class CostEntry {
+ public:
+  Cost m_latency;
+  Cost m_throughput;
+
+  CostEntry() : m_latency(-1), m_throughput(-1) {}
+  CostEntry(Cost latency, Cost throughput)
+    : m_latency(latency), m_throughput(throughput) {}
+};
+
+// Per operation costs in cycles fit from the microbenchmarks
+// in costModelCalibrator.cpp and persisted to a cost table
+class CalibratedCostModel : public CostModel {
+ private:
+  std::map<string, CostEntry> m_table;
+  double m_residencyBytes[NUMRESIDENCIES];
+
+  string EntryKey(CostModelOp op, Type type, Residency residency);
+  const CostEntry& GetEntry(CostModelOp op, Type type);
+
+ public:
+  CalibratedCostModel();
+
+  static bool TableExists(string fileName);
+
+  Residency CurrentResidency();
+  bool HasEntry(CostModelOp op, Type type, Residency residency);
+  void SetEntry(CostModelOp op, Type type, Residency residency, CostEntry entry);
+  void SetResidencyBytes(Residency residency, double bytes);
+  double GetResidencyBytes(Residency residency) { return m_residencyBytes[residency]; }
+
+  void ReadTable(string fileName);
+  void WriteTable(string fileName);
+
+  virtual Cost OpCost(CostModelOp op, Type type);
+  virtual Cost OpLatency(CostModelOp op, Type type);
 };
 
 extern CostModel* costModel;
@@ -0,0 +1,366 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "costModelCalibrator.h"
+
+#if DOLLDLA
+
+#include <fstream>
+
+#include "avx.h"
+#include "runnerUtils.h"
+
+#define NUMUNROLLS 8
+#define CALIBRATIONSTRIDE 16
+#define NUMSWEEPS 32
+#define MINOPCOST 0.05
+
+CostModelCalibrator::CostModelCalibrator(string evalDirName, Type type, double l1Bytes, double l2Bytes)
+{
+  m_evalDirName = evalDirName;
+  m_type = type;
+  m_residencyBytes[L1RESIDENT] = l1Bytes;
+  m_residencyBytes[L2RESIDENT] = l2Bytes;
+  m_dataFileName = "lldla_cost_calibration_" + TypeToStr(type) + "_data";
+  for (int i = 0; i < NUMCOSTMODELOPS; i++) {
+    CostModelOp op = (CostModelOp) i;
+    if ((op == MASKEDLOADOP || op == MASKEDSTOREOP) && !ArchSupportsMaskedOps()) {
+      continue;
+    }
+    m_ops.push_back(op);
+  }
+}
+
+bool CostModelCalibrator::ArchSupportsMaskedOps()
+{
+  for (auto ext : *arch->SupportedExtensions()) {
+    if (dynamic_cast<AVX*>(ext) != NULL) {
+      return true;
+    }
+  }
+  return false;
+}
+
+string CostModelCalibrator::ElemTypeName()
+{
+  if (m_type == REAL_SINGLE) {
+    return "float";
+  } else if (m_type == REAL_DOUBLE) {
+    return "double";
+  }
+  cout << "ERROR: Bad type in CostModelCalibrator" << endl;
+  LOG_FAIL("replacement for throw call");
+  throw;
+}
+
+string CostModelCalibrator::BenchmarkName(CostModelOp op, Residency residency, bool dependent)
+{
+  string name = "bench_" + CostModelOpToStr(op) + "_" + ResidencyToStr(residency);
+  if (dependent) {
+    name += "_latency";
+  } else {
+    name += "_throughput";
+  }
+  return name;
+}
+
+string CostModelCalibrator::OverheadBenchmarkName(Residency residency)
+{
+  return "bench_loop_overhead_" + ResidencyToStr(residency);
+}
+
+// Number of elements of the buffer each instance of op walks over
+int CostModelCalibrator::OpStride(CostModelOp op)
+{
+  int vecWidth = arch->VecRegWidth(m_type);
+  switch(op) {
+  case(STRIDEDLOADOP):
+  case(STRIDEDSTOREOP):
+    return vecWidth * CALIBRATIONSTRIDE;
+  case(DUPLICATELOADOP):
+    return 1;
+  default:
+    return vecWidth;
+  }
+}
+
+// Code for one instance of op. Independent instances write
+// register regNum, dependent instances form a chain through r0
+string CostModelCalibrator::OpCode(CostModelOp op, int regNum, bool dependent)
+{
+  string reg = "r" + std::to_string((long long int) (dependent ? 0 : regNum));
+  string offset = std::to_string((long long int) (regNum * OpStride(op)));
+  string memPtr = "(p + " + offset + ")";
+  string stride = std::to_string((long long int) CALIBRATIONSTRIDE);
+  int residual = arch->VecRegWidth(m_type) - 1;
+
+  switch(op) {
+  case(CONTIGLOADOP):
+    return arch->ContiguousLoad(m_type, memPtr, reg);
+  case(CONTIGSTOREOP):
+    return arch->ContiguousStore(m_type, memPtr, reg);
+  case(STRIDEDLOADOP):
+    return arch->StridedLoad(m_type, memPtr, reg, stride);
+  case(STRIDEDSTOREOP):
+    return arch->StridedStore(m_type, memPtr, reg, stride);
+  case(PACKEDLOADOP):
+    return arch->PackedLoad(m_type, memPtr, reg, "1", residual) + "\n";
+  case(UNPACKSTOREOP):
+    return arch->UnpackStore(m_type, memPtr, reg, "1", residual) + "\n";
+  case(MASKEDLOADOP):
+    return AVX::MaskedLoadCode(m_type, memPtr, "mask", reg);
+  case(MASKEDSTOREOP):
+    return AVX::MaskedStoreCode(m_type, memPtr, "mask", reg);
+  case(DUPLICATELOADOP):
+    return arch->DuplicateLoad(m_type, memPtr, reg);
+  case(ZEROOP):
+    return arch->ZeroVar(m_type, reg);
+  case(ADDOP):
+    return arch->AddCode(m_type, "r8", reg, reg);
+  case(MULOP):
+    return arch->MulCode(m_type, "r8", reg, reg);
+  case(FMAOP):
+    return arch->FMACode(m_type, "r8", "r9", reg, reg);
+  case(ACCUMOP):
+    return arch->AccumCode(m_type, dependent ? "acc_buf" : "(acc_buf + " + std::to_string((long long int) regNum) + ")", reg);
+  default:
+    cout << "ERROR: Bad op in CostModelCalibrator::OpCode" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+string CostModelCalibrator::BenchmarkFunction(string benchName, string loopBody, int opStride, bool needsMask)
+{
+  string elemType = ElemTypeName();
+  string regType = arch->TypeName(m_type);
+  string func = "double " + benchName + "(" + elemType + "* buf, long long num_elems, long long num_iters) {\n";
+  func += "\t" + regType + " r0, r1, r2, r3, r4, r5, r6, r7, r8, r9;\n";
+  func += "\t" + elemType + " acc_buf[NUM_UNROLLS];\n";
+  func += "\t" + elemType + "* p;\n";
+  func += "\tdouble times[NUM_TRIALS];\n";
+  func += "\tunsigned long long start_time, end_time;\n";
+  func += "\tlong long i, offset;\n";
+  func += "\tint t;\n";
+  if (needsMask) {
+    func += "\t" + AVX::MaskRegisterDeclaration(m_type, "mask", arch->VecRegWidth(m_type) - 1) + "\n";
+  }
+  for (int i = 0; i < 10; i++) {
+    func += "\t" + arch->ZeroVar(m_type, "r" + std::to_string((long long int) i));
+  }
+  func += "\tmemset(acc_buf, 0, sizeof(acc_buf));\n";
+  func += "\tfor (t = -1; t < NUM_TRIALS; t++) {\n";
+  // The sweep wraps with a compare rather than a mask so num_elems
+  // need not be a power of two, buf has a sweep's worth of slack
+  func += "\t\toffset = 0;\n";
+  func += "\t\tstart_time = rdtsc();\n";
+  func += "\t\tfor (i = 0; i < num_iters; i++) {\n";
+  func += "\t\t\tp = buf + offset;\n";
+  func += loopBody;
+  func += "\t\t\toffset += NUM_UNROLLS * " + std::to_string((long long int) opStride) + ";\n";
+  func += "\t\t\tif (offset >= num_elems) {\n";
+  func += "\t\t\t\toffset = 0;\n";
+  func += "\t\t\t}\n";
+  func += "\t\t}\n";
+  func += "\t\tend_time = rdtsc();\n";
+  func += "\t\tif (t >= 0) {\n";
+  func += "\t\t\ttimes[t] = ((double) (end_time - start_time)) / (num_iters * NUM_UNROLLS);\n";
+  func += "\t\t}\n";
+  func += "\t}\n";
+  func += "\tsink += acc_buf[0];\n";
+  func += "\treturn median(times, NUM_TRIALS);\n";
+  func += "}\n\n";
+  return func;
+}
+
+string CostModelCalibrator::BenchmarkCall(string benchName, Residency residency, int opStride)
+{
+  string elemType = ElemTypeName();
+  long long numElems = (long long) m_residencyBytes[residency] / (m_type == REAL_SINGLE ? sizeof(float) : sizeof(double));
+  long long numIters = (numElems / (NUMUNROLLS * opStride)) * NUMSWEEPS;
+  if (numIters < NUMSWEEPS) {
+    numIters = NUMSWEEPS;
+  }
+  string call = "\tfprintf(data_file, \"" + benchName + " %f\\n\", ";
+  call += benchName + "(buf, " + std::to_string(numElems) + ", " + std::to_string(numIters) + "));\n";
+  return call;
+}
+
+string CostModelCalibrator::MicrobenchmarkCode()
+{
+  string code = "#include <immintrin.h>\n";
+  code += "#include <string.h>\n";
+  code += "#include \"utils.h\"\n\n";
+  code += "#define NUM_TRIALS 15\n";
+  code += "#define NUM_UNROLLS " + std::to_string((long long int) NUMUNROLLS) + "\n";
+  code += "#define DXT_KEEP(r) __asm__ volatile(\"\" : \"+x\"((r).v))\n\n";
+  code += arch->VecRegTypeDec(m_type) + "\n";
+  code += "volatile double sink;\n\n";
+  code += "int compare_doubles(const void* a, const void* b) {\n";
+  code += "\tdouble da = *((const double*) a);\n\tdouble db = *((const double*) b);\n";
+  code += "\treturn (da > db) - (da < db);\n}\n\n";
+  code += "double median(double* times, int num_times) {\n";
+  code += "\tqsort(times, num_times, sizeof(double), compare_doubles);\n";
+  code += "\treturn times[num_times / 2];\n}\n\n";
+
+  string mainBody = "";
+  for (int r = 0; r < NUMRESIDENCIES; r++) {
+    Residency residency = (Residency) r;
+
+    string overheadBody = "";
+    for (int k = 0; k < NUMUNROLLS; k++) {
+      overheadBody += "\t\t\tDXT_KEEP(r" + std::to_string((long long int) k) + ");\n";
+    }
+    string overheadName = OverheadBenchmarkName(residency);
+    code += BenchmarkFunction(overheadName, overheadBody, arch->VecRegWidth(m_type), false);
+    mainBody += BenchmarkCall(overheadName, residency, arch->VecRegWidth(m_type));
+
+    for (auto op : m_ops) {
+      // Arithmetic does not touch memory, so it is only measured once
+      if (!IsMemoryOp(op) && residency != L1RESIDENT) {
+	continue;
+      }
+      bool needsMask = (op == MASKEDLOADOP || op == MASKEDSTOREOP);
+      for (int dep = 0; dep < 2; dep++) {
+	bool dependent = dep == 1;
+	if (dependent && (op == ZEROOP || (IsMemoryOp(op) && op != ACCUMOP))) {
+	  continue;
+	}
+	string body = "";
+	for (int k = 0; k < NUMUNROLLS; k++) {
+	  body += "\t\t\t" + OpCode(op, k, dependent);
+	  body += "\t\t\tDXT_KEEP(r" + std::to_string((long long int) (dependent ? 0 : k)) + ");\n";
+	}
+	string benchName = BenchmarkName(op, residency, dependent);
+	code += BenchmarkFunction(benchName, body, OpStride(op), needsMask);
+	mainBody += BenchmarkCall(benchName, residency, OpStride(op));
+      }
+    }
+  }
+
+  long long maxElems = (long long) m_residencyBytes[L2RESIDENT] / arch->ElemBytes(m_type) + NUMUNROLLS * arch->VecRegWidth(m_type) * CALIBRATIONSTRIDE;
+  code += "int main() {\n";
+  code += "\t" + ElemTypeName() + "* buf = alloc_aligned_32(" + std::to_string(maxElems) + " * sizeof(" + ElemTypeName() + "));\n";
+  code += "\tmemset(buf, 0, " + std::to_string(maxElems) + " * sizeof(" + ElemTypeName() + "));\n";
+  code += "\tFILE* data_file = fopen(\"" + m_dataFileName + "\", \"w\");\n";
+  code += mainBody;
+  code += "\tfclose(data_file);\n";
+  code += "\treturn 0;\n}\n";
+  return code;
+}
+
+void CostModelCalibrator::WriteMicrobenchmarkCode(string executableName)
+{
+  string testFileName = executableName + ".c";
+  std::ofstream outStream(testFileName);
+  if (outStream.is_open()) {
+    outStream << MicrobenchmarkCode() << endl;
+    outStream.close();
+  } else {
+    cout << "ERROR: CostModelCalibrator could not create file " << testFileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+void CostModelCalibrator::CompileAndRun(string executableName)
+{
+  string compileStr = arch->CompileString(executableName, executableName + ".c");
+  cout << "Compile string is " << compileStr << endl;
+  int compileRes = system(compileStr.c_str());
+  cout << "Compile result = " << std::to_string((long long int) compileRes) << endl;
+
+  string runStr = "./" + executableName;
+  int runRes = system(runStr.c_str());
+  cout << "Run result = " << std::to_string((long long int) runRes) << endl;
+
+  string removeExecutable = "rm -f " + executableName;
+  system(removeExecutable.c_str());
+}
+
+std::map<string, double> CostModelCalibrator::ReadBenchmarkData()
+{
+  std::map<string, double> measurements;
+  std::ifstream dataStream(m_dataFileName);
+  if (!dataStream.is_open()) {
+    cout << "ERROR: Could not open microbenchmark data " << m_dataFileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  string benchName;
+  double cyclesPerOp;
+  while (dataStream >> benchName >> cyclesPerOp) {
+    measurements[benchName] = cyclesPerOp;
+  }
+  dataStream.close();
+  string removeDataFile = "rm -f " + m_dataFileName;
+  system(removeDataFile.c_str());
+  return measurements;
+}
+
+void CostModelCalibrator::Calibrate(CalibratedCostModel* model)
+{
+  string executableName = m_evalDirName + "/lldla_cost_calibration";
+  WriteMicrobenchmarkCode(executableName);
+  CompileAndRun(executableName);
+  auto measurements = ReadBenchmarkData();
+
+  for (int r = 0; r < NUMRESIDENCIES; r++) {
+    Residency residency = (Residency) r;
+    model->SetResidencyBytes(residency, m_residencyBytes[r]);
+    double overhead = measurements[OverheadBenchmarkName(residency)];
+    for (auto op : m_ops) {
+      if (!IsMemoryOp(op) && residency != L1RESIDENT) {
+	continue;
+      }
+      auto throughputMeasurement = measurements.find(BenchmarkName(op, residency, false));
+      if (throughputMeasurement == measurements.end()) {
+	cout << "ERROR: Missing measurement for " << BenchmarkName(op, residency, false) << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
+      }
+      Cost throughput = max(throughputMeasurement->second - overhead, MINOPCOST);
+      // Memory operations are only ever timed back to back, so
+      // their latency is taken to be their throughput
+      Cost latency = throughput;
+      auto latencyMeasurement = measurements.find(BenchmarkName(op, residency, true));
+      if (latencyMeasurement != measurements.end()) {
+	latency = max(latencyMeasurement->second - overhead, throughput);
+      }
+      cout << CostModelOpToStr(op) << " " << ResidencyToStr(residency);
+      cout << " latency = " << latency << " throughput = " << throughput << endl;
+      model->SetEntry(op, m_type, residency, CostEntry(latency, throughput));
+    }
+  }
+}
+
+void CalibrateCostModel(string evalDirName, string tableFileName)
+{
+  CalibratedCostModel model;
+  CostModelCalibrator singleCalibrator(evalDirName, REAL_SINGLE, arch->L1Bytes() / 2, arch->L2Bytes() / 2);
+  singleCalibrator.Calibrate(&model);
+  CostModelCalibrator doubleCalibrator(evalDirName, REAL_DOUBLE, arch->L1Bytes() / 2, arch->L2Bytes() / 2);
+  doubleCalibrator.Calibrate(&model);
+  model.WriteTable(tableFileName);
+  cout << "Wrote calibrated cost table to " << tableFileName << endl;
+}
+
+#endif // DOLLDLA
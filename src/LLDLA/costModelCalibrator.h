@@ -0,0 +1,62 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COST_MODEL_CALIBRATOR_H_
+#define COST_MODEL_CALIBRATOR_H_
+
+#include "costModel.h"
+
+#if DOLLDLA
+
+// Generates, compiles and runs a suite of microbenchmarks for the
+// register level operations LLDLA emits and fits per operation
+// latency and throughput costs (in cycles) from the measurements
+class CostModelCalibrator {
+ private:
+  string m_evalDirName;
+  Type m_type;
+  double m_residencyBytes[NUMRESIDENCIES];
+  string m_dataFileName;
+  vector<CostModelOp> m_ops;
+
+  bool ArchSupportsMaskedOps();
+  string ElemTypeName();
+  string BenchmarkName(CostModelOp op, Residency residency, bool dependent);
+  string OverheadBenchmarkName(Residency residency);
+  int OpStride(CostModelOp op);
+  string OpCode(CostModelOp op, int regNum, bool dependent);
+  string BenchmarkFunction(string benchName, string loopBody, int opStride, bool needsMask);
+  string BenchmarkCall(string benchName, Residency residency, int opStride);
+  string MicrobenchmarkCode();
+  void WriteMicrobenchmarkCode(string executableName);
+  void CompileAndRun(string executableName);
+  std::map<string, double> ReadBenchmarkData();
+
+ public:
+  CostModelCalibrator(string evalDirName, Type type, double l1Bytes, double l2Bytes);
+  void Calibrate(CalibratedCostModel* model);
+};
+
+void CalibrateCostModel(string evalDirName, string tableFileName);
+
+#endif // DOLLDLA
+
+#endif // COST_MODEL_CALIBRATOR_H_
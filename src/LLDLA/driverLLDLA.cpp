@@ -20,7 +20,9 @@
 */
 
 #include "benchmarkMenu.h"
+#include "benchmarkSuite.h"
 #include "blasExamples.h"
+#include "costModelCalibrator.h"
 #include "driverMenu.h"
 #include "driverSettings.h"
 #include "driverUtils.h"
@@ -512,6 +514,9 @@ int main(int argc, const char* argv[])
       problemInstance.AddDimension(m, "m");
       problemInstance.AddDimension(n, "n");
       algPSet = TRSMLTest(precision, m, n);
+      // Vectorized TRSML updates a whole register of right hand sides
+      // with fused multiply adds, the reference does it an element at a time
+      problemInstance.SetReordersArithmetic(true);
       break;
     case(36):
       if (argc != 4) {
@@ -524,6 +529,24 @@ int main(int argc, const char* argv[])
       problemInstance.AddDimension(m, "m");
       algPSet = NegateVector(precision, m);
       break;
+    case(37):
+      if (argc != 2) {
+	PrintMainMenu();
+	TearDownGlobalState(); return 0;
+      }
+      CalibrateCostModel("runtimeEvaluation", LLDLACOSTTABLEFILE);
+      TearDownGlobalState(); return 0;
+    case(38):
+      {
+	if (argc < 3 || argc > 5) {
+	  PrintMainMenu();
+	  TearDownGlobalState(); return 0;
+	}
+	string baselineFileName = argc > 3 ? argv[3] : "";
+	double threshold = argc > 4 ? atof(argv[4]) : DEFAULTREGRESSIONTHRESHOLD;
+	unsigned int numRegressions = RunBenchmarkSuite(argv[2], baselineFileName, threshold);
+	TearDownGlobalState(); return numRegressions ? 1 : 0;
+      }
     default:
       PrintMainMenu();
       TearDownGlobalState();
@@ -28,23 +28,25 @@ void PrintMainMenu()
   cout <<"\n\nWelcome to DxTer LLDLA! Please choose an option below:\n\n";
   cout << "./driver arg1 arg2 ...\n";
   cout <<"\n";
+  cout <<"Types are F/D for real and C/Z for complex single/double\n";
+  cout <<"\n";
   cout <<"arg1 == 0   -> View benchmarks\n";
   cout <<"\n";
   cout <<"Single Operation Examples\n";
   cout <<"         3  -> Dot prod F/D M\n";
-  cout <<"         4  -> Matrix add F/D M N\n";
+  cout <<"         4  -> Matrix add F/D/C/Z M N\n";
   cout <<"         5  -> Matrix vector multiply N/T F/D M N\n";
-  cout <<"         6  -> Scalar vector multiply C/R F/D M\n";
+  cout <<"         6  -> Scalar vector multiply C/R F/D/C/Z M\n";
   cout <<"         7  -> Vector matrix multiply F/D M N\n";
-  cout <<"         8  -> Scalar matrix multiply F/D M N\n";
-  cout <<"         9  -> Vector add C/R F/D M\n";
+  cout <<"         8  -> Scalar matrix multiply F/D/C/Z M N\n";
+  cout <<"         9  -> Vector add C/R F/D/C/Z M\n";
   cout <<"        15  -> Gen Size Col Vector SVMul F/D M\n";
   cout <<"        33  -> MMMul F/D M N P\n";
   cout <<"\n";
   cout <<"BLAS Examples\n";
   cout <<"         1  -> Gemm  N/T N/T F/D M N P\n";
   cout <<"        14  -> Gemv N/T F/D M N\n";
-  cout <<"        16  -> Axpy C/R F/D M\n";
+  cout <<"        16  -> Axpy C/R F/D/C/Z M\n";
   cout <<"        35  -> TRSML F/D M N\n";
   cout <<"\n";
   cout <<"Miscellaneous Examples\n";
@@ -75,6 +77,10 @@ void PrintMainMenu()
   cout <<"\n";
   cout <<"Automated tests\n";
   cout <<"        30  -> Basic examples, no runtime evaluation\n";
+  cout <<"        38  -> Benchmark suite SUITE_FILE [BASELINE_CSV [THRESHOLD]]\n";
+  cout <<"\n";
+  cout <<"Cost model\n";
+  cout <<"        37  -> Calibrate cost model from microbenchmarks\n";
   cout <<"\n";
 }
 
@@ -23,18 +23,65 @@
 
 #if DOLLDLA
 
+#include <cstdlib>
+
 #include "costModel.h"
 #include "uniqueNameSource.h"
 
 Architecture* arch;
 UniqueNameSource* localInputNames;
 CostModel* costModel;
+unsigned int numThreads;
+bool sizeGeneric;
+unsigned int inputAlignment;
+
+static unsigned int RequestedNumThreads() {
+  const char* requested = getenv("LLDLA_NUM_THREADS");
+  if (requested == NULL || atoi(requested) < 1) {
+    return 1;
+  }
+  return atoi(requested);
+}
+
+static bool RequestedSizeGeneric() {
+  const char* requested = getenv("LLDLA_SIZE_GENERIC");
+  return requested != NULL && atoi(requested) != 0;
+}
+
+static unsigned int RequestedInputAlignment() {
+  const char* requested = getenv("LLDLA_ALIGNMENT");
+  if (requested == NULL) {
+    return DEFAULTINPUTALIGNMENT;
+  }
+  int alignment = atoi(requested);
+  // The harness can only allocate buffers with power of two alignments
+  // up to MAXINPUTALIGNMENT
+  if (alignment < 1 || alignment > MAXINPUTALIGNMENT || (alignment & (alignment - 1))) {
+    cout << "WARNING: ignoring LLDLA_ALIGNMENT=" << requested << ", using "
+	 << DEFAULTINPUTALIGNMENT << endl;
+    return DEFAULTINPUTALIGNMENT;
+  }
+  return alignment;
+}
 
 void SetUpGlobalState() {
   LOG_START("LLDLA");
   arch = new HaswellMacbook();
-  costModel = new BasicCostModel();
+  if (CalibratedCostModel::TableExists(LLDLACOSTTABLEFILE)) {
+    CalibratedCostModel* calibratedModel = new CalibratedCostModel();
+    calibratedModel->ReadTable(LLDLACOSTTABLEFILE);
+    costModel = calibratedModel;
+  } else {
+    costModel = new BasicCostModel();
+  }
   localInputNames = new UniqueNameSource("u_local_input_");
+  numThreads = RequestedNumThreads();
+  sizeGeneric = RequestedSizeGeneric();
+  inputAlignment = RequestedInputAlignment();
+  if ((int) numThreads > arch->NumCores()) {
+    cout << "WARNING: " << numThreads << " threads requested but the architecture has "
+	 << arch->NumCores() << " cores" << endl;
+  }
 }
 
 void TearDownGlobalState() {
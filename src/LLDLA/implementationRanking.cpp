@@ -0,0 +1,330 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "implementationRanking.h"
+
+#if DOLLDLA
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "basePSet.h"
+#include "realLoop.h"
+#include "regArith.h"
+#include "regLoadStore.h"
+#include "splitUnrolled.h"
+
+static bool IsLoad(Node* node) {
+  return dynamic_cast<LoadToRegs*>(node) || dynamic_cast<PackedLoadToRegs*>(node)
+    || dynamic_cast<DuplicateRegLoad*>(node);
+}
+
+static bool IsStore(Node* node) {
+  return dynamic_cast<StoreFromRegs*>(node) || dynamic_cast<UnpackStoreFromRegs*>(node);
+}
+
+static bool IsArith(Node* node) {
+  ClassType nodeClass = node->GetNodeClass();
+  return nodeClass == FMAdd::GetClass() || nodeClass == Add::GetClass() || nodeClass == Mul::GetClass();
+}
+
+static void AddFeatures(GraphIter* iter, FeatureVec &features, unsigned int depth) {
+  Poss* poss = iter->m_poss;
+  for (auto node : poss->m_possNodes) {
+    ClassType nodeClass = node->GetNodeClass();
+    features["count_" + nodeClass] += 1;
+    features["cost_" + nodeClass] += node->GetCost();
+    if (IsLoad(node)) {
+      features["loads"] += 1;
+    } else if (IsStore(node)) {
+      features["stores"] += 1;
+    } else if (IsArith(node)) {
+      features["arith"] += 1;
+    }
+    if (nodeClass == SplitUnrolled::GetClass()) {
+      double unrollFactor = ((SplitUnrolled*) node)->m_unrollFactor;
+      features["max_unroll_factor"] = std::max(features["max_unroll_factor"], unrollFactor);
+    }
+  }
+
+  for (unsigned int i = 0; i < poss->m_sets.size(); ++i) {
+    const RealPSet* real = poss->m_sets[i]->GetReal();
+    unsigned int setDepth = depth;
+    if (real->IsLoop()) {
+      const RealLoop* loop = (const RealLoop*) real;
+      ++setDepth;
+      features["loops"] += 1;
+      features["loop_depth"] = std::max(features["loop_depth"], (double) setDepth);
+      if (loop->IsUnrolled()) {
+	features["unrolled_loops"] += 1;
+      }
+      if (loop->IsParallel()) {
+	features["parallel_loops"] += 1;
+      }
+    }
+    AddFeatures(iter->m_subIters[i], features, setDepth);
+  }
+}
+
+FeatureVec ExtractFeatures(GraphIter &iter) {
+  FeatureVec features;
+  features["cost"] = iter.Eval();
+  AddFeatures(&iter, features, 0);
+  double arith = std::max(features["arith"], 1.0);
+  features["loads_per_arith"] = features["loads"] / arith;
+  features["stores_per_arith"] = features["stores"] / arith;
+  return features;
+}
+
+//Each line is the problem, the median cycles, and name=value pairs
+vector<TimingHistoryRow> ReadTimingHistory(string fileName) {
+  vector<TimingHistoryRow> rows;
+  std::ifstream historyFile(fileName);
+  string line;
+  while (std::getline(historyFile, line)) {
+    std::stringstream lineStream(line);
+    TimingHistoryRow row;
+    if (!(lineStream >> row.m_problem >> row.m_medianCycles) || row.m_medianCycles <= 0) {
+      continue;
+    }
+    string feature;
+    while (lineStream >> feature) {
+      size_t eq = feature.find('=');
+      if (eq != string::npos) {
+	row.m_features[feature.substr(0, eq)] = atof(feature.substr(eq + 1).c_str());
+      }
+    }
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+void AppendTimingHistory(string fileName, const vector<TimingHistoryRow> &rows) {
+  std::ofstream historyFile(fileName, std::ios::app);
+  if (!historyFile) {
+    cout << "WARNING: could not append to timing history " << fileName << endl;
+    return;
+  }
+  for (const auto &row : rows) {
+    historyFile << row.m_problem << " " << row.m_medianCycles;
+    for (const auto &feature : row.m_features) {
+      historyFile << " " << feature.first << "=" << feature.second;
+    }
+    historyFile << "\n";
+  }
+}
+
+RankingModel::RankingModel()
+  : m_trained(false), m_heldOutRankCorrelation(0)
+{
+}
+
+double RankingModel::Transform(double val) {
+  return log1p(std::max(val, 0.0));
+}
+
+vector<double> RankingModel::FeatureValues(const FeatureVec &features) const {
+  vector<double> vals(m_featureNames.size(), 0);
+  for (unsigned int i = 0; i < m_featureNames.size(); ++i) {
+    auto find = features.find(m_featureNames[i]);
+    if (find != features.end()) {
+      vals[i] = Transform(find->second);
+    }
+  }
+  return vals;
+}
+
+//Spearman rank correlation, with tied values sharing their average rank
+static double RankCorrelation(const vector<double> &as, const vector<double> &bs) {
+  auto ranks = [](const vector<double> &vals) {
+    vector<unsigned int> order(vals.size());
+    for (unsigned int i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+	      [&vals](unsigned int a, unsigned int b) { return vals[a] < vals[b]; });
+    vector<double> rank(vals.size());
+    unsigned int i = 0;
+    while (i < order.size()) {
+      unsigned int j = i;
+      while (j + 1 < order.size() && vals[order[j + 1]] == vals[order[i]]) {
+	++j;
+      }
+      for (unsigned int k = i; k <= j; ++k) {
+	rank[order[k]] = (i + j) / 2.0;
+      }
+      i = j + 1;
+    }
+    return rank;
+  };
+  vector<double> aRanks = ranks(as);
+  vector<double> bRanks = ranks(bs);
+  double mean = (as.size() - 1) / 2.0;
+  double cov = 0, aVar = 0, bVar = 0;
+  for (unsigned int i = 0; i < as.size(); ++i) {
+    cov += (aRanks[i] - mean) * (bRanks[i] - mean);
+    aVar += (aRanks[i] - mean) * (aRanks[i] - mean);
+    bVar += (bRanks[i] - mean) * (bRanks[i] - mean);
+  }
+  if (aVar == 0 || bVar == 0) {
+    return 0;
+  }
+  return cov / sqrt(aVar * bVar);
+}
+
+void RankingModel::Train(const vector<TimingHistoryRow> &rows) {
+  std::set<string> names, problems;
+  for (const auto &row : rows) {
+    problems.insert(row.m_problem);
+    for (const auto &feature : row.m_features) {
+      names.insert(feature.first);
+    }
+  }
+  m_heldOutRankCorrelation = 0;
+  if (rows.size() < MINRANKINGHISTORYROWS || problems.size() < MINRANKINGHISTORYPROBLEMS) {
+    m_trained = false;
+    return;
+  }
+  m_featureNames.assign(names.begin(), names.end());
+
+  //Hold out every RANKINGHOLDOUTSTRIDE-th problem (at least one), fit
+  // on the rest, and check how well the scores order the held-out
+  // problems' implementations by measured cycles
+  std::set<string> heldOut;
+  unsigned int problemNum = 0;
+  for (const auto &problem : problems) {
+    if (++problemNum % RANKINGHOLDOUTSTRIDE == 0) {
+      heldOut.insert(problem);
+    }
+  }
+  if (heldOut.empty()) {
+    heldOut.insert(*problems.rbegin());
+  }
+  vector<TimingHistoryRow> fitRows;
+  std::map<string, vector<const TimingHistoryRow*>> heldOutRows;
+  for (const auto &row : rows) {
+    if (heldOut.find(row.m_problem) == heldOut.end()) {
+      fitRows.push_back(row);
+    } else {
+      heldOutRows[row.m_problem].push_back(&row);
+    }
+  }
+  Fit(fitRows);
+  double weightedSum = 0;
+  unsigned int weight = 0;
+  for (const auto &problem : heldOutRows) {
+    if (problem.second.size() < 2) {
+      continue;
+    }
+    vector<double> scores, cycles;
+    for (auto row : problem.second) {
+      scores.push_back(Score(row->m_features));
+      cycles.push_back(row->m_medianCycles);
+    }
+    weightedSum += problem.second.size() * RankCorrelation(scores, cycles);
+    weight += problem.second.size();
+  }
+  if (weight > 0) {
+    m_heldOutRankCorrelation = weightedSum / weight;
+  }
+
+  Fit(rows);
+  m_trained = true;
+}
+
+void RankingModel::Fit(const vector<TimingHistoryRow> &rows) {
+  unsigned int numFeatures = m_featureNames.size();
+  //Center the targets and features of each problem
+  std::map<string, vector<double>> featureMeans;
+  std::map<string, double> targetMeans;
+  std::map<string, unsigned int> problemRows;
+  vector<vector<double>> xs;
+  vector<double> ys;
+  for (const auto &row : rows) {
+    xs.push_back(FeatureValues(row.m_features));
+    ys.push_back(log(row.m_medianCycles));
+    vector<double> &means = featureMeans[row.m_problem];
+    means.resize(numFeatures, 0);
+    for (unsigned int j = 0; j < numFeatures; ++j) {
+      means[j] += xs.back()[j];
+    }
+    targetMeans[row.m_problem] += ys.back();
+    ++problemRows[row.m_problem];
+  }
+
+  //Solve (X^T X + ridge I) w = X^T y by Gaussian elimination
+  vector<vector<double>> lhs(numFeatures, vector<double>(numFeatures + 1, 0));
+  for (unsigned int r = 0; r < rows.size(); ++r) {
+    const string &problem = rows[r].m_problem;
+    double count = problemRows[problem];
+    vector<double> x(numFeatures);
+    for (unsigned int j = 0; j < numFeatures; ++j) {
+      x[j] = xs[r][j] - featureMeans[problem][j] / count;
+    }
+    double y = ys[r] - targetMeans[problem] / count;
+    for (unsigned int j = 0; j < numFeatures; ++j) {
+      for (unsigned int k = 0; k < numFeatures; ++k) {
+	lhs[j][k] += x[j] * x[k];
+      }
+      lhs[j][numFeatures] += x[j] * y;
+    }
+  }
+  for (unsigned int j = 0; j < numFeatures; ++j) {
+    lhs[j][j] += RANKINGRIDGE;
+  }
+  for (unsigned int col = 0; col < numFeatures; ++col) {
+    unsigned int pivot = col;
+    for (unsigned int r = col + 1; r < numFeatures; ++r) {
+      if (fabs(lhs[r][col]) > fabs(lhs[pivot][col])) {
+	pivot = r;
+      }
+    }
+    std::swap(lhs[col], lhs[pivot]);
+    for (unsigned int r = col + 1; r < numFeatures; ++r) {
+      double factor = lhs[r][col] / lhs[col][col];
+      for (unsigned int k = col; k <= numFeatures; ++k) {
+	lhs[r][k] -= factor * lhs[col][k];
+      }
+    }
+  }
+  m_weights.assign(numFeatures, 0);
+  for (int j = numFeatures - 1; j >= 0; --j) {
+    double sum = lhs[j][numFeatures];
+    for (unsigned int k = j + 1; k < numFeatures; ++k) {
+      sum -= lhs[j][k] * m_weights[k];
+    }
+    m_weights[j] = sum / lhs[j][j];
+  }
+}
+
+Cost RankingModel::Score(const FeatureVec &features) const {
+  vector<double> vals = FeatureValues(features);
+  Cost score = 0;
+  for (unsigned int j = 0; j < vals.size(); ++j) {
+    score += m_weights[j] * vals[j];
+  }
+  return score;
+}
+
+#endif // DOLLDLA
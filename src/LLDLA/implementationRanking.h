@@ -0,0 +1,88 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef IMPLEMENTATION_RANKING_H_
+#define IMPLEMENTATION_RANKING_H_
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "linearization/graphIter.h"
+
+#define LLDLATIMINGHISTORYFILE "runtimeEvaluation/lldla_timing_history.txt"
+#define MINRANKINGHISTORYROWS 100
+#define MINRANKINGHISTORYPROBLEMS 2
+#define RANKINGRIDGE 1.0
+#define RANKINGHOLDOUTSTRIDE 4
+
+//Named numeric features of one implementation, e.g. how many nodes
+// of each class it has, its loop structure, and loads and stores
+// per arithmetic instruction
+typedef std::map<string, double> FeatureVec;
+
+FeatureVec ExtractFeatures(GraphIter &iter);
+
+//One timed implementation.  m_problem names the operation, sizes and
+// type it implements
+struct TimingHistoryRow {
+  string m_problem;
+  double m_medianCycles;
+  FeatureVec m_features;
+};
+
+vector<TimingHistoryRow> ReadTimingHistory(string fileName);
+void AppendTimingHistory(string fileName, const vector<TimingHistoryRow> &rows);
+
+//Ridge regression from log(1 + feature) to log(median cycles).
+// Rows are centered per problem before fitting, so the model only
+// learns what makes one implementation of a problem faster than
+// another, and the static cost is just one more feature.  Scores
+// are only comparable between implementations of the same problem
+class RankingModel {
+ private:
+  vector<string> m_featureNames;
+  vector<double> m_weights;
+  bool m_trained;
+  double m_heldOutRankCorrelation;
+
+  static double Transform(double val);
+  vector<double> FeatureValues(const FeatureVec &features) const;
+  void Fit(const vector<TimingHistoryRow> &rows);
+
+ public:
+  RankingModel();
+
+  //Leaves the model untrained when the history is too small
+  void Train(const vector<TimingHistoryRow> &rows);
+  bool IsTrained() const { return m_trained; }
+
+  //Spearman correlation between scores and median cycles on the
+  // problems held out of training, averaged weighted by row count
+  double HeldOutRankCorrelation() const { return m_heldOutRankCorrelation; }
+
+  //Lower is faster
+  Cost Score(const FeatureVec &features) const;
+};
+
+#endif // DOLLDLA
+
+#endif // IMPLEMENTATION_RANKING_H_
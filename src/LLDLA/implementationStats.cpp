@@ -19,6 +19,8 @@
     along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+
 #include "implementationStats.h"
 
 #if DOLLDLA
@@ -48,10 +50,17 @@ void ImplementationStats::ComputeFlopsPerCycle(Type type, Cost flopCost, TimeVec
   }
 
   m_meanFlopsPerCycle = m_meanFlopsPerCycle / numRuns;
+
+  //The median is what implementations are ranked by since,
+  // unlike the mean, a few interrupted runs don't move it
+  TimeVec sorted(*runtimes);
+  std::sort(sorted.begin(), sorted.end());
+  m_medianFlopsPerCycle = flopCost / sorted[sorted.size() / 2];
 }
 
 void ImplementationStats::ComputePercentagesOfPeak(Type type) {
   m_meanPercentOfPeak = (m_meanFlopsPerCycle / arch->FlopsPerCycle(type)) * 100;
+  m_medianPercentOfPeak = (m_medianFlopsPerCycle / arch->FlopsPerCycle(type)) * 100;
   m_worstPercentOfPeak = (m_worstFlopsPerCycle / arch->FlopsPerCycle(type)) * 100;
   m_bestPercentOfPeak = (m_bestFlopsPerCycle / arch->FlopsPerCycle(type)) * 100;
 }
@@ -78,6 +87,14 @@ double ImplementationStats::GetAvgPercentOfPeak() {
   return m_meanPercentOfPeak;
 }
 
+double ImplementationStats::GetMedianFlopsPerCycle() {
+  return m_medianFlopsPerCycle;
+}
+
+double ImplementationStats::GetMedianPercentOfPeak() {
+  return m_medianPercentOfPeak;
+}
+
 double ImplementationStats::GetBestFlopsPerCycle() {
   return m_bestFlopsPerCycle;
 }
@@ -108,6 +125,8 @@ void ImplementationStats::PrettyPrintPerformanceStats()
   cout << "IMPLEMENTATION #" << m_implNumber << endl;
   cout << "     Average flops/cycle = " << m_meanFlopsPerCycle << endl;
   cout << "               % of peak = " << m_meanPercentOfPeak << endl << endl;
+  cout << "      Median flops/cycle = " << m_medianFlopsPerCycle << endl;
+  cout << "               % of peak = " << m_medianPercentOfPeak << endl << endl;
   cout << "        Best flops/cycle = " << m_bestFlopsPerCycle << endl;
   cout << "               % of peak = " << m_bestPercentOfPeak << endl << endl;
   cout << "       Worst flops/cycle = " << m_worstFlopsPerCycle << endl;
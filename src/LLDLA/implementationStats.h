@@ -31,7 +31,9 @@ class ImplementationStats {
  private:
   double
     m_meanFlopsPerCycle,
+    m_medianFlopsPerCycle,
     m_meanPercentOfPeak,
+    m_medianPercentOfPeak,
     m_bestPercentOfPeak,
     m_worstPercentOfPeak,
     m_bestFlopsPerCycle,
@@ -49,6 +51,8 @@ class ImplementationStats {
   GraphNum GetNum();
   double GetAvgFlopsPerCycle();
   double GetAvgPercentOfPeak();
+  double GetMedianFlopsPerCycle();
+  double GetMedianPercentOfPeak();
   double GetBestFlopsPerCycle();
   double GetBestPercentOfPeak();
   double GetWorstFlopsPerCycle();
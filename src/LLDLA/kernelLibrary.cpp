@@ -0,0 +1,398 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kernelLibrary.h"
+
+#if DOLLDLA
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#include "streamingUtils.h"
+
+//Last identifier in a C declaration like "double *A"
+static string DeclaredName(string declaration) {
+  return declaration.substr(declaration.find_last_of(" *") + 1);
+}
+
+//Name defined by a line like "#define ANumRows 16"
+static string DefinedName(string define) {
+  string name = define.substr(string("#define ").size());
+  return name.substr(0, name.find(' '));
+}
+
+string KernelLibraryName(Type type, string opName) {
+  string prefix = ComponentType(type) == REAL_SINGLE ? "s" : "d";
+  if (IsComplex(type)) {
+    prefix = ComponentType(type) == REAL_SINGLE ? "c" : "z";
+  }
+  return "dxt_" + prefix + opName;
+}
+
+//Name of the function a definition in RUNTIMEUTILSSOURCE starts,
+// or "" when the line does not start one
+static string DefinedFunctionName(string line) {
+  if (line.empty() || isspace(line[0]) || line[0] == '#' || line[0] == '/') {
+    return "";
+  }
+  size_t paren = line.find('(');
+  if (paren == string::npos) {
+    return "";
+  }
+  size_t end = line.find_last_not_of(" \t", paren - 1);
+  size_t start = line.find_last_of(" \t*", end);
+  return line.substr(start + 1, end - start);
+}
+
+string RuntimeHelperFunctions(string code) {
+  std::ifstream utils(RUNTIMEUTILSSOURCE);
+  if (!utils.is_open()) {
+    cout << "ERROR: could not read " << RUNTIMEUTILSSOURCE << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  //Function definitions by name, and the #defines they use
+  vector<std::pair<string, string>> funcs;
+  string defines = "";
+  string line;
+  while (std::getline(utils, line)) {
+    if (line.compare(0, 8, "#define ") == 0) {
+      defines += line + "\n";
+      continue;
+    }
+    string name = DefinedFunctionName(line);
+    if (name.empty()) {
+      continue;
+    }
+    string def = line + "\n";
+    int depth = 0;
+    bool opened = false;
+    while (true) {
+      for (char c : line) {
+	if (c == '{') {
+	  depth++;
+	  opened = true;
+	} else if (c == '}') {
+	  depth--;
+	}
+      }
+      if ((opened && depth == 0) || (!opened && line.find(';') != string::npos)) {
+	break;
+      }
+      if (!std::getline(utils, line)) {
+	break;
+      }
+      def += line + "\n";
+    }
+    if (opened) {
+      funcs.push_back(std::make_pair(name, def));
+    }
+  }
+
+  //Helpers may call other helpers, so keep going until none are added
+  vector<bool> used(funcs.size(), false);
+  string usedCode = code;
+  bool added = true;
+  while (added) {
+    added = false;
+    for (unsigned int i = 0; i < funcs.size(); i++) {
+      if (!used[i] && usedCode.find(funcs[i].first + "(") != string::npos) {
+	used[i] = true;
+	usedCode += funcs[i].second;
+	added = true;
+      }
+    }
+  }
+  string helpers = "";
+  for (unsigned int i = 0; i < funcs.size(); i++) {
+    if (used[i]) {
+      string def = funcs[i].second;
+      helpers += (def.compare(0, 7, "static ") == 0 ? "" : "static ") + def + "\n";
+    }
+  }
+  if (helpers.empty()) {
+    return "";
+  }
+  //The helpers' index macros have names kernels use for operands
+  string undefs = "";
+  std::stringstream defineLines(defines);
+  while (std::getline(defineLines, line)) {
+    string name = line.substr(string("#define ").size());
+    undefs += "#undef " + name.substr(0, name.find_first_of(" (")) + "\n";
+  }
+  return defines + "\n" + helpers + undefs + "\n";
+}
+
+KernelLibrary::KernelLibrary(string name, Type type, bool genericFallback) {
+  m_name = name;
+  m_type = type;
+  m_sizeGeneric = sizeGeneric;
+  m_genericFallback = genericFallback && !sizeGeneric;
+  if (m_sizeGeneric) {
+    m_name = GenericLibraryName();
+  }
+}
+
+string KernelLibrary::GenericLibraryName() {
+  string suffix = "_generic";
+  if (m_name.size() >= suffix.size()
+      && m_name.compare(m_name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+    return m_name;
+  }
+  return m_name + suffix;
+}
+
+void KernelLibrary::AddKernel(ProblemInstance* problemInstance, LLDLAUniverse* uni, string implStr) {
+  auto dimNames = problemInstance->DimensionNames();
+  auto dimValues = problemInstance->DimensionValues();
+
+  KernelLibraryEntry entry;
+  entry.m_funcName = m_name;
+  entry.m_dimValues = *dimValues;
+  for (auto dimValue : *dimValues) {
+    entry.m_funcName += "_" + std::to_string((long long int) dimValue);
+  }
+  if (m_sizeGeneric) {
+    entry.m_argDeclarations = uni->m_kernelArgDeclarations;
+  } else {
+    entry.m_defines = uni->m_constantDefines;
+    entry.m_argDeclarations = uni->m_declarationVectors;
+  }
+  entry.m_implStr = implStr;
+
+  if (m_entries.empty()) {
+    for (auto dimName : *dimNames) {
+      m_dimNames.push_back(*dimName);
+    }
+    m_dispatchArgDeclarations = uni->m_kernelArgDeclarations;
+  } else if (entry.m_dimValues.size() != m_dimNames.size()
+	     || entry.m_argDeclarations != m_entries.front().m_argDeclarations) {
+    cout << "ERROR: " << entry.m_funcName << " does not have the same arguments as the rest of " << m_name << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  for (auto dimName : *dimNames) {
+    delete dimName;
+  }
+  delete dimNames;
+  delete dimValues;
+
+  for (auto &other : m_entries) {
+    if (other.m_dimValues == entry.m_dimValues) {
+      cout << m_name << " already has a kernel for " << entry.m_funcName << ", keeping the first one" << endl;
+      return;
+    }
+  }
+  m_entries.push_back(entry);
+}
+
+string KernelLibrary::KernelFunction(const KernelLibraryEntry &entry) {
+  string func = "";
+  for (auto define : entry.m_defines) {
+    func += define + "\n";
+  }
+  func += "static void " + entry.m_funcName + "(";
+  for (unsigned int i = 0; i < entry.m_argDeclarations.size(); i++) {
+    func += (i > 0 ? ", " : "") + entry.m_argDeclarations[i];
+  }
+  func += ") {\n" + AddStreamStoreFence(entry.m_implStr) + "return;\n}\n";
+  //Each size-specific kernel has its own defines for the same names
+  for (auto define : entry.m_defines) {
+    func += "#undef " + DefinedName(define) + "\n";
+  }
+  return func + "\n";
+}
+
+string KernelLibrary::KernelFunctions() {
+  string funcs = "";
+  for (auto &entry : m_entries) {
+    funcs += KernelFunction(entry);
+  }
+  return funcs;
+}
+
+string KernelLibrary::DispatchSignature() {
+  string sig = "int " + m_name + "(";
+  for (auto dimName : m_dimNames) {
+    sig += "unsigned int " + dimName + ", ";
+  }
+  auto &argDecls = m_dispatchArgDeclarations;
+  for (unsigned int i = 0; i < argDecls.size(); i++) {
+    sig += (i > 0 ? ", " : "") + argDecls[i];
+  }
+  return sig + ")";
+}
+
+string KernelLibrary::KernelCall(const KernelLibraryEntry &entry, string indent) {
+  string call = indent + entry.m_funcName + "(";
+  for (unsigned int i = 0; i < entry.m_argDeclarations.size(); i++) {
+    call += (i > 0 ? ", " : "") + DeclaredName(entry.m_argDeclarations[i]);
+  }
+  call += ");\n";
+  return call + indent + "return 0;\n";
+}
+
+//Decision tree with one level of tests per dimension, entries are
+// sorted so the ones that share a value for dim are adjacent.  A kernel
+// is only called when the operands have the sizes and strides it was
+// generated for
+string KernelLibrary::ExactSizeDispatch(vector<KernelLibraryEntry*> entries, unsigned int dim, string indent) {
+  if (dim == m_dimNames.size()) {
+    const KernelLibraryEntry &entry = *entries.front();
+    string test = "";
+    for (auto define : entry.m_defines) {
+      string name = DefinedName(define);
+      string value = define.substr(define.find(name) + name.size() + 1);
+      test += (test.empty() ? "" : " && ") + name + " == " + value;
+    }
+    return indent + "if (" + test + ") {\n" + KernelCall(entry, indent + "\t") + indent + "}\n";
+  }
+  string tree = "";
+  auto begin = entries.begin();
+  while (begin != entries.end()) {
+    int value = (*begin)->m_dimValues[dim];
+    auto end = begin;
+    while (end != entries.end() && (*end)->m_dimValues[dim] == value) {
+      ++end;
+    }
+    tree += indent + "if (" + m_dimNames[dim] + " == " + std::to_string((long long int) value) + ") {\n";
+    tree += ExactSizeDispatch(vector<KernelLibraryEntry*>(begin, end), dim + 1, indent + "\t");
+    tree += indent + "}\n";
+    begin = end;
+  }
+  return tree;
+}
+
+//Every size-generic kernel is correct for every size, so this picks
+// the smallest searched size that is at least the requested size in
+// every dimension and falls back to the largest one
+string KernelLibrary::CoveringSizeDispatch() {
+  vector<KernelLibraryEntry*> entries;
+  for (auto &entry : m_entries) {
+    entries.push_back(&entry);
+  }
+  std::stable_sort(entries.begin(), entries.end(),
+		   [](KernelLibraryEntry* a, KernelLibraryEntry* b) {
+		     long long int aSize = 1, bSize = 1;
+		     for (auto dimValue : a->m_dimValues) aSize *= dimValue;
+		     for (auto dimValue : b->m_dimValues) bSize *= dimValue;
+		     return aSize < bSize;
+		   });
+  string dispatch = "";
+  for (unsigned int i = 0; i + 1 < entries.size(); i++) {
+    string test = "";
+    for (unsigned int dim = 0; dim < m_dimNames.size(); dim++) {
+      test += (dim > 0 ? " && " : "") + m_dimNames[dim] + " <= " + std::to_string((long long int) entries[i]->m_dimValues[dim]);
+    }
+    dispatch += "\tif (" + test + ") {\n" + KernelCall(*entries[i], "\t\t") + "\t}\n";
+  }
+  return dispatch + KernelCall(*entries.back(), "\t");
+}
+
+string KernelLibrary::DispatchFunction() {
+  string func = DispatchSignature() + " {\n";
+  if (m_sizeGeneric) {
+    func += CoveringSizeDispatch();
+  } else {
+    vector<KernelLibraryEntry*> entries;
+    for (auto &entry : m_entries) {
+      entries.push_back(&entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+		     [](KernelLibraryEntry* a, KernelLibraryEntry* b) {
+		       return a->m_dimValues < b->m_dimValues;
+		     });
+    func += ExactSizeDispatch(entries, 0, "\t");
+    if (m_genericFallback) {
+      func += "\treturn " + GenericLibraryName() + "(";
+      for (unsigned int i = 0; i < m_dimNames.size(); i++) {
+	func += m_dimNames[i] + ", ";
+      }
+      for (unsigned int i = 0; i < m_dispatchArgDeclarations.size(); i++) {
+	func += (i > 0 ? ", " : "") + DeclaredName(m_dispatchArgDeclarations[i]);
+      }
+      func += ");\n";
+    } else {
+      func += "\treturn -1;\n";
+    }
+  }
+  return func + "}\n";
+}
+
+void KernelLibrary::WriteFiles(string dirName) {
+  if (m_entries.empty()) {
+    cout << "No kernels in " << m_name << ", nothing to write" << endl;
+    return;
+  }
+
+  struct stat st = {0};
+  if (stat(dirName.c_str(), &st) == -1) {
+    mkdir(dirName.c_str(), 0700);
+  }
+
+  string headerName = m_name + ".h";
+  string guard = m_name + "_H_";
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+  std::ofstream header(dirName + "/" + headerName);
+  std::ofstream source(dirName + "/" + m_name + ".c");
+  if (!header.is_open() || !source.is_open()) {
+    cout << "ERROR: could not create " << m_name << " in " << dirName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  header << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+  if (m_sizeGeneric || m_genericFallback) {
+    header << "//Returns 0 once a kernel has run\n";
+  } else {
+    header << "//Returns 0 once a kernel has run, or -1 when no kernel was\n";
+    header << "// generated for the sizes and strides\n";
+  }
+  header << "//Every operand has to be aligned to " << inputAlignment << " bytes\n";
+  header << DispatchSignature() << ";\n\n";
+  header << "#endif\n";
+  header.close();
+
+  source << "#include <immintrin.h>\n";
+  source << "#include <string.h>\n";
+  source << "#include \"" << headerName << "\"\n";
+  if (m_genericFallback) {
+    source << "#include \"" << GenericLibraryName() << ".h\"\n";
+  }
+  source << "\n";
+  source << "#define MUVALUE " << arch->VecRegWidth(m_type) << "\n";
+  source << "#define min(a,b) ((a) < (b) ? (a) : (b))\n";
+  source << arch->VecRegTypeDec(m_type) << "\n";
+  for (auto ext : *arch->SupportedExtensions()) {
+    source << ext->GlobalDeclarations();
+  }
+  string kernels = KernelFunctions();
+  source << "\n" << RuntimeHelperFunctions(kernels) << kernels << DispatchFunction();
+  source.close();
+
+  cout << "Wrote " << m_entries.size() << " kernels for " << m_name << " to " << dirName << endl;
+}
+
+#endif // DOLLDLA
@@ -0,0 +1,91 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KERNEL_LIBRARY_H_
+#define KERNEL_LIBRARY_H_
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "lldlaUniverse.h"
+#include "problemInstance.h"
+
+//The winning implementation for one size in the library's grid
+struct KernelLibraryEntry {
+  string m_funcName;
+  vector<int> m_dimValues;
+  vector<string> m_defines;
+  vector<string> m_argDeclarations;
+  string m_implStr;
+};
+
+#define RUNTIMEUTILSSOURCE "runtimeEvaluation/utils.c"
+
+//Name of the library for an operation, e.g. dxt_dgemv
+string KernelLibraryName(Type type, string opName);
+
+//Definitions of the runtime helpers in RUNTIMEUTILSSOURCE that code
+// calls, like copy_double, as static functions, so generated code can
+// be compiled without the test harness
+string RuntimeHelperFunctions(string code);
+
+//Collects the best implementation for every size in a sweep and
+// writes them out as one C source and header.  The dispatch function
+// takes the problem dimensions followed by the sizes, strides and data
+// of every operand.
+// Size-generic kernels handle any size, so the dispatcher picks the
+// smallest searched size that covers the requested one.  Such a
+// library is named <name>_generic.
+// Size-specific kernels are picked by exact sizes and strides.  With
+// genericFallback everything else is passed on to <name>_generic, which
+// has to be built alongside and linked with it, otherwise the
+// dispatcher returns -1
+class KernelLibrary {
+ private:
+  string m_name;
+  Type m_type;
+  bool m_sizeGeneric;
+  bool m_genericFallback;
+  vector<string> m_dimNames;
+  vector<string> m_dispatchArgDeclarations;
+  vector<KernelLibraryEntry> m_entries;
+
+  string KernelFunctions();
+  string KernelFunction(const KernelLibraryEntry &entry);
+  string DispatchSignature();
+  string DispatchFunction();
+  string ExactSizeDispatch(vector<KernelLibraryEntry*> entries, unsigned int dim, string indent);
+  string CoveringSizeDispatch();
+  string KernelCall(const KernelLibraryEntry &entry, string indent);
+  string GenericLibraryName();
+
+ public:
+  KernelLibrary(string name, Type type, bool genericFallback = false);
+
+  void AddKernel(ProblemInstance* problemInstance, LLDLAUniverse* uni, string implStr);
+  unsigned int NumKernels() const { return m_entries.size(); }
+  void WriteFiles(string dirName);
+};
+
+#endif // DOLLDLA
+
+#endif // KERNEL_LIBRARY_H_
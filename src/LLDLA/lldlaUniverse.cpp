@@ -25,23 +25,40 @@
 
 #include <sstream>
 
+#include "costModel.h"
 #include "helperNodes.h"
 
 void LLDLAUniverse::Init(RealPSet* seed) {
-Universe::Init(seed);
+  // Function arguments are read off the seed before simplification
+  // so the cost model knows the working set before anything is Prop'd
   SetupFunctionArguments(seed);
+  Universe::Init(seed);
 }
 
 void LLDLAUniverse::SetupFunctionArguments(RealPSet* seed) {
   int pSize = seed->m_posses.size();
   cout << std::to_string((long long int) pSize) << endl;
   Poss *poss = seed->m_posses.begin()->second;
+  double workingSetBytes = 0;
   for (auto node : poss->m_possNodes) {
     if (node->GetNodeClass() == InputNode::GetClass()) {
       InputNode* inNode = (InputNode*) node;
+      double elemBytes = arch->ElemBytes(inNode->GetDataType());
+      workingSetBytes += (*inNode->GetM(0))[0] * (*inNode->GetN(0))[0] * elemBytes;
       m_declarationVectors.push_back(inNode->DataDeclaration());
-      m_constantDefines.push_back(inNode->NumRowsDefine());
-      m_constantDefines.push_back(inNode->NumColsDefine());
+      const DataTypeInfo& info = inNode->DataType(0);
+      m_kernelArgDeclarations.push_back("unsigned int " + info.m_numRowsVar);
+      m_kernelArgDeclarations.push_back("unsigned int " + info.m_numColsVar);
+      m_kernelArgDeclarations.push_back("int " + info.m_rowStrideVar);
+      m_kernelArgDeclarations.push_back("int " + info.m_colStrideVar);
+      m_kernelArgDeclarations.push_back(inNode->DataDeclaration());
+      if (sizeGeneric) {
+	m_sizeVars.push_back(make_pair(info.m_numRowsVar, (*inNode->GetM(0))[0]));
+	m_sizeVars.push_back(make_pair(info.m_numColsVar, (*inNode->GetN(0))[0]));
+      } else {
+	m_constantDefines.push_back(inNode->NumRowsDefine());
+	m_constantDefines.push_back(inNode->NumColsDefine());
+      }
       m_constantDefines.push_back(inNode->RowStrideDefine());
       m_constantDefines.push_back(inNode->ColStrideDefine());
       m_argNames.push_back(inNode->GetName(0).str());
@@ -49,6 +66,7 @@ void LLDLAUniverse::SetupFunctionArguments(RealPSet* seed) {
       m_outputNames.push_back(node->GetName(0).str());
     }
   }
+  costModel->SetWorkingSetBytes(workingSetBytes);
 }
 
 void LLDLAUniverse::SetUpOperation(RealPSet* startSet) {
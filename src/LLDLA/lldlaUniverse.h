@@ -37,6 +37,13 @@ class LLDLAUniverse : public Universe {
   vector<string> m_argNames;
   vector<string> m_outputNames;
 
+  //With sizeGeneric, sizes are variables instead of defines.  Each
+  // entry is a size variable and its value during the search
+  vector<pair<string, Size>> m_sizeVars;
+  //Parameter list of the exported size-generic kernel, which is also
+  // the one every kernel library dispatcher takes
+  vector<string> m_kernelArgDeclarations;
+
   LLDLAUniverse()
     : Universe::Universe() {}
 
@@ -20,6 +20,7 @@
 */
 
 #include "localInput.h"
+#include "LLDLA.h"
 
 #if DOLLDLA
 
@@ -27,6 +28,7 @@ LocalInput::LocalInput(string name, Size m, Size n,
 		       Size rowStrideVal, Size colStrideVal,
 		       Type dataType)
 : InputNode::InputNode(name, m, n, rowStrideVal, colStrideVal, dataType) {
+  m_dataTypeInfo.m_alignment = LOCALINPUTALIGNMENT;
 }
 
 LocalInput::LocalInput()
@@ -50,15 +52,20 @@ void LocalInput::PrintCode(IndStream& out) {
   string typeName;
   string varName = m_varName.m_name;
   string byteArray = varName + "_name";
-  if (dataType == REAL_SINGLE) {
-    typeName = "float";
-  } else {
-    typeName = "double";
+  typeName = ElemTypeName(dataType);
+
+  if (HasGenericSizes()) {
+    string size = m_dataTypeInfo.m_numRowsVar + " * " + m_dataTypeInfo.m_numColsVar;
+    out.Indent();
+    *out << typeName << " " << varName << "[" << size << "] __attribute__((aligned(" << LOCALINPUTALIGNMENT << ")));" << endl;
+    out.Indent();
+    *out << "memset(" << varName << ", 0, sizeof(" << varName << "));" << endl;
+    return;
   }
 
   string size = std::to_string((long long int) m_msize->OnlyEntry()) + " * " + std::to_string((long long int) m_nsize->OnlyEntry());
   out.Indent();
-  *out << typeName << " " << varName << "[" << size << "*sizeof(" << typeName << ")] __attribute__((aligned(32))) = {0};" << endl;
+  *out << typeName << " " << varName << "[" << size << "*sizeof(" << typeName << ")] __attribute__((aligned(" << LOCALINPUTALIGNMENT << "))) = {0};" << endl;
 
 }
 
@@ -66,16 +73,37 @@ NodeType LocalInput::GetType() const {
   return "LocalInput " + LayerNumToStr(GetLayer());
 }
 
+void LocalInput::Duplicate(const Node *orig, bool shallow, bool possMerging) {
+  InputNode::Duplicate(orig, shallow, possMerging);
+  const LocalInput *node = (LocalInput*) orig;
+  m_genericNumRows = node->m_genericNumRows;
+  m_genericNumCols = node->m_genericNumCols;
+}
+
+bool LocalInput::HasGenericSizes() const {
+  return sizeGeneric && !m_genericNumRows.empty() && !m_genericNumCols.empty();
+}
+
 void LocalInput::AddVariables(VarSet& set) const {
   string uint = "const unsigned int ";
-  string nRowsVarName = uint + m_dataTypeInfo.m_numRowsVar + " = ";
-  nRowsVarName += std::to_string((long long int) m_msize->OnlyEntry()) + ";";
-  string nColsVarName = uint + m_dataTypeInfo.m_numColsVar + " = ";
-  nColsVarName += std::to_string((long long int) m_nsize->OnlyEntry()) + ";";
-  string rowStrideVarName = uint + m_dataTypeInfo.m_rowStrideVar + " = ";
-  rowStrideVarName += std::to_string((long long int) m_dataTypeInfo.m_rowStrideVal) + ";";
-  string colStrideVarName = uint + m_dataTypeInfo.m_colStrideVar + " = ";
-  colStrideVarName += std::to_string((long long int) m_dataTypeInfo.m_colStrideVal) + ";";
+  string nRows = std::to_string((long long int) m_msize->OnlyEntry());
+  string nCols = std::to_string((long long int) m_nsize->OnlyEntry());
+  string rowStride = std::to_string((long long int) m_dataTypeInfo.m_rowStrideVal);
+  string colStride = std::to_string((long long int) m_dataTypeInfo.m_colStrideVal);
+  if (HasGenericSizes()) {
+    //Local inputs are contiguous, so the leading stride follows the sizes
+    nRows = m_genericNumRows;
+    nCols = m_genericNumCols;
+    if (m_dataTypeInfo.m_rowStrideVal == 1) {
+      colStride = nRows;
+    } else {
+      rowStride = nCols;
+    }
+  }
+  string nRowsVarName = uint + m_dataTypeInfo.m_numRowsVar + " = " + nRows + ";";
+  string nColsVarName = uint + m_dataTypeInfo.m_numColsVar + " = " + nCols + ";";
+  string rowStrideVarName = uint + m_dataTypeInfo.m_rowStrideVar + " = " + rowStride + ";";
+  string colStrideVarName = uint + m_dataTypeInfo.m_colStrideVar + " = " + colStride + ";";
 
   Var nRowsVar(DirectVarDeclType, nRowsVarName, GetDataType());
   Var nColsVar(DirectVarDeclType, nColsVarName, GetDataType());
@@ -23,6 +23,9 @@
 
 #if DOLLDLA
 
+// Bytes local buffers are aligned to
+#define LOCALINPUTALIGNMENT 32
+
 class LocalInput : public InputNode
 {
  public:
@@ -43,6 +46,18 @@ class LocalInput : public InputNode
   virtual NodeType GetType() const;
 
   virtual void AddVariables(VarSet& set) const;
+  virtual void Duplicate(const Node *orig, bool shallow, bool possMerging);
+
+  //Size expressions printed in size-generic code, where the
+  //constant sizes only hold for the sizes that were searched
+  inline void SetGenericSizes(string numRows, string numCols)
+  { m_genericNumRows = numRows; m_genericNumCols = numCols; }
+
+ private:
+  string m_genericNumRows;
+  string m_genericNumCols;
+
+  bool HasGenericSizes() const;
 };
 
 #endif // DOLLDLA
@@ -42,6 +42,12 @@ void MAdd::PrintCode(IndStream &out)
     } else if (GetDataType() == REAL_SINGLE) {
       out.Indent();
       *out << "simple_add_float( ";
+    } else if (GetDataType() == COMPLEX_DOUBLE) {
+      out.Indent();
+      *out << "simple_add_complex( ";
+    } else if (GetDataType() == COMPLEX_SINGLE) {
+      out.Indent();
+      *out << "simple_add_complex_float( ";
     }
     *out << InputDataType(0).m_numRowsVar << ", " <<
       InputDataType(0).m_numColsVar << ", " <<
@@ -123,6 +129,9 @@ void MAdd::Prop()
 
     if (m_layer == ABSLAYER) {
       m_cost = GetInputM(0)->SumProds11(*GetInputN(0));
+      if (IsComplex(GetDataType())) {
+	m_cost *= COMPLEXADDFLOPS;
+      }
     } else {
       m_cost = ZERO;
     }
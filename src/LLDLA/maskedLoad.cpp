@@ -47,29 +47,41 @@ void MaskedLoad::SanityCheckInputDimensions() {
 void MaskedLoad::Prop() {
   if (!IsValidCost(m_cost)) {
     SanityCheckInputDimensions();
-    m_cost = costModel->ContigVecLoadCost();
+    m_cost = costModel->OpCost(MASKEDLOADOP, GetDataType());
   }
 }
 
 void MaskedLoad::PrintCode(IndStream& out) {
   string toLoadName = GetInputNameStr(0);
   string loadStr = GetNameStr(0);
-  string assignOpName;
 
-  if (GetDataType() == REAL_SINGLE) {
-    assignOpName = "_mm256_maskload_ps";
-  } else if (GetDataType() == REAL_DOUBLE) {
-    assignOpName = "_mm256_maskload_pd";
-  } else {
-    throw;
+  if (sizeGeneric) {
+    string lengthVar = GetInputNumRows(0) == 1 ? InputDataType(0).m_numColsVar : InputDataType(0).m_numRowsVar;
+    PrintResidualSwitch(out, lengthVar, GetVecRegWidth(),
+			[&](int residual) {
+			  string maskVarName = m_maskVarName + "_" + std::to_string((long long int) residual);
+			  return AVX::MaskedLoadCode(GetDataType(), toLoadName, maskVarName, loadStr);
+			});
+    return;
   }
 
   out.Indent();
-  *out << loadStr << ". v = " + assignOpName + "( " + toLoadName + " , " + m_maskVarName + " );" << endl;
+  *out << AVX::MaskedLoadCode(GetDataType(), toLoadName, m_maskVarName, loadStr);
 }
 
 void MaskedLoad::AddVariables(VarSet& set) const {
   LoadToRegs::AddVariables(set);
+  if (sizeGeneric) {
+    //One mask per residual size, the switch in PrintCode picks one
+    for (int residual = 0; residual < GetVecRegWidth(); ++residual) {
+      string maskVarName = m_maskVarName + "_" + std::to_string((long long int) residual);
+      string varDecl = AVX::MaskRegisterDeclaration(GetDataType(), maskVarName, residual);
+      Var var(DirectVarDeclType, varDecl, GetDataType());
+      set.insert(var);
+    }
+    return;
+  }
+
   unsigned int residualSize;
   if (GetInputNumRows(0) == 1) {
     residualSize = GetInputNumCols(0);
@@ -43,27 +43,40 @@ void MaskedStore::SanityCheckInputDimensions() {
 void MaskedStore::Prop() {
   if (!IsValidCost(m_cost)) {
     SanityCheckInputDimensions();
-    m_cost = costModel->ContigVecLoadCost();
+    m_cost = costModel->OpCost(MASKEDSTOREOP, GetDataType());
   }
 }
 
 void MaskedStore::PrintCode(IndStream& out) {
   string buffer = GetInputNameStr(1);
   string regName = GetInputNameStr(0);
-  string assignOpName;
 
-  if (GetDataType() == REAL_SINGLE) {
-    assignOpName = "_mm256_maskstore_ps";
-  } else if (GetDataType() == REAL_DOUBLE) {
-    assignOpName = "_mm256_maskstore_pd";
-  } else {
-    throw;
+  if (sizeGeneric) {
+    string lengthVar = GetInputNumRows(1) == 1 ? InputDataType(1).m_numColsVar : InputDataType(1).m_numRowsVar;
+    PrintResidualSwitch(out, lengthVar, GetVecRegWidth(),
+			[&](int residual) {
+			  string maskVarName = m_maskVarName + "_" + std::to_string((long long int) residual);
+			  return AVX::MaskedStoreCode(GetDataType(), buffer, maskVarName, regName);
+			});
+    return;
   }
+
   out.Indent();
-  *out << assignOpName + "( " + buffer + " , " + m_maskVarName + " , " + regName + ".v );\n" << endl;
+  *out << AVX::MaskedStoreCode(GetDataType(), buffer, m_maskVarName, regName) << endl;
 }
 
 void MaskedStore::AddVariables(VarSet& set) const {
+  if (sizeGeneric) {
+    //One mask per residual size, the switch in PrintCode picks one
+    for (int residual = 0; residual < GetVecRegWidth(); ++residual) {
+      string maskVarName = m_maskVarName + "_" + std::to_string((long long int) residual);
+      string varDecl = AVX::MaskRegisterDeclaration(GetDataType(), maskVarName, residual);
+      Var var(DirectVarDeclType, varDecl, GetDataType());
+      set.insert(var);
+    }
+    return;
+  }
+
   unsigned int residualSize;
   if (GetInputNumRows(0) == 1) {
     residualSize = GetInputNumCols(0);
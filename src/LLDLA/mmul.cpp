@@ -56,6 +56,10 @@ void MMul::PrintCode(IndStream &out)
 	*out << "simple_mmul( ";
       } else if (m_type == REAL_SINGLE) {
 	*out << "simple_mmul_float( ";
+      } else {
+	cout << "ERROR: MMul has no reference implementation for complex types" << endl;
+	LOG_FAIL("replacement for throw call");
+	throw;
       }
       *out << InputDataType(2).m_numRowsVar << ", " <<
 	InputDataType(2).m_numColsVar << ", " <<
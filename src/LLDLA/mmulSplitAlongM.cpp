@@ -25,14 +25,32 @@
 
 #if DOLLDLA
 
+string MMulSplitAlongM::GetType() const {
+  if (m_blockSize) {
+    return "MMulSplitAlongM bs:" + std::to_string((long long int) m_blockSize)
+      + ", " + std::to_string((long long int) m_type);
+  }
+  return "MMulSplitAlongM";
+}
+
+int MMulSplitAlongM::SplitSize(const Gemm* gemm) const {
+  if (m_blockSize) {
+    return m_blockSize;
+  }
+  return gemm->GetVecRegWidth();
+}
+
 bool MMulSplitAlongM::CanApply(const Node* node) const {
   if (node->GetNodeClass() == Gemm::GetClass()) {
     auto gemm = static_cast<const Gemm*>(node);
     if (gemm->GetLayer() != m_fromLayer) {
       return false;
     }
-    return !(gemm->GetInputM(0)->EvenlyDivisibleBy(gemm->GetVecRegWidth()))
-      && *(gemm->GetInputM(0)) > gemm->GetVecRegWidth();
+    if (m_blockSize && gemm->GetDataType() != m_type) {
+      return false;
+    }
+    return !(gemm->GetInputM(0)->EvenlyDivisibleBy(SplitSize(gemm)))
+      && *(gemm->GetInputM(0)) > SplitSize(gemm);
   }
   return false;
 }
@@ -40,8 +58,8 @@ bool MMulSplitAlongM::CanApply(const Node* node) const {
 void MMulSplitAlongM::Apply(Node* node) const {
   auto oldGemm = static_cast<Gemm*>(node);
 
-  auto partA = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(0), oldGemm->InputConnNum(0), oldGemm, 0, DIMM, oldGemm->GetVecRegWidth());
-  auto partC = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(2), oldGemm->InputConnNum(2), oldGemm, 2, DIMM, oldGemm->GetVecRegWidth());
+  auto partA = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(0), oldGemm->InputConnNum(0), oldGemm, 0, DIMM, SplitSize(oldGemm));
+  auto partC = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(2), oldGemm->InputConnNum(2), oldGemm, 2, DIMM, SplitSize(oldGemm));
 
   auto mainGemm = new Gemm(ABSLAYER, NORMAL, NORMAL, COEFONE, COEFONE, oldGemm->GetDataType());
   mainGemm->AddInputs(6,
@@ -20,18 +20,27 @@
 */
 
 #include "LLDLA.h"
+#include "mmul.h"
 
 #if DOLLDLA
 
 class MMulSplitAlongM : public SingleTrans {
  private:
   Layer m_fromLayer, m_toLayer;
+  // 0 splits off the residual of the register width,
+  // otherwise the residual of a cache block of m_type
+  int m_blockSize;
+  Type m_type;
+
+  int SplitSize(const Gemm* gemm) const;
 
  public:
   MMulSplitAlongM(Layer fromLayer, Layer toLayer)
-    : m_fromLayer(fromLayer), m_toLayer(toLayer) {}
+    : m_fromLayer(fromLayer), m_toLayer(toLayer), m_blockSize(0), m_type(REAL_DOUBLE) {}
+  MMulSplitAlongM(Layer fromLayer, Layer toLayer, Type type, int blockSize)
+    : m_fromLayer(fromLayer), m_toLayer(toLayer), m_blockSize(blockSize), m_type(type) {}
 
-  virtual string GetType() const { return "MMulSplitAlongM"; }
+  virtual string GetType() const;
   virtual bool IsRef() const { return true; }
 
   virtual bool CanApply(const Node* node) const;
@@ -25,14 +25,32 @@
 
 #if DOLLDLA
 
+string MMulSplitAlongN::GetType() const {
+  if (m_blockSize) {
+    return "MMulSplitAlongN bs:" + std::to_string((long long int) m_blockSize)
+      + ", " + std::to_string((long long int) m_type);
+  }
+  return "MMulSplitAlongN";
+}
+
+int MMulSplitAlongN::SplitSize(const Gemm* gemm) const {
+  if (m_blockSize) {
+    return m_blockSize;
+  }
+  return gemm->GetVecRegWidth();
+}
+
 bool MMulSplitAlongN::CanApply(const Node* node) const {
   if (node->GetNodeClass() == Gemm::GetClass()) {
     auto gemm = static_cast<const Gemm*>(node);
     if (gemm->GetLayer() != m_fromLayer) {
       return false;
     }
-    return !(gemm->GetInputN(1)->EvenlyDivisibleBy(gemm->GetVecRegWidth())) &&
-      *(gemm->GetInputN(1)) > gemm->GetVecRegWidth();
+    if (m_blockSize && gemm->GetDataType() != m_type) {
+      return false;
+    }
+    return !(gemm->GetInputN(1)->EvenlyDivisibleBy(SplitSize(gemm))) &&
+      *(gemm->GetInputN(1)) > SplitSize(gemm);
   }
   return false;
 }
@@ -40,8 +58,8 @@ bool MMulSplitAlongN::CanApply(const Node* node) const {
 void MMulSplitAlongN::Apply(Node* node) const {
   auto oldGemm = static_cast<Gemm*>(node);
 
-  auto partB = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(1), oldGemm->InputConnNum(1), oldGemm, 1, DIMN, oldGemm->GetVecRegWidth());
-  auto partC = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(2), oldGemm->InputConnNum(2), oldGemm, 2, DIMN, oldGemm->GetVecRegWidth());
+  auto partB = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(1), oldGemm->InputConnNum(1), oldGemm, 1, DIMN, SplitSize(oldGemm));
+  auto partC = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(2), oldGemm->InputConnNum(2), oldGemm, 2, DIMN, SplitSize(oldGemm));
 
   auto mainGemm = new Gemm(ABSLAYER, NORMAL, NORMAL, COEFONE, COEFONE, oldGemm->GetDataType());
   mainGemm->AddInputs(6,
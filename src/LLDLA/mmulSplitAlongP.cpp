@@ -25,14 +25,32 @@
 
 #if DOLLDLA
 
+string MMulSplitAlongP::GetType() const {
+  if (m_blockSize) {
+    return "MMulSplitAlongP bs:" + std::to_string((long long int) m_blockSize)
+      + ", " + std::to_string((long long int) m_type);
+  }
+  return "MMulSplitAlongP";
+}
+
+int MMulSplitAlongP::SplitSize(const Gemm* gemm) const {
+  if (m_blockSize) {
+    return m_blockSize;
+  }
+  return gemm->GetVecRegWidth();
+}
+
 bool MMulSplitAlongP::CanApply(const Node* node) const {
   if (node->GetNodeClass() == Gemm::GetClass()) {
     auto gemm = static_cast<const Gemm*>(node);
     if (gemm->GetLayer() != m_fromLayer) {
       return false;
     }
-    return !(gemm->GetInputN(0)->EvenlyDivisibleBy(gemm->GetVecRegWidth()))
-      && *(gemm->GetInputN(0)) > gemm->GetVecRegWidth();
+    if (m_blockSize && gemm->GetDataType() != m_type) {
+      return false;
+    }
+    return !(gemm->GetInputN(0)->EvenlyDivisibleBy(SplitSize(gemm)))
+      && *(gemm->GetInputN(0)) > SplitSize(gemm);
   }
   return false;
 }
@@ -40,8 +58,8 @@ bool MMulSplitAlongP::CanApply(const Node* node) const {
 void MMulSplitAlongP::Apply(Node* node) const {
   auto oldGemm = static_cast<Gemm*>(node);
 
-  auto partA = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(0), oldGemm->InputConnNum(0), oldGemm, 0, DIMN, oldGemm->GetVecRegWidth());
-  auto partB = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(1), oldGemm->InputConnNum(1), oldGemm, 1, DIMM, oldGemm->GetVecRegWidth());
+  auto partA = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(0), oldGemm->InputConnNum(0), oldGemm, 0, DIMN, SplitSize(oldGemm));
+  auto partB = PartitionIntoMainAndResidual(m_toLayer, oldGemm->Input(1), oldGemm->InputConnNum(1), oldGemm, 1, DIMM, SplitSize(oldGemm));
 
   auto mainGemm = new Gemm(ABSLAYER, NORMAL, NORMAL, COEFONE, COEFONE, oldGemm->GetDataType());
   mainGemm->AddInputs(6,
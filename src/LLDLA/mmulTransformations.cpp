@@ -174,6 +174,82 @@ void MMulLoopExp::Apply(Node *node) const
   GemmLoopExp::Apply(node);
 }
 
+BSSize LLDLACacheBS(DimName dim, Type type)
+{
+  int blockSize;
+  switch (dim) {
+  case (DIMM):
+    blockSize = arch->MCBlockSize(type);
+    break;
+  case (DIMK):
+    blockSize = arch->KCBlockSize(type);
+    break;
+  case (DIMN):
+    blockSize = arch->NCBlockSize(type);
+    break;
+  default:
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  BSSizeEnum mu = (type == REAL_SINGLE) ? USELLDLAMUSINGLE : USELLDLAMUDOUBLE;
+  return BSSize(mu, blockSize / arch->VecRegWidth(type));
+}
+
+MMulCacheBlockLoopExp::MMulCacheBlockLoopExp(Layer fromLayer, Layer toLayer, DimName dim, Type type)
+  : MMulLoopExp(fromLayer, toLayer, dim, LLDLACacheBS(dim, type), type)
+{
+}
+
+string MMulCacheBlockLoopExp::GetType() const
+{
+  return "LLDLA cache block " + MMulLoopExp::GetType();
+}
+
+bool MMulCacheBlockLoopExp::CanApply(const Node* node) const
+{
+  if (!CheckGemmLoop(node)) {
+    return false;
+  }
+
+  const Gemm *gemm = static_cast<const Gemm*>(node);
+  const SizeList *dimSize;
+  switch (m_dim) {
+  case (0):
+    //DIMM
+    dimSize = gemm->GetInputM(2);
+    break;
+  case (1):
+    //DIMK
+    if (gemm->m_transA == NORMAL) {
+      dimSize = gemm->GetInputN(0);
+    } else {
+      dimSize = gemm->GetInputM(0);
+    }
+    break;
+  case (2):
+    //DIMN
+    dimSize = gemm->GetInputN(2);
+    break;
+  default:
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  Size bs = m_bsSize.GetSize();
+  if (!dimSize->EvenlyDivisibleBy(bs) || *dimSize <= bs) {
+    return false;
+  }
+
+  const BasePSet *loop = gemm->FindClosestLoop();
+  if (loop) {
+    if (dynamic_cast<const LoopInterface*>(loop)->GetBSSize().GetSize() < bs) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool GemmTransToNotTrans::CanApply(const Node *node) const
 {
   const Gemm *gemm = (Gemm*)node;
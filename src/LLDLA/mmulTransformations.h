@@ -41,6 +41,19 @@ class MMulLoopExp : public GemmLoopExp
   virtual void Apply(Node *node) const;
 };
 
+// Blocks a Gemm for one level of the cache hierarchy.  These loops
+// only go outside of loops with smaller blocks, so the register
+// level MMulLoopExp loops end up innermost
+class MMulCacheBlockLoopExp : public MMulLoopExp
+{
+ public:
+  MMulCacheBlockLoopExp(Layer fromLayer, Layer toLayer, DimName dim, Type type);
+  virtual string GetType() const;
+  virtual bool CanApply(const Node *node) const;
+};
+
+BSSize LLDLACacheBS(DimName dim, Type type);
+
 class GemmTransToNotTrans : public SingleTrans
 {
  public:
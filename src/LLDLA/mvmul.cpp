@@ -48,6 +48,10 @@ void MVMul::PrintCode(IndStream &out)
       *out << "simple_mmul( ";
     } else if (GetDataType() == REAL_SINGLE) {
       *out << "simple_mmul_float( ";
+    } else {
+      cout << "ERROR: MVMul has no reference implementation for complex types" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
     }
     *out << InputDataType(0).m_numRowsVar << ", " <<
       "1, " <<
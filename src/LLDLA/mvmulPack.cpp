@@ -35,7 +35,7 @@ bool MVMulPackOutput::CanApply(const Node* node) const {
       return false;
     }
     return !(mvmul->InputMIsMultipleOfVecRegWidth(0))
-      && mvmul->GetInputM(0) > 0;
+      && *mvmul->GetInputM(0) > 0;
   }
   LOG_FAIL("replacement for throw call");
   throw;
@@ -51,8 +51,10 @@ void PackToCopyAndZero::Apply(Node* node) const {
   Partition* partition;
   if (pack->PackDir() == HORIZONTAL) {
     partition = new Partition(m_toLayer, pack->PackDir(), pack->PackN());
+    partition->SetGenericSplitPoint(pack->InputDataType(0).m_numColsVar);
   } else {
     partition = new Partition(m_toLayer, pack->PackDir(), pack->PackM());
+    partition->SetGenericSplitPoint(pack->InputDataType(0).m_numRowsVar);
   }
   partition->AddInput(pack->Input(1), pack->InputConnNum(1));
 
@@ -0,0 +1,210 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "packedPanel.h"
+
+#if DOLLDLA
+
+#include "intLoop.h"
+
+PackedPanel::PackedPanel(Layer layer, bool rowMajor, Type type)
+  : m_rowMajor(rowMajor), m_layer(layer)
+{
+  // Consumers ask for the element type before the data type
+  // cache is built, so it cannot wait for BuildDataTypeCache
+  m_info.m_type = type;
+}
+
+void PackedPanel::Duplicate(const Node* orig, bool shallow, bool possMerging) {
+  DLANode::Duplicate(orig, shallow, possMerging);
+  const PackedPanel* panel = static_cast<const PackedPanel*>(orig);
+  m_rowMajor = panel->m_rowMajor;
+  m_layer = panel->m_layer;
+  m_info = panel->m_info;
+  m_name = panel->m_name;
+}
+
+void PackedPanel::Prop() {
+  if (!IsValidCost(m_cost)) {
+    DLANode::Prop();
+    if (m_inputs.size() != 1) {
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    if (!GetInputM(0)->IsConstant() || !GetInputN(0)->IsConstant()) {
+      cout << "ERROR: PackedPanel needs a constant sized input" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    m_cost = GetInputM(0)->SumProds11(*GetInputN(0));
+  }
+}
+
+void PackedPanel::PrintCode(IndStream &out) {
+  const DataTypeInfo& src = InputDataType(0);
+
+  out.Indent();
+  if (GetDataType() == REAL_SINGLE) {
+    *out << "copy_float(";
+  } else {
+    *out << "copy_double(";
+  }
+  *out << src.m_numRowsVar << ", " << src.m_numColsVar << ", ";
+  *out << GetInputName(0).m_name << ", ";
+  *out << src.m_rowStrideVar << ", " << src.m_colStrideVar << ", ";
+  *out << m_name.m_name << ", ";
+  *out << m_info.m_rowStrideVar << ", " << m_info.m_colStrideVar << ");" << endl;
+}
+
+const SizeList* PackedPanel::GetM(ConnNum num) const {
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return GetInputM(0);
+}
+
+const SizeList* PackedPanel::GetN(ConnNum num) const {
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return GetInputN(0);
+}
+
+Name PackedPanel::GetName(ConnNum num) const {
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return m_name;
+}
+
+void PackedPanel::ClearDataTypeCache() {
+}
+
+void PackedPanel::BuildDataTypeCache() {
+  const DataTypeInfo& src = InputDataType(0);
+  Size numRows = GetInputM(0)->OnlyEntry();
+  Size numCols = GetInputN(0)->OnlyEntry();
+
+  // The dimensions are part of the name so that panels of the
+  // same operand in main and residual code get separate buffers
+  m_name = GetInputName(0);
+  m_name.m_name += "_packed" + std::to_string((long long int) numRows)
+    + "x" + std::to_string((long long int) numCols);
+
+  Size rowStride = m_rowMajor ? numCols : 1;
+  Size colStride = m_rowMajor ? 1 : numRows;
+  m_info = DataTypeInfo(rowStride, colStride,
+			src.m_numRowsVar, src.m_numColsVar,
+			m_name.m_name + "RowStride", m_name.m_name + "ColStride",
+			src.m_type);
+  m_info.m_alignment = 32;
+}
+
+void PackedPanel::AddVariables(VarSet &set) const {
+  string typeName = GetDataType() == REAL_SINGLE ? "float" : "double";
+  string size = std::to_string((long long int) GetInputM(0)->OnlyEntry())
+    + " * " + std::to_string((long long int) GetInputN(0)->OnlyEntry());
+  // A panel can be as big as L3, far more than a thread's stack, so
+  // the buffer has static storage.  It is thread local so that
+  // exported kernels can be called from several threads at once
+  string bufferDecl = "static __thread " + typeName + " " + m_name.m_name + "[" + size + "] __attribute__((aligned(32)));";
+  string uint = "const unsigned int ";
+  string rowStrideDecl = uint + m_info.m_rowStrideVar + " = "
+    + std::to_string((long long int) m_info.m_rowStrideVal) + ";";
+  string colStrideDecl = uint + m_info.m_colStrideVar + " = "
+    + std::to_string((long long int) m_info.m_colStrideVal) + ";";
+
+  Var bufferVar(DirectVarDeclType, bufferDecl, GetDataType());
+  Var rowStrideVar(DirectVarDeclType, rowStrideDecl, GetDataType());
+  Var colStrideVar(DirectVarDeclType, colStrideDecl, GetDataType());
+  set.insert(bufferVar);
+  set.insert(rowStrideVar);
+  set.insert(colStrideVar);
+}
+
+string PackGemmPanel::GetType() const {
+  return "PackGemmPanel " + std::to_string((long long int) m_operand)
+    + ", " + std::to_string((long long int) m_type);
+}
+
+bool PackGemmPanel::IsInsideCacheBlock(const Gemm* gemm) const {
+  const BasePSet *loop = gemm->FindClosestLoop();
+  if (!loop) {
+    return false;
+  }
+  return dynamic_cast<const LoopInterface*>(loop)->GetBSSize().GetSize()
+    > (Size) gemm->GetVecRegWidth();
+}
+
+bool PackGemmPanel::CanApply(const Node* node) const {
+  if (node->GetNodeClass() != Gemm::GetClass()) {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  auto gemm = static_cast<const Gemm*>(node);
+  if (gemm->GetLayer() != m_fromLayer || gemm->GetDataType() != m_type) {
+    return false;
+  }
+  if (gemm->m_transA != NORMAL || gemm->m_transB != NORMAL) {
+    return false;
+  }
+  if (gemm->Input(m_operand)->GetNodeClass() == PackedPanel::GetClass()) {
+    return false;
+  }
+  if (!IsInsideCacheBlock(gemm)) {
+    return false;
+  }
+  if (!gemm->GetInputM(m_operand)->IsConstant()
+      || !gemm->GetInputN(m_operand)->IsConstant()) {
+    return false;
+  }
+
+  // Packing only pays off if the packed operand is reused across
+  // several register blocks of the other dimension of C
+  int regWidth = gemm->GetVecRegWidth();
+  if (m_operand == 0) {
+    if (*(gemm->GetInputN(2)) <= regWidth) {
+      return false;
+    }
+  } else {
+    if (*(gemm->GetInputM(2)) <= regWidth) {
+      return false;
+    }
+  }
+
+  double bufferBytes = (double) gemm->GetInputNumRows(m_operand)
+    * gemm->GetInputNumCols(m_operand) * arch->ElemBytes(m_type);
+  int cacheBytes = (m_operand == 0) ? arch->L2Bytes() : arch->L3Bytes();
+  return bufferBytes <= cacheBytes;
+}
+
+void PackGemmPanel::Apply(Node* node) const {
+  auto gemm = static_cast<Gemm*>(node);
+
+  // A is consumed a column of registers at a time, B a row at a time
+  auto panel = new PackedPanel(m_toLayer, m_operand != 0, gemm->GetDataType());
+  panel->AddInput(gemm->Input(m_operand), gemm->InputConnNum(m_operand));
+  gemm->m_poss->AddNode(panel);
+
+  gemm->ChangeInput2Way(gemm->Input(m_operand), gemm->InputConnNum(m_operand), panel, 0);
+}
+
+#endif // DOLLDLA
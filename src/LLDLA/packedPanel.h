@@ -0,0 +1,95 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "DLANode.h"
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "mmul.h"
+
+// A copy of its input in a contiguous, aligned buffer, either
+// column major (for the A block of a Gemm) or row major (for
+// the B panel), the way BLIS packs operands for its micro-kernel
+class PackedPanel : public DLANode
+{
+ private:
+  bool m_rowMajor;
+  DataTypeInfo m_info;
+  Name m_name;
+
+ public:
+  Layer m_layer;
+
+  PackedPanel(Layer layer, bool rowMajor, Type type);
+
+  virtual NodeType GetType() const { return m_rowMajor ? "PackedPanel row major" : "PackedPanel col major"; }
+  static Node* BlankInst() { return new PackedPanel(ABSLAYER, false, REAL_DOUBLE); }
+  virtual Node* GetNewInst() { return BlankInst(); }
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+  static ClassType GetClass() { return "PackedPanel"; }
+
+  inline void SetLayer(Layer layer) { m_layer = layer; }
+  inline Layer GetLayer() const { return m_layer; }
+
+  virtual void Duplicate(const Node* orig, bool shallow, bool possMerging);
+  virtual void Prop();
+  virtual void PrintCode(IndStream &out);
+
+  virtual const DataTypeInfo& DataType(ConnNum num) const { return m_info; }
+  virtual const SizeList* GetM(ConnNum num) const;
+  virtual const SizeList* GetN(ConnNum num) const;
+  virtual Name GetName(ConnNum num) const;
+
+  virtual bool IsReadOnly() const { return true; }
+  virtual bool Overwrites(const Node* input, ConnNum num) const { return false; }
+  virtual bool IsDataDependencyOfInput() const { return false; }
+
+  virtual void AddVariables(VarSet &set) const;
+  virtual void BuildDataTypeCache();
+  virtual void ClearDataTypeCache();
+};
+
+// Packs the A block (column major) or B panel (row major) of a
+// cache blocked Gemm so the register level code streams through
+// unit stride memory
+class PackGemmPanel : public SingleTrans {
+ private:
+  Layer m_fromLayer, m_toLayer;
+  ConnNum m_operand;
+  Type m_type;
+
+  bool IsInsideCacheBlock(const Gemm* gemm) const;
+
+ public:
+  PackGemmPanel(Layer fromLayer, Layer toLayer, ConnNum operand, Type type)
+    : m_fromLayer(fromLayer), m_toLayer(toLayer), m_operand(operand), m_type(type) {}
+
+  virtual string GetType() const;
+  virtual bool IsRef() const { return true; }
+
+  virtual bool CanApply(const Node* node) const;
+  virtual void Apply(Node* node) const;
+};
+
+#endif // DOLLDLA
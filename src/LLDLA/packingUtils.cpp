@@ -51,6 +51,9 @@ Partition* PartitionIntoMainAndResidual(Layer layer, Node* outNode, ConnNum outN
     LOG_FAIL("replacement for throw call");
   }
   auto part = new Partition(layer, partDir, mainSize);
+  string sizeVar = dim == DIMM ? dlaNode->InputDataType(inNum).m_numRowsVar : dlaNode->InputDataType(inNum).m_numColsVar;
+  string multipleStr = std::to_string((long long int) multiple);
+  part->SetGenericSplitPoint("((" + sizeVar + " / " + multipleStr + ") * " + multipleStr + ")", multiple);
   part->AddInput(outNode, outNum);
   return part;
 }
@@ -0,0 +1,176 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "parallelizeLoop.h"
+
+#if DOLLDLA
+
+#include "LLDLA.h"
+#include "loopSupport.h"
+#include "packedPanel.h"
+
+ParallelizeLoop::ParallelizeLoop(LoopParallelism parallelism)
+  : m_parallelism(parallelism)
+{
+  if (m_parallelism == SEQUENTIALLOOP) {
+    cout << "Error: ParallelizeLoop needs a parallel schedule\n";
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+static bool IsParallelLoop(const BasePSet *set)
+{
+  if (!set->IsLoop())
+    return false;
+  const LoopInterface *loop = dynamic_cast<const LoopInterface*>(set);
+  return loop->GetParallelism() != SEQUENTIALLOOP;
+}
+
+static bool ContainsParallelLoop(const BasePSet *set)
+{
+  if (IsParallelLoop(set))
+    return true;
+  if (!set->IsReal())
+    return ContainsParallelLoop(set->GetReal());
+  const PossMMap &map = set->GetPosses();
+  PossMMapConstIter iter = map.begin();
+  for(; iter != map.end(); ++iter) {
+    const Poss *poss = iter->second;
+    PSetVecConstIter setIter = poss->m_sets.begin();
+    for(; setIter != poss->m_sets.end(); ++setIter) {
+      if (ContainsParallelLoop(*setIter))
+	return true;
+    }
+  }
+  return false;
+}
+
+// Packed panels live in thread local buffers, so a panel one
+// thread of a parallel loop packs is not the one the others read
+static bool ContainsPackedPanel(const BasePSet *set)
+{
+  if (!set->IsReal())
+    return ContainsPackedPanel(set->GetReal());
+  const PossMMap &map = set->GetPosses();
+  PossMMapConstIter iter = map.begin();
+  for(; iter != map.end(); ++iter) {
+    const Poss *poss = iter->second;
+    NodeVecConstIter nodeIter = poss->m_possNodes.begin();
+    for(; nodeIter != poss->m_possNodes.end(); ++nodeIter) {
+      if ((*nodeIter)->GetNodeClass() == PackedPanel::GetClass())
+	return true;
+    }
+    PSetVecConstIter setIter = poss->m_sets.begin();
+    for(; setIter != poss->m_sets.end(); ++setIter) {
+      if (ContainsPackedPanel(*setIter))
+	return true;
+    }
+  }
+  return false;
+}
+
+bool ParallelizeLoop::CanApply(const Node *node) const
+{
+  if (node->GetNodeClass() != SplitSingleIter::GetClass()) {
+    cout << "Error: Attempted to apply ParallelizeLoop to non SplitSingleIter node\n";
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  if (numThreads <= 1)
+    return false;
+
+  if (!node->IsTunnel(SETTUNIN))
+    return false;
+
+  const SplitSingleIter *split = (SplitSingleIter*)node;
+
+  if (!split->m_isControlTun)
+    return false;
+
+  const LoopInterface *loopInt = split->GetMyLoop();
+  const BasePSet *loop = dynamic_cast<const BasePSet*>(loopInt);
+  if (!loop->IsReal())
+    return false;
+
+  if (loopInt->GetType() != LLDLALOOP)
+    return false;
+
+  if (loop->m_flags & SETLOOPISUNROLLED)
+    return false;
+
+  if (loopInt->GetParallelism() != SEQUENTIALLOOP)
+    return false;
+
+  unsigned int numExecs = split->NumberOfLoopExecs();
+  if (!numExecs)
+    return false;
+
+  //A single iteration has nothing to split among threads
+  for(unsigned int i = 0; i < numExecs; ++i) {
+    if (split->NumIters(i) < 2)
+      return false;
+  }
+
+  if (!loopInt->HasIndepIters())
+    return false;
+
+  //No nested parallelism: neither an enclosing loop
+  // nor a loop in the body may already be parallel
+  const Poss *owner = loop->m_ownerPoss;
+  while (owner && owner->m_pset) {
+    if (IsParallelLoop(owner->m_pset))
+      return false;
+    owner = owner->m_pset->m_ownerPoss;
+  }
+
+  const PossMMap &map = loop->GetPosses();
+  PossMMapConstIter iter = map.begin();
+  for(; iter != map.end(); ++iter) {
+    const Poss *poss = iter->second;
+    PSetVecConstIter setIter = poss->m_sets.begin();
+    for(; setIter != poss->m_sets.end(); ++setIter) {
+      if (ContainsParallelLoop(*setIter))
+	return false;
+    }
+  }
+
+  if (ContainsPackedPanel(loop))
+    return false;
+
+  return true;
+}
+
+void ParallelizeLoop::Apply(Node *node) const
+{
+  SplitSingleIter *split = (SplitSingleIter*)node;
+  RealLoop *loop = (RealLoop*)(split->GetMyLoop());
+  loop->Parallelize(m_parallelism);
+  if (m_parallelism == DYNAMICPARALLELLOOP)
+    loop->m_functionality += "dynamic parallel\n";
+  else
+    loop->m_functionality += "static parallel\n";
+}
+
+#endif // DOLLDLA
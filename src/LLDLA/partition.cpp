@@ -26,16 +26,16 @@
 
 #if DOLLDLA
 
-Partition::Partition(Layer layer, Dir partType, Size splitSize) {
+Partition::Partition(Layer layer, Dir partType, Size splitSize, bool exact) {
   m_layer = layer;
   m_partType = partType;
   m_splitSize = splitSize;
+  m_exact = exact;
+  m_genericSplitMultiple = 1;
   return;
 }
 
-void Partition::PrintCode(IndStream &out) {
-  out.Indent();
-  *out << m_startName.m_name << " = " << GetInputName(0).m_name << ";\n";
+string Partition::SplitPointStr() {
   string splitPoint;
   const SizeList *sizes = NULL;
   if (m_partType == HORIZONTAL) {
@@ -44,12 +44,35 @@ void Partition::PrintCode(IndStream &out) {
   else {
     sizes = GetInputM(0);
   }
-  if (sizes->IsConstant()) {
+  if (sizeGeneric && !m_genericSplitPoint.empty())
+    splitPoint = m_genericSplitPoint;
+  else if (sizes->IsConstant()) {
     Size size = (*sizes)[0];
-    splitPoint = std::to_string((long long int)(floor(size / (double)m_splitSize) * m_splitSize));
+    if (m_exact)
+      splitPoint = std::to_string((long long int) m_splitSize);
+    else
+      splitPoint = std::to_string((long long int)(floor(size / (double)m_splitSize) * m_splitSize));
   }
   else
     LOG_FAIL("not handling non-constant partition print code yet");
+  return splitPoint;
+}
+
+unsigned int Partition::EndAlignment() {
+  Size splitMultiple = m_splitSize;
+  if (sizeGeneric && !m_genericSplitPoint.empty()) {
+    splitMultiple = m_genericSplitMultiple;
+  }
+  if (m_partType == HORIZONTAL) {
+    return InputDataType(0).ColOffsetAlignment(splitMultiple);
+  }
+  return InputDataType(0).RowOffsetAlignment(splitMultiple);
+}
+
+void Partition::PrintCode(IndStream &out) {
+  out.Indent();
+  *out << m_startName.m_name << " = " << GetInputName(0).m_name << ";\n";
+  string splitPoint = SplitPointStr();
   out.Indent();
 
   if (m_partType == HORIZONTAL) {
@@ -100,6 +123,8 @@ void Partition::AddVariables(VarSet &set) const {
     typeName = "float* ";
   } else if (GetDataType() == REAL_DOUBLE) {
     typeName = "double* ";
+  } else if (IsComplex(GetDataType())) {
+    typeName = ElemTypeName(GetDataType()) + "* ";
   } else {
     cout << "Unsupported datatype: " << GetDataType() << endl;
   }
@@ -182,6 +207,15 @@ void Partition::BuildVerticalSizes() {
 }
 
 void Partition::BuildStartAndEndSizes(const SizeList* toSplit) {
+  if (m_exact) {
+    m_startSizes = SizeList::M_cache.GetCachedExactSplitSize(true,
+							     toSplit,
+							     m_splitSize);
+    m_endSizes = SizeList::M_cache.GetCachedExactSplitSize(false,
+							   toSplit,
+							   m_splitSize);
+    return;
+  }
   m_startSizes = SizeList::M_cache.GetCachedSplitSize(true,
 						      toSplit,
 						      m_splitSize);
@@ -206,6 +240,8 @@ void Partition::BuildHorizontalDataTypeInfo() {
 			       inData.m_numRowsVar, endNumColsVar,
 			       inData.m_rowStrideVar, inData.m_colStrideVar,
 			       inData.m_type);
+  m_startInfo->m_alignment = inData.m_alignment;
+  m_endInfo->m_alignment = EndAlignment();
 }
 
 void Partition::BuildVerticalDataTypeInfo() {
@@ -224,6 +260,8 @@ void Partition::BuildVerticalDataTypeInfo() {
 			       endNumRowsVar, inData.m_numColsVar,
 			       inData.m_rowStrideVar, inData.m_colStrideVar,
 			       inData.m_type);
+  m_startInfo->m_alignment = inData.m_alignment;
+  m_endInfo->m_alignment = EndAlignment();
 }
 
 void Partition::ClearDataTypeCache() {
@@ -258,6 +296,9 @@ void Partition::Duplicate(const Node* orig, bool shallow, bool possMerging) {
 
   m_partType = part->m_partType;
   m_splitSize = part->m_splitSize;
+  m_exact = part->m_exact;
+  m_genericSplitPoint = part->m_genericSplitPoint;
+  m_genericSplitMultiple = part->m_genericSplitMultiple;
 
   m_startSizes = part->m_startSizes;
   m_endSizes = part->m_endSizes;
@@ -31,10 +31,18 @@
 class Partition : public DLANode
 {
   
- private:
+ protected:
   Dir m_partType;
 
   unsigned int m_splitSize;
+  // When set the start partition is exactly m_splitSize
+  // instead of the largest multiple of m_splitSize
+  bool m_exact;
+  // Split point printed in size-generic code, where m_splitSize only
+  // holds for the sizes that were searched
+  string m_genericSplitPoint;
+  // m_genericSplitPoint is always a multiple of this
+  unsigned int m_genericSplitMultiple;
 
   const SizeList* m_startSizes;
   const SizeList* m_endSizes;
@@ -61,20 +69,27 @@ class Partition : public DLANode
   void BuildVerticalSizes();
   void BuildStartAndEndSizes(const SizeList* toSplit);
 
+  // Number of rows or columns in the start partition
+  virtual string SplitPointStr();
+  // Alignment of the first element of the end partition
+  virtual unsigned int EndAlignment();
+
  public:
   Layer m_layer;
   
-  Partition(Layer layer, Dir partType, Size splitSize);
+  Partition(Layer layer, Dir partType, Size splitSize, bool exact = false);
 
   virtual void PrintCode(IndStream &out);
 
   virtual ~Partition() {}
   inline void SetLayer(Layer layer) { m_layer = layer; }
+  inline void SetGenericSplitPoint(string splitPoint, unsigned int multiple = 1)
+  { m_genericSplitPoint = splitPoint; m_genericSplitMultiple = multiple; }
   inline Layer GetLayer() const { return m_layer; }
   virtual bool IsReadOnly() const { return false; }
   virtual bool CanTrans() const { return false; }
 
-  virtual NodeType GetType() const { return "Partition" + std::to_string((long long int) m_partType) + std::to_string((long long int) m_splitSize); }
+  virtual NodeType GetType() const { return "Partition" + std::to_string((long long int) m_partType) + std::to_string((long long int) m_splitSize) + (m_exact ? "exact" : ""); }
   static ClassType GetClass() {return "partitionNode";}
   virtual ClassType GetNodeClass() const { return GetClass(); }
   virtual Name GetName(ConnNum num) const;
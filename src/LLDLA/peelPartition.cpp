@@ -0,0 +1,68 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "peelPartition.h"
+
+#if DOLLDLA
+
+PeelPartition::PeelPartition(Layer layer, Dir partType, Size headSize, unsigned int alignBytes)
+  : Partition(layer, partType, headSize, true),
+    m_alignBytes(alignBytes)
+{
+}
+
+string PeelPartition::SplitPointStr() {
+  if (m_inputs.size() > 1) {
+    const DataTypeInfo& headData = InputDataType(1);
+    return m_partType == HORIZONTAL ? headData.m_numColsVar : headData.m_numRowsVar;
+  }
+  const DataTypeInfo& inData = InputDataType(0);
+  string length = m_partType == HORIZONTAL ? inData.m_numColsVar : inData.m_numRowsVar;
+  string mask = "(" + std::to_string((long long int) m_alignBytes) + " - 1)";
+  string misalignment = "(((size_t) " + GetInputName(0).m_name + ") & " + mask + ")";
+  string headBytes = "((" + std::to_string((long long int) m_alignBytes) + " - " + misalignment + ") & " + mask + ")";
+  string elemBytes = std::to_string((long long int) arch->ElemBytes(GetDataType()));
+  return "min( " + length + ", " + headBytes + " / " + elemBytes + " )";
+}
+
+unsigned int PeelPartition::EndAlignment() {
+  if (m_inputs.size() > 1) {
+    // Only the operand whose address the head is computed from is
+    // aligned after it
+    return arch->ElemBytes(GetDataType());
+  }
+  return m_alignBytes;
+}
+
+NodeType PeelPartition::GetType() const {
+  return "PeelPartition" + std::to_string((long long int) m_partType)
+    + std::to_string((long long int) m_splitSize)
+    + " " + std::to_string((long long int) m_alignBytes)
+    + " " + std::to_string((long long int) m_inputs.size());
+}
+
+void PeelPartition::Duplicate(const Node* orig, bool shallow, bool possMerging) {
+  Partition::Duplicate(orig, shallow, possMerging);
+  const PeelPartition* part = static_cast<const PeelPartition*>(orig);
+  m_alignBytes = part->m_alignBytes;
+}
+
+#endif // DOLLDLA
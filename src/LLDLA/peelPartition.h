@@ -0,0 +1,58 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "LLDLA.h"
+#include "partition.h"
+
+#if DOLLDLA
+
+// Splits off the head of a vector that ends where a vector register
+// aligned access can begin, so at most one register width short of
+// it.  With one input the head ends at the first vector aligned
+// element of that input, with two inputs input 0 is split to the
+// length of the head input 1 holds (the start partition of another
+// PeelPartition).  The head length is only known at runtime, so
+// this is only used in size-generic code where the searched head
+// size stands in for every head length
+class PeelPartition : public Partition
+{
+ protected:
+  unsigned int m_alignBytes;
+
+  virtual string SplitPointStr();
+  virtual unsigned int EndAlignment();
+
+ public:
+  PeelPartition(Layer layer, Dir partType, Size headSize, unsigned int alignBytes);
+
+  virtual NodeType GetType() const;
+  static ClassType GetClass() { return "peelPartitionNode"; }
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+
+  virtual Node* GetNewInst() { return BlankInst(); }
+  static Node* BlankInst() { return new PeelPartition(ABSLAYER, VERTICAL, 1, 1); }
+
+  virtual void Duplicate(const Node* orig, bool shallow, bool possMerging);
+};
+
+#endif // DOLLDLA
@@ -0,0 +1,165 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "peelToAlignment.h"
+
+#if DOLLDLA
+
+#include "peelPartition.h"
+#include "recombine.h"
+#include "svmul.h"
+#include "svmulAdd.h"
+#include "vadd.h"
+
+// The last input of each operation peeled is the vector it overwrites
+static bool IsVectorOperand(const Node* node, ConnNum num) {
+  if (node->GetNodeClass() == VAdd::GetClass()) {
+    return true;
+  }
+  // Input 0 of SVMul and SVMulAdd is the scalar
+  return num > 0;
+}
+
+PeelToAlignment::PeelToAlignment(Layer fromLayer, Layer toLayer, ClassType opClass, VecType vecType) {
+  m_fromLayer = fromLayer;
+  m_toLayer = toLayer;
+  m_opClass = opClass;
+  m_vecType = vecType;
+}
+
+// The searched head size has to leave a residual behind it so the
+// searched code handles every tail length as well.  A head or tail
+// of one element would look like a scalar to the residual code,
+// which then reads its runtime length from the wrong dimension
+Size PeelToAlignment::HeadSize(const Node* node) const {
+  const DLANode* dlaNode = static_cast<const DLANode*>(node);
+  ConnNum outNum = node->m_inputs.size() - 1;
+  int length = m_vecType == ROWVECTOR ? dlaNode->GetInputNumCols(outNum) : dlaNode->GetInputNumRows(outNum);
+  int vecRegWidth = node->GetVecRegWidth();
+  for (int headSize = 2; headSize < vecRegWidth; ++headSize) {
+    int rest = length - headSize;
+    if (rest > vecRegWidth && rest % vecRegWidth > 1) {
+      return headSize;
+    }
+  }
+  return 0;
+}
+
+Node* PeelToAlignment::NewOperation(const Node* node) const {
+  if (node->GetNodeClass() == VAdd::GetClass()) {
+    return new VAdd(m_toLayer, m_vecType);
+  } else if (node->GetNodeClass() == SVMul::GetClass()) {
+    return new SVMul(m_toLayer);
+  } else if (node->GetNodeClass() == SVMulAdd::GetClass()) {
+    return new SVMulAdd(m_toLayer, m_vecType);
+  }
+  cout << "ERROR: PeelToAlignment can't copy " << node->GetNodeClass() << endl;
+  LOG_FAIL("replacement for throw call");
+  throw;
+}
+
+bool PeelToAlignment::CanApply(const Node* node) const {
+  if (!sizeGeneric) {
+    return false;
+  }
+  const DLANode* dlaNode = static_cast<const DLANode*>(node);
+  if (node->GetNodeClass() == VAdd::GetClass()) {
+    const VAdd* vadd = static_cast<const VAdd*>(node);
+    if (vadd->GetLayer() != m_fromLayer || vadd->GetVecType() != m_vecType) {
+      return false;
+    }
+  } else if (node->GetNodeClass() == SVMul::GetClass()) {
+    const SVMul* svmul = static_cast<const SVMul*>(node);
+    if (svmul->GetLayer() != m_fromLayer || svmul->GetVecType() != m_vecType) {
+      return false;
+    }
+  } else if (node->GetNodeClass() == SVMulAdd::GetClass()) {
+    const SVMulAdd* svmulAdd = static_cast<const SVMulAdd*>(node);
+    if (svmulAdd->GetLayer() != m_fromLayer || svmulAdd->GetVecType() != m_vecType) {
+      return false;
+    }
+  } else {
+    cout << "ERROR: Applying PeelToAlignment to " << node->GetNodeClass() << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  ConnNum outNum = node->m_inputs.size() - 1;
+  const DataTypeInfo& outData = dlaNode->InputDataType(outNum);
+  Stride vecStride = m_vecType == ROWVECTOR ? outData.m_colStride : outData.m_rowStride;
+  if (!IsUnitStride(vecStride) || dlaNode->InputIsVecRegAligned(outNum)) {
+    return false;
+  }
+  return HeadSize(node) > 0;
+}
+
+void PeelToAlignment::Apply(Node* node) const {
+  DLANode* dlaNode = static_cast<DLANode*>(node);
+  ConnNum outNum = node->m_inputs.size() - 1;
+  Dir partDir = m_vecType == ROWVECTOR ? HORIZONTAL : VERTICAL;
+  Size headSize = HeadSize(node);
+  unsigned int alignBytes = arch->VecRegBytes(dlaNode->GetDataType());
+
+  auto alignedPart = new PeelPartition(m_toLayer, partDir, headSize, alignBytes);
+  alignedPart->AddInput(node->Input(outNum), node->InputConnNum(outNum));
+  node->m_poss->AddNode(alignedPart);
+
+  // The other vector operands are split at the head length of the output
+  vector<Node*> parts(node->m_inputs.size(), NULL);
+  parts[outNum] = alignedPart;
+  for (ConnNum num = 0; num < outNum; ++num) {
+    if (IsVectorOperand(node, num)) {
+      auto part = new PeelPartition(m_toLayer, partDir, headSize, alignBytes);
+      part->AddInputs(4,
+		      node->Input(num), node->InputConnNum(num),
+		      alignedPart, 0);
+      node->m_poss->AddNode(part);
+      parts[num] = part;
+    }
+  }
+
+  auto head = NewOperation(node);
+  auto body = NewOperation(node);
+  for (ConnNum num = 0; num <= outNum; ++num) {
+    if (parts[num] != NULL) {
+      head->AddInput(parts[num], 0);
+      body->AddInput(parts[num], 1);
+    } else {
+      head->AddInput(node->Input(num), node->InputConnNum(num));
+      body->AddInput(node->Input(num), node->InputConnNum(num));
+    }
+  }
+
+  auto rec = new Recombine(m_toLayer, partDir);
+  rec->AddInputs(6,
+		 head, 0,
+		 body, 0,
+		 node->Input(outNum), node->InputConnNum(outNum));
+
+  node->m_poss->AddNode(head);
+  node->m_poss->AddNode(body);
+  node->m_poss->AddNode(rec);
+
+  node->RedirectChildren(rec, 0);
+  node->m_poss->DeleteChildAndCleanUp(node);
+}
+
+#endif // DOLLDLA
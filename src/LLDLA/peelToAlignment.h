@@ -0,0 +1,54 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "transform.h"
+
+// Peels a head of fewer than a register width of elements off a
+// vector operation so the rest of its output vector starts on a
+// vector register boundary.  The head and the residual at the end
+// become masked or packed residual code and the main loop gets
+// aligned loads and stores to the output.  The head length depends
+// on the address of the output, so this only applies to size-generic
+// searches
+class PeelToAlignment : public SingleTrans {
+ private:
+  Layer m_fromLayer, m_toLayer;
+  ClassType m_opClass;
+  VecType m_vecType;
+
+  Size HeadSize(const Node* node) const;
+  Node* NewOperation(const Node* node) const;
+
+ public:
+  PeelToAlignment(Layer fromLayer, Layer toLayer, ClassType opClass, VecType vecType);
+
+  virtual string GetType() const { return "PeelToAlignment " + m_opClass + std::to_string((long long int) m_vecType); }
+  virtual bool IsRef() const { return true; }
+
+  virtual bool CanApply(const Node* node) const;
+  virtual void Apply(Node* node) const;
+};
+
+#endif // DOLLDLA
@@ -0,0 +1,246 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "planarRegs.h"
+
+#if DOLLDLA
+
+#include "costModel.h"
+
+bool PlanarLoadToRegs::IsContiguousLoad() const
+{
+  if (IsInputColVector(0)) {
+    return IsUnitStride(InputDataType(0).m_rowStride);
+  } else {
+    return IsUnitStride(InputDataType(0).m_colStride);
+  }
+}
+
+string PlanarLoadToRegs::StrideVar() const
+{
+  if (IsInputColVector(0)) {
+    return InputDataType(0).m_rowStrideVar;
+  } else {
+    return InputDataType(0).m_colStrideVar;
+  }
+}
+
+void PlanarLoadToRegs::Prop()
+{
+  if (!IsValidCost(m_cost)) {
+    DLANode::Prop();
+    if (m_inputs.size() != 1) {
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    Input(0)->Prop();
+
+    int width = arch->PlanarVecRegWidth(GetDataType());
+    if (!(IsInputColVector(0) && GetInputNumRows(0) == width)
+	&& !(IsInputRowVector(0) && GetInputNumCols(0) == width)) {
+      cout << "Error: Incorrect dimensions for planar register load of " << GetInputNameStr(0) << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+
+    // Two loads and the shuffles that split them into planes
+    CostModelOp loadOp = IsContiguousLoad() ? CONTIGLOADOP : STRIDEDLOADOP;
+    m_cost = 2 * costModel->OpCost(loadOp, GetDataType())
+      + 2 * costModel->OpCost(ADDOP, GetDataType());
+  }
+}
+
+void PlanarLoadToRegs::PrintCode(IndStream &out)
+{
+  out.Indent();
+  if (IsContiguousLoad()) {
+    *out << arch->PlanarContiguousLoad(GetDataType(), GetInputNameStr(0), GetNameStr(0));
+  } else {
+    *out << arch->PlanarStridedLoad(GetDataType(), GetInputNameStr(0), GetNameStr(0), StrideVar());
+  }
+}
+
+const SizeList* PlanarLoadToRegs::GetM(ConnNum num) const
+{
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return GetInputM(0);
+}
+
+const SizeList* PlanarLoadToRegs::GetN(ConnNum num) const
+{
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return GetInputN(0);
+}
+
+Name PlanarLoadToRegs::GetName(ConnNum num) const
+{
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  Name name = GetInputName(0);
+  name.m_name += "_pregs";
+  return name;
+}
+
+void PlanarLoadToRegs::AddVariables(VarSet &set) const
+{
+  string varDecl = arch->PlanarTypeName(GetDataType()) + " " + GetInputNameStr(0) + "_pregs;";
+  Var var(DirectVarDeclType, varDecl, GetDataType());
+  set.insert(var);
+}
+
+void PlanarDuplicateRegLoad::Prop()
+{
+  if (!IsValidCost(m_cost)) {
+    if (m_inputs.size() != 1) {
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    if ((*(GetInputM(0)) != 1) ||
+	(*(GetInputN(0)) != 1)) {
+      cout << "Bad planar duplicate load arg, dimensions are: " << endl;
+      GetInputM(0)->Print();
+      GetInputN(0)->Print();
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    Input(0)->Prop();
+    // One broadcast for each plane
+    m_cost = 2 * costModel->OpCost(DUPLICATELOADOP, ComponentType(GetDataType()));
+  }
+}
+
+void PlanarDuplicateRegLoad::PrintCode(IndStream &out)
+{
+  out.Indent();
+  *out << arch->PlanarDuplicateLoad(GetDataType(), GetInputNameStr(0), GetNameStr(0));
+}
+
+void PlanarDuplicateRegLoad::ClearDataTypeCache()
+{
+  m_mSizes = NULL;
+  m_nSizes = NULL;
+}
+
+void PlanarDuplicateRegLoad::BuildDataTypeCache()
+{
+  if (!m_mSizes) {
+    m_info = InputDataType(0);
+    m_info.m_numRowsVar = "planar vector register size";
+    m_info.m_numColsVar = "1";
+    unsigned int num = GetInputM(0)->NumSizes();
+    m_mSizes = SizeList::M_cache.GetCachedRepeatedSize(arch->PlanarVecRegWidth(GetDataType()), num);
+    m_nSizes = SizeList::M_cache.GetCachedRepeatedSize(1, num);
+  }
+}
+
+const SizeList* PlanarDuplicateRegLoad::GetM(ConnNum num) const
+{
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return m_mSizes;
+}
+
+const SizeList* PlanarDuplicateRegLoad::GetN(ConnNum num) const
+{
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  return m_nSizes;
+}
+
+Name PlanarDuplicateRegLoad::GetName(ConnNum num) const
+{
+  if (num != 0) {
+    LOG_FAIL("replacement for throw call");
+  }
+  Name name = GetInputName(0);
+  name.m_name += "_pregDup";
+  return name;
+}
+
+void PlanarDuplicateRegLoad::AddVariables(VarSet &set) const
+{
+  string varDecl = arch->PlanarTypeName(GetDataType()) + " " + GetInputNameStr(0) + "_pregDup;";
+  Var var(DirectVarDeclType, varDecl, GetDataType());
+  set.insert(var);
+}
+
+void PlanarMul::Prop()
+{
+  if (!IsValidCost(m_cost)) {
+    DLAOp<2, 1>::Prop();
+    // Four component multiplies cover two registers of complex elements
+    m_cost = 4 * costModel->OpCost(MULOP, ComponentType(GetDataType()));
+  }
+}
+
+void PlanarMul::PrintCode(IndStream &out)
+{
+  out.Indent();
+  string aStr = GetInputNameStr(0);
+  string bStr = GetInputNameStr(1);
+  *out << arch->PlanarMulCode(GetDataType(), aStr, bStr, bStr);
+}
+
+bool PlanarStoreFromRegs::IsContiguousStore() const
+{
+  if (IsInputColVector(1)) {
+    return IsUnitStride(InputDataType(1).m_rowStride);
+  } else {
+    return IsUnitStride(InputDataType(1).m_colStride);
+  }
+}
+
+string PlanarStoreFromRegs::StrideVar() const
+{
+  if (IsInputColVector(1)) {
+    return InputDataType(1).m_rowStrideVar;
+  } else {
+    return InputDataType(1).m_colStrideVar;
+  }
+}
+
+void PlanarStoreFromRegs::Prop()
+{
+  if (!IsValidCost(m_cost)) {
+    DLAOp<2, 1>::Prop();
+    m_cost = 2 * costModel->RegStoreCost(GetDataType(), IsContiguousStore())
+      + 2 * costModel->OpCost(ADDOP, GetDataType());
+  }
+}
+
+void PlanarStoreFromRegs::PrintCode(IndStream &out)
+{
+  out.Indent();
+  if (IsContiguousStore()) {
+    *out << arch->PlanarContiguousStore(GetDataType(), GetInputNameStr(1), GetInputNameStr(0));
+  } else {
+    *out << arch->PlanarStridedStore(GetDataType(), GetInputNameStr(1), GetInputNameStr(0), StrideVar());
+  }
+}
+
+#endif // DOLLDLA
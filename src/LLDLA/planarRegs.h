@@ -0,0 +1,129 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "DLANode.h"
+#include "DLAOp.h"
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+// Planar complex registers hold the real parts of 2 * mu complex
+// elements in one vector register and the imaginary parts in another,
+// so multiplies need no shuffles.  The deinterleave happens once in the
+// load and the interleave once in the store
+
+class PlanarLoadToRegs : public DLANode
+{
+ private:
+  bool IsContiguousLoad() const;
+  string StrideVar() const;
+
+ public:
+  virtual NodeType GetType() const { return "PlanarLoadToRegs"; }
+  static Node* BlankInst() { return new PlanarLoadToRegs(); }
+  virtual Node* GetNewInst() { return BlankInst(); }
+
+  virtual void Prop();
+  virtual void PrintCode(IndStream &out);
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+  static ClassType GetClass() { return "PlanarLoadToRegs"; }
+  virtual const DataTypeInfo& DataType(ConnNum num) const { return InputDataType(0); }
+  virtual const SizeList* GetM(ConnNum num) const;
+  virtual const SizeList* GetN(ConnNum num) const;
+
+  virtual Name GetName(ConnNum num) const;
+
+  virtual bool IsReadOnly() const { return true; }
+  virtual bool Overwrites(const Node *input, ConnNum num) const { return false; }
+  virtual bool IsDataDependencyOfInput() const { return true; }
+
+  virtual void AddVariables(VarSet &set) const;
+};
+
+class PlanarDuplicateRegLoad : public DLANode
+{
+ public:
+  const SizeList *m_mSizes;
+  const SizeList *m_nSizes;
+  DataTypeInfo m_info;
+
+  virtual NodeType GetType() const { return "PlanarDuplicateRegLoad"; }
+  static Node* BlankInst() { return new PlanarDuplicateRegLoad(); }
+  virtual Node* GetNewInst() { return BlankInst(); }
+
+  virtual void Prop();
+  virtual void PrintCode(IndStream &out);
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+  static ClassType GetClass() { return "PlanarDuplicateVecReg"; }
+  virtual const DataTypeInfo& DataType(ConnNum num) const { return m_info; }
+  virtual const SizeList* GetM(ConnNum num) const;
+  virtual const SizeList* GetN(ConnNum num) const;
+
+  virtual Name GetName(ConnNum num) const;
+
+  virtual bool IsReadOnly() const { return true; }
+  virtual bool Overwrites(const Node *input, ConnNum num) const { return false; }
+  virtual bool IsDataDependencyOfInput() const { return true; }
+
+  virtual void AddVariables(VarSet &set) const;
+  virtual void BuildDataTypeCache();
+  virtual void ClearDataTypeCache();
+};
+
+class PlanarMul : public DLAOp<2, 1>
+{
+ public:
+  virtual NodeType GetType() const { return "PlanarMul"; }
+  static Node* BlankInst() { return new PlanarMul(); }
+  virtual Node* GetNewInst() { return BlankInst(); }
+
+  virtual void Prop();
+  virtual void PrintCode(IndStream &out);
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+  static ClassType GetClass() { return "PlanarMul"; }
+
+  virtual bool IsReadOnly() const { return false; }
+  virtual bool IsDataDependencyOfInput() const { return true; }
+};
+
+class PlanarStoreFromRegs : public DLAOp<2, 1>
+{
+ private:
+  bool IsContiguousStore() const;
+  string StrideVar() const;
+
+ public:
+  virtual NodeType GetType() const { return "PlanarStoreFromRegs"; }
+  static Node* BlankInst() { return new PlanarStoreFromRegs(); }
+  virtual Node* GetNewInst() { return BlankInst(); }
+
+  virtual void Prop();
+  virtual void PrintCode(IndStream &out);
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+  static ClassType GetClass() { return "PlanarStoreFromRegs"; }
+
+  virtual bool IsReadOnly() const { return false; }
+  virtual bool IsDataDependencyOfInput() const { return true; }
+};
+
+#endif // DOLLDLA
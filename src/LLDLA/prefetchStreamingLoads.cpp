@@ -0,0 +1,88 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "prefetchStreamingLoads.h"
+
+#if DOLLDLA
+
+#include "costModel.h"
+#include "regLoadStore.h"
+#include "streamingUtils.h"
+
+static bool IsStreamingLoad(const Node* node) {
+  if (node->GetNodeClass() != LoadToRegs::GetClass()) {
+    return false;
+  }
+  auto load = static_cast<const LoadToRegs*>(node);
+  return !load->HasPrefetch() && load->IsContiguousLoad() && IsStreamingAccess(load, 0);
+}
+
+string PrefetchStreamingLoads::GetType() const {
+  return "PrefetchStreamingLoads " + std::to_string((long long int) m_byteDistance) + " " + PrefetchHintToStr(m_hint);
+}
+
+bool PrefetchStreamingLoads::CanApply(const Node* node) const {
+  if (node->GetNodeClass() != LoadToRegs::GetClass()) {
+    cout << "ERROR: Applying PrefetchStreamingLoads to non LoadToRegs node" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  if (costModel->WorkingSetBytes() <= arch->L2Bytes()) {
+    return false;
+  }
+  if (!IsStreamingLoad(node)) {
+    return false;
+  }
+  //All streaming loads in the poss get the same prefetch, so only
+  // the first one applies the transformation
+  for (auto possNode : node->m_poss->m_possNodes) {
+    if (possNode == node) {
+      return true;
+    }
+    if (IsStreamingLoad(possNode)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+void PrefetchStreamingLoads::Apply(Node* node) const {
+  vector<Node*> loads;
+  for (auto possNode : node->m_poss->m_possNodes) {
+    if (IsStreamingLoad(possNode)) {
+      loads.push_back(possNode);
+    }
+  }
+
+  for (auto load : loads) {
+    auto prefetchedLoad = new LoadToRegs();
+    prefetchedLoad->SetPrefetch(m_byteDistance, m_hint);
+    prefetchedLoad->AddInput(load->Input(0), load->InputConnNum(0));
+
+    load->RedirectChildren(prefetchedLoad, 0);
+
+    load->m_poss->AddNode(prefetchedLoad);
+    load->m_poss->DeleteChildAndCleanUp(load);
+  }
+  return;
+}
+
+#endif // DOLLDLA
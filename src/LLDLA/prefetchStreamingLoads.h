@@ -0,0 +1,46 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "transform.h"
+
+// Prefetches byteDistance ahead of every contiguous register load
+// in a poss that streams through an operand, i.e. loads the block a
+// loop is stepping forward through along the vector's own
+// direction. Prefetching only pays off once the data falls out of
+// L2, so it is not tried for smaller working sets
+class PrefetchStreamingLoads : public SingleTrans {
+ public:
+  int m_byteDistance;
+  PrefetchHint m_hint;
+
+  PrefetchStreamingLoads(int byteDistance, PrefetchHint hint)
+    : m_byteDistance(byteDistance), m_hint(hint) {}
+  virtual string GetType() const;
+
+  virtual bool CanApply(const Node* node) const;
+  virtual void Apply(Node* node) const;
+};
+
+#endif // DOLLDLA
@@ -25,6 +25,7 @@
 
 ProblemInstance::ProblemInstance() {
   m_name = unique_ptr<string>(new string(""));
+  m_reordersArithmetic = false;
 }
 
 ProblemInstance::~ProblemInstance() {
@@ -66,6 +67,10 @@ Type ProblemInstance::GetType() {
   return m_type;
 }
 
+bool ProblemInstance::ReordersArithmetic() {
+  return m_reordersArithmetic;
+}
+
 void ProblemInstance::SetCost(Cost cost) {
   m_cost = cost;
 }
@@ -78,4 +83,8 @@ void ProblemInstance::SetType(Type type) {
   m_type = type;
 }
 
+void ProblemInstance::SetReordersArithmetic(bool reorders) {
+  m_reordersArithmetic = reorders;
+}
+
 #endif // DOLLDLA
@@ -32,6 +32,7 @@ class ProblemInstance {
   unique_ptr<string> m_name;
   Type m_type;
   Cost m_cost;
+  bool m_reordersArithmetic;
 
   vector<unique_ptr<string>> m_dimNames;
   vector<int> m_dimValues;
@@ -48,10 +49,14 @@ class ProblemInstance {
   Cost GetCost();
   string GetName();
   Type GetType();
+  bool ReordersArithmetic();
 
   void SetCost(Cost cost);
   void SetName(string name);
   void SetType(Type type);
+  // Problems whose implementations legitimately round differently
+  // from the reference are sanity checked with a tolerance
+  void SetReordersArithmetic(bool reorders);
 };
 
 #endif // DOLLDLA
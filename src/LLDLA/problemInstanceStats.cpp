@@ -25,6 +25,7 @@
 
 void ProblemInstanceStats::ComputeBestAndWorstImplementations(Type type) {
   double bestAvgFlopsPerCycle = 0.0;
+  double bestMedianFlopsPerCycle = 0.0;
   double bestFlopsPerCycle = 0.0;
   double worstFlopsPerCycle = -1; 
   for (const auto& impl : m_implementationStats) {
@@ -33,6 +34,11 @@ void ProblemInstanceStats::ComputeBestAndWorstImplementations(Type type) {
       m_bestAvgFlopsPerCycleImpl = impl.get();
     }
 
+    if (impl->GetMedianFlopsPerCycle() > bestMedianFlopsPerCycle) {
+      bestMedianFlopsPerCycle = impl->GetMedianFlopsPerCycle();
+      m_bestMedianFlopsPerCycleImpl = impl.get();
+    }
+
     if (impl->GetBestFlopsPerCycle() > bestFlopsPerCycle) {
       bestFlopsPerCycle = impl->GetBestFlopsPerCycle();
       m_bestFlopsPerCycleImpl = impl.get();
@@ -91,6 +97,26 @@ GraphNum ProblemInstanceStats::GetBestAvgFlopsPerCycleImpl() {
   return m_bestAvgFlopsPerCycleImpl->GetNum();
 }
 
+double ProblemInstanceStats::GetBestMedianFlopsPerCycle() {
+  return m_bestMedianFlopsPerCycleImpl->GetMedianFlopsPerCycle();
+}
+
+GraphNum ProblemInstanceStats::GetBestMedianFlopsPerCycleImpl() {
+  return m_bestMedianFlopsPerCycleImpl->GetNum();
+}
+
+double ProblemInstanceStats::GetBestAvgPercentOfPeak() {
+  return m_bestAvgFlopsPerCycleImpl->GetAvgPercentOfPeak();
+}
+
+double ProblemInstanceStats::GetBestMedianPercentOfPeak() {
+  return m_bestMedianFlopsPerCycleImpl->GetMedianPercentOfPeak();
+}
+
+unsigned int ProblemInstanceStats::NumImplementations() {
+  return m_implementationStats.size();
+}
+
 void ProblemInstanceStats::PrintProblemSummary() {
   cout << "\n&&&&&&&&&&&&&&&&&& Problem Summary &&&&&&&&&&&&&&&&&&&" << endl;
   cout << "Datatype                : " << TypeToStr(m_type) << endl;
@@ -98,6 +124,8 @@ void ProblemInstanceStats::PrintProblemSummary() {
   cout << "# of Implementations    : " << m_implementationStats.size() << endl;
   cout << "Best Avg. Flops / Cycle : " << m_bestAvgFlopsPerCycleImpl->GetAvgFlopsPerCycle() << endl;
   cout << "Best Avg. Pct of peak   : " << m_bestAvgFlopsPerCycleImpl->GetAvgPercentOfPeak() << endl;
+  cout << "Best Median Flops / Cycle : " << m_bestMedianFlopsPerCycleImpl->GetMedianFlopsPerCycle() << endl;
+  cout << "Best Median Pct of peak   : " << m_bestMedianFlopsPerCycleImpl->GetMedianPercentOfPeak() << endl;
   cout << "&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&&\n" << endl;
 }
 
@@ -148,7 +176,7 @@ void ProblemInstanceStats::GetNBest(vector<GraphNum> &keepers, int numToKeep)
   priority_queue<double> queue;
   double currBest = 0;
   for (const auto& implStat : m_implementationStats) {
-    double curr = -1*implStat->GetAvgFlopsPerCycle();
+    double curr = -1*implStat->GetMedianFlopsPerCycle();
     if (curr <= currBest) {
       queue.push(curr);
       if (queue.size() > numToKeep) {
@@ -162,7 +190,7 @@ void ProblemInstanceStats::GetNBest(vector<GraphNum> &keepers, int numToKeep)
     }
   }
   for (const auto& implStat : m_implementationStats) {
-    double curr = -1*implStat->GetAvgFlopsPerCycle();
+    double curr = -1*implStat->GetMedianFlopsPerCycle();
     if (curr <= currBest) {
       keepers.push_back(implStat->GetNum());
     }
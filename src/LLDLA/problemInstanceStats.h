@@ -44,6 +44,7 @@ class ProblemInstanceStats {
   void PrintProblemSummary();
 
   ImplementationStats* m_bestAvgFlopsPerCycleImpl;
+  ImplementationStats* m_bestMedianFlopsPerCycleImpl;
   ImplementationStats* m_bestFlopsPerCycleImpl;
   ImplementationStats* m_worstFlopsPerCycleImpl;
 
@@ -62,6 +63,11 @@ class ProblemInstanceStats {
   string CSVLineColumnTitles();
   double GetBestAvgFlopsPerCycle();
   GraphNum GetBestAvgFlopsPerCycleImpl();
+  double GetBestMedianFlopsPerCycle();
+  GraphNum GetBestMedianFlopsPerCycleImpl();
+  double GetBestAvgPercentOfPeak();
+  double GetBestMedianPercentOfPeak();
+  unsigned int NumImplementations();
   void PrettyPrintPerformanceStats();
   string CSVLine();
   void WriteImplementationCSV(string impCSVPath);
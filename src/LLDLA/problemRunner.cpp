@@ -23,30 +23,61 @@
 
 #if DOLLDLA
 
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
 #include <string>
 
 #include "allTransformations.h"
 #include "DLAReg.h"
+#include "implementationRanking.h"
 #include "oneStageTimingResult.h"
 #include "runtimeEvaluation.h"
+#include "sizeGeneric.h"
 
-#define TIMEANDCULLBEFOREUNROLLING 1
+#define DOSUCCESSIVEHALVING 1
 
 static string evalDirName = "runtimeEvaluation";
 static SanityCheckSetting sanityCheckSetting = CHECKALLBUFFERS;
-static TimingSetting timingSetting = ONEPHASETIMING;
+static TimingSetting timingSetting = ADAPTIVETIMING;
 static unsigned int numberOfImplementationsToEvaluate = 1000;
 static int minCycles = 100000000;
 
-#if TIMEANDCULLBEFOREUNROLLING
-static double percentToKeep = .5;
-void FirstPhaseTimingAndCulling(LLDLAUniverse* uni, ProblemInstance* problemInstance, double percentToCull);
-#endif
-
-
-ProblemInstanceStats* RunProblemWithRTE(int algNum, RealPSet* algPSet, ProblemInstance* problemInstance) {
+#define DORANKINGMODEL 1
+
+#if DORANKINGMODEL
+//Once the timing history trains the ranking model, the final
+// evaluation times this many candidates picked by the model instead
+// of numberOfImplementationsToEvaluate picked by static cost
+static unsigned int numberOfRankedImplementationsToEvaluate = 100;
+
+string TimingHistoryProblem(ProblemInstance* problemInstance);
+void RecordTimingHistory(ProblemInstance* problemInstance, ImplementationMap* impMap, vector<OneStageTimingResult*>* results);
+#endif // DORANKINGMODEL
+
+#if DOSUCCESSIVEHALVING
+//Successive halving: after a phase the surviving implementations are
+// timed on a short budget and only the fastest fraction is kept.  A
+// fraction of 1 skips that rung.  The rung budget is minCycles times
+// the fractions still to be applied, so every rung spends about the
+// same total cycles and only the finalists are timed with minCycles.
+// The loop and RTL rungs are off by default since most of their
+// graphs still call the reference kernels, and the unroll rung is
+// off because every rung recompiles its survivors, which costs more
+// than timing them right before the final evaluation.  Override with
+// LLDLA_HALVING_KEEP=loop,rtl,prim,unroll
+static double phaseKeepFractions[NUMPHASES] = {1, 1, .5, 1};
+static int minRungCycles = 1000000;
+
+void ReadHalvingSchedule();
+int RungBudget(LLDLAPhase phase);
+void TimeAndCull(LLDLAUniverse* uni, ProblemInstance* problemInstance, double keepFraction, int budgetCycles);
+#endif // DOSUCCESSIVEHALVING
+
+
+ProblemInstanceStats* RunProblemWithRTE(int algNum, RealPSet* algPSet, ProblemInstance* problemInstance, KernelLibrary* library) {
   auto uni = RunProblem(algNum, algPSet, problemInstance);
-  auto pStats = RuntimeEvaluation(algNum, uni, problemInstance);
+  auto pStats = RuntimeEvaluation(algNum, uni, problemInstance, library);
   delete uni;
   return pStats;
 }
@@ -66,7 +97,7 @@ std::string LLDLAPhaseString(LLDLAPhase phase) {
   throw;
 }
 
-void RunPhase(Universe* uni, int numIters, LLDLAPhase phase) {
+void RunPhase(LLDLAUniverse* uni, int numIters, LLDLAPhase phase, ProblemInstance* problemInstance) {
   time_t start, end;
 
   cout << "Expanding " << LLDLAPhaseString(phase) << endl;
@@ -84,11 +115,22 @@ void RunPhase(Universe* uni, int numIters, LLDLAPhase phase) {
   time(&end);
 
   cout << "Propagation took " << difftime(end,start) << " seconds\n";
+
+#if DOSUCCESSIVEHALVING
+  if (phaseKeepFractions[phase] < 1) {
+    GraphNum num = uni->TotalCount();
+    TimeAndCull(uni, problemInstance, phaseKeepFractions[phase], RungBudget(phase));
+    cout << "After the " << LLDLAPhaseString(phase) << " rung, " << num << " -> " << uni->TotalCount() << " graphs left\n";
+  }
+#endif // DOSUCCESSIVEHALVING
 }
 
 LLDLAUniverse* RunProblem(int algNum, RealPSet* startSet, ProblemInstance* problemInstance) {
   RegAllLLDLANodes();
   AddTransformations();
+#if DOSUCCESSIVEHALVING
+  ReadHalvingSchedule();
+#endif // DOSUCCESSIVEHALVING
 
   int numIters = -1;
   auto uni = new LLDLAUniverse();
@@ -105,31 +147,28 @@ LLDLAUniverse* RunProblem(int algNum, RealPSet* startSet, ProblemInstance* probl
   cout << "Done with problem setup" << endl;
 
   problemInstance->SetCost(uni->GetOperationFlopCost());
+  if (sizeGeneric) {
+    CheckSizeGenericDimensions(problemInstance);
+  }
   cout << "Implementation for correctness check:\n" << uni->GetSanityCheckImplStr();
   cout << "Flops for operation = " << std::to_string((long double) uni->GetOperationFlopCost()) << endl;
 
   time(&start);
 
   if ((CurrPhase == LLDLALOOPPHASE) && DOLLDLALOOPPHASE) {
-    RunPhase(uni, numIters, LLDLALOOPPHASE);
+    RunPhase(uni, numIters, LLDLALOOPPHASE, problemInstance);
   }
 
   if ((CurrPhase == LLDLARTLPHASE) && DOLLDLARTLPHASE) {
-    RunPhase(uni, numIters, LLDLARTLPHASE);
+    RunPhase(uni, numIters, LLDLARTLPHASE, problemInstance);
   }
 
   if ((CurrPhase == LLDLAPRIMPHASE) && DOLLDLAPRIMPHASE) {
-    RunPhase(uni, numIters, LLDLAPRIMPHASE);
-  }
-
-  if (TIMEANDCULLBEFOREUNROLLING) {
-    GraphNum num = uni->TotalCount();
-    FirstPhaseTimingAndCulling(uni, problemInstance, percentToKeep);
-    cout << "Aftering first timing phase, " << num << " -> " << uni->TotalCount() << " graphs left\n";
+    RunPhase(uni, numIters, LLDLAPRIMPHASE, problemInstance);
   }
 
   if ((CurrPhase == LLDLALOOPUNROLLPHASE) && DOLLDLALOOPUNROLLPHASE) {
-    RunPhase(uni, numIters, LLDLALOOPUNROLLPHASE);
+    RunPhase(uni, numIters, LLDLALOOPUNROLLPHASE, problemInstance);
   }
 
   time(&end);
@@ -141,26 +180,92 @@ LLDLAUniverse* RunProblem(int algNum, RealPSet* startSet, ProblemInstance* probl
   return uni;
 }
 
-ProblemInstanceStats* RuntimeEvaluation(int algNum, LLDLAUniverse* uni, ProblemInstance* problemInstance) {
+#if DORANKINGMODEL
+//The K-th lowest of vals, or the highest when there are fewer than K
+Cost KthLowest(vector<Cost> vals, unsigned int k)
+{
+  if (vals.size() <= k)
+    return *std::max_element(vals.begin(), vals.end());
+  std::nth_element(vals.begin(), vals.begin() + (k - 1), vals.end());
+  return vals[k - 1];
+}
+
+//The union of the ranking model's and the static cost's top
+// numberOfRankedImplementationsToEvaluate candidates, so a
+// poorly trained model can't hide the implementations the cost
+// model already finds
+unique_ptr<ImplementationMap> RankedImpStrMap(LLDLAUniverse* uni, const RankingModel &rankingModel)
+{
+  vector<Cost> scores, costs;
+  GraphIter iter(uni->m_pset->m_posses.begin()->second);
+  do {
+    scores.push_back(rankingModel.Score(ExtractFeatures(iter)));
+    costs.push_back(iter.Eval());
+  } while (!iter.Increment());
+  Cost scoreCut = KthLowest(scores, numberOfRankedImplementationsToEvaluate);
+  Cost costCut = KthLowest(costs, numberOfRankedImplementationsToEvaluate);
+  unsigned int numGraphs = 0;
+  for (unsigned int i = 0; i < scores.size(); ++i) {
+    if (scores[i] <= scoreCut || costs[i] <= costCut)
+      ++numGraphs;
+  }
+  cout << "Timing " << numGraphs << " candidates from the ranking model and static cost\n";
+  return uni->ImpStrMap(true, numGraphs,
+			[&rankingModel, scoreCut, costCut](GraphIter &iter) {
+			  return (rankingModel.Score(ExtractFeatures(iter)) <= scoreCut
+				  || iter.Eval() <= costCut) ? 0 : 1;
+			});
+}
+#endif // DORANKINGMODEL
+
+ProblemInstanceStats* RuntimeEvaluation(int algNum, LLDLAUniverse* uni, ProblemInstance* problemInstance, KernelLibrary* library) {
   LOG_A("Starting runtime evaluation for " + problemInstance->GetName());
   cout << "Writing all implementations to runtime eval files\n";
   RuntimeTest rtest(problemInstance, uni, minCycles);
   RuntimeEvaluator evaler = RuntimeEvaluator(evalDirName);
 
   cout << "About to evaluate\n";
+#if DORANKINGMODEL
+  RankingModel rankingModel;
+  rankingModel.Train(ReadTimingHistory(LLDLATIMINGHISTORYFILE));
+  unique_ptr<ImplementationMap> impMap;
+  if (rankingModel.IsTrained()) {
+    cout << "Picking candidates with the ranking model trained on " << LLDLATIMINGHISTORYFILE << endl;
+    cout << "Ranking model held-out rank correlation = " << rankingModel.HeldOutRankCorrelation() << endl;
+    impMap = RankedImpStrMap(uni, rankingModel);
+  } else {
+    impMap = uni->ImpStrMap(true, numberOfImplementationsToEvaluate);
+  }
+#else
   auto impMap = uni->ImpStrMap(false, numberOfImplementationsToEvaluate);
+#endif // DORANKINGMODEL
   vector<TimingResult*>* timingResults = evaler.EvaluateImplementations(sanityCheckSetting, timingSetting, rtest, impMap.get(), uni->GetSanityCheckImplStr());
   cout << "Done evaluating\n";
 
   vector<OneStageTimingResult*>* oneStageResults = reinterpret_cast<vector<OneStageTimingResult*>*>(timingResults);
+#if DORANKINGMODEL
+  RecordTimingHistory(problemInstance, impMap.get(), oneStageResults);
+  for (auto &info : *impMap) {
+    delete info.second.iter;
+    info.second.iter = NULL;
+  }
+#endif // DORANKINGMODEL
   auto pStats = new ProblemInstanceStats(problemInstance, oneStageResults);
   pStats->PrettyPrintPerformanceStats();
 
-  GraphNum best = pStats->GetBestAvgFlopsPerCycleImpl();
-  cout << "Best Avg. flops/cycle = " << pStats->GetBestAvgFlopsPerCycle() << endl;
+  GraphNum best = pStats->GetBestMedianFlopsPerCycleImpl();
+  cout << "Best Median flops/cycle = " << pStats->GetBestMedianFlopsPerCycle() << endl;
 
   cout << impMap.get()->find(best)->second.str << endl;
 
+  if (sizeGeneric) {
+    ExportSizeGenericKernel(evalDirName, problemInstance, uni, impMap.get()->find(best)->second.str);
+  }
+
+  if (library) {
+    library->AddKernel(problemInstance, uni, impMap.get()->find(best)->second.str);
+  }
+
   LOG_A("Done with runtime evaluation of " + problemInstance->GetName());
 
   for (auto elem : *timingResults)
@@ -170,15 +275,93 @@ ProblemInstanceStats* RuntimeEvaluation(int algNum, LLDLAUniverse* uni, ProblemI
   return pStats;
 }
 
-#if TIMEANDCULLBEFOREUNROLLING
-void FirstPhaseTimingAndCulling(LLDLAUniverse* uni, ProblemInstance* problemInstance, double percentToCull)
+#if DORANKINGMODEL
+string TimingHistoryProblem(ProblemInstance* problemInstance)
 {
-  LOG_A("Starting first-phase runtime evaluation for " + problemInstance->GetName());
+  string problem = problemInstance->GetName() + "_" + TypeToStr(problemInstance->GetType());
+  vector<int>* dimValues = problemInstance->DimensionValues();
+  for (auto dimValue : *dimValues) {
+    problem += "_" + std::to_string((long long int) dimValue);
+  }
+  delete dimValues;
+  if (sizeGeneric) {
+    problem += "_generic";
+  }
+  return problem;
+}
+
+//Appends every timed implementation's features and median cycles to
+// the history the ranking model is trained on
+void RecordTimingHistory(ProblemInstance* problemInstance, ImplementationMap* impMap, vector<OneStageTimingResult*>* results)
+{
+  string problem = TimingHistoryProblem(problemInstance);
+  vector<TimingHistoryRow> rows;
+  for (auto result : *results) {
+    vector<double> times = *(result->GetTimes());
+    auto info = impMap->find(result->GetNum());
+    if (times.empty() || info == impMap->end() || !info->second.iter) {
+      continue;
+    }
+    std::sort(times.begin(), times.end());
+    TimingHistoryRow row;
+    row.m_problem = problem;
+    row.m_medianCycles = times[times.size() / 2];
+    row.m_features = ExtractFeatures(*(info->second.iter));
+    rows.push_back(row);
+  }
+  AppendTimingHistory(LLDLATIMINGHISTORYFILE, rows);
+}
+#endif // DORANKINGMODEL
+
+#if DOSUCCESSIVEHALVING
+void ReadHalvingSchedule()
+{
+  const char* requested = getenv("LLDLA_HALVING_KEEP");
+  if (requested == NULL) {
+    return;
+  }
+  double fractions[NUMPHASES];
+  std::stringstream fractionStream(requested);
+  string fraction;
+  unsigned int numFractions = 0;
+  while (std::getline(fractionStream, fraction, ',')) {
+    if (numFractions == NUMPHASES) {
+      ++numFractions;
+      break;
+    }
+    fractions[numFractions] = atof(fraction.c_str());
+    if (fractions[numFractions] <= 0 || fractions[numFractions] > 1) {
+      break;
+    }
+    ++numFractions;
+  }
+  if (numFractions != NUMPHASES) {
+    cout << "WARNING: ignoring LLDLA_HALVING_KEEP=" << requested
+	 << ", it needs " << NUMPHASES << " fractions in (0, 1]" << endl;
+    return;
+  }
+  for (unsigned int phase = 0; phase < NUMPHASES; ++phase) {
+    phaseKeepFractions[phase] = fractions[phase];
+  }
+}
+
+int RungBudget(LLDLAPhase phase)
+{
+  double budget = minCycles;
+  for (int later = phase; later < NUMPHASES; ++later) {
+    budget *= phaseKeepFractions[later];
+  }
+  return std::max((int) budget, minRungCycles);
+}
+
+void TimeAndCull(LLDLAUniverse* uni, ProblemInstance* problemInstance, double keepFraction, int budgetCycles)
+{
+  LOG_A("Starting successive halving rung for " + problemInstance->GetName());
   cout << "Writing all implementations to runtime eval files\n";
-  RuntimeTest rtest(problemInstance, uni, minCycles);
+  RuntimeTest rtest(problemInstance, uni, budgetCycles);
   RuntimeEvaluator evaler = RuntimeEvaluator(evalDirName);
 
-  cout << "About to evaluate\n";
+  cout << "About to evaluate with a budget of " << budgetCycles << " cycles\n";
 
   auto impMap = uni->ImpStrMap(true, numberOfImplementationsToEvaluate);
   vector<TimingResult*>* timingResults = evaler.EvaluateImplementations(sanityCheckSetting, timingSetting, rtest, impMap.get(), uni->GetSanityCheckImplStr());
@@ -186,13 +369,16 @@ void FirstPhaseTimingAndCulling(LLDLAUniverse* uni, ProblemInstance* problemInst
 
   vector<OneStageTimingResult*>* oneStageResults = reinterpret_cast<vector<OneStageTimingResult*>*>(timingResults);
   auto pStats = new ProblemInstanceStats(problemInstance, oneStageResults);
+#if DORANKINGMODEL
+  RecordTimingHistory(problemInstance, impMap.get(), oneStageResults);
+#endif // DORANKINGMODEL
 
   vector<GraphNum> keepers;
-  pStats->GetNBest(keepers,ceil(impMap->size()*percentToCull));
+  pStats->GetNBest(keepers,ceil(impMap->size()*keepFraction));
 
   uni->m_pset->ClearKeeperFromAll();
 
-  cout << "should have " << ceil(impMap->size()*percentToCull) << endl;
+  cout << "should have " << ceil(impMap->size()*keepFraction) << endl;
   cout << "keepers size " << keepers.size() << endl;
 
   for(auto num : keepers) {
@@ -203,18 +389,15 @@ void FirstPhaseTimingAndCulling(LLDLAUniverse* uni, ProblemInstance* problemInst
     delete info.second.iter;
   }
 
-
   for (auto elem : *timingResults)
     delete elem;
   delete timingResults;
-
+  delete pStats;
 
   uni->m_pset->DeleteNonKeepers();
 
-
-  
-  LOG_A("Done with first-phase runtime evaluation of " + problemInstance->GetName());
+  LOG_A("Done with successive halving rung of " + problemInstance->GetName());
 }
-#endif //TIMEANDCULLBEFOREUNROLLING
+#endif // DOSUCCESSIVEHALVING
 
 #endif // DOLLDLA
@@ -23,13 +23,15 @@
 
 #if DOLLDLA
 
+#include "kernelLibrary.h"
 #include "lldlaUniverse.h"
 
-ProblemInstanceStats* RunProblemWithRTE(int algNum, RealPSet* algPSet, ProblemInstance* problemInstance);
+//When library is given, the best implementation is added to it
+ProblemInstanceStats* RunProblemWithRTE(int algNum, RealPSet* algPSet, ProblemInstance* problemInstance, KernelLibrary* library = NULL);
 
 LLDLAUniverse* RunProblem(int algNum, RealPSet* startSet, ProblemInstance* problemInstance);
 
-ProblemInstanceStats* RuntimeEvaluation(int algNum, LLDLAUniverse* uni, ProblemInstance* problemInstance);
+ProblemInstanceStats* RuntimeEvaluation(int algNum, LLDLAUniverse* uni, ProblemInstance* problemInstance, KernelLibrary* library = NULL);
 
 
 #endif // DOLLDLA
@@ -23,6 +23,8 @@
 
 #if DOLLDLA
 
+#include "costModel.h"
+
 void FMAdd::Prop()
 {
   if (!IsValidCost(m_cost)) {
@@ -39,7 +41,7 @@ void FMAdd::Prop()
       LOG_FAIL("replacement for throw call");
       }*/
 
-    m_cost = 0;
+    m_cost = costModel->OpCost(FMAOP, GetDataType());
   }
 }
 
@@ -61,7 +63,7 @@ void Add::Prop()
 // TODO: Delete shape checks and instead check that
 // inputs are registers
 
-     m_cost = 0;
+     m_cost = costModel->OpCost(ADDOP, GetDataType());
   }
 }
 
@@ -82,7 +84,7 @@ void Mul::Prop()
 // TODO: Delete shape checks and instead check that
 // inputs are registers
 
-    m_cost = 0;
+    m_cost = costModel->OpCost(MULOP, GetDataType());
   }
 }
 
@@ -98,6 +100,9 @@ void Mul::PrintCode(IndStream &out)
 void ZeroReg::Prop()
 {
 // TODO: Add full prop method with register checks
+  if (!IsValidCost(m_cost)) {
+    m_cost = costModel->OpCost(ZEROOP, GetDataType());
+  }
   return;
 }
 
@@ -112,6 +117,9 @@ void ZeroReg::PrintCode(IndStream &out)
 void AccumReg::Prop()
 {
 // TODO: Add full prop method with register checks
+  if (!IsValidCost(m_cost)) {
+    m_cost = costModel->OpCost(ACCUMOP, GetDataType());
+  }
   return;
 }
 
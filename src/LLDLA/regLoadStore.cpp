@@ -56,20 +56,43 @@ void LoadToRegs::SetCost()
   Input(0)->Prop();
   if (IsInputColVector(0)) {
     if (IsUnitStride(InputDataType(0).m_rowStride)) {
-      m_cost = costModel->ContigVecLoadCost();
+      m_cost = costModel->OpCost(CONTIGLOADOP, GetDataType());
     } else {
-      m_cost = GetVecRegWidth() * costModel->ContigVecLoadCost();
+      m_cost = costModel->OpCost(STRIDEDLOADOP, GetDataType());
     }
   } else {
     if (IsUnitStride(InputDataType(0).m_colStride)) {
-      m_cost = costModel->ContigVecLoadCost();
+      m_cost = costModel->OpCost(CONTIGLOADOP, GetDataType());
     } else {
-      m_cost = GetVecRegWidth() * costModel->ContigVecLoadCost();
+      m_cost = costModel->OpCost(STRIDEDLOADOP, GetDataType());
     }
   }
+  if (IsContiguousLoad()) {
+    m_cost += costModel->SplitLineCost(GetDataType(), InputDataType(0).m_alignment);
+  }
+  if (HasPrefetch()) {
+    m_cost += costModel->PrefetchCost();
+  }
   return;
 }
 
+NodeType LoadToRegs::GetType() const
+{
+  if (HasPrefetch()) {
+    return "LoadToRegs prefetch " + std::to_string((long long int) m_prefetchDistance) + " " + PrefetchHintToStr(m_prefetchHint);
+  }
+  return "LoadToRegs";
+}
+
+bool LoadToRegs::IsContiguousLoad() const
+{
+  if (IsInputColVector(0)) {
+    return IsUnitStride(InputDataType(0).m_rowStride);
+  } else {
+    return IsUnitStride(InputDataType(0).m_colStride);
+  }
+}
+
 void LoadToRegs::Prop()
 {
   if (!IsValidCost(m_cost)) {
@@ -112,8 +135,15 @@ void LoadToRegs::PrintCode(IndStream &out) {
     }    
   }
 
+  if (HasPrefetch()) {
+    *out << arch->Prefetch(toLoadName, m_prefetchDistance, m_prefetchHint);
+    out.Indent();
+  }
+
   if (isStridedLoad) {
     *out << arch->StridedLoad(GetDataType(), toLoadName, loadStr, strideVar);
+  } else if (InputIsVecRegAligned(0)) {
+    *out << arch->AlignedLoad(GetDataType(), toLoadName, loadStr);
   } else {
     *out << arch->ContiguousLoad(GetDataType(), toLoadName, loadStr);
   }
@@ -150,13 +180,21 @@ void LoadToRegs::AddVariables(VarSet &set) const {
   set.insert(var);
 }
 
+void LoadToRegs::Duplicate(const Node *orig, bool shallow, bool possMerging)
+{
+  DLANode::Duplicate(orig, shallow, possMerging);
+  const LoadToRegs *load = (LoadToRegs*) orig;
+  m_prefetchDistance = load->m_prefetchDistance;
+  m_prefetchHint = load->m_prefetchHint;
+}
+
 void PackedLoadToRegs::Prop() {
   if (!IsValidCost(m_cost)) {
     if (!(IsInputRowVector(0) || IsInputColVector(0)) || !InputIsResidual(0)) {
       cout << "Input to PackedLoadToRegs is not a row or column vector" << endl;
       throw;
     }
-    m_cost = GetVecRegWidth() * costModel->ContigVecLoadCost();
+    m_cost = costModel->OpCost(PACKEDLOADOP, GetDataType());
   }
 }
 
@@ -195,12 +233,26 @@ void PackedLoadToRegs::PrintCode(IndStream &out) {
       strideVar = InputDataType(0).m_colStrideVar;
     }    
   }
+  if (sizeGeneric) {
+    PrintResidualSwitch(out, ResidualSizeVar(), GetVecRegWidth(),
+			[&](int residual) {
+			  return arch->PackedLoad(GetDataType(), toLoadName, loadStr, strideVar, residual) + "\n";
+			});
+    return;
+  }
   int residual = ComputeResidual();
   out.Indent();
   *out << arch->PackedLoad(GetDataType(), toLoadName, loadStr, strideVar, residual);
   return;
 }
 
+string PackedLoadToRegs::ResidualSizeVar() {
+  if (IsInputColVector(0)) {
+    return InputDataType(0).m_numRowsVar;
+  }
+  return InputDataType(0).m_numColsVar;
+}
+
 const SizeList* PackedLoadToRegs::GetM(ConnNum num) const {
   if (num != 0) {
     LOG_FAIL("replacement for throw call");
@@ -235,20 +287,21 @@ void StoreFromRegs::Prop() {
     DLAOp<2,1>::Prop();
 
     if (IsInputColVector(1)) {
-      if (IsUnitStride(InputDataType(1).m_rowStride)) {
-	m_cost = costModel->ContigVecStoreCost();
-      } else {
-	m_cost = GetVecRegWidth() * costModel->ContigVecStoreCost();
-      }
+      m_cost = costModel->RegStoreCost(GetDataType(), IsUnitStride(InputDataType(1).m_rowStride));
     } else {
-      if (IsUnitStride(InputDataType(1).m_colStride)) {
-	m_cost = costModel->ContigVecStoreCost();
-      } else {
-	m_cost = GetVecRegWidth() * costModel->ContigVecStoreCost();
-      }
+      m_cost = costModel->RegStoreCost(GetDataType(), IsUnitStride(InputDataType(1).m_colStride));
+    }
+    if (IsContiguousStore()) {
+      m_cost += costModel->SplitLineCost(GetDataType(), InputDataType(1).m_alignment);
     }
-    
-    m_cost = 0;
+  }
+}
+
+bool StoreFromRegs::IsContiguousStore() const {
+  if (IsInputColVector(1)) {
+    return IsUnitStride(InputDataType(1).m_rowStride);
+  } else {
+    return IsUnitStride(InputDataType(1).m_colStride);
   }
 }
 
@@ -282,6 +335,8 @@ void StoreFromRegs::PrintCode(IndStream &out) {
   out.Indent();
   if (isStridedLoad) {
     *out << arch->StridedStore(GetDataType(), storeLocation, regVarName, strideVar);
+  } else if (InputIsVecRegAligned(1)) {
+    *out << arch->AlignedStore(GetDataType(), storeLocation, regVarName);
   } else {
     *out << arch->ContiguousStore(GetDataType(), storeLocation, regVarName);
   }
@@ -303,7 +358,7 @@ void StoreFromRegs::StoreNonContigLocations(IndStream &out, string regVarName, s
 void UnpackStoreFromRegs::Prop() {
   if (!IsValidCost(m_cost)) {
     if (!(IsInputRowVector(1) || IsInputColVector(1)) || !InputIsResidual(1)) {
-      m_cost = GetVecRegWidth() * costModel->ContigVecStoreCost();
+      m_cost = costModel->OpCost(UNPACKSTOREOP, GetDataType());
     }
   }
 }
@@ -347,6 +402,14 @@ void UnpackStoreFromRegs::PrintCode(IndStream &out)
     }    
   }
 
+  if (sizeGeneric) {
+    PrintResidualSwitch(out, ResidualSizeVar(), GetVecRegWidth(),
+			[&](int residual) {
+			  return arch->UnpackStore(GetDataType(), storeLocation, regVarName, strideVar, residual) + "\n";
+			});
+    return;
+  }
+
   int residual = ComputeResidual();
 
   out.Indent();
@@ -354,6 +417,13 @@ void UnpackStoreFromRegs::PrintCode(IndStream &out)
   return;
 }
 
+string UnpackStoreFromRegs::ResidualSizeVar() {
+  if (IsInputColVector(1)) {
+    return InputDataType(1).m_numRowsVar;
+  }
+  return InputDataType(1).m_numColsVar;
+}
+
 void DuplicateRegLoad::Prop() {
   if (!IsValidCost(m_cost)) {
     if (m_inputs.size() != 1) {
@@ -369,7 +439,7 @@ void DuplicateRegLoad::Prop() {
       throw;
     }
     Input(0)->Prop();
-    m_cost = 0;
+    m_cost = costModel->OpCost(DUPLICATELOADOP, GetDataType());
   }
 }
 
@@ -446,7 +516,7 @@ void TempVecReg::Prop() {
       throw;
     }
     Input(0)->Prop();
-    m_cost = 0;
+    m_cost = costModel->OpCost(ZEROOP, GetDataType());
   }
 }
 
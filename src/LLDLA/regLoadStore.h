@@ -31,15 +31,47 @@
 
 #include "loopTunnel.h"
 
+//For size-generic code, prints a switch over the runtime length of
+// a residual with one case per residual size.  The default case is
+// a residual of zero
+template <typename ResidualCode>
+void PrintResidualSwitch(IndStream &out, string lengthVar, int vecRegWidth, ResidualCode residualCode)
+{
+  out.Indent();
+  *out << "switch (" << lengthVar << ") {\n";
+  for (int residual = 1; residual <= vecRegWidth; ++residual) {
+    out.Indent();
+    if (residual < vecRegWidth)
+      *out << "case " << residual << ":\n";
+    else
+      *out << "default:\n";
+    out.Indent(1);
+    *out << residualCode(residual % vecRegWidth);
+    out.Indent(1);
+    *out << "break;\n";
+  }
+  out.Indent();
+  *out << "}\n";
+}
+
 class LoadToRegs : public DLANode
 {
  protected:
+  //Bytes ahead of the load to prefetch, 0 when there is no prefetch
+  int m_prefetchDistance;
+  PrefetchHint m_prefetchHint;
+
   void SetCost();
   void SanityCheckInputDims();
 
  public:
+  LoadToRegs() : m_prefetchDistance(0), m_prefetchHint(PREFETCHT0) {}
+
+  void SetPrefetch(int byteDistance, PrefetchHint hint) { m_prefetchDistance = byteDistance; m_prefetchHint = hint; }
+  bool HasPrefetch() const { return m_prefetchDistance > 0; }
+  bool IsContiguousLoad() const;
 
-  virtual NodeType GetType() const { return "LoadToRegs"; }
+  virtual NodeType GetType() const;
   static Node* BlankInst() { return  new LoadToRegs(); }
   virtual Node* GetNewInst() { return BlankInst(); }
 
@@ -58,6 +90,7 @@ class LoadToRegs : public DLANode
   virtual bool IsDataDependencyOfInput() const {return true;}
 
   virtual void AddVariables(VarSet &set) const;
+  virtual void Duplicate(const Node *orig, bool shallow, bool possMerging);
 
   //  virtual Phase MaxPhase() const;
 };
@@ -65,6 +98,7 @@ class LoadToRegs : public DLANode
 class PackedLoadToRegs : public DLANode {
  private:
   int ComputeResidual();
+  string ResidualSizeVar();
  public:
 
   virtual NodeType GetType() const { return "PackedLoadToRegs"; }
@@ -166,12 +200,14 @@ class StoreFromRegs : public DLAOp<2,1>
   virtual bool IsDataDependencyOfInput() const {return true;}
 
   void StoreNonContigLocations(IndStream &out, string regVarName, string storePtr, string strideVar);
+  bool IsContiguousStore() const;
 };
 
 class UnpackStoreFromRegs : public DLAOp<2,1>
 {
  private:
   int ComputeResidual();
+  string ResidualSizeVar();
 
  public:
   virtual NodeType GetType() const {return "UnpackStoreFromRegs";}
@@ -0,0 +1,195 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "registerPressure.h"
+
+#if DOLLDLA
+
+#include "costModel.h"
+#include "nodeLinElem.h"
+#include "setLinElem.h"
+#include "basePSet.h"
+#include "tunnel.h"
+#include "regLoadStore.h"
+#include "regArith.h"
+#include "maskedLoad.h"
+
+bool ProducesVecReg(const Node *node)
+{
+  ClassType nodeClass = node->GetNodeClass();
+  return nodeClass == LoadToRegs::GetClass()
+    || nodeClass == MaskedLoad::GetClass()
+    || nodeClass == PackedLoadToRegs::GetClass()
+    || nodeClass == DuplicateRegLoad::GetClass()
+    || nodeClass == TempVecReg::GetClass()
+    || nodeClass == FMAdd::GetClass()
+    || nodeClass == Add::GetClass()
+    || nodeClass == Mul::GetClass()
+    || nodeClass == ZeroReg::GetClass();
+}
+
+bool IsVecRegConn(const Node *node, ConnNum num)
+{
+  // Registers hoisted out of a loop or carried out of one
+  // reach their users through tunnels
+  while (node->IsTunnel()) {
+    if (node->m_inputs.empty()) {
+      return false;
+    }
+    node = node->Input(0);
+  }
+  return ProducesVecReg(node);
+}
+
+void VecRegUsesAndDefs(const LinElem *elem, StrSet &uses, StrSet &defs)
+{
+  if (elem->IsNode()) {
+    const Node *node = ((NodeLinElem*)elem)->m_node;
+    for (auto inConn : node->m_inputs) {
+      if (IsVecRegConn(inConn->m_n, inConn->m_num)) {
+	uses.insert(inConn->m_n->GetNameStr(inConn->m_num));
+      }
+    }
+    if (ProducesVecReg(node)) {
+      defs.insert(node->GetNameStr(0));
+    }
+  }
+  else if (elem->IsSet()) {
+    const BasePSet *set = ((SetLinElem*)elem)->m_set;
+    for (auto inTun : set->m_inTuns) {
+      if (!inTun->m_inputs.empty()
+	  && IsVecRegConn(inTun->Input(0), inTun->InputConnNum(0))) {
+	uses.insert(inTun->GetInputNameStr(0));
+      }
+    }
+    for (auto outTun : set->m_outTuns) {
+      if (IsVecRegConn(outTun, 0)) {
+	defs.insert(outTun->GetNameStr(0));
+      }
+    }
+  }
+}
+
+unsigned int VecRegResultLatencySlots(const LinElem *elem)
+{
+  if (!elem->IsNode()) {
+    return 0;
+  }
+  const Node *node = ((NodeLinElem*)elem)->m_node;
+  ClassType nodeClass = node->GetNodeClass();
+  CostModelOp op;
+  if (nodeClass == FMAdd::GetClass()) {
+    op = FMAOP;
+  } else if (nodeClass == Add::GetClass()) {
+    op = ADDOP;
+  } else if (nodeClass == Mul::GetClass()) {
+    op = MULOP;
+  } else {
+    return 0;
+  }
+  Type type = node->GetDataType();
+  Cost throughput = costModel->OpCost(op, type);
+  Cost latency = costModel->OpLatency(op, type);
+  if (throughput <= 0 || latency <= throughput) {
+    return VECARITHLATENCYSLOTS;
+  }
+  return (unsigned int) ceil(latency / throughput);
+}
+
+void LiveVecRegCounts(const Linearization &lin, vector<int> &counts)
+{
+  unsigned int numElems = lin.m_order.size();
+  std::map<string, unsigned int> firstDef;
+  std::map<string, unsigned int> lastUse;
+  for (unsigned int i = 0; i < numElems; ++i) {
+    StrSet uses, defs;
+    VecRegUsesAndDefs(lin.m_order[i], uses, defs);
+    for (auto name : uses) {
+      lastUse[name] = i;
+      // Registers coming in from outside this poss
+      // are live from its start
+      if (firstDef.find(name) == firstDef.end()) {
+	firstDef[name] = 0;
+      }
+    }
+    for (auto name : defs) {
+      if (firstDef.find(name) == firstDef.end()) {
+	firstDef[name] = i;
+      }
+      if (lastUse.find(name) == lastUse.end() || lastUse[name] < i) {
+	lastUse[name] = i;
+      }
+    }
+  }
+
+  counts.assign(numElems, 0);
+  for (auto def : firstDef) {
+    for (unsigned int i = def.second; i <= lastUse[def.first]; ++i) {
+      ++counts[i];
+    }
+  }
+}
+
+int MaxLiveVecRegs(const Linearization &lin)
+{
+  vector<int> counts;
+  LiveVecRegCounts(lin, counts);
+  int maxLive = 0;
+  for (auto count : counts) {
+    maxLive = max(maxLive, count);
+  }
+  return maxLive;
+}
+
+Cost VecRegSpillCost(const Linearization &lin)
+{
+  vector<int> counts;
+  LiveVecRegCounts(lin, counts);
+  int numRegs = arch->NumVecRegs();
+
+  // Every time the excess over the register file grows,
+  // one more register has to be stored and later reloaded
+  unsigned int numSpills = 0;
+  int prevExcess = 0;
+  const Node *regNode = NULL;
+  for (unsigned int i = 0; i < counts.size(); ++i) {
+    int excess = max(counts[i] - numRegs, 0);
+    if (excess > prevExcess) {
+      numSpills += excess - prevExcess;
+    }
+    prevExcess = excess;
+    if (!regNode && lin.m_order[i]->IsNode()) {
+      const Node *node = ((NodeLinElem*)(lin.m_order[i]))->m_node;
+      if (ProducesVecReg(node)) {
+	regNode = node;
+      }
+    }
+  }
+
+  if (!numSpills || !regNode) {
+    return 0;
+  }
+  Type type = regNode->GetDataType();
+  return numSpills * (costModel->OpCost(CONTIGSTOREOP, type)
+		      + costModel->OpCost(CONTIGLOADOP, type));
+}
+
+#endif // DOLLDLA
@@ -0,0 +1,52 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "linElem.h"
+#include "linearization.h"
+
+// Number of independent instructions to schedule between a
+// register arithmetic op and its consumer when the cost model
+// has no latency data
+#define VECARITHLATENCYSLOTS 4
+
+bool ProducesVecReg(const Node *node);
+bool IsVecRegConn(const Node *node, ConnNum num);
+
+// Names of the vector registers read and written by elem
+void VecRegUsesAndDefs(const LinElem *elem, StrSet &uses, StrSet &defs);
+// Number of scheduling slots until the register written by
+// elem can be consumed without stalling
+unsigned int VecRegResultLatencySlots(const LinElem *elem);
+
+// Number of vector registers live while each element of lin executes
+void LiveVecRegCounts(const Linearization &lin, vector<int> &counts);
+int MaxLiveVecRegs(const Linearization &lin);
+// Cost of the spill stores and reloads needed when more vector
+// registers are live than the architecture has
+Cost VecRegSpillCost(const Linearization &lin);
+
+#endif // DOLLDLA
@@ -30,6 +30,10 @@ string TypeToStr(Type type) {
     return "real_single_precision";
   case(REAL_DOUBLE):
     return "real_double_precision";
+  case(COMPLEX_SINGLE):
+    return "complex_single_precision";
+  case(COMPLEX_DOUBLE):
+    return "complex_double_precision";
   default:
     cout << "ERROR: Bad type in TypeToStr" << endl;
     LOG_FAIL("replacement for throw call");
@@ -50,14 +50,19 @@ void RuntimeEvaluator::WriteTestCodeToFile(string executableName, string testCod
 
 void RuntimeEvaluator::CompileTest(string executableName) {
   string testFileName = executableName + ".c";
+  string compileStr = arch->CompileString(executableName, testFileName);
+  if (numThreads > 1)
+    compileStr += " " + arch->OpenMPFlag();
   cout << "All implementations written to files\n";
-  cout << "Compile string is " << arch->CompileString(executableName, testFileName) << endl;
-  int compileRes = system(arch->CompileString(executableName, testFileName).c_str());
+  cout << "Compile string is " << compileStr << endl;
+  int compileRes = system(compileStr.c_str());
   cout << "Compile result = " << std::to_string((long long int) compileRes) << endl;
 }
 
 void RuntimeEvaluator::RunTest(string executableName) {
   string runStr = "./" + executableName;
+  if (numThreads > 1)
+    runStr = "OMP_NUM_THREADS=" + std::to_string((long long int) numThreads) + " " + runStr;
   int runRes = system(runStr.c_str());
   cout << "Run string is " << runStr << endl;
   cout << "Run result = " << std::to_string((long long int) runRes) << endl;
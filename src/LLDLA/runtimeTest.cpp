@@ -24,14 +24,17 @@
 #if DOLLDLA
 
 #include "avx.h"
+#include "streamingUtils.h"
 
 RuntimeTest::RuntimeTest(ProblemInstance* prob, LLDLAUniverse* uni, unsigned int minCycles) {
   m_type = prob->GetType();
+  m_tolerantSanityCheck = prob->ReordersArithmetic();
   m_operationName = prob->GetName();
   m_argNames = uni->m_argNames;
   m_outputNames = uni->m_outputNames;
   m_argDeclarations = uni->m_declarationVectors;
   m_defines = uni->m_constantDefines;
+  m_sizeVars = uni->m_sizeVars;
   m_minCycles = minCycles;
   m_dataFileName = m_operationName + "_time_data";
   m_correctTestFileName = m_operationName + "_correctness_test_results";
@@ -52,22 +55,56 @@ void RuntimeTest::AddMiscellaneousDefines()
 {
   m_defines.push_back("#define BUF_SIZE 1000000");
   m_defines.push_back("#define MIN_CYCLES " + std::to_string((long long int) m_minCycles));
+  m_defines.push_back("#define WARMUP_RUNS 10");
+  m_defines.push_back("#define MIN_SAMPLES 30");
+  m_defines.push_back("#define MAX_SAMPLES 10000");
+  m_defines.push_back("#define CI_CHECK_INTERVAL 10");
+  m_defines.push_back("#define CI_REL_WIDTH 0.02");
   m_defines.push_back("#define min(a,b) ((a) < (b) ? (a) : (b))");
-  m_defines.push_back("#define ALLOC_BUFFER(size) alloc_aligned_16((size))");
+  // Buffers have to keep the alignment promise the code was generated with
+  if (inputAlignment > 16) {
+    m_defines.push_back("#define ALLOC_BUFFER(size) alloc_aligned_32((size))");
+  } else {
+    m_defines.push_back("#define ALLOC_BUFFER(size) alloc_aligned_16((size))");
+  }
   m_defines.push_back("#define MUVALUE " + std::to_string((long long int) arch->VecRegWidth(m_type)) + "\n");
   m_defines.push_back(arch->VecRegTypeDec(m_type));
   if (m_type == REAL_SINGLE) {
     cout << "Datatype is real single\n";
     m_defines.push_back("#define NUM_SIZE sizeof(float)");
     m_defines.push_back("#define FILL_WITH_RAND_VALUES(size, buf) rand_floats((size), (buf))");
-    m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff_float((size), (b1), (b2), (test_name))");
+    if (m_tolerantSanityCheck) {
+      m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff_rel_float((size), (b1), (b2), 1e-4f, (test_name))");
+    } else {
+      m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff_float((size), (b1), (b2), (test_name))");
+    }
     m_defines.push_back("#define COPY_BUFFER(size, b1, b2) copy_buffer_float((size), (b1), (b2))");
   } else if (m_type == REAL_DOUBLE) {
     cout << "Datatype is real double\n";
     m_defines.push_back("#define NUM_SIZE sizeof(double)");
     m_defines.push_back("#define FILL_WITH_RAND_VALUES(size, buf) rand_doubles((size), (buf))");
-    m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff((size), (b1), (b2), (test_name))");
+    if (m_tolerantSanityCheck) {
+      m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff_rel((size), (b1), (b2), 1e-10, (test_name))");
+    } else {
+      m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff((size), (b1), (b2), (test_name))");
+    }
     m_defines.push_back("#define COPY_BUFFER(size, b1, b2) copy_buffer((size), (b1), (b2))");
+  } else if (m_type == COMPLEX_SINGLE) {
+    // Buffers are ALLOC_BUFFER(BUF_SIZE * sizeof(NUM_SIZE)) bytes, so complex
+    // buffers are filled and compared BUF_SIZE components at a time.
+    // Vectorized complex multiplies round differently from the C
+    // _Complex reference, so components are compared with a tolerance
+    cout << "Datatype is complex single\n";
+    m_defines.push_back("#define NUM_SIZE sizeof(float _Complex)");
+    m_defines.push_back("#define FILL_WITH_RAND_VALUES(size, buf) rand_floats((size), (float*) (buf))");
+    m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff_rel_float((size), (float*) (b1), (float*) (b2), 1e-4f, (test_name))");
+    m_defines.push_back("#define COPY_BUFFER(size, b1, b2) copy_buffer_float((size), (float*) (b1), (float*) (b2))");
+  } else if (m_type == COMPLEX_DOUBLE) {
+    cout << "Datatype is complex double\n";
+    m_defines.push_back("#define NUM_SIZE sizeof(double _Complex)");
+    m_defines.push_back("#define FILL_WITH_RAND_VALUES(size, buf) rand_doubles((size), (double*) (buf))");
+    m_defines.push_back("#define TEST_BUFFER_DIFF(size, b1, b2, test_name) test_buffer_diff_rel((size), (double*) (b1), (double*) (b2), 1e-10, (test_name))");
+    m_defines.push_back("#define COPY_BUFFER(size, b1, b2) copy_buffer((size), (double*) (b1), (double*) (b2))");
   } else {
     cout << "Error: Unsupported type for runtime test data\n";
     LOG_FAIL("replacement for throw call");
@@ -83,9 +120,39 @@ string RuntimeTest::HeadersAndDefines(unsigned int numImplementations) {
     cout << "EXTENSION NAME = " + ext->SetupFuncName() << endl;
     headersAndDefines += ext->GlobalDeclarations();
   }
+  if (sizeGeneric) {
+    headersAndDefines += SizeVariables();
+  }
   return headersAndDefines;
 }
 
+//Size-generic implementations read their sizes from globals.
+// set_sizes(shift) shrinks every size by shift so the sanity
+// checks reach each residual size, while strides stay the same
+string RuntimeTest::SizeVariables() {
+  string sizeVars = "\n";
+  string setSizes = "void set_sizes(int shift) {\n";
+  for (auto sizeVar : m_sizeVars) {
+    string size = std::to_string((long long int) sizeVar.second);
+    sizeVars += "unsigned int " + sizeVar.first + " = " + size + ";\n";
+    setSizes += "\t" + sizeVar.first + " = " + size + " > shift ? " + size + " - shift : " + size + ";\n";
+  }
+  setSizes += "}\n";
+  return sizeVars + setSizes;
+}
+
+string RuntimeTest::SizeSweep(string checks) {
+  string sweep = "\tint shift;\n";
+  sweep += "\tfor (shift = 0; shift < MUVALUE; shift++) {\n";
+  sweep += "\tset_sizes(shift);\n";
+  sweep += "\tprintf(\"Sizes shrunk by %d\\n\", shift);\n";
+  sweep += CopyArgBuffersTo("_ref") + "\n";
+  sweep += checks;
+  sweep += "\t}\n";
+  sweep += "\tset_sizes(0);\n";
+  return sweep;
+}
+
 string RuntimeTest::ImplementationFunctions(vector<pair<GraphNum, ImplInfo>>* imps, string referenceImp) {
   string refFuncName = m_operationName + "_test";
   string implementationFunctions = MakeImpFuncs(imps) + MakeFunc(refFuncName, referenceImp);
@@ -127,16 +194,26 @@ string RuntimeTest::SanityCheckBufferAllocation() {
 
 string RuntimeTest::OutputBufferSanityChecks(vector<pair<GraphNum, ImplInfo>>* imps, string referenceImpName) {
   auto argBufferAllocation = SanityCheckBufferAllocation();
-  string correctnessCheck = argBufferAllocation + CopyArgBuffersTo("_ref") + "\n";
-  correctnessCheck += OutputBufferCorrectnessCheck(imps, referenceImpName);
+  string correctnessCheck = argBufferAllocation;
+  if (sizeGeneric) {
+    correctnessCheck += SizeSweep(OutputBufferCorrectnessCheck(imps, referenceImpName));
+  } else {
+    correctnessCheck += CopyArgBuffersTo("_ref") + "\n";
+    correctnessCheck += OutputBufferCorrectnessCheck(imps, referenceImpName);
+  }
   correctnessCheck += "}\n";
   return correctnessCheck;
 }
 
 string RuntimeTest::AllBufferSanityChecks(vector<pair<GraphNum, ImplInfo>>* imps, string referenceImpName) {
   auto argBufferAllocation = SanityCheckBufferAllocation();
-  string correctnessCheck = argBufferAllocation + CopyArgBuffersTo("_ref") + "\n";
-  correctnessCheck += CorrectnessCheck(imps, referenceImpName);
+  string correctnessCheck = argBufferAllocation;
+  if (sizeGeneric) {
+    correctnessCheck += SizeSweep(CorrectnessCheck(imps, referenceImpName));
+  } else {
+    correctnessCheck += CopyArgBuffersTo("_ref") + "\n";
+    correctnessCheck += CorrectnessCheck(imps, referenceImpName);
+  }
   correctnessCheck += "}\n";
   return correctnessCheck;
 }
@@ -145,8 +222,10 @@ string RuntimeTest::TimingCode(TimingSetting timingSetting, vector<pair<GraphNum
   //  unsigned int numImpls = imps->size();
   if (timingSetting == ONEPHASETIMING) {
     return OnePhaseTimingCode(imps, operationName);
-  } else {
+  } else if (timingSetting == TWOPHASETIMING) {
     return TwoPhaseTimingCode(imps, operationName);
+  } else {
+    return AdaptiveTimingCode(imps, operationName);
   }
 }
 
@@ -185,6 +264,25 @@ string RuntimeTest::TwoPhaseTimingCode(vector<pair<GraphNum, ImplInfo>>* imps, s
   return timingFunc;
 }
 
+string RuntimeTest::AdaptiveTimingCode(vector<pair<GraphNum, ImplInfo>>* imps, string operationName) {
+  string prototype = "void time_implementations() {\n";
+  string argBufferAllocation = "\tprintf(\"Starting buffer allocation\\n\");\n";
+  argBufferAllocation += AllocateArgBuffers(m_argDeclarations, "") + "\n";
+  argBufferAllocation += FillBuffersWithRandValues(m_argNames, "") + "\n";
+  argBufferAllocation += "\tFILE *" + m_dataFileName + " = fopen(\"" + m_dataFileName + "\", \"w\");\n";
+  argBufferAllocation += "\tprintf(\"Done with allocation\\n\");\n";
+
+  string timingSetup = "\tint j, num_samples, rejected;\n\tlong long start_time, end_time, exec_time, total_cycles;\n";
+  timingSetup += "\tlong long ci_low, median, ci_high;\n";
+  timingSetup += "\tlong long best_median = -1, best_ci_high = -1;\n";
+  timingSetup += "\tstatic long long samples[MAX_SAMPLES], scratch[MAX_SAMPLES];\n";
+  string timingFunc = prototype + argBufferAllocation + "\n" + timingSetup;
+  string timingLoop = AdaptiveTimingLoops(imps);
+  timingLoop += "\n\tfclose(" + m_dataFileName + ");\n";
+  timingFunc += "\n" + timingLoop + "\n}\n";
+  return timingFunc;
+}
+
 string RuntimeTest::SetupFunction() {
   string decl = "void set_up_test() {\n";
   for (auto extension : *arch->SupportedExtensions()) {
@@ -340,6 +438,56 @@ string RuntimeTest::TwoPhaseTimingLoop(unsigned int i) {
   return loopBody;
 }
 
+string RuntimeTest::AdaptiveTimingLoops(vector<pair<GraphNum, ImplInfo>>* imps) {
+  string loopBody = "";
+  for (auto imp : *imps) {
+    loopBody += AdaptiveTimingLoop(imp.first);
+  }
+  return loopBody;
+}
+
+string RuntimeTest::AdaptiveTimingLoop(unsigned int i) {
+  string loopBody = "";
+  string opName = m_operationName + "_" + std::to_string((long long int) i);
+  string call = opName + "(" + CArgList(m_argNames) + ");\n";
+  loopBody += "\tfor (j = 0; j < WARMUP_RUNS; j++) {\n";
+  loopBody += "\t\t" + call;
+  loopBody += "\t}\n";
+  loopBody += "\ttotal_cycles = 0;\n";
+  loopBody += "\tnum_samples = 0;\n";
+  loopBody += "\trejected = 0;\n";
+  loopBody += "\twhile (num_samples < MAX_SAMPLES && total_cycles < MIN_CYCLES) {\n";
+  loopBody += "\t\tstart_time = rdtsc();\n";
+  loopBody += "\t\t" + call;
+  loopBody += "\t\tend_time = rdtsc();\n";
+  loopBody += "\t\texec_time = end_time - start_time;\n";
+  loopBody += "\t\tsamples[num_samples++] = exec_time;\n";
+  loopBody += "\t\ttotal_cycles += exec_time;\n";
+  loopBody += "\t\tif (num_samples >= MIN_SAMPLES && num_samples % CI_CHECK_INTERVAL == 0) {\n";
+  loopBody += "\t\t\tmedian_and_ci(num_samples, samples, scratch, &ci_low, &median, &ci_high);\n";
+  loopBody += "\t\t\tif (best_ci_high >= 0 && ci_low > best_ci_high) {\n";
+  loopBody += "\t\t\t\trejected = 1;\n";
+  loopBody += "\t\t\t\tbreak;\n";
+  loopBody += "\t\t\t}\n";
+  loopBody += "\t\t\tif (ci_high - ci_low <= CI_REL_WIDTH * median) {\n";
+  loopBody += "\t\t\t\tbreak;\n";
+  loopBody += "\t\t\t}\n";
+  loopBody += "\t\t}\n";
+  loopBody += "\t}\n";
+  loopBody += "\tmedian_and_ci(num_samples, samples, scratch, &ci_low, &median, &ci_high);\n";
+  loopBody += "\tif (!rejected && (best_median < 0 || median < best_median)) {\n";
+  loopBody += "\t\tbest_median = median;\n";
+  loopBody += "\t\tbest_ci_high = ci_high;\n";
+  loopBody += "\t}\n";
+  loopBody += "\tfor (j = 0; j < num_samples; j++) {\n";
+  loopBody += "\t\tfprintf(" + m_dataFileName + ", \"%lld\\n\", samples[j]);\n";
+  loopBody += "\t}\n";
+  loopBody += "\tfprintf(" + m_dataFileName + ", \"#\\n\");\n";
+  loopBody += "\tfprintf(" + m_dataFileName + ", \"%d\\n\", " + std::to_string((long long int) i) + ");\n";
+  loopBody += "\tprintf(\"Done evaluating " + opName + ": %d samples, median %lld%s\\n\", num_samples, median, rejected ? \" (rejected)\" : \"\");\n";
+  return loopBody;
+}
+
 string RuntimeTest::FillBuffersWithRandValues(const vector<string> argNames, string postfix) {
   std::vector<string> bufferFills;
   std::vector<string>::iterator argIter;
@@ -404,7 +552,7 @@ string RuntimeTest::MakeImpFuncs(vector<pair<GraphNum, ImplInfo>>* imps) {
 string RuntimeTest::MakeFunc(string funcName, string funcBody) {
   string funcDec = "void " + funcName;
   funcDec = funcDec + "(" + CArgList(m_argDeclarations) + ")" + "{\n";
-  funcDec = funcDec + funcBody + "return;\n}\n";
+  funcDec = funcDec + AddStreamStoreFence(funcBody) + "return;\n}\n";
   return funcDec;
 }
 
@@ -32,7 +32,11 @@
 using namespace std;
 
 enum SanityCheckSetting { CHECKALLBUFFERS, CHECKOUTPUTBUFFERS, NONE };
-enum TimingSetting { ONEPHASETIMING, TWOPHASETIMING };
+// ADAPTIVETIMING warms each implementation up, samples it until the
+// confidence interval on its median is tight, and races it against
+// the best implementation seen so far, dropping it once it is
+// clearly slower
+enum TimingSetting { ONEPHASETIMING, TWOPHASETIMING, ADAPTIVETIMING };
 
 class RuntimeTest {
  protected:
@@ -43,9 +47,11 @@ class RuntimeTest {
   string m_correctTestFileName;
   vector<string> m_operationArgs;
   vector<string> m_argDeclarations;
+  vector<pair<string, Size>> m_sizeVars;
 
   int m_chunkSize;
   Type m_type;
+  bool m_tolerantSanityCheck;
 
   string ToCStatements(vector<string> lines);
   string CArgList(vector<string> args);
@@ -61,8 +67,11 @@ class RuntimeTest {
   string SanityChecks(SanityCheckSetting sanityCheckSetting, vector<pair<GraphNum, ImplInfo>>* imps, string referenceImpName);
   string OnePhaseTimingCode(vector<pair<GraphNum, ImplInfo>>* imps, string operationName);
   string TwoPhaseTimingCode(vector<pair<GraphNum, ImplInfo>>* imps, string operationName);
+  string AdaptiveTimingCode(vector<pair<GraphNum, ImplInfo>>* imps, string operationName);
   string TimingCode(TimingSetting timingSetting, vector<pair<GraphNum, ImplInfo>>* imps, string operationName);
   string HeadersAndDefines(unsigned int numImplementations);
+  string SizeVariables();
+  string SizeSweep(string checks);
   string MakeFunc(string funcName, string funcBody);
   string CorrectnessCheck(vector<pair<GraphNum, ImplInfo>>* imps, string referenceImpName);
   string AllocateArgBuffers(const vector<string> args, string postfix);
@@ -74,6 +83,8 @@ class RuntimeTest {
   string TimingLoops(vector<pair<GraphNum, ImplInfo>>* imps);
   string TwoPhaseTimingLoop(unsigned int i);
   string TwoPhaseTimingLoops(vector<pair<GraphNum, ImplInfo>>* imps);
+  string AdaptiveTimingLoop(unsigned int i);
+  string AdaptiveTimingLoops(vector<pair<GraphNum, ImplInfo>>* imps);
   void AddIncludes();
   void AddMiscellaneousDefines();
 
@@ -29,7 +29,7 @@ void AddScalars::Prop()
 {
   if (!IsValidCost(m_cost)) {
     DLAOp<2, 1>::Prop();
-    m_cost = costModel->ContigVecLoadCost() + costModel->ContigVecStoreCost();
+    m_cost = costModel->ContigVecLoadCost(GetDataType()) + costModel->ContigVecStoreCost(GetDataType());
   }
 }
 
@@ -46,7 +46,7 @@ void MulScalars::Prop()
 {
   if (!IsValidCost(m_cost)) {
     DLAOp<2, 1>::Prop();
-    m_cost = costModel->ContigVecLoadCost() + costModel->ContigVecStoreCost();
+    m_cost = costModel->ContigVecLoadCost(GetDataType()) + costModel->ContigVecStoreCost(GetDataType());
   }
 }
 
@@ -59,11 +59,28 @@ void MulScalars::PrintCode(IndStream &out)
   return;
 }
 
+void DivScalars::Prop()
+{
+  if (!IsValidCost(m_cost)) {
+    DLAOp<2, 1>::Prop();
+    m_cost = costModel->ContigVecLoadCost(GetDataType()) + costModel->ContigVecStoreCost(GetDataType());
+  }
+}
+
+void DivScalars::PrintCode(IndStream &out)
+{
+  out.Indent();
+  string aStr = GetInputNameStr(0);
+  string bStr = GetInputNameStr(1);
+  *out << "*" << bStr << " = *" << bStr << " / *" << aStr << ";\n";
+  return;
+}
+
 void SetScalarToZero::Prop()
 {
   if (!IsValidCost(m_cost)) {
     DLAOp<1, 1>::Prop();
-    m_cost = costModel->ContigVecStoreCost();
+    m_cost = costModel->ContigVecStoreCost(GetDataType());
   }
   return;
 }
@@ -59,6 +59,23 @@ class MulScalars : public DLAOp<2, 1>
   virtual bool IsDataDependencyOfInput() const { return true; }
 };
 
+// Computes b = b / a
+class DivScalars : public DLAOp<2, 1>
+{
+ public:
+  virtual NodeType GetType() const { return "DivScalars"; }
+  static Node* BlankInst() { return new DivScalars(); }
+  virtual Node* GetNewInst() { return BlankInst(); }
+
+  virtual void Prop();
+  virtual void PrintCode(IndStream &out);
+  virtual ClassType GetNodeClass() const { return GetClass(); }
+  static ClassType GetClass() { return "DivScalars"; }
+
+  virtual bool IsReadOnly() const { return false; }
+  virtual bool IsDataDependencyOfInput() const { return true; }
+};
+
 class SetScalarToZero : public DLAOp<1, 1>
 {
  public:
@@ -36,30 +36,62 @@ void ScalarConstant::Prop() {
 }
 
 void ScalarConstant::PrintCode(IndStream& out) {
-  Type dataType = m_dataTypeInfo.m_type;
+  // The declaration is hoisted by AddVariables so that copies of
+  // this node (e.g., in an unrolled loop body) do not redeclare it
+  out.Indent();
+  *out << m_varName.m_name << "[0] = " << std::to_string((long double) m_value) << ";\n";
+
+  return;
+}
+
+void ScalarConstant::AddVariables(VarSet& set) const {
   string typeName;
-  string varName = m_varName.m_name;
-  string byteArray = varName + "_name";
-  if (dataType == REAL_SINGLE) {
+  if (m_dataTypeInfo.m_type == REAL_SINGLE) {
     typeName = "float ";
   } else {
     typeName = "double ";
   }
+  string varDecl = typeName + m_varName.m_name + "[1];";
+  Var var(DirectVarDeclType, varDecl, m_dataTypeInfo.m_type);
+  set.insert(var);
+  return;
+}
 
-  out.Indent();
-  *out << typeName << " " << varName << "[1];\n";
-  out.Indent();
-  *out << varName << "[0] = " << std::to_string((long double) m_value) << ";\n";
+void ScalarConstant::Duplicate(const Node *orig, bool shallow, bool possMerging) {
+  LocalInput::Duplicate(orig, shallow, possMerging);
+  const ScalarConstant *constant = static_cast<const ScalarConstant*>(orig);
+  m_value = constant->m_value;
+}
 
-  return;
+// A constant created inside of a loop body has one size
+// per execution of the body, just like the body's tunnels
+const SizeList* ScalarConstant::SizesInPoss() const {
+  unsigned int numExecs = 1;
+  if (m_poss && !m_poss->m_inTuns.empty()) {
+    const DLANode *tun = static_cast<const DLANode*>(m_poss->InTun(0));
+    numExecs = tun->GetM(0)->NumSizes();
+  }
+  return SizeList::M_cache.GetCachedRepeatedSize(1, numExecs);
 }
 
-void ScalarConstant::AddVariables(VarSet& set) const {
-  return;
+const SizeList* ScalarConstant::GetM(ConnNum num) const {
+  if (num > 0) {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  return SizesInPoss();
+}
+
+const SizeList* ScalarConstant::GetN(ConnNum num) const {
+  if (num > 0) {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  return SizesInPoss();
 }
 
 NodeType ScalarConstant::GetType() const {
-  return "Scalar constant " + LayerNumToStr(GetLayer());
+  return "Scalar constant " + std::to_string((long double) m_value) + " " + LayerNumToStr(GetLayer());
 }
 
 
@@ -28,6 +28,8 @@ class ScalarConstant : public LocalInput
  protected:
   double m_value;
 
+  const SizeList* SizesInPoss() const;
+
  public:
   ScalarConstant(string name, Type dataType, double value);
   virtual void Prop();
@@ -37,11 +39,15 @@ class ScalarConstant : public LocalInput
   static ClassType GetClass() {return "scalarConstant";}
   static Node* BlankInst() { return new ScalarConstant("", REAL_SINGLE, 0); }
   virtual Node* GetNewInst() { return BlankInst(); }
+  virtual void Duplicate(const Node *orig, bool shallow, bool possMerging);
 
   virtual NodeType GetType() const;
 
   virtual void AddVariables(VarSet& set) const;
 
+  virtual const SizeList* GetM(ConnNum num) const;
+  virtual const SizeList* GetN(ConnNum num) const;
+
 };
 
 #endif // DOLLDLA
@@ -0,0 +1,98 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sizeGeneric.h"
+
+#if DOLLDLA
+
+#include <fstream>
+
+#include "kernelLibrary.h"
+#include "streamingUtils.h"
+
+static bool SizeGenericDimensionOK(int value, int mu) {
+  return value == 1 || (value > 2 * mu && value % mu != 0);
+}
+
+bool SizeGenericDimensionsOK(Type type, const vector<int> &dimValues) {
+  int mu = arch->VecRegWidth(type);
+  for (auto value : dimValues) {
+    if (!SizeGenericDimensionOK(value, mu)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CheckSizeGenericDimensions(ProblemInstance* problemInstance) {
+  int mu = arch->VecRegWidth(problemInstance->GetType());
+  auto dimNames = problemInstance->DimensionNames();
+  auto dimValues = problemInstance->DimensionValues();
+  for (unsigned int i = 0; i < dimValues->size(); i++) {
+    int value = (*dimValues)[i];
+    if (!SizeGenericDimensionOK(value, mu)) {
+      cout << "ERROR: size-generic search with " << *(*dimNames)[i] << " = " << value
+	   << ", pick a size above " << 2 * mu << " that is not a multiple of " << mu << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    delete (*dimNames)[i];
+  }
+  delete dimNames;
+  delete dimValues;
+}
+
+void ExportSizeGenericKernel(string dirName, ProblemInstance* problemInstance, LLDLAUniverse* uni, string implStr) {
+  Type type = problemInstance->GetType();
+  string fileName = dirName + "/" + problemInstance->GetName() + "_generic.c";
+  std::ofstream outStream(fileName);
+  if (!outStream.is_open()) {
+    cout << "ERROR: could not create file " << fileName << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+
+  outStream << "#include <immintrin.h>\n";
+  outStream << "#include <string.h>\n\n";
+  outStream << "//Every operand has to be aligned to " << inputAlignment << " bytes\n";
+  outStream << "#define MUVALUE " << arch->VecRegWidth(type) << "\n";
+  outStream << "#define min(a,b) ((a) < (b) ? (a) : (b))\n";
+  outStream << arch->VecRegTypeDec(type) << "\n";
+  for (auto ext : *arch->SupportedExtensions()) {
+    outStream << ext->GlobalDeclarations();
+  }
+
+  outStream << RuntimeHelperFunctions(implStr);
+
+  outStream << "void " << problemInstance->GetName() << "(";
+  for (unsigned int i = 0; i < uni->m_kernelArgDeclarations.size(); i++) {
+    if (i > 0) {
+      outStream << ", ";
+    }
+    outStream << uni->m_kernelArgDeclarations[i];
+  }
+  outStream << ") {\n" << AddStreamStoreFence(implStr) << "return;\n}\n";
+  outStream.close();
+
+  cout << "Wrote size-generic kernel to " << fileName << endl;
+}
+
+#endif // DOLLDLA
@@ -0,0 +1,47 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIZE_GENERIC_H_
+#define SIZE_GENERIC_H_
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "lldlaUniverse.h"
+#include "problemInstance.h"
+
+//A size-generic search only produces residual code for dimensions
+// that have a residual, and only produces loops for dimensions big
+// enough to need one, so it refuses sizes that give neither rather
+// than pick a kernel whose residue code was never checked or timed
+void CheckSizeGenericDimensions(ProblemInstance* problemInstance);
+
+//False when CheckSizeGenericDimensions would refuse the sizes
+bool SizeGenericDimensionsOK(Type type, const vector<int> &dimValues);
+
+//Writes implStr to dirName as a C function named after the problem
+// whose sizes and strides are arguments
+void ExportSizeGenericKernel(string dirName, ProblemInstance* problemInstance, LLDLAUniverse* uni, string implStr);
+
+#endif // DOLLDLA
+
+#endif // SIZE_GENERIC_H_
@@ -40,6 +40,12 @@ void SMMul::PrintCode(IndStream &out)
     } else if (GetDataType() == REAL_SINGLE) {
       out.Indent();
       *out << "simple_smul_float( ";
+    } else if (GetDataType() == COMPLEX_DOUBLE) {
+      out.Indent();
+      *out << "simple_smul_complex( ";
+    } else if (GetDataType() == COMPLEX_SINGLE) {
+      out.Indent();
+      *out << "simple_smul_complex_float( ";
     }
     *out << InputDataType(1).m_numRowsVar << ", " <<
       InputDataType(1).m_numColsVar << ", " <<
@@ -119,6 +125,9 @@ void SMMul::Prop()
 
     if (m_layer == ABSLAYER) {
       m_cost = GetInputM(1)->SumProds11(*GetInputN(1));
+      if (IsComplex(GetDataType())) {
+	m_cost *= COMPLEXMULFLOPS;
+      }
     } else {
       m_cost = ZERO;
     }
@@ -0,0 +1,56 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "storeToStreamStore.h"
+
+#if DOLLDLA
+
+#include "costModel.h"
+#include "streamStoreFromRegs.h"
+#include "streamingUtils.h"
+
+bool StoreToStreamStore::CanApply(const Node* node) const {
+  if (node->GetNodeClass() != StoreFromRegs::GetClass()) {
+    cout << "ERROR: Applying StoreToStreamStore to non StoreFromRegs node" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  if (costModel->WorkingSetBytes() <= arch->L2Bytes()) {
+    return false;
+  }
+  auto store = static_cast<const StoreFromRegs*>(node);
+  return store->IsContiguousStore() && IsStreamingAccess(store, 1);
+}
+
+void StoreToStreamStore::Apply(Node* node) const {
+  auto streamStore = new StreamStoreFromRegs();
+  streamStore->AddInputs(4,
+			 node->Input(0), node->InputConnNum(0),
+			 node->Input(1), node->InputConnNum(1));
+
+  node->RedirectChildren(streamStore, 0);
+
+  node->m_poss->AddNode(streamStore);
+  node->m_poss->DeleteChildAndCleanUp(node);
+  return;
+}
+
+#endif // DOLLDLA
@@ -0,0 +1,45 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "streamStoreFromRegs.h"
+
+#if DOLLDLA
+
+#include "costModel.h"
+
+void StreamStoreFromRegs::Prop() {
+  if (!IsValidCost(m_cost)) {
+    DLAOp<2,1>::Prop();
+    if (!IsContiguousStore()) {
+      cout << "ERROR: Streaming stores must be contiguous" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
+    }
+    m_cost = costModel->StreamStoreCost(GetDataType());
+  }
+}
+
+void StreamStoreFromRegs::PrintCode(IndStream &out) {
+  out.Indent();
+  *out << arch->StreamStore(GetDataType(), GetInputNameStr(1), GetInputNameStr(0), InputIsVecRegAligned(1));
+}
+
+#endif // DOLLDLA
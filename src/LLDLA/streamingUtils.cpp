@@ -0,0 +1,61 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "streamingUtils.h"
+
+#if DOLLDLA
+
+#include "loopSupport.h"
+
+//Every streaming store intrinsic has this in its name
+#define STREAMSTOREINFIX "_stream_"
+
+bool IsStreamingAccess(const DLANode* node, ConnNum num) {
+  bool isColVector = node->IsInputColVector(num);
+  const Node* input = node->Input(num);
+  ConnNum inputNum = node->InputConnNum(num);
+  while (input->IsTunnel() && input->GetNodeClass() != SplitSingleIter::GetClass()) {
+    inputNum = input->InputConnNum(0);
+    input = input->Input(0);
+  }
+  if (input->GetNodeClass() != SplitSingleIter::GetClass() || inputNum != 1) {
+    return false;
+  }
+
+  auto split = static_cast<const SplitSingleIter*>(input);
+  if (split->GetMyLoop()->GetType() != LLDLALOOP) {
+    return false;
+  }
+  if (isColVector) {
+    return split->m_dir == PARTDOWN;
+  } else {
+    return split->m_dir == PARTRIGHT;
+  }
+}
+
+string AddStreamStoreFence(string implStr) {
+  if (implStr.find(STREAMSTOREINFIX) == string::npos) {
+    return implStr;
+  }
+  return implStr + arch->StoreFence();
+}
+
+#endif // DOLLDLA
@@ -0,0 +1,42 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STREAMING_UTILS_H_
+#define STREAMING_UTILS_H_
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "DLANode.h"
+
+//True if input num of node is the current block of a forward LLDLA
+// loop that splits the operand in the direction the vector runs, so
+// every iteration touches the memory just past the last one
+bool IsStreamingAccess(const DLANode* node, ConnNum num);
+
+//Streaming stores are weakly ordered, so a kernel that uses them
+// fences before returning to make its output visible to other cores
+string AddStreamStoreFence(string implStr);
+
+#endif // DOLLDLA
+
+#endif // STREAMING_UTILS_H_
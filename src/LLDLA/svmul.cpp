@@ -53,6 +53,10 @@ void SVMul::PrintCode(IndStream &out)
       *out << "simple_smul( ";
     } else if (GetDataType() == REAL_SINGLE) {
       *out << "simple_smul_float( ";
+    } else if (GetDataType() == COMPLEX_DOUBLE) {
+      *out << "simple_smul_complex( ";
+    } else if (GetDataType() == COMPLEX_SINGLE) {
+      *out << "simple_smul_complex_float( ";
     }
     if (GetVecType() == COLVECTOR) {
       *out << InputDataType(1).m_numRowsVar << ", " <<
@@ -160,6 +164,9 @@ void SVMul::Prop()
       } else {
 	m_cost = GetInputM(1)->Sum();
       }
+      if (IsComplex(GetDataType())) {
+	m_cost *= COMPLEXMULFLOPS;
+      }
     } else {
       m_cost = ZERO;
     }
@@ -306,6 +313,10 @@ void SVMulLoopRef::Apply(Node *node) const
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuSingle);
   } else if (svmul->GetDataType() == REAL_DOUBLE) {
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuDouble);
+  } else if (svmul->GetDataType() == COMPLEX_SINGLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexSingle);
+  } else if (svmul->GetDataType() == COMPLEX_DOUBLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexDouble);
   } else {
     cout << "Error: Bad data type in vadd apply\n";
     LOG_FAIL("replacement for throw call");
@@ -458,6 +469,10 @@ void SVMulToRegArith::Apply(Node* node) const
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuSingle);
   } else if (svmul->GetDataType() == REAL_DOUBLE) {
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuDouble);
+  } else if (svmul->GetDataType() == COMPLEX_SINGLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexSingle);
+  } else if (svmul->GetDataType() == COMPLEX_DOUBLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexDouble);
   } else {
     cout << "Error: Bad data type in vadd apply\n";
     LOG_FAIL("replacement for throw call");
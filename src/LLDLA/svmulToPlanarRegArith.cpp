@@ -0,0 +1,132 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "svmulToPlanarRegArith.h"
+
+#if DOLLDLA
+
+#include "planarRegs.h"
+
+SVMulToPlanarRegArith::SVMulToPlanarRegArith(Layer fromLayer, Layer toLayer, VecType vecType)
+{
+  m_fromLayer = fromLayer;
+  m_toLayer = toLayer;
+  m_vecType = vecType;
+}
+
+string SVMulToPlanarRegArith::GetType() const
+{
+  if (m_vecType == ROWVECTOR) {
+    return "SVMul planar register arith - Row vector " + LayerNumToStr(m_fromLayer)
+      + " to " + LayerNumToStr(m_toLayer);
+  } else {
+    return "SVMul planar register arith - Col vector " + LayerNumToStr(m_fromLayer)
+      + " to " + LayerNumToStr(m_toLayer);
+  }
+}
+
+bool SVMulToPlanarRegArith::CanApply(const Node* node) const
+{
+  if (node->GetNodeClass() != SVMul::GetClass()) {
+    cout << "ERROR: Trying to apply SVMulToPlanarRegArith to non SVMul node" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  const SVMul* svmul = static_cast<const SVMul*>(node);
+  if (svmul->GetLayer() != m_fromLayer
+      || svmul->GetVecType() != m_vecType
+      || !IsComplex(svmul->GetDataType())) {
+    return false;
+  }
+  int width = arch->PlanarVecRegWidth(svmul->GetDataType());
+  if (m_vecType == COLVECTOR) {
+    return svmul->GetInputM(1)->EvenlyDivisibleBy(width);
+  } else {
+    return svmul->GetInputN(1)->EvenlyDivisibleBy(width);
+  }
+}
+
+void SVMulToPlanarRegArith::Apply(Node* node) const
+{
+  SVMul* svmul = static_cast<SVMul*>(node);
+
+  // Split up the input vector
+  SplitSingleIter* splitVec;
+  if (m_vecType == ROWVECTOR) {
+    splitVec = new SplitSingleIter(PARTRIGHT, POSSTUNIN, true);
+  } else {
+    splitVec = new SplitSingleIter(PARTDOWN, POSSTUNIN, true);
+  }
+
+  splitVec->AddInput(svmul->Input(1), svmul->InputConnNum(1));
+
+  if (m_vecType == ROWVECTOR) {
+    splitVec->SetUpStats(FULLUP, NOTUP,
+			  FULLUP, NOTUP);
+  } else {
+    splitVec->SetUpStats(FULLUP, FULLUP,
+			  NOTUP, NOTUP);
+  }
+
+  // Broadcast the real and imaginary parts of the scalar outside of the loop
+  PlanarDuplicateRegLoad* dup = new PlanarDuplicateRegLoad();
+  dup->AddInput(svmul->Input(0), svmul->InputConnNum(0));
+
+  node->m_poss->AddNode(dup);
+
+  LoopTunnel* scalarTun = new LoopTunnel(POSSTUNIN);
+  scalarTun->AddInput(dup, 0);
+  scalarTun->SetAllStats(FULLUP);
+
+  PlanarLoadToRegs* loadA = new PlanarLoadToRegs();
+  loadA->AddInput(splitVec, 1);
+
+  PlanarMul* mul = new PlanarMul();
+  mul->AddInput(scalarTun, 0);
+  mul->AddInput(loadA, 0);
+
+  PlanarStoreFromRegs* storeVec = new PlanarStoreFromRegs();
+  storeVec->AddInput(mul, 0);
+  storeVec->AddInput(splitVec, 1);
+
+  LoopTunnel* scalarOut = new LoopTunnel(POSSTUNOUT);
+  scalarOut->AddInput(scalarTun, 0);
+  scalarOut->AddInput(scalarTun, 1);
+  scalarOut->CopyTunnelInfo(scalarTun);
+
+  CombineSingleIter* combineVec = splitVec->CreateMatchingCombine(1, 1, storeVec, 0);
+
+  Poss* loopPoss = new Poss(2, combineVec, scalarOut);
+
+  // Each iteration covers two complex vector registers worth of elements
+  RealLoop* loop;
+  if (svmul->GetDataType() == COMPLEX_SINGLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, BSSize(USELLDLAMUCOMPLEXSINGLE, 2));
+  } else {
+    loop = new RealLoop(LLDLALOOP, loopPoss, BSSize(USELLDLAMUCOMPLEXDOUBLE, 2));
+  }
+
+  node->m_poss->AddPSet(loop);
+  node->RedirectChildren(loop->OutTun(0), 0);
+  node->m_poss->DeleteChildAndCleanUp(node);
+}
+
+#endif // DOLLDLA
@@ -0,0 +1,48 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "LLDLA.h"
+
+#if DOLLDLA
+
+#include "svmul.h"
+#include "transform.h"
+
+// Implements a complex SVMul with planar registers: the scalar is
+// broadcast into a planar register once, outside of the loop, and the
+// loop body deinterleaves 2 * mu elements, multiplies them without
+// shuffles and interleaves them back on the store
+class SVMulToPlanarRegArith : public SingleTrans
+{
+ public:
+  Layer m_fromLayer, m_toLayer;
+  VecType m_vecType;
+
+  SVMulToPlanarRegArith(Layer fromLayer, Layer toLayer, VecType vecType);
+  virtual string GetType() const;
+  virtual bool CanApply(const Node* node) const;
+  virtual void Apply(Node* node) const;
+  virtual bool IsRef() const { return true; }
+};
+
+#endif // DOLLDLA
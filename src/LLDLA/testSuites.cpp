@@ -23,10 +23,32 @@
 
 #if DOLLDLA
 
+#include "blasExamples.h"
 #include "problemInstance.h"
 #include "problemRunner.h"
 #include "singleOperationExamples.h"
 
+//Fails unless at least one implementation in uni contains code, and
+// not excluded when it is given, so each transformation's test checks
+// that it actually fires.  The universe owns the start set, so
+// deleting it frees both
+void CheckSomeImplementationContains(LLDLAUniverse* uni, string problemName, string code, string excluded = "") {
+  auto impMap = uni->ImpStrMap(false, 0);
+  for (auto &imp : *impMap) {
+    if (imp.second.str.find(code) != string::npos
+	&& (excluded.empty() || imp.second.str.find(excluded) == string::npos)) {
+      return;
+    }
+  }
+  cout << "ERROR: no implementation of " << problemName << " contains " << code;
+  if (!excluded.empty()) {
+    cout << " without " << excluded;
+  }
+  cout << endl;
+  LOG_FAIL("replacement for throw call");
+  throw;
+}
+
 void RunSimpleSDotProductNoRuntimeEval() {
   int simpleSize = 128;
   Type singlePrec = REAL_SINGLE;
@@ -61,14 +83,140 @@ void RunUnevenSizeMatrixAdd() {
   delete matProb;
 }
 
+//K is two KC cache blocks, so Gemm gets a cache block loop over K
+// and A's block inside it is packed
+void RunPackedPanelGemm() {
+  Type dFloat = REAL_DOUBLE;
+  int mSize = 8;
+  int nSize = 8;
+  int pSize = 2 * arch->KCBlockSize(dFloat);
+  RealPSet* gemm = GemmTest(dFloat, NORMAL, NORMAL, mSize, nSize, pSize);
+  ProblemInstance gemmInst;
+  gemmInst.SetName("double_precision_packed_gemm");
+  gemmInst.SetType(dFloat);
+  gemmInst.AddDimension(mSize, "m");
+  gemmInst.AddDimension(nSize, "n");
+  gemmInst.AddDimension(pSize, "p");
+  auto uni = RunProblem(1, gemm, &gemmInst);
+  CheckSomeImplementationContains(uni, gemmInst.GetName(), "_packed");
+  delete uni;
+}
+
+//At least one implementation replaces the call to simple_trsml with
+// AVX register code
+void RunVectorizedTRSML() {
+  Type dFloat = REAL_DOUBLE;
+  int size = arch->VecRegWidth(dFloat);
+  RealPSet* trsml = TRSMLTest(dFloat, size, size);
+  ProblemInstance trsmlInst;
+  trsmlInst.SetName("double_precision_trsml");
+  trsmlInst.SetType(dFloat);
+  trsmlInst.AddDimension(size, "m");
+  trsmlInst.AddDimension(size, "n");
+  trsmlInst.SetReordersArithmetic(true);
+  auto uni = RunProblem(1, trsml, &trsmlInst);
+  CheckSomeImplementationContains(uni, trsmlInst.GetName(), "_mm256_", "simple_trsml");
+  delete uni;
+}
+
+//With more than one thread, MAdd's loops have independent
+// iterations, so one of them runs as an OpenMP parallel for
+void RunParallelMAdd() {
+  Type dFloat = REAL_DOUBLE;
+  int mSize = 4 * arch->VecRegWidth(dFloat);
+  int nSize = 4 * arch->VecRegWidth(dFloat);
+  unsigned int wasNumThreads = numThreads;
+  numThreads = 2;
+  RealPSet* madd = MAddTest(dFloat, mSize, nSize);
+  ProblemInstance maddInst;
+  maddInst.SetName("double_precision_parallel_madd");
+  maddInst.SetType(dFloat);
+  maddInst.AddDimension(mSize, "m");
+  maddInst.AddDimension(nSize, "n");
+  auto uni = RunProblem(1, madd, &maddInst);
+  CheckSomeImplementationContains(uni, maddInst.GetName(), "#pragma omp parallel for");
+  delete uni;
+  numThreads = wasNumThreads;
+}
+
 void RunMatrixExamplesNoRTE() {
   RunUnevenSizeMatrixAdd();
+  RunPackedPanelGemm();
+  RunVectorizedTRSML();
+  RunParallelMAdd();
+}
+
+//The residue of a size-generic kernel is picked by a switch on the
+// runtime length
+void RunSizeGenericSVMul() {
+  Type dFloat = REAL_DOUBLE;
+  int mSize = 2 * arch->VecRegWidth(dFloat) + 3;
+  bool wasSizeGeneric = sizeGeneric;
+  sizeGeneric = true;
+  RealPSet* svmul = SVMulTest(dFloat, COLVECTOR, mSize);
+  ProblemInstance svmulInst;
+  svmulInst.SetName("double_precision_size_generic_svmul");
+  svmulInst.SetType(dFloat);
+  svmulInst.AddDimension(mSize, "m");
+  auto uni = RunProblem(1, svmul, &svmulInst);
+  CheckSomeImplementationContains(uni, svmulInst.GetName(), "switch (");
+  delete uni;
+  sizeGeneric = wasSizeGeneric;
+}
+
+//Inputs only aligned to an element get a peeled head whose length
+// comes from the output's address
+void RunPeeledVAdd() {
+  Type dFloat = REAL_DOUBLE;
+  int mSize = 2 * arch->VecRegWidth(dFloat) + 3;
+  bool wasSizeGeneric = sizeGeneric;
+  unsigned int wasInputAlignment = inputAlignment;
+  sizeGeneric = true;
+  inputAlignment = arch->ElemBytes(dFloat);
+  RealPSet* vadd = VAddTest(dFloat, COLVECTOR, mSize);
+  ProblemInstance vaddInst;
+  vaddInst.SetName("double_precision_peeled_vadd");
+  vaddInst.SetType(dFloat);
+  vaddInst.AddDimension(mSize, "m");
+  auto uni = RunProblem(1, vadd, &vaddInst);
+  CheckSomeImplementationContains(uni, vaddInst.GetName(), "(size_t)");
+  delete uni;
+  sizeGeneric = wasSizeGeneric;
+  inputAlignment = wasInputAlignment;
+}
+
+void RunSizeGenericExamplesNoRTE() {
+  RunSizeGenericSVMul();
+  RunPeeledVAdd();
+}
+
+//Both the interleaved layout, which multiplies with fmaddsub, and the
+// planar layout, which splits real and imaginary parts into separate
+// registers, are searched
+void RunComplexSVMul() {
+  Type zFloat = COMPLEX_DOUBLE;
+  int mSize = 24;
+  RealPSet* svmul = SVMulTest(zFloat, COLVECTOR, mSize);
+  ProblemInstance svmulInst;
+  svmulInst.SetName("complex_double_svmul");
+  svmulInst.SetType(zFloat);
+  svmulInst.AddDimension(mSize, "m");
+  auto uni = RunProblem(1, svmul, &svmulInst);
+  CheckSomeImplementationContains(uni, svmulInst.GetName(), "_mm256_fmaddsub_pd");
+  CheckSomeImplementationContains(uni, svmulInst.GetName(), "zvec_planar_reg");
+  delete uni;
+}
+
+void RunComplexExamplesNoRTE() {
+  RunComplexSVMul();
 }
 
 void BasicNoRuntimeEvalTests() {
   cout << "Running several examples with no rutime evaluation" << endl;
   RunVectorExamplesNoRuntimeEval();
   RunMatrixExamplesNoRTE();
+  RunSizeGenericExamplesNoRTE();
+  RunComplexExamplesNoRTE();
   cout << "Done" << endl;
   return;
 }
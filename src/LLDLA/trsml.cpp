@@ -23,15 +23,47 @@
 
 #if DOLLDLA
 
+#include "mmul.h"
+#include "partition.h"
+#include "recombine.h"
+#include "scalarArith.h"
+#include "scalarConstant.h"
+#include "smmul.h"
+#include "svmul.h"
+#include "uniqueNameSource.h"
+#include "vmmul.h"
+#include "vrwSVMulToRegArith.h"
+
+TRSML::TRSML(Layer layer)
+  : m_negatedRHS(false)
+{
+  SetLayer(layer);
+}
+
+TRSML::TRSML(Layer layer, bool negatedRHS)
+  : m_negatedRHS(negatedRHS)
+{
+  SetLayer(layer);
+}
+
 void TRSML::PrintCode(IndStream& out) {
+  if (m_negatedRHS) {
+    cout << "Error: No code for TRSML with a negated right hand side" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
   out.Indent();
   if (GetDataType() == REAL_DOUBLE) {
     *out << "simple_trsml(";
+  } else if (GetDataType() == REAL_SINGLE) {
+    *out << "simple_trsml_float(";
   } else {
+    cout << "Error: Bad data type in TRSML::PrintCode" << endl;
+    LOG_FAIL("replacement for throw call");
     throw;
   }
   *out << InputDataType(0).m_numRowsVar << ", " <<
-    InputDataType(0).m_numColsVar << ", " <<
+    InputDataType(1).m_numColsVar << ", " <<
     GetInputName(0).str() << ", " <<
     InputDataType(0).m_rowStrideVar << ", " <<
     InputDataType(0).m_colStrideVar << ", " <<
@@ -42,20 +74,24 @@ void TRSML::PrintCode(IndStream& out) {
 }
 
 void TRSML::SanityCheckInputDimensions() {
-  if (GetInputNumRows(0) != GetInputNumCols(0)) {
-    LOG_FAIL("Bad dimensions in TRSML");
+  if (*GetInputM(0) != *GetInputN(0)) {
+    cout << "Error: TRSML L is not square" << endl;
+    LOG_FAIL("replacement for throw call");
     throw;
   }
-  if (GetInputNumRows(0) != GetInputNumRows(1)) {
-    LOG_FAIL("Bad dimensions in TRSML");
+  if (*GetInputM(0) != *GetInputM(1)) {
+    cout << "Error: TRSML L and B have different numbers of rows" << endl;
+    LOG_FAIL("replacement for throw call");
     throw;
   }
 }
 
 void TRSML::Prop() {
   if (!IsValidCost(m_cost)) {
+    DLAOp<2, 1>::Prop();
     SanityCheckInputDimensions();
-    m_cost = ZERO;
+    // m^2 * n flops
+    m_cost = GetInputM(1)->SumProds21(*GetInputN(1));
   }
 }
 
@@ -75,15 +111,335 @@ Phase TRSML::MaxPhase() const {
 }
 
 Node* TRSML::BlankInst() {
-  throw;
+  return new TRSML(ABSLAYER);
 }
 
 void TRSML::Duplicate(const Node* orig, bool shallow, bool possMerging) {
-  throw;
+  DLAOp<2, 1>::Duplicate(orig, shallow, possMerging);
+  const TRSML *trsml = static_cast<const TRSML*>(orig);
+  m_negatedRHS = trsml->m_negatedRHS;
 }
 
 NodeType TRSML::GetType() const {
-  return "TRSML";
+  return "TRSML" + LayerNumToStr(GetLayer()) + (m_negatedRHS ? " negated" : "");
+}
+
+// Panels of B that are a multiple of mu wide are left to
+// TRSMLLoopExp so that the other refinements only see
+// panels that fit in a vector register
+static bool ShouldLoopOverN(const TRSML *trsml)
+{
+  int mu = trsml->GetVecRegWidth();
+  return *(trsml->GetInputN(1)) > mu
+    && trsml->GetInputN(1)->EvenlyDivisibleBy(mu);
+}
+
+string TRSMLLoopExp::GetType() const
+{
+  return "TRSMLLoopExp " + std::to_string((long long int) m_type);
+}
+
+BSSize TRSMLLoopExp::BlockSize() const
+{
+  if (m_type == REAL_SINGLE) {
+    return LLDLAMuSingle;
+  }
+  return LLDLAMuDouble;
+}
+
+bool TRSMLLoopExp::CanApply(const Node *node) const
+{
+  if (node->GetNodeClass() != TRSML::GetClass()) {
+    cout << "Error: Applying TRSMLLoopExp to non TRSML node\n";
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  const TRSML *trsml = static_cast<const TRSML*>(node);
+  if (trsml->GetLayer() != m_fromLayer) {
+    return false;
+  }
+  if (trsml->GetDataType() != m_type) {
+    return false;
+  }
+  if (!trsml->GetInputM(0)->IsConstant()) {
+    return false;
+  }
+
+  const BasePSet *loop = trsml->FindClosestLoop();
+  if (loop) {
+    if (dynamic_cast<const LoopInterface*>(loop)->GetDimName() == DIMN)
+      return false;
+  }
+
+  return *(trsml->GetInputN(1)) > BlockSize().GetSize()
+    && trsml->GetInputN(1)->EvenlyDivisibleBy(BlockSize().GetSize());
+}
+
+void TRSMLLoopExp::Apply(Node *node) const
+{
+  TRSML *trsml = static_cast<TRSML*>(node);
+
+  // Move right through the columns of B
+  SplitSingleIter *split = new SplitSingleIter(PARTRIGHT, POSSTUNIN, true);
+  split->AddInput(trsml->Input(1), trsml->InputConnNum(1));
+  split->SetUpStats(FULLUP, NOTUP,
+		    FULLUP, NOTUP);
+  split->SetIndepIters();
+
+  // L is used whole by every iteration
+  LoopTunnel *lTun = new LoopTunnel(POSSTUNIN);
+  lTun->AddInput(trsml->Input(0), trsml->InputConnNum(0));
+  lTun->SetAllStats(FULLUP);
+  lTun->SetIndepIters();
+
+  TRSML *newTrsml = new TRSML(m_toLayer, trsml->IsNegatedRHS());
+  newTrsml->AddInputs(4,
+		      lTun, 0,
+		      split, 1);
+
+  LoopTunnel *lTunOut = new LoopTunnel(POSSTUNOUT);
+  lTunOut->AddInput(lTun, 0);
+  lTunOut->AddInput(lTun, 1);
+  lTunOut->CopyTunnelInfo(lTun);
+
+  CombineSingleIter *com = split->CreateMatchingCombine(1,
+							1, newTrsml, 0);
+
+  Poss *loopPoss = new Poss(2, lTunOut, com);
+  RealLoop *loop = new RealLoop(LLDLALOOP, loopPoss, BlockSize());
+  loop->SetDimName(DIMN);
+
+  node->m_poss->AddPSet(loop);
+  node->RedirectChildren(loop->OutTun(1), 0);
+  node->m_poss->DeleteChildAndCleanUp(node);
+}
+
+string TRSMLNegateRHS::GetType() const
+{
+  return "TRSMLNegateRHS";
+}
+
+bool TRSMLNegateRHS::CanApply(const Node *node) const
+{
+  if (node->GetNodeClass() != TRSML::GetClass()) {
+    cout << "Error: Applying TRSMLNegateRHS to non TRSML node\n";
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  const TRSML *trsml = static_cast<const TRSML*>(node);
+  if (trsml->GetLayer() != m_fromLayer) {
+    return false;
+  }
+  if (trsml->IsNegatedRHS() || ShouldLoopOverN(trsml)) {
+    return false;
+  }
+  // A 1 x 1 TRSML is already a single scaling
+  return *(trsml->GetInputM(0)) > 1;
+}
+
+void TRSMLNegateRHS::Apply(Node *node) const
+{
+  TRSML *trsml = static_cast<TRSML*>(node);
+
+  auto negOne = new ScalarConstant(localInputNames->Next("negative_one"), trsml->GetDataType(), -1);
+
+  DLANode *negate;
+  if (trsml->GetInputNumCols(1) == 1) {
+    negate = new SVMul(m_toLayer);
+  } else {
+    negate = new SMMul(m_toLayer);
+  }
+  negate->AddInputs(4,
+		    negOne, 0,
+		    trsml->Input(1), trsml->InputConnNum(1));
+
+  auto negTrsml = new TRSML(m_toLayer, true);
+  negTrsml->AddInputs(4,
+		      trsml->Input(0), trsml->InputConnNum(0),
+		      negate, 0);
+
+  node->m_poss->AddNode(negOne);
+  node->m_poss->AddNode(negate);
+  node->m_poss->AddNode(negTrsml);
+
+  node->RedirectChildren(negTrsml, 0);
+  node->m_poss->DeleteChildAndCleanUp(node);
+}
+
+string TRSMLSplitAlongM::GetType() const
+{
+  return "TRSMLSplitAlongM";
+}
+
+// Rows above the split point.  Blocks of mu rows are split off
+// the top so that the solved part stays aligned to mu
+int TRSMLSplitAlongM::SplitPoint(const TRSML *trsml) const
+{
+  int m = trsml->GetInputNumRows(0);
+  int mu = trsml->GetVecRegWidth();
+  if (m > mu) {
+    return ((m - 1) / mu) * mu;
+  }
+  return m - 1;
+}
+
+bool TRSMLSplitAlongM::CanApply(const Node *node) const
+{
+  if (node->GetNodeClass() != TRSML::GetClass()) {
+    cout << "Error: Applying TRSMLSplitAlongM to non TRSML node\n";
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  const TRSML *trsml = static_cast<const TRSML*>(node);
+  if (trsml->GetLayer() != m_fromLayer) {
+    return false;
+  }
+  if (!trsml->IsNegatedRHS() || ShouldLoopOverN(trsml)) {
+    return false;
+  }
+  if (!trsml->GetInputM(0)->IsConstant()) {
+    return false;
+  }
+  return *(trsml->GetInputM(0)) > 1;
+}
+
+void TRSMLSplitAlongM::Apply(Node *node) const
+{
+  TRSML *trsml = static_cast<TRSML*>(node);
+  int splitPoint = SplitPoint(trsml);
+  Type dataType = trsml->GetDataType();
+
+  // L -> L00, L10, L11
+  auto partL = new Partition(m_toLayer, VERTICAL, splitPoint, true);
+  partL->AddInput(trsml->Input(0), trsml->InputConnNum(0));
+
+  auto partLTop = new Partition(m_toLayer, HORIZONTAL, splitPoint, true);
+  partLTop->AddInput(partL, 0);
+
+  auto partLBottom = new Partition(m_toLayer, HORIZONTAL, splitPoint, true);
+  partLBottom->AddInput(partL, 1);
+
+  // B -> B0, B1
+  auto partB = new Partition(m_toLayer, VERTICAL, splitPoint, true);
+  partB->AddInput(trsml->Input(1), trsml->InputConnNum(1));
+
+  auto topSolve = new TRSML(m_toLayer, true);
+  topSolve->AddInputs(4,
+		      partLTop, 0,
+		      partB, 0);
+
+  node->m_poss->AddNode(partL);
+  node->m_poss->AddNode(partLTop);
+  node->m_poss->AddNode(partLBottom);
+  node->m_poss->AddNode(partB);
+  node->m_poss->AddNode(topSolve);
+
+  DLANode *update;
+  DLANode *bottomSolve;
+  bool isRow = trsml->GetInputNumRows(0) - splitPoint == 1;
+  if (isRow) {
+    // x1 = (b1 + l10 * X0) * (-1 / l11)
+    update = new VMMul(m_toLayer);
+    update->AddInputs(6,
+		      partLBottom, 0,
+		      topSolve, 0,
+		      partB, 1);
+
+    auto recip = new ScalarConstant(localInputNames->Next("negative_one"), dataType, -1);
+    auto div = new DivScalars();
+    div->AddInputs(4,
+		   partLBottom, 1,
+		   recip, 0);
+
+    bottomSolve = new SVMul(m_toLayer);
+    bottomSolve->AddInputs(4,
+			   div, 0,
+			   update, 0);
+
+    node->m_poss->AddNode(recip);
+    node->m_poss->AddNode(div);
+  }
+  else {
+    update = new Gemm(m_toLayer, NORMAL, NORMAL, COEFONE, COEFONE, dataType);
+    update->AddInputs(6,
+		      partLBottom, 0,
+		      topSolve, 0,
+		      partB, 1);
+
+    bottomSolve = new TRSML(m_toLayer, true);
+    bottomSolve->AddInputs(4,
+			   partLBottom, 1,
+			   update, 0);
+  }
+  node->m_poss->AddNode(update);
+  node->m_poss->AddNode(bottomSolve);
+
+  auto rec = new Recombine(m_toLayer, VERTICAL);
+  rec->AddInputs(6,
+		 topSolve, 0,
+		 bottomSolve, 0,
+		 trsml->Input(1), trsml->InputConnNum(1));
+  node->m_poss->AddNode(rec);
+
+  // A row that fills a vector register goes straight to register
+  // code.  Every row of a diagonal block would otherwise multiply
+  // the number of implementations by the VMMul and SVMul choices
+  if (isRow && trsml->GetInputNumCols(1) == trsml->GetVecRegWidth()) {
+    VMMulToRegArith(m_toLayer, m_toLayer).Apply(update);
+    VRWSVMulToRegArith(m_toLayer, m_toLayer).Apply(bottomSolve);
+  }
+
+  node->RedirectChildren(rec, 0);
+  node->m_poss->DeleteChildAndCleanUp(node);
+}
+
+string TRSMLToSVMul::GetType() const
+{
+  return "TRSMLToSVMul";
+}
+
+bool TRSMLToSVMul::CanApply(const Node *node) const
+{
+  if (node->GetNodeClass() != TRSML::GetClass()) {
+    cout << "Error: Applying TRSMLToSVMul to non TRSML node\n";
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  const TRSML *trsml = static_cast<const TRSML*>(node);
+  if (trsml->GetLayer() != m_fromLayer) {
+    return false;
+  }
+  return *(trsml->GetInputM(0)) == 1;
+}
+
+void TRSMLToSVMul::Apply(Node *node) const
+{
+  TRSML *trsml = static_cast<TRSML*>(node);
+
+  // Scale by 1 / l once instead of dividing every element of B
+  ScalarConstant *recip;
+  if (trsml->IsNegatedRHS()) {
+    recip = new ScalarConstant(localInputNames->Next("negative_one"), trsml->GetDataType(), -1);
+  } else {
+    recip = new ScalarConstant(localInputNames->Next("one"), trsml->GetDataType(), 1);
+  }
+
+  auto div = new DivScalars();
+  div->AddInputs(4,
+		 trsml->Input(0), trsml->InputConnNum(0),
+		 recip, 0);
+
+  auto scale = new SVMul(m_toLayer);
+  scale->AddInputs(4,
+		   div, 0,
+		   trsml->Input(1), trsml->InputConnNum(1));
+
+  node->m_poss->AddNode(recip);
+  node->m_poss->AddNode(div);
+  node->m_poss->AddNode(scale);
+
+  node->RedirectChildren(scale, 0);
+  node->m_poss->DeleteChildAndCleanUp(node);
 }
 
 #endif // DOLLDLA
@@ -24,16 +24,20 @@
 #if DOLLDLA
 
 #include "DLAOp.h"
+#include "intLoop.h"
 
+// Solves L * X = B for X, overwriting B, where
+// L (input 0) is lower triangular.  A TRSML with a
+// negated right hand side solves L * X = -B instead
 class TRSML : public DLAOp<2, 1> {
  protected:
-  Layer m_layer;
+  bool m_negatedRHS;
 
   void SanityCheckInputDimensions();
 
  public:
- TRSML(Layer layer) :
-  m_layer(layer) {}
+  TRSML(Layer layer);
+  TRSML(Layer layer, bool negatedRHS);
 
   virtual void PrintCode(IndStream& out);
 
@@ -49,6 +53,79 @@ class TRSML : public DLAOp<2, 1> {
 
   virtual NodeType GetType() const;
 
+  inline bool IsNegatedRHS() const { return m_negatedRHS; }
+};
+
+// Loops over panels of mu columns of B.  The columns of
+// B are independent, so each iteration is its own TRSML
+class TRSMLLoopExp : public SingleTrans
+{
+ public:
+  Layer m_fromLayer, m_toLayer;
+  Type m_type;
+
+ TRSMLLoopExp(Layer fromLayer, Layer toLayer, Type type)
+   : m_fromLayer(fromLayer), m_toLayer(toLayer), m_type(type) {}
+  virtual string GetType() const;
+  virtual bool CanApply(const Node *node) const;
+  virtual void Apply(Node *node) const;
+  virtual bool IsRef() const { return true; }
+
+  BSSize BlockSize() const;
+};
+
+// B = -B followed by a TRSML with a negated right hand side.
+// The LLDLA Gemm refinements only handle alpha = beta = 1, so
+// carrying -B through the solve turns every B1 - L10 * X0
+// update into B1 + L10 * X0 and leaves a single negation
+class TRSMLNegateRHS : public SingleTrans
+{
+ public:
+  Layer m_fromLayer, m_toLayer;
+
+ TRSMLNegateRHS(Layer fromLayer, Layer toLayer)
+   : m_fromLayer(fromLayer), m_toLayer(toLayer) {}
+  virtual string GetType() const;
+  virtual bool CanApply(const Node *node) const;
+  virtual void Apply(Node *node) const;
+  virtual bool IsRef() const { return true; }
+};
+
+// Splits L into [L00 0; L10 L11] and B into [B0; B1]
+// for a TRSML with a negated right hand side:
+//   X0 = TRSML(L00, B0)
+//   X1 = TRSML(L11, B1 + L10 * X0)
+// L11 is the last mu rows (or fewer) of L, so the update is
+// a Gemm.  When L11 is a single row the update is a VMMul
+// and the solve is a scaling of that row
+class TRSMLSplitAlongM : public SingleTrans
+{
+ public:
+  Layer m_fromLayer, m_toLayer;
+
+ TRSMLSplitAlongM(Layer fromLayer, Layer toLayer)
+   : m_fromLayer(fromLayer), m_toLayer(toLayer) {}
+  virtual string GetType() const;
+  virtual bool CanApply(const Node *node) const;
+  virtual void Apply(Node *node) const;
+  virtual bool IsRef() const { return true; }
+
+  int SplitPoint(const TRSML *trsml) const;
+};
+
+// A 1 x 1 TRSML is a scaling of the row of B
+// by the reciprocal of L
+class TRSMLToSVMul : public SingleTrans
+{
+ public:
+  Layer m_fromLayer, m_toLayer;
+
+ TRSMLToSVMul(Layer fromLayer, Layer toLayer)
+   : m_fromLayer(fromLayer), m_toLayer(toLayer) {}
+  virtual string GetType() const;
+  virtual bool CanApply(const Node *node) const;
+  virtual void Apply(Node *node) const;
+  virtual bool IsRef() const { return true; }
 };
 
 #endif // DOLLDLA
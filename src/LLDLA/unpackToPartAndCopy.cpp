@@ -49,8 +49,10 @@ void UnpackToPartAndCopy::Apply(Node* node) const {
   Partition* part;
   if (unpack->UnpackDir() == HORIZONTAL) {
     part = new Partition(m_toLayer, unpack->UnpackDir(), unpack->UnpackN());
+    part->SetGenericSplitPoint(unpack->InputDataType(1).m_numColsVar);
   } else {
     part = new Partition(m_toLayer, unpack->UnpackDir(), unpack->UnpackM());
+    part->SetGenericSplitPoint(unpack->InputDataType(1).m_numRowsVar);
   }
   part->AddInput(unpack->Input(0), unpack->InputConnNum(0));
 
@@ -42,6 +42,10 @@ void VAdd::PrintCode(IndStream &out)
       *out << "simple_add( ";
     } else if (GetDataType() == REAL_SINGLE) {
       *out << "simple_add_float( ";
+    } else if (GetDataType() == COMPLEX_DOUBLE) {
+      *out << "simple_add_complex( ";
+    } else if (GetDataType() == COMPLEX_SINGLE) {
+      *out << "simple_add_complex_float( ";
     }
     if (GetVecType() == COLVECTOR) {
       *out << InputDataType(1).m_numRowsVar << ", " <<
@@ -151,6 +155,9 @@ void VAdd::Prop()
       } else {
 	m_cost = GetInputM(1)->Sum();
       }
+      if (IsComplex(GetDataType())) {
+	m_cost *= COMPLEXADDFLOPS;
+      }
     } else {
       m_cost = ZERO;
     }
@@ -334,6 +341,10 @@ void VAddLoopRef::Apply(Node *node) const
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuSingle);
   } else if (vadd->GetDataType() == REAL_DOUBLE) {
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuDouble);
+  } else if (vadd->GetDataType() == COMPLEX_SINGLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexSingle);
+  } else if (vadd->GetDataType() == COMPLEX_DOUBLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexDouble);
   } else {
     LOG_FAIL("Error: Bad GetDataType in vadd apply\n");
     throw;
@@ -472,6 +483,10 @@ void VAddToRegArith::Apply(Node* node) const
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuSingle);
   } else if (vadd->GetDataType() == REAL_DOUBLE) {
     loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuDouble);
+  } else if (vadd->GetDataType() == COMPLEX_SINGLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexSingle);
+  } else if (vadd->GetDataType() == COMPLEX_DOUBLE) {
+    loop = new RealLoop(LLDLALOOP, loopPoss, LLDLAMuComplexDouble);
   } else {
     cout << "Error: Bad GetDataType() in vadd apply\n";
     LOG_FAIL("replacement for throw call");
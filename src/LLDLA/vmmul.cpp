@@ -48,6 +48,10 @@ void VMMul::PrintCode(IndStream &out)
       *out << "simple_mmul( ";
     } else if (GetDataType() == REAL_SINGLE) {
       *out << "simple_mmul_float( ";
+    } else {
+      cout << "ERROR: VMMul has no reference implementation for complex types" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
     }
     *out << "1, " <<
       InputDataType(1).m_numRowsVar << ", " <<
@@ -45,6 +45,10 @@ void VVDot::PrintCode(IndStream &out)
       *out << "simple_mmul( ";
     } else if (GetDataType() == REAL_SINGLE) {
       *out << "simple_mmul_float( ";
+    } else {
+      cout << "ERROR: VVDot has no reference implementation for complex types" << endl;
+      LOG_FAIL("replacement for throw call");
+      throw;
     }
     *out << "1, " <<
       "1, " <<
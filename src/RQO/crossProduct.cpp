@@ -89,6 +89,7 @@ void CrossProduct::BuildDataTypeCache()
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
                  InputDataType(1).m_fields.end());
+  m_dataTypeInfo.KeepOrder(InputDataType(0));
 }
 
 void CrossProduct::Prop()
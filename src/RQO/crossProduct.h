@@ -49,13 +49,13 @@ class CrossProduct : public Sortable
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs() * Input(1)->Outputs();}
+  virtual Cost GetCost() {return CopyCost(Outputs());}
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "crossproduct";}
   virtual void ClearDataTypeCache();
   virtual void BuildDataTypeCache();
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
-  virtual int Outputs() {return (Input(0)->Outputs() > Input(1)->Outputs()) ? Input(0)-> Outputs() : Input(1)->Outputs();}
+  virtual int Outputs() {return RowsToInt((double)Input(0)->Outputs() * Input(1)->Outputs());}
 
 };
 
@@ -25,157 +25,89 @@
 
 #if DORQO
 
-vector<Tuple> scanFunc(Relation table, OrNode *query, vector<string> values)
-{
-	vector<Tuple> output;
-
-	for(auto tuple : table.getTuples())
-	{
-		if(query->evaluate(tuple, -1))
-		{
-			output.push_back(tuple);
-		}
-	}
-
-    //set up newvalues
-    vector<string> newValues;
-    for(auto fvPair : output.at(0).getFields())
-    {
-        newValues.push_back(fvPair.getField());
-    }
-    vector<string>::iterator it = newValues.begin();
-	for(auto string : values)
-    {
-        it = find(newValues.begin(), newValues.end(), string);
-        if(it != newValues.end())
-        {
-            newValues.erase(it);
-        }
-        
-    }
-
-    output = trim(output, newValues);
-
-	return output;
-}
-
-vector<Tuple> indexFunc(Relation table, OrNode *query, int index, vector<string> values)
+//Copies the rows of table in selection, in selection order
+static vector<Tuple> copyRows(Relation &table, const SelectionVector &selection)
 {
     vector<Tuple> output;
-
-    for(auto tuple : table.getTuples())
+    output.reserve(selection.size());
+    //A relation held only as columns is not materialized for a few rows
+    if(!table.hasTuples())
     {
-        if(query->evaluate(tuple, index))
+        for(auto row : selection)
         {
-            output.push_back(tuple);
+            output.push_back(table.getColumns()->getTuple(row));
         }
+        return output;
     }
-
-    //set up newvalues
-    vector<string> newValues;
-    for(auto fvPair : output.at(0).getFields())
-    {
-        newValues.push_back(fvPair.getField());
-    }
-    vector<string>::iterator it = newValues.begin();
-    for(auto string : values)
+    const vector<Tuple> &tuples = table.getTuples();
+    for(auto row : selection)
     {
-        it = find(newValues.begin(), newValues.end(), string);
-        if(it != newValues.end())
-        {
-            newValues.erase(it);
-        }
-        
+        output.push_back(tuples[row]);
     }
-
-    output = trim(output, newValues);
-
     return output;
 }
 
-vector<Tuple> nindexFunc(Relation table, OrNode *query, set<int> indeces, vector<string> values)
+//Rows of table satisfying query, in table order
+static vector<Tuple> selectRows(Relation &table, OrNode *query)
 {
-    vector<Tuple> output;
-
-    set<int>::iterator iter = indeces.begin();
-
-    for(auto tuple : table.getTuples())
-    {
-        if(query->evaluate(tuple, (*iter)))
-        {
-            output.push_back(tuple);
-        }
-    }
-
-    ++iter;
-    for(; iter != indeces.end(); ++iter)
-    {
-        int i;
-        for(i = 0; i < output.size(); i++)
-        {
-            if(!query->evaluate(output.at(i), (*iter)))
-            {
-                output.erase(output.begin() + i);
-            }
-        }
-    }
+    SelectionVector selection;
+    BatchPredicate predicate(query, table.getColumns());
+    predicate.select(selection);
+    return copyRows(table, selection);
+}
 
-    //set up newvalues
+//Removes every field of table not listed in values
+static vector<Tuple> keepValues(Relation &table, vector<Tuple> output, vector<string> values)
+{
     vector<string> newValues;
-    for(auto fvPair : output.at(0).getFields())
-    {
-        newValues.push_back(fvPair.getField());
-    }
-    vector<string>::iterator it = newValues.begin();
-    for(auto string : values)
+    for(auto attribute : table.attributes)
     {
-        it = find(newValues.begin(), newValues.end(), string);
-        if(it != newValues.end())
+        if(find(values.begin(), values.end(), attribute.m_name) == values.end())
         {
-            newValues.erase(it);
+            newValues.push_back(attribute.m_name);
         }
-        
     }
 
-    output = trim(output, newValues);
+    return trim(output, newValues);
+}
 
-    return output;
+vector<Tuple> scanFunc(Relation &table, OrNode *query, vector<string> values)
+{
+    vector<Tuple> output = selectRows(table, query);
+
+    return keepValues(table, output, values);
 }
 
-vector<Tuple> orderedindexFunc(Relation table, OrNode *query, int index, vector<string> values)
+vector<Tuple> indexFunc(Relation &table, OrNode *query, int index, vector<string> values)
 {
-    vector<Tuple> output;
-    vector<Tuple> tablevalues = table.getTuples();
-    tablevalues = sortFunc(tablevalues, index);
+    SelectionVector selection;
+    BatchPredicate predicate(query, table.getColumns());
+    set<int> columns;
+    columns.insert(index);
+    HashIndexSelect(table, predicate, columns, selection);
 
-    for(auto tuple : tablevalues)
-    {
-        if(query->evaluate(tuple, index))
-        {
-            output.push_back(tuple);
-        }
-    }
+    return keepValues(table, copyRows(table, selection), values);
+}
 
-    //set up newvalues
-    vector<string> newValues;
-    for(auto fvPair : output.at(0).getFields())
-    {
-        newValues.push_back(fvPair.getField());
-    }
-    vector<string>::iterator it = newValues.begin();
-    for(auto string : values)
-    {
-        it = find(newValues.begin(), newValues.end(), string);
-        if(it != newValues.end())
-        {
-            newValues.erase(it);
-        }
-        
-    }
+//The hash indexes on every column that narrows the query are probed
+//and their row ids intersected
+vector<Tuple> nindexFunc(Relation &table, OrNode *query, set<int> indeces, vector<string> values)
+{
+    SelectionVector selection;
+    BatchPredicate predicate(query, table.getColumns());
+    HashIndexSelect(table, predicate, indeces, selection);
 
-    output = trim(output, newValues);
+    return keepValues(table, copyRows(table, selection), values);
+}
 
-    return output;
+//Rows come out of the sorted index already in order of column index
+vector<Tuple> orderedindexFunc(Relation &table, OrNode *query, int index, vector<string> values)
+{
+    SelectionVector selection;
+    BatchPredicate predicate(query, table.getColumns());
+    SortedIndexSelect(table, predicate, index, selection);
+
+    return keepValues(table, copyRows(table, selection), values);
 }
 
 bool satisfiesJoin(Tuple tuple1, Tuple tuple2, int key1, int key2)
@@ -187,18 +119,17 @@ bool satisfiesJoin(Tuple tuple1, Tuple tuple2, int key1, int key2)
     return false;
 }
 
-Tuple joinTuples(Tuple one, Tuple two, int key)
+Tuple joinTuples(const Tuple &one, const Tuple &two, int key)
 {
     Tuple newTuple;
-    for(FieldValuePair fvPair : one.getFields())
+    newTuple.fields.reserve(one.fields.size() + two.fields.size() - 1);
+    newTuple.fields.insert(newTuple.fields.end(), one.fields.begin(), one.fields.end());
+    const string &keyValue = two.fields.at(key).m_value;
+    for(const FieldValuePair &fvPair : two.fields)
     {
-        newTuple.addField(fvPair.getField(), fvPair.getValue());
-    }
-    for(FieldValuePair fvPair : two.getFields())
-    {
-        if(fvPair.getValue() != two.getValueAt(key))
+        if(fvPair.m_value != keyValue)
         {
-            newTuple.addField(fvPair.getField(), fvPair.getValue());
+            newTuple.fields.push_back(fvPair);
         }
     }
     return newTuple;
@@ -225,61 +156,76 @@ vector<Tuple> nestedJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int
     return output;
 }
 
-vector<Tuple> hashJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2)
+//Joins row ids first and copies payload fields only for matches.
+//Output is in list2 order, matches for one list2 row in list1 order
+vector<Tuple> hashJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2,
+                       ColumnType type1, ColumnType type2)
 {
-    unordered_map<string, Tuple> hash;
-    vector<Tuple> output;
-    unordered_map<string, Tuple>::const_iterator iter = hash.begin();
+    vector<int64_t> keys1, keys2;
+    JoinKeysFromTuples(list1, key1, type1, list2, key2, type2, keys1, keys2);
 
-    for(auto tup1 : list1)
-    {
-        hash.insert(pair<string, Tuple>(
-            tup1.getValueAt(key1), tup1));
-    }
-    for(auto tup2 : list2)
+    JoinIndex index;
+    RadixHashJoin joiner;
+    joiner.join(keys1.data(), keys1.size(), keys2.data(), keys2.size(), index);
+    index.orderByRight(list2.size());
+
+    vector<Tuple> output(index.size());
+#pragma omp parallel for schedule(static)
+    for(int i = 0; i < (int)index.size(); i++)
     {
-        iter = hash.find(tup2.getValueAt(key2));
-        if(iter != hash.end())
-        {
-            Tuple toAdd = joinTuples(iter->second, tup2, key2);
-            output.push_back(toAdd);
-        }
+        output[i] = joinTuples(list1[index.m_leftRows[i]], list2[index.m_rightRows[i]], key2);
     }
     return output;
 }
 
-vector<Tuple> mergeJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2)
+//Sorts only the sides not already in key order, as permutations, then
+//joins each pair of equal key groups.  Output is in key order, a
+//group's matches in list1 then list2 order
+vector<Tuple> mergeJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2,
+                        ColumnType type1, ColumnType type2)
 {
-    vector<Tuple> output;
-    list1 = sortFunc(list1, key1);
-    list2 = sortFunc(list2, key2);
+    vector<int64_t> keys1, keys2;
+    SortKeysFromTuples(list1, key1, list2, key2, keys1, keys2, !NumericJoinKeys(type1, type2));
+    vector<uint32_t> order1, order2;
+    RadixSorter sorter;
+    sorter.sort(keys1.data(), keys1.size(), order1);
+    sorter.sort(keys2.data(), keys2.size(), order2);
 
-    vector<Tuple>::iterator iter1 = list1.begin();
-    vector<Tuple>::iterator iter2 = list2.begin();
-
-    while(iter1 != list1.end() && iter2 != list2.end())
+    vector<Tuple> output;
+    size_t pos1 = 0;
+    size_t pos2 = 0;
+    while(pos1 < order1.size() && pos2 < order2.size())
     {
-        if(satisfiesJoin((*iter1), (*iter2), key1, key2))
+        int64_t key = keys1[order1[pos1]];
+        if(key < keys2[order2[pos2]])
         {
-            Tuple toAdd = joinTuples((*iter1), (*iter2), key2);
-            output.push_back(toAdd);
-            ++iter2;
+            ++pos1;
         }
-        else if((*iter1).compareTo((*iter2), key1, key2))
+        else if(key > keys2[order2[pos2]])
         {
-        	if((*iter1).getFields().at(key1).getValue() == (*iter2).getFields().at(key2).getValue())
-        	{
-        		++iter2;
-        	}
-        	else
-        	{
-        		++iter1;
-        	}
-            
+            ++pos2;
         }
         else
         {
-            ++iter2;
+            size_t end1 = pos1;
+            while(end1 < order1.size() && keys1[order1[end1]] == key)
+            {
+                ++end1;
+            }
+            size_t end2 = pos2;
+            while(end2 < order2.size() && keys2[order2[end2]] == key)
+            {
+                ++end2;
+            }
+            for(size_t i = pos1; i < end1; i++)
+            {
+                for(size_t j = pos2; j < end2; j++)
+                {
+                    output.push_back(joinTuples(list1[order1[i]], list2[order2[j]], key2));
+                }
+            }
+            pos1 = end1;
+            pos2 = end2;
         }
     }
 
@@ -369,92 +315,107 @@ vector<Tuple> rightOuterJoin(vector<Tuple> list1, vector<Tuple> list2, int key1,
 
 
 
+//Merges two lists already in key order, taking left first on ties
 vector<Tuple> mergeFunc(vector<Tuple> left, vector<Tuple> right, int key1, int key2)
 {
-    vector<Tuple> output;
+    vector<int64_t> leftKeys, rightKeys;
+    SortKeysFromTuples(left, key1, right, key2, leftKeys, rightKeys);
 
-    while(left.size() != 0 && right.size() != 0)
+    vector<Tuple> output;
+    output.reserve(left.size() + right.size());
+    size_t posLeft = 0;
+    size_t posRight = 0;
+    while(posLeft < left.size() && posRight < right.size())
     {
-        if((*left.begin()).compareTo((*right.begin()), key1, key2))
+        if(rightKeys[posRight] < leftKeys[posLeft])
         {
-            output.push_back((*left.begin()));
-            left.erase(left.begin());
+            output.push_back(std::move(right[posRight++]));
         }
         else
         {
-            output.push_back((*right.begin()));
-            right.erase(right.begin());
+            output.push_back(std::move(left[posLeft++]));
         }
     }
-    while(left.size() != 0)
-    {
-        output.push_back((*left.begin()));
-        left.erase(left.begin());
-    }
-    while(right.size() != 0)
-    {
-        output.push_back((*right.begin()));
-        right.erase(right.begin());
-    }
+    std::move(left.begin() + posLeft, left.end(), std::back_inserter(output));
+    std::move(right.begin() + posRight, right.end(), std::back_inserter(output));
 
     return output;
 }
 
+//Stable sort on the typed values of field key
 vector<Tuple> sortFunc(vector<Tuple> list, int key)
 {
-    if(list.size() <= 1)
+    vector<int64_t> keys;
+    SortKeysFromTuples(list, key, keys);
+    vector<uint32_t> order;
+    RadixSorter sorter;
+    if(!sorter.sort(keys.data(), keys.size(), order))
     {
         return list;
     }
+    return PermuteTuples(list, order);
+}
 
-    int mid = list.size() / 2;
-    vector<Tuple>::iterator iter = list.begin() + mid;
-    vector<Tuple> left(list.begin(), iter);
-    vector<Tuple> right(iter, list.end());
-
-    left = sortFunc(left, key);
-    right = sortFunc(right, key);
-
-
-    return mergeFunc(left, right, key, key);
-
+static bool sameTuple(const Tuple &one, const Tuple &two)
+{
+    if(one.fields.size() != two.fields.size())
+    {
+        return false;
+    }
+    for(size_t i = 0; i < one.fields.size(); i++)
+    {
+        if(one.fields[i].m_field != two.fields[i].m_field
+            || one.fields[i].m_value != two.fields[i].m_value)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
+//Sorts both lists by key as permutations and merges them, keeping one
+//copy when the heads of the two lists are the same tuple
 vector<Tuple> unionFunc(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2)
 {
-    list1 = sortFunc(list1, key1);
-    list2 = sortFunc(list2, key2);
+    vector<int64_t> keys1, keys2;
+    SortKeysFromTuples(list1, key1, list2, key2, keys1, keys2);
+    vector<uint32_t> order1, order2;
+    RadixSorter sorter;
+    sorter.sort(keys1.data(), keys1.size(), order1);
+    sorter.sort(keys2.data(), keys2.size(), order2);
 
     vector<Tuple> output;
-
-    while(list1.size() != 0 && list2.size() != 0)
-    {
-        if((*list1.begin()).equals((*list2.begin())))
+    output.reserve(list1.size() + list2.size());
+    size_t pos1 = 0;
+    size_t pos2 = 0;
+    while(pos1 < order1.size() && pos2 < order2.size())
+    {
+        Tuple &tuple1 = list1[order1[pos1]];
+        Tuple &tuple2 = list2[order2[pos2]];
+        if(sameTuple(tuple1, tuple2))
         {
-            output.push_back((*list1.begin()));
-            list1.erase(list1.begin());
-            list2.erase(list2.begin());
+            output.push_back(std::move(tuple1));
+            ++pos1;
+            ++pos2;
         }
-        else if((*list1.begin()).compareTo((*list2.begin()), key1, key2))
+        else if(keys2[order2[pos2]] < keys1[order1[pos1]])
         {
-            output.push_back((*list1.begin()));
-            list1.erase(list1.begin());
+            output.push_back(std::move(tuple2));
+            ++pos2;
         }
         else
         {
-            output.push_back((*list2.begin()));
-            list2.erase(list2.begin());
+            output.push_back(std::move(tuple1));
+            ++pos1;
         }
     }
-    while(list1.size() != 0)
+    for(; pos1 < order1.size(); pos1++)
     {
-        output.push_back((*list1.begin()));
-        list1.erase(list1.begin());
+        output.push_back(std::move(list1[order1[pos1]]));
     }
-    while(list2.size() != 0)
+    for(; pos2 < order2.size(); pos2++)
     {
-        output.push_back((*list2.begin()));
-        list2.erase(list2.begin());
+        output.push_back(std::move(list2[order2[pos2]]));
     }
 
     return output;
@@ -539,8 +500,6 @@ vector<Tuple> fullOuterJoin(vector<Tuple> list1, vector<Tuple> list2, int key1,
 
     vector<Tuple> left = leftOuterJoin(list1, list2, key1, key2);
     vector<Tuple> right = rightOuterJoin(list1, list2, key1, key2);
-    left = sortFunc(left, key1);
-    right = sortFunc(right, key2);
 
     output = unionFunc(left, right, key1, key2);
 
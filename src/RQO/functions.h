@@ -27,6 +27,10 @@
 #include "rqoBasis.h"
 #include "queryNodes.h"
 #include "rqoRelation.h"
+#include "rqoBatchPredicate.h"
+#include "rqoHashJoin.h"
+#include "rqoIndex.h"
+#include "rqoRadixSort.h"
 #include <unordered_map>
 #include <iostream>
 #include <algorithm>
@@ -37,15 +41,19 @@ using namespace queryNodes;
 
 
 
-vector<Tuple> scanFunc(Relation table, OrNode *query, vector<string> values);
-vector<Tuple> indexFunc(Relation table, OrNode *query, int index, vector<string> values);
-vector<Tuple> nindexFunc(Relation table, OrNode *query, set<int> indeces, vector<string> values);
-vector<Tuple> orderedindexFunc(Relation table, OrNode *query, int index, vector<string> values);
+vector<Tuple> scanFunc(Relation &table, OrNode *query, vector<string> values);
+vector<Tuple> indexFunc(Relation &table, OrNode *query, int index, vector<string> values);
+vector<Tuple> nindexFunc(Relation &table, OrNode *query, set<int> indeces, vector<string> values);
+vector<Tuple> orderedindexFunc(Relation &table, OrNode *query, int index, vector<string> values);
 bool satisfiesJoin(Tuple tuple1, Tuple tuple2, int key1, int key2);
-Tuple joinTuples(Tuple one, Tuple two, int key);
+Tuple joinTuples(const Tuple &one, const Tuple &two, int key);
 vector<Tuple> nestedJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2);
-vector<Tuple> hashJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2);
-vector<Tuple> mergeJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2);
+//type1 and type2 are the columnar types of the key columns, see
+//NumericJoinKeys
+vector<Tuple> hashJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2,
+                       ColumnType type1 = STRINGCOLUMN, ColumnType type2 = STRINGCOLUMN);
+vector<Tuple> mergeJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2,
+                        ColumnType type1 = STRINGCOLUMN, ColumnType type2 = STRINGCOLUMN);
 vector<Tuple> leftOuterJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2);
 vector<Tuple> rightOuterJoin(vector<Tuple> list1, vector<Tuple> list2, int key1, int key2);
 vector<Tuple> mergeFunc(vector<Tuple> left, vector<Tuple> right, int key1, int key2);
@@ -78,10 +78,13 @@ void HJoin::ClearDataTypeCache()
 
 void HJoin::BuildDataTypeCache()
 {
+  m_rows = -1;
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  //Output follows the probe side, input 1
+  m_dataTypeInfo.KeepOrder(InputDataType(1));
 }
 void HJoin::PrintCode(IndStream &out)
 {
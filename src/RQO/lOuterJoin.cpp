@@ -68,10 +68,12 @@ void LeftOuterJoin::ClearDataTypeCache()
 
 void LeftOuterJoin::BuildDataTypeCache()
 {
+  m_rows = -1;
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  m_dataTypeInfo.KeepOrder(InputDataType(0));
 }
 void LeftOuterJoin::PrintCode(IndStream &out)
 {
@@ -47,14 +47,14 @@ class LeftOuterJoin : public Join
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs() * Input(1)->Outputs();}
+  virtual Cost GetCost() {return NestedJoinCost(Input(0)->Outputs(), Input(1)->Outputs(), Outputs());}
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "leftouterjoin";}
   virtual void ClearDataTypeCache();
   virtual void BuildDataTypeCache();
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
   virtual Join* CreateCopyOfJoin() const;
-  virtual int Outputs() {return (Input(0)->Outputs() > Input(1)->Outputs()) ? Input(0)-> Outputs() : Input(1)->Outputs();}
+  virtual int Outputs() {return std::max(Join::Outputs(), Input(0)->Outputs());}
 
 };
 
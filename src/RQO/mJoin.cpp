@@ -64,6 +64,17 @@ void MJoin::Duplicate(const Node *orig, bool shallow, bool possMerging)
   Node::Duplicate(orig, shallow, possMerging);
 }
 
+Cost MJoin::GetCost()
+{
+  //Inputs already in join key order skip their sort
+  bool leftOrdered = !m_in0Fields.empty()
+    && InputDataType(0).m_orderedBy == m_in0Fields[0];
+  bool rightOrdered = !m_in1Fields.empty()
+    && InputDataType(1).m_orderedBy == m_in1Fields[0];
+  return MergeJoinCost(Input(0)->Outputs(), leftOrdered,
+                       Input(1)->Outputs(), rightOrdered, Outputs());
+}
+
 const DataTypeInfo& MJoin::DataType(ConnNum num) const
 {
   return m_dataTypeInfo;
@@ -76,10 +87,14 @@ void MJoin::ClearDataTypeCache()
 
 void MJoin::BuildDataTypeCache()
 {
+  m_rows = -1;
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  //mergeJoin emits rows in key order
+  if (!m_in0Fields.empty())
+    m_dataTypeInfo.m_orderedBy = m_in0Fields[0];
 }
 void MJoin::PrintCode(IndStream &out)
 {
@@ -76,10 +76,13 @@ void NJoin::ClearDataTypeCache()
 
 void NJoin::BuildDataTypeCache()
 {
+  m_rows = -1;
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  //Output follows the outer loop, input 0
+  m_dataTypeInfo.KeepOrder(InputDataType(0));
 }
 void NJoin::PrintCode(IndStream &out)
 {
@@ -47,14 +47,17 @@ class OuterJoin : public Join
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs() * Input(1)->Outputs();}
+  virtual Cost GetCost() {return NestedJoinCost(Input(0)->Outputs(), Input(1)->Outputs(), Outputs());}
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "outerjoin";}
   virtual void ClearDataTypeCache();
   virtual void BuildDataTypeCache();
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
   virtual Join* CreateCopyOfJoin() const;
-  virtual int Outputs() {return (Input(0)->Outputs() > Input(1)->Outputs()) ? Input(0)-> Outputs() : Input(1)->Outputs();}
+  //Every inner match plus the unmatched rows of each side
+  virtual int Outputs() {return RowsToInt(std::max(Rows(), (double)Input(0)->Outputs())
+                                          + std::max(Rows(), (double)Input(1)->Outputs())
+                                          - Rows());}
 
 };
 
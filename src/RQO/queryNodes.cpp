@@ -362,4 +362,69 @@ bool FieldSet::evaluate(Tuple tuple, int index)
     return ret;
 }
 
+OrNode* createQuery(string query)
+{
+  OrNode *ret = new OrNode();
+  int i = 0;
+  int j = 0;
+  i = query.find("OR");
+  while(i != -1)
+  {
+    string str = query.substr(j, i - j);
+    AndNode *andNode = findAnd(str);
+    ret->addAnd(andNode);
+    delete andNode;
+    i += 3;
+    j = i;
+    i = query.find("OR", j);
+  }
+  string end = query.substr(j);
+  AndNode *andNode = findAnd(end);
+  ret->addAnd(andNode);
+  delete andNode;
+  return ret;
+}
+
+AndNode* findAnd(string query)
+{
+  AndNode *ret = new AndNode();
+  int i = 0;
+  int j = 0;
+  i = query.find("AND");
+
+  while(i != -1)
+  {
+    string str = query.substr(j, i - j);
+    FieldValue *clause = findClause(str);
+    ret->addClause(clause);
+    delete clause;
+    i += 4;
+    j = i;
+    i = query.find("AND", j);
+  }
+  string end = query.substr(j);
+  FieldValue *clause = findClause(end);
+  ret->addClause(clause);
+  delete clause;
+  return ret;
+}
+
+FieldValue* findClause(string query)
+{
+  string relation;
+  int i = 0;
+  int j = 0;
+  i = query.find(" ");
+  string field = query.substr(j, i - j);
+  ++i;
+  j = query.find(" ", i);
+  relation = query.substr(i, j - i);
+  ++j;
+  //A clause cut before AND or OR keeps the space in front of it
+  string value = query.substr(j);
+  value.erase(value.find_last_not_of(" ") + 1);
+  FieldValue *ret = new FieldValue(relation, value, field);
+  return ret;
+}
+
 #endif
\ No newline at end of file
@@ -45,6 +45,7 @@ namespace queryNodes
 
       public:
         OrNode();
+        virtual ~OrNode() {}
         //This adds a child node to the vector children.
         virtual void addAnd(AndNode* child) {children.push_back(*child);}
         //This Deletes a specified child node in children
@@ -53,6 +54,7 @@ namespace queryNodes
         virtual bool evaluate(Tuple tuple, int index);
         //Return the id of the node
         virtual string getId() {return m_id;}
+        virtual const vector<queryNodes::AndNode>& getAnds() const {return children;}
     };
 
     class AndNode : public OrNode
@@ -67,6 +69,7 @@ namespace queryNodes
         //Deletes a specified node from children.
         virtual void deleteClause(FieldValue* child);
         virtual bool evaluate(Tuple tuple, int index);
+        virtual const vector<queryNodes::FieldValue>& getClauses() const {return children;}
     };
 
     class ClauseNode : public AndNode
@@ -110,8 +113,11 @@ namespace queryNodes
     };
 }
 
-
-
+//Parses "field op value" clauses joined by AND and OR, AND binding
+//tighter.  The caller owns the returned tree
+queryNodes::OrNode* createQuery(string query);
+queryNodes::AndNode* findAnd(string query);
+queryNodes::FieldValue* findClause(string query);
 
 
 #endif
\ No newline at end of file
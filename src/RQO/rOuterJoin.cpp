@@ -68,10 +68,12 @@ void RightOuterJoin::Prop()
 
 void RightOuterJoin::BuildDataTypeCache()
 {
+  m_rows = -1;
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  m_dataTypeInfo.KeepOrder(InputDataType(1));
 }
 void RightOuterJoin::PrintCode(IndStream &out)
 {
@@ -6,7 +6,16 @@ DataTypeInfo& DataTypeInfo::operator=(const DataTypeInfo &rhs)
 {
   m_fields = rhs.m_fields;
   m_sortedBy = rhs.m_sortedBy;
+  m_orderedBy = rhs.m_orderedBy;
   return *this;
 }
 
+void DataTypeInfo::KeepOrder(const DataTypeInfo &input)
+{
+  if (m_fields.find(input.m_orderedBy) != m_fields.end())
+    m_orderedBy = input.m_orderedBy;
+  else
+    m_orderedBy = "";
+}
+
 #endif //DORQO
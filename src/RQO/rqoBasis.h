@@ -35,7 +35,12 @@ class DataTypeInfo
  public:
   set<string> m_fields;
   string m_sortedBy;
+  //Field the rows are known to be in key order on, a physical
+  //property.  Empty when the order is unknown
+  string m_orderedBy;
   DataTypeInfo& operator=(const DataTypeInfo &rhs);
+  //Takes input's order if its field is still in m_fields
+  void KeepOrder(const DataTypeInfo &input);
 };
 
 #endif //DORQO
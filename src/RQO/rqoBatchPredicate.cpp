@@ -0,0 +1,742 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoBatchPredicate.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+
+#if DORQO
+
+using namespace queryNodes;
+
+//Membership tables are used for IN lists spanning fewer values than this
+#define INTABLEMAXSPAN 65536
+
+void Bitmap::resize(size_t size, bool value)
+{
+    m_size = size;
+    m_words.assign((size + 63) / 64, value ? ~0ULL : 0ULL);
+    if(value && (size % 64))
+    {
+        m_words.back() &= (1ULL << (size % 64)) - 1;
+    }
+}
+
+size_t Bitmap::count() const
+{
+    size_t count = 0;
+    for(auto word : m_words)
+    {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+void Bitmap::andWith(const Bitmap &other)
+{
+    if(other.m_size != m_size)
+    {
+        cout << "Bitmaps of " << m_size << " and " << other.m_size << " rows combined" << endl;
+        throw;
+    }
+    for(size_t w = 0; w < m_words.size(); w++)
+    {
+        m_words[w] &= other.m_words[w];
+    }
+}
+
+void Bitmap::orWith(const Bitmap &other)
+{
+    if(other.m_size != m_size)
+    {
+        cout << "Bitmaps of " << m_size << " and " << other.m_size << " rows combined" << endl;
+        throw;
+    }
+    for(size_t w = 0; w < m_words.size(); w++)
+    {
+        m_words[w] |= other.m_words[w];
+    }
+}
+
+void Bitmap::toSelection(SelectionVector &selection) const
+{
+    for(size_t w = 0; w < m_words.size(); w++)
+    {
+        uint64_t word = m_words[w];
+        while(word)
+        {
+            selection.push_back(w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+bool ColumnKernel::test(size_t row) const
+{
+    if(m_type == FALSEKERNEL || m_column.isNull(row))
+    {
+        return false;
+    }
+    switch(m_type)
+    {
+    case(TRUEKERNEL):
+    case(FALSEKERNEL):
+        break;
+    case(INTRANGEKERNEL):
+        return m_column.m_ints[row] >= m_low && m_column.m_ints[row] <= m_high;
+    case(INTNOTEQUALKERNEL):
+        return m_column.m_ints[row] != m_low;
+    case(INTINKERNEL):
+    {
+        int64_t value = m_column.m_ints[row];
+        if(!m_inTable.empty())
+        {
+            uint64_t offset = (uint64_t)value - (uint64_t)m_low;
+            return offset < m_inTable.size() && m_inTable[offset];
+        }
+        return std::binary_search(m_inValues.begin(), m_inValues.end(), value);
+    }
+    case(DOUBLECOMPAREKERNEL):
+    {
+        double value = m_column.m_doubles[row];
+        switch(m_op)
+        {
+        case(EQUALOP):
+            return value == m_value;
+        case(NOTEQUALOP):
+            return value != m_value;
+        case(LESSOP):
+            return value < m_value;
+        case(LESSEQUALOP):
+            return value <= m_value;
+        case(GREATEROP):
+            return value > m_value;
+        case(GREATEREQUALOP):
+            return value >= m_value;
+        }
+    }
+    }
+    return true;
+}
+
+bool StrToCompareOp(string str, CompareOp &op)
+{
+    if(str == "=")
+    {
+        op = EQUALOP;
+    }
+    else if(str == "!=")
+    {
+        op = NOTEQUALOP;
+    }
+    else if(str == "<")
+    {
+        op = LESSOP;
+    }
+    else if(str == "<=")
+    {
+        op = LESSEQUALOP;
+    }
+    else if(str == ">")
+    {
+        op = GREATEROP;
+    }
+    else if(str == ">=")
+    {
+        op = GREATEREQUALOP;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+template<typename T>
+static bool Compare(const T &left, CompareOp op, const T &right)
+{
+    switch(op)
+    {
+    case(EQUALOP):
+        return left == right;
+    case(NOTEQUALOP):
+        return left != right;
+    case(LESSOP):
+        return left < right;
+    case(LESSEQUALOP):
+        return left <= right;
+    case(GREATEROP):
+        return left > right;
+    case(GREATEREQUALOP):
+        return left >= right;
+    }
+    throw;
+}
+
+//Packs test(values[i]) into bit i % 64 of words[i / 64].  The inner
+//loop has no branches so it vectorizes
+template<typename T, typename Test>
+static void FillWords(const T *values, size_t count, uint64_t *words, Test test)
+{
+    size_t full = count / 64;
+    for(size_t w = 0; w < full; w++)
+    {
+        const T *block = values + w * 64;
+        uint64_t word = 0;
+        for(size_t i = 0; i < 64; i++)
+        {
+            word |= (uint64_t)test(block[i]) << i;
+        }
+        words[w] = word;
+    }
+    if(count % 64)
+    {
+        const T *block = values + full * 64;
+        uint64_t word = 0;
+        for(size_t i = 0; i < count % 64; i++)
+        {
+            word |= (uint64_t)test(block[i]) << i;
+        }
+        words[full] = word;
+    }
+}
+
+//low <= value <= high as a single unsigned compare
+struct RangeTest
+{
+    uint64_t m_low;
+    uint64_t m_width;
+
+    RangeTest(int64_t low, int64_t high) : m_low(low), m_width((uint64_t)high - (uint64_t)low) {}
+    bool operator()(int64_t value) const {return (uint64_t)value - m_low <= m_width;}
+};
+
+struct TableTest
+{
+    const uint8_t *m_table;
+    uint64_t m_low;
+    uint64_t m_size;
+
+    bool operator()(int64_t value) const
+    {
+        uint64_t offset = (uint64_t)value - m_low;
+        return offset < m_size && m_table[offset];
+    }
+};
+
+ColumnKernel::ColumnKernel(KernelType type)
+    : m_type(type),
+    m_op(EQUALOP),
+    m_low(LLONG_MIN),
+    m_high(LLONG_MAX),
+    m_value(0)
+{
+}
+
+ColumnKernel::ColumnKernel(KernelType type, const ColumnView &column)
+    : m_type(type),
+    m_column(column),
+    m_op(EQUALOP),
+    m_low(LLONG_MIN),
+    m_high(LLONG_MAX),
+    m_value(0)
+{
+}
+
+void ColumnKernel::evaluate(size_t begin, size_t end, uint64_t *words) const
+{
+    size_t count = end - begin;
+    size_t numWords = (count + 63) / 64;
+    const int64_t *ints = m_column.m_ints + begin;
+    switch(m_type)
+    {
+    case(TRUEKERNEL):
+        std::fill(words, words + numWords, ~0ULL);
+        break;
+    case(FALSEKERNEL):
+        std::fill(words, words + numWords, 0ULL);
+        return;
+    case(INTRANGEKERNEL):
+        FillWords(ints, count, words, RangeTest(m_low, m_high));
+        break;
+    case(INTNOTEQUALKERNEL):
+    {
+        int64_t excluded = m_low;
+        FillWords(ints, count, words, [excluded](int64_t value) {return value != excluded;});
+        break;
+    }
+    case(INTINKERNEL):
+        if(!m_inTable.empty())
+        {
+            TableTest test = {m_inTable.data(), (uint64_t)m_low, m_inTable.size()};
+            FillWords(ints, count, words, test);
+        }
+        else
+        {
+            uint64_t valueWords[PREDICATEBLOCKWORDS];
+            std::fill(words, words + numWords, 0ULL);
+            for(auto value : m_inValues)
+            {
+                FillWords(ints, count, valueWords, RangeTest(value, value));
+                for(size_t w = 0; w < numWords; w++)
+                {
+                    words[w] |= valueWords[w];
+                }
+            }
+        }
+        break;
+    case(DOUBLECOMPAREKERNEL):
+    {
+        const double *doubles = m_column.m_doubles + begin;
+        double constant = m_value;
+        switch(m_op)
+        {
+        case(EQUALOP):
+            FillWords(doubles, count, words, [constant](double value) {return value == constant;});
+            break;
+        case(NOTEQUALOP):
+            FillWords(doubles, count, words, [constant](double value) {return value != constant;});
+            break;
+        case(LESSOP):
+            FillWords(doubles, count, words, [constant](double value) {return value < constant;});
+            break;
+        case(LESSEQUALOP):
+            FillWords(doubles, count, words, [constant](double value) {return value <= constant;});
+            break;
+        case(GREATEROP):
+            FillWords(doubles, count, words, [constant](double value) {return value > constant;});
+            break;
+        case(GREATEREQUALOP):
+            FillWords(doubles, count, words, [constant](double value) {return value >= constant;});
+            break;
+        }
+        break;
+    }
+    }
+
+    if(count % 64)
+    {
+        words[numWords - 1] &= (1ULL << (count % 64)) - 1;
+    }
+    if(m_column.m_nulls)
+    {
+        uint64_t nullWords[PREDICATEBLOCKWORDS];
+        FillWords(m_column.m_nulls + begin, count, nullWords, [](uint8_t isNull) {return isNull != 0;});
+        for(size_t w = 0; w < numWords; w++)
+        {
+            words[w] &= ~nullWords[w];
+        }
+    }
+}
+
+//Kernel for an int valued column compared with value.  Fractional
+//values narrow the bounds, so x > 2.5 becomes x >= 3
+static ColumnKernel IntKernel(const ColumnView &column, CompareOp op, double value)
+{
+    const double largest = 9.2e18;
+    if(std::isnan(value))
+    {
+        return ColumnKernel(op == NOTEQUALOP ? TRUEKERNEL : FALSEKERNEL, column);
+    }
+    if(value > largest || value < -largest)
+    {
+        bool above = value > 0;
+        bool allPass = (op == NOTEQUALOP)
+            || (above && (op == LESSOP || op == LESSEQUALOP))
+            || (!above && (op == GREATEROP || op == GREATEREQUALOP));
+        return ColumnKernel(allPass ? TRUEKERNEL : FALSEKERNEL, column);
+    }
+
+    int64_t floorVal = (int64_t)std::floor(value);
+    int64_t ceilVal = (int64_t)std::ceil(value);
+    ColumnKernel kernel(INTRANGEKERNEL, column);
+    switch(op)
+    {
+    case(EQUALOP):
+        if(floorVal != ceilVal)
+        {
+            return ColumnKernel(FALSEKERNEL, column);
+        }
+        kernel.m_low = kernel.m_high = floorVal;
+        break;
+    case(NOTEQUALOP):
+        if(floorVal != ceilVal)
+        {
+            return ColumnKernel(TRUEKERNEL, column);
+        }
+        kernel.m_type = INTNOTEQUALKERNEL;
+        kernel.m_low = floorVal;
+        break;
+    case(LESSOP):
+        kernel.m_high = ceilVal - 1;
+        break;
+    case(LESSEQUALOP):
+        kernel.m_high = floorVal;
+        break;
+    case(GREATEROP):
+        kernel.m_low = floorVal + 1;
+        break;
+    case(GREATEREQUALOP):
+        kernel.m_low = ceilVal;
+        break;
+    }
+    return kernel;
+}
+
+//With a sorted dictionary string order is code order, so every
+//comparison is a code range
+static ColumnKernel StringKernel(const ColumnView &column, CompareOp op, const string &value)
+{
+    const vector<string> &dictionary = *column.m_dictionary;
+    if(!column.m_sortedDictionary)
+    {
+        ColumnKernel kernel(INTINKERNEL, column);
+        kernel.m_low = 0;
+        kernel.m_inTable.resize(dictionary.size());
+        for(size_t code = 0; code < dictionary.size(); code++)
+        {
+            kernel.m_inTable[code] = Compare(dictionary[code], op, value);
+        }
+        return kernel;
+    }
+
+    int64_t lower = column.lowerBoundCode(value);
+    bool found = lower < (int64_t)dictionary.size() && dictionary[lower] == value;
+    int64_t upper = lower + (found ? 1 : 0);
+    ColumnKernel kernel(INTRANGEKERNEL, column);
+    kernel.m_low = 0;
+    switch(op)
+    {
+    case(EQUALOP):
+        if(!found)
+        {
+            return ColumnKernel(FALSEKERNEL, column);
+        }
+        kernel.m_low = kernel.m_high = lower;
+        break;
+    case(NOTEQUALOP):
+        if(!found)
+        {
+            return ColumnKernel(TRUEKERNEL, column);
+        }
+        kernel.m_type = INTNOTEQUALKERNEL;
+        kernel.m_low = lower;
+        break;
+    case(LESSOP):
+        kernel.m_high = lower - 1;
+        break;
+    case(LESSEQUALOP):
+        kernel.m_high = upper - 1;
+        break;
+    case(GREATEROP):
+        kernel.m_low = upper;
+        break;
+    case(GREATEREQUALOP):
+        kernel.m_low = lower;
+        break;
+    }
+    return kernel;
+}
+
+BatchPredicate::BatchPredicate(OrNode *query, const ColumnarRelation *relation)
+    : m_numRows(relation->getSize())
+{
+    for(auto &andNode : query->getAnds())
+    {
+        vector<ColumnKernel> term;
+        for(auto &clause : andNode.getClauses())
+        {
+            term.push_back(compileClause(clause, relation));
+        }
+        if(term.empty())
+        {
+            term.push_back(ColumnKernel(TRUEKERNEL));
+        }
+        mergeRanges(term);
+        if(term.size() == 1 && term[0].m_type == FALSEKERNEL)
+        {
+            continue;
+        }
+        m_terms.push_back(term);
+    }
+    fuseEqualities();
+}
+
+ColumnKernel BatchPredicate::compileClause(const FieldValue &clause, const ColumnarRelation *relation)
+{
+    string field = StripSpaces(clause.m_field);
+    string relationOp = StripSpaces(clause.m_relation);
+    string value = StripSpaces(clause.m_value);
+    if(field.empty() && relationOp.empty())
+    {
+        return ColumnKernel(TRUEKERNEL);
+    }
+
+    CompareOp op;
+    if(!StrToCompareOp(relationOp, op))
+    {
+        cout << "Unknown comparison " << relationOp << " on " << field << endl;
+        throw;
+    }
+    ColumnView column = relation->getColumn(field);
+    switch(column.m_type)
+    {
+    case(INTCOLUMN):
+    {
+        double number;
+        if(ParseDouble(value, number))
+        {
+            return IntKernel(column, op, number);
+        }
+        break;
+    }
+    case(DATECOLUMN):
+    {
+        int64_t days;
+        DateFormat format;
+        if(ParseDate(value, days, format))
+        {
+            return IntKernel(column, op, days);
+        }
+        break;
+    }
+    case(DOUBLECOLUMN):
+    {
+        ColumnKernel kernel(DOUBLECOMPAREKERNEL, column);
+        kernel.m_op = op;
+        if(ParseDouble(value, kernel.m_value))
+        {
+            return kernel;
+        }
+        break;
+    }
+    case(STRINGCOLUMN):
+        return StringKernel(column, op, value);
+    }
+    cout << value << " cannot be compared with " << ColumnTypeToStr(column.m_type)
+        << " column " << field << endl;
+    throw;
+}
+
+//Intersects range kernels that read the same column and drops
+//kernels that cannot change the conjunction
+void BatchPredicate::mergeRanges(vector<ColumnKernel> &term)
+{
+    vector<ColumnKernel> merged;
+    for(auto &kernel : term)
+    {
+        if(kernel.m_type == FALSEKERNEL)
+        {
+            term.assign(1, kernel);
+            return;
+        }
+        if(kernel.m_type == TRUEKERNEL && !kernel.m_column.m_nulls)
+        {
+            continue;
+        }
+        bool absorbed = false;
+        if(kernel.m_type == INTRANGEKERNEL)
+        {
+            for(auto &existing : merged)
+            {
+                if(existing.m_type == INTRANGEKERNEL && existing.m_column.m_ints == kernel.m_column.m_ints)
+                {
+                    existing.m_low = std::max(existing.m_low, kernel.m_low);
+                    existing.m_high = std::min(existing.m_high, kernel.m_high);
+                    absorbed = true;
+                    break;
+                }
+            }
+        }
+        if(!absorbed)
+        {
+            merged.push_back(kernel);
+        }
+    }
+    for(auto &kernel : merged)
+    {
+        if(kernel.m_type == INTRANGEKERNEL && kernel.m_low > kernel.m_high)
+        {
+            term.assign(1, ColumnKernel(FALSEKERNEL));
+            return;
+        }
+    }
+    //Equalities and ranges first, they are the most likely to empty a block
+    std::stable_sort(merged.begin(), merged.end(),
+        [](const ColumnKernel &left, const ColumnKernel &right)
+        {return left.m_type == INTRANGEKERNEL && right.m_type != INTRANGEKERNEL;});
+    if(merged.empty())
+    {
+        merged.push_back(ColumnKernel(TRUEKERNEL));
+    }
+    term = merged;
+}
+
+//Replaces terms that are a lone equality on the same column with one
+//IN kernel per column
+void BatchPredicate::fuseEqualities()
+{
+    vector<vector<ColumnKernel>> fused;
+    map<const int64_t*, vector<ColumnKernel>> equalities;
+    vector<const int64_t*> columnOrder;
+    for(auto &term : m_terms)
+    {
+        if(term.size() == 1 && term[0].isEquality())
+        {
+            const int64_t *column = term[0].m_column.m_ints;
+            if(equalities.find(column) == equalities.end())
+            {
+                columnOrder.push_back(column);
+            }
+            equalities[column].push_back(term[0]);
+        }
+        else
+        {
+            fused.push_back(term);
+        }
+    }
+
+    for(auto column : columnOrder)
+    {
+        vector<ColumnKernel> &kernels = equalities[column];
+        if(kernels.size() == 1)
+        {
+            fused.push_back(kernels);
+            continue;
+        }
+        ColumnKernel in(INTINKERNEL, kernels[0].m_column);
+        for(auto &kernel : kernels)
+        {
+            in.m_inValues.push_back(kernel.m_low);
+        }
+        std::sort(in.m_inValues.begin(), in.m_inValues.end());
+        in.m_inValues.erase(std::unique(in.m_inValues.begin(), in.m_inValues.end()), in.m_inValues.end());
+        uint64_t span = (uint64_t)in.m_inValues.back() - (uint64_t)in.m_inValues.front();
+        if(span < INTABLEMAXSPAN)
+        {
+            in.m_low = in.m_inValues.front();
+            in.m_inTable.assign(span + 1, 0);
+            for(auto value : in.m_inValues)
+            {
+                in.m_inTable[value - in.m_low] = 1;
+            }
+            in.m_inValues.clear();
+        }
+        fused.push_back(vector<ColumnKernel>(1, in));
+    }
+    m_terms = fused;
+}
+
+//ORs the terms' matches for rows [begin, end) into out
+void BatchPredicate::evaluateBlock(size_t begin, size_t end, uint64_t *out) const
+{
+    uint64_t termWords[PREDICATEBLOCKWORDS];
+    uint64_t clauseWords[PREDICATEBLOCKWORDS];
+    size_t numWords = (end - begin + 63) / 64;
+    for(auto &term : m_terms)
+    {
+        term[0].evaluate(begin, end, termWords);
+        for(size_t k = 1; k < term.size(); k++)
+        {
+            uint64_t any = 0;
+            for(size_t w = 0; w < numWords; w++)
+            {
+                any |= termWords[w];
+            }
+            if(!any)
+            {
+                break;
+            }
+            term[k].evaluate(begin, end, clauseWords);
+            for(size_t w = 0; w < numWords; w++)
+            {
+                termWords[w] &= clauseWords[w];
+            }
+        }
+        for(size_t w = 0; w < numWords; w++)
+        {
+            out[w] |= termWords[w];
+        }
+    }
+}
+
+void BatchPredicate::evaluate(Bitmap &result) const
+{
+    result.resize(m_numRows, false);
+    for(size_t begin = 0; begin < m_numRows; begin += PREDICATEBLOCKROWS)
+    {
+        size_t end = std::min(begin + PREDICATEBLOCKROWS, m_numRows);
+        evaluateBlock(begin, end, result.m_words.data() + begin / 64);
+    }
+}
+
+void BatchPredicate::select(SelectionVector &selection) const
+{
+    Bitmap bitmap;
+    evaluate(bitmap);
+    selection.clear();
+    selection.reserve(bitmap.count());
+    bitmap.toSelection(selection);
+}
+
+void BatchPredicate::selectBlock(size_t begin, size_t end, SelectionVector &selection) const
+{
+    uint64_t words[PREDICATEBLOCKWORDS] = {0};
+    evaluateBlock(begin, end, words);
+    size_t numWords = (end - begin + 63) / 64;
+    for(size_t w = 0; w < numWords; w++)
+    {
+        uint64_t word = words[w];
+        while(word)
+        {
+            selection.push_back(begin + w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+void BatchPredicate::filter(SelectionVector &selection) const
+{
+    size_t kept = 0;
+    for(auto row : selection)
+    {
+        for(auto &term : m_terms)
+        {
+            bool match = true;
+            for(size_t k = 0; match && k < term.size(); k++)
+            {
+                match = term[k].test(row);
+            }
+            if(match)
+            {
+                selection[kept++] = row;
+                break;
+            }
+        }
+    }
+    selection.resize(kept);
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoColumnarRelation.h"
+#include "queryNodes.h"
+
+#if DORQO
+
+//Rows are evaluated a block at a time so the intermediate bitmaps
+//of a conjunction stay in L1
+#define PREDICATEBLOCKROWS 2048
+#define PREDICATEBLOCKWORDS (PREDICATEBLOCKROWS / 64)
+
+//Ids of selected rows in increasing order
+typedef vector<uint32_t> SelectionVector;
+
+//One bit per row
+class Bitmap
+{
+public:
+    vector<uint64_t> m_words;
+    size_t m_size;
+
+    Bitmap() : m_size(0) {}
+    virtual void resize(size_t size, bool value);
+    bool test(size_t row) const {return (m_words[row >> 6] >> (row & 63)) & 1;}
+    virtual size_t count() const;
+    virtual void andWith(const Bitmap &other);
+    virtual void orWith(const Bitmap &other);
+    virtual void toSelection(SelectionVector &selection) const;
+};
+
+
+enum CompareOp {EQUALOP,
+                NOTEQUALOP,
+                LESSOP,
+                LESSEQUALOP,
+                GREATEROP,
+                GREATEREQUALOP};
+
+//Both int kernels also serve date columns (days) and string columns
+//(dictionary codes)
+enum KernelType {TRUEKERNEL,
+                 FALSEKERNEL,
+                 INTRANGEKERNEL,
+                 INTNOTEQUALKERNEL,
+                 INTINKERNEL,
+                 DOUBLECOMPAREKERNEL};
+
+bool StrToCompareOp(string str, CompareOp &op);
+
+//A single clause compiled against one typed column.  Null rows never
+//satisfy a kernel that reads a column
+class ColumnKernel
+{
+public:
+    KernelType m_type;
+    ColumnView m_column;
+    CompareOp m_op;
+    //Inclusive bounds for INTRANGEKERNEL, m_low is the excluded value
+    //for INTNOTEQUALKERNEL and the first value of m_inTable
+    int64_t m_low;
+    int64_t m_high;
+    double m_value;
+    //INTINKERNEL membership of m_low + i, or when empty the sorted
+    //m_inValues are tested one at a time
+    vector<uint8_t> m_inTable;
+    vector<int64_t> m_inValues;
+
+    ColumnKernel(KernelType type);
+    ColumnKernel(KernelType type, const ColumnView &column);
+    //Writes the result for rows [begin, end) to words, bit i of word w
+    //being row begin + 64w + i.  At most PREDICATEBLOCKROWS rows
+    void evaluate(size_t begin, size_t end, uint64_t *words) const;
+    //The kernel applied to a single row
+    bool test(size_t row) const;
+    bool isEquality() const {return m_type == INTRANGEKERNEL && m_low == m_high;}
+};
+
+
+//An OrNode compiled against a columnar relation.  Clauses are bound to
+//columns by field name, ranges on one column within an AND are merged
+//and an OR of equalities on one column becomes an IN kernel
+class BatchPredicate
+{
+public:
+    size_t m_numRows;
+    //Disjunction of conjunctions, as in OrNode and AndNode
+    vector<vector<ColumnKernel>> m_terms;
+
+    BatchPredicate(queryNodes::OrNode *query, const ColumnarRelation *relation);
+    virtual void evaluate(Bitmap &result) const;
+    virtual void select(SelectionVector &selection) const;
+    //Appends the matching rows in [begin, end) to selection.  begin
+    //is a multiple of 64 and end - begin at most PREDICATEBLOCKROWS
+    virtual void selectBlock(size_t begin, size_t end, SelectionVector &selection) const;
+    //Keeps the rows of selection that match, testing them one at a time.
+    //For the few candidate rows an index lookup leaves
+    virtual void filter(SelectionVector &selection) const;
+
+private:
+    void evaluateBlock(size_t begin, size_t end, uint64_t *out) const;
+    ColumnKernel compileClause(const queryNodes::FieldValue &clause, const ColumnarRelation *relation);
+    void mergeRanges(vector<ColumnKernel> &term);
+    void fuseEqualities();
+};
+
+
+#endif
@@ -0,0 +1,570 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoColumn.h"
+#include "rqoTableStore.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#if DORQO
+
+static const char *monthNames[12] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                     "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+//Days since 1970-01-01 of a proleptic Gregorian date
+static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day)
+{
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static void CivilFromDays(int64_t days, int64_t &year, int64_t &month, int64_t &day)
+{
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth + (shiftedMonth < 10 ? 3 : -9);
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+string ColumnTypeToStr(ColumnType type)
+{
+    switch(type)
+    {
+    case(INTCOLUMN):
+        return "int";
+    case(DOUBLECOLUMN):
+        return "double";
+    case(STRINGCOLUMN):
+        return "string";
+    case(DATECOLUMN):
+        return "date";
+    default:
+        cout << "Bad column type" << endl;
+        throw;
+    }
+}
+
+bool StrToColumnType(string str, ColumnType &type)
+{
+    if(str == "int")
+    {
+        type = INTCOLUMN;
+    }
+    else if(str == "double")
+    {
+        type = DOUBLECOLUMN;
+    }
+    else if(str == "string")
+    {
+        type = STRINGCOLUMN;
+    }
+    else if(str == "date")
+    {
+        type = DATECOLUMN;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+string StripSpaces(const string &str)
+{
+    size_t first = str.find_first_not_of(" \t");
+    if(first == string::npos)
+    {
+        return "";
+    }
+    size_t last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+bool ParseInt(const string &text, int64_t &value)
+{
+    if(text.empty())
+    {
+        return false;
+    }
+    char *end;
+    errno = 0;
+    value = strtoll(text.c_str(), &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+bool ParseDouble(const string &text, double &value)
+{
+    if(text.empty())
+    {
+        return false;
+    }
+    char *end;
+    value = strtod(text.c_str(), &end);
+    return *end == '\0';
+}
+
+bool ParseDate(const string &text, int64_t &days, DateFormat &format)
+{
+    int64_t year, month, day;
+    if(text.size() == 10 && text[4] == '-' && text[7] == '-')
+    {
+        if(!ParseInt(text.substr(0, 4), year) || !ParseInt(text.substr(5, 2), month)
+            || !ParseInt(text.substr(8, 2), day))
+        {
+            return false;
+        }
+        format = ISOFORMAT;
+    }
+    else if((text.size() == 9 || text.size() == 11) && text[2] == '-' && text[6] == '-')
+    {
+        if(!ParseInt(text.substr(0, 2), day) || !ParseInt(text.substr(7), year))
+        {
+            return false;
+        }
+        //Two digit years are taken to be in 1950 - 2049
+        if(text.size() == 9)
+        {
+            year += (year < 50) ? 2000 : 1900;
+        }
+        string monthName = text.substr(3, 3);
+        bool fullYear = text.size() == 11;
+        if(monthName[0] >= 'a' && monthName[1] >= 'a')
+        {
+            format = fullYear ? LOWERDAYMONTHFULLYEARFORMAT : LOWERDAYMONTHYEARFORMAT;
+        }
+        else if(monthName[1] >= 'a')
+        {
+            format = fullYear ? TITLEDAYMONTHFULLYEARFORMAT : TITLEDAYMONTHYEARFORMAT;
+        }
+        else
+        {
+            format = fullYear ? DAYMONTHFULLYEARFORMAT : DAYMONTHYEARFORMAT;
+        }
+        std::transform(monthName.begin(), monthName.end(), monthName.begin(), ::toupper);
+        month = 0;
+        for(int i = 0; i < 12; i++)
+        {
+            if(monthName == monthNames[i])
+            {
+                month = i + 1;
+                break;
+            }
+        }
+    }
+    else
+    {
+        return false;
+    }
+    if(month < 1 || month > 12 || day < 1 || day > 31)
+    {
+        return false;
+    }
+    days = DaysFromCivil(year, month, day);
+    return true;
+}
+
+string DateToStr(int64_t days, DateFormat format)
+{
+    int64_t year, month, day;
+    CivilFromDays(days, year, month, day);
+    std::ostringstream out;
+    out << std::setfill('0');
+    if(format == ISOFORMAT)
+    {
+        out << std::setw(4) << year << "-" << std::setw(2) << month << "-" << std::setw(2) << day;
+    }
+    else
+    {
+        string monthName = monthNames[month - 1];
+        if(format == LOWERDAYMONTHYEARFORMAT || format == LOWERDAYMONTHFULLYEARFORMAT)
+        {
+            std::transform(monthName.begin(), monthName.end(), monthName.begin(), ::tolower);
+        }
+        else if(format == TITLEDAYMONTHYEARFORMAT || format == TITLEDAYMONTHFULLYEARFORMAT)
+        {
+            std::transform(monthName.begin() + 1, monthName.end(), monthName.begin() + 1, ::tolower);
+        }
+        bool fullYear = format == DAYMONTHFULLYEARFORMAT || format == LOWERDAYMONTHFULLYEARFORMAT
+            || format == TITLEDAYMONTHFULLYEARFORMAT;
+        out << std::setw(2) << day << "-" << monthName << "-";
+        //A two digit year can only be written for 1950 - 2049
+        if(!fullYear && year >= 1950 && year < 2050)
+        {
+            out << std::setw(2) << (year % 100);
+        }
+        else
+        {
+            out << std::setw(4) << year;
+        }
+    }
+    return out.str();
+}
+
+ColumnView::ColumnView()
+    : m_type(INTCOLUMN),
+    m_dateFormat(DAYMONTHYEARFORMAT),
+    m_ints(NULL),
+    m_doubles(NULL),
+    m_nulls(NULL),
+    m_dictionary(NULL),
+    m_sortedDictionary(false),
+    m_size(0)
+{
+}
+
+double ColumnView::getNumeric(size_t row) const
+{
+    if(m_type == DOUBLECOLUMN)
+    {
+        return m_doubles[row];
+    }
+    return (double)m_ints[row];
+}
+
+string ColumnView::getString(size_t row) const
+{
+    if(isNull(row))
+    {
+        return "";
+    }
+    switch(m_type)
+    {
+    case(INTCOLUMN):
+        return std::to_string((long long int)m_ints[row]);
+    case(DOUBLECOLUMN):
+    {
+        std::ostringstream out;
+        out << std::setprecision(15) << m_doubles[row];
+        return out.str();
+    }
+    case(STRINGCOLUMN):
+        return m_dictionary->at(m_ints[row]);
+    case(DATECOLUMN):
+        return DateToStr(m_ints[row], m_dateFormat);
+    default:
+        cout << "Bad column type" << endl;
+        throw;
+    }
+}
+
+int64_t ColumnView::findCode(const string &str) const
+{
+    if(m_sortedDictionary)
+    {
+        int64_t code = lowerBoundCode(str);
+        if(code < (int64_t)m_dictionary->size() && m_dictionary->at(code) == str)
+        {
+            return code;
+        }
+        return -1;
+    }
+    for(size_t i = 0; i < m_dictionary->size(); i++)
+    {
+        if(m_dictionary->at(i) == str)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int64_t ColumnView::lowerBoundCode(const string &str) const
+{
+    return std::lower_bound(m_dictionary->begin(), m_dictionary->end(), str) - m_dictionary->begin();
+}
+
+Column::Column(string name, ColumnType type)
+    : m_name(name),
+    m_type(type),
+    m_dateFormat(DAYMONTHYEARFORMAT),
+    m_hasDates(false),
+    m_hasNulls(false),
+    m_sortedDictionary(true),
+    m_mappedValues(NULL),
+    m_mappedNulls(NULL),
+    m_mappedRows(0)
+{
+}
+
+void Column::unmap()
+{
+    if(!m_mapping)
+    {
+        return;
+    }
+    if(m_type == DOUBLECOLUMN)
+    {
+        const double *values = (const double*)m_mappedValues;
+        m_doubles.assign(values, values + m_mappedRows);
+    }
+    else
+    {
+        const int64_t *values = (const int64_t*)m_mappedValues;
+        m_ints.assign(values, values + m_mappedRows);
+    }
+    if(m_mappedNulls)
+    {
+        m_nulls.assign(m_mappedNulls, m_mappedNulls + m_mappedRows);
+    }
+    else
+    {
+        m_nulls.assign(m_mappedRows, 0);
+    }
+    m_codes.clear();
+    for(size_t i = 0; i < m_dictionary.size(); i++)
+    {
+        m_codes.insert(pair<string, int64_t>(m_dictionary[i], i));
+    }
+    m_mapping.reset();
+    m_mappedValues = NULL;
+    m_mappedNulls = NULL;
+    m_mappedRows = 0;
+}
+
+void Column::reserve(size_t rows)
+{
+    unmap();
+    if(m_type == DOUBLECOLUMN)
+    {
+        m_doubles.reserve(rows);
+    }
+    else
+    {
+        m_ints.reserve(rows);
+    }
+    m_nulls.reserve(rows);
+}
+
+void Column::mergeDateFormat(DateFormat format)
+{
+    if(!m_hasDates)
+    {
+        m_dateFormat = format;
+        m_hasDates = true;
+    }
+    else if(format != m_dateFormat)
+    {
+        m_dateFormat = ISOFORMAT;
+    }
+}
+
+void Column::append(const string &value)
+{
+    unmap();
+    if(value.empty() && m_type != STRINGCOLUMN)
+    {
+        if(m_type == DOUBLECOLUMN)
+        {
+            m_doubles.push_back(0);
+        }
+        else
+        {
+            m_ints.push_back(0);
+        }
+        m_nulls.push_back(1);
+        m_hasNulls = true;
+        return;
+    }
+
+    bool parsed = true;
+    switch(m_type)
+    {
+    case(INTCOLUMN):
+    {
+        int64_t intVal;
+        parsed = ParseInt(value, intVal);
+        m_ints.push_back(intVal);
+        break;
+    }
+    case(DOUBLECOLUMN):
+    {
+        double doubleVal;
+        parsed = ParseDouble(value, doubleVal);
+        m_doubles.push_back(doubleVal);
+        break;
+    }
+    case(DATECOLUMN):
+    {
+        int64_t days;
+        DateFormat format;
+        parsed = ParseDate(value, days, format);
+        if(parsed)
+        {
+            mergeDateFormat(format);
+        }
+        m_ints.push_back(days);
+        break;
+    }
+    case(STRINGCOLUMN):
+    {
+        unordered_map<string, int64_t>::const_iterator iter = m_codes.find(value);
+        if(iter != m_codes.end())
+        {
+            m_ints.push_back(iter->second);
+        }
+        else
+        {
+            int64_t code = m_dictionary.size();
+            if(!m_dictionary.empty() && value < m_dictionary.back())
+            {
+                m_sortedDictionary = false;
+            }
+            m_dictionary.push_back(value);
+            m_codes.insert(pair<string, int64_t>(value, code));
+            m_ints.push_back(code);
+        }
+        break;
+    }
+    }
+    if(!parsed)
+    {
+        cout << "Value " << value << " of column " << m_name << " is not a "
+            << ColumnTypeToStr(m_type) << endl;
+        throw;
+    }
+    m_nulls.push_back(0);
+}
+
+void Column::append(const Column &other)
+{
+    if(other.m_type != m_type)
+    {
+        cout << "Column " << other.m_name << " of type " << ColumnTypeToStr(other.m_type)
+            << " appended to " << m_name << " of type " << ColumnTypeToStr(m_type) << endl;
+        throw;
+    }
+    unmap();
+    ColumnView values = other.view();
+    if(m_type == DATECOLUMN && other.m_hasDates)
+    {
+        mergeDateFormat(other.m_dateFormat);
+    }
+    if(m_type == DOUBLECOLUMN)
+    {
+        m_doubles.insert(m_doubles.end(), values.m_doubles, values.m_doubles + values.size());
+    }
+    else if(m_type != STRINGCOLUMN)
+    {
+        m_ints.insert(m_ints.end(), values.m_ints, values.m_ints + values.size());
+    }
+    else
+    {
+        //Codes of other's dictionary in this column's dictionary
+        vector<int64_t> newCode(other.m_dictionary.size());
+        for(size_t i = 0; i < other.m_dictionary.size(); i++)
+        {
+            const string &str = other.m_dictionary[i];
+            unordered_map<string, int64_t>::const_iterator iter = m_codes.find(str);
+            if(iter != m_codes.end())
+            {
+                newCode[i] = iter->second;
+                continue;
+            }
+            newCode[i] = m_dictionary.size();
+            if(!m_dictionary.empty() && str < m_dictionary.back())
+            {
+                m_sortedDictionary = false;
+            }
+            m_dictionary.push_back(str);
+            m_codes.insert(pair<string, int64_t>(str, newCode[i]));
+        }
+        m_ints.reserve(m_ints.size() + values.size());
+        for(size_t row = 0; row < values.size(); row++)
+        {
+            m_ints.push_back(newCode[values.m_ints[row]]);
+        }
+    }
+    if(values.m_nulls)
+    {
+        m_nulls.insert(m_nulls.end(), values.m_nulls, values.m_nulls + values.size());
+        m_hasNulls = true;
+    }
+    else
+    {
+        m_nulls.resize(m_nulls.size() + values.size(), 0);
+    }
+}
+
+void Column::sortDictionary()
+{
+    if(m_type != STRINGCOLUMN || m_sortedDictionary)
+    {
+        return;
+    }
+    unmap();
+    vector<string> sorted = m_dictionary;
+    std::sort(sorted.begin(), sorted.end());
+    vector<int64_t> newCode(m_dictionary.size());
+    m_codes.clear();
+    for(size_t i = 0; i < sorted.size(); i++)
+    {
+        m_codes.insert(pair<string, int64_t>(sorted[i], i));
+    }
+    for(size_t i = 0; i < m_dictionary.size(); i++)
+    {
+        newCode[i] = m_codes[m_dictionary[i]];
+    }
+    for(auto &code : m_ints)
+    {
+        code = newCode[code];
+    }
+    m_dictionary.swap(sorted);
+    m_sortedDictionary = true;
+}
+
+ColumnView Column::view() const
+{
+    ColumnView view;
+    view.m_type = m_type;
+    view.m_dateFormat = m_dateFormat;
+    if(m_mapping)
+    {
+        view.m_ints = m_type == DOUBLECOLUMN ? NULL : (const int64_t*)m_mappedValues;
+        view.m_doubles = m_type == DOUBLECOLUMN ? (const double*)m_mappedValues : NULL;
+        view.m_nulls = m_mappedNulls;
+    }
+    else
+    {
+        view.m_ints = m_ints.empty() ? NULL : m_ints.data();
+        view.m_doubles = m_doubles.empty() ? NULL : m_doubles.data();
+        view.m_nulls = m_hasNulls ? m_nulls.data() : NULL;
+    }
+    view.m_dictionary = &m_dictionary;
+    view.m_sortedDictionary = m_sortedDictionary;
+    view.m_size = size();
+    return view;
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#if DORQO
+
+class MappedFile;
+
+
+
+//Physical type of a column.  Dates are stored as days since
+//1970-01-01 and strings as codes into a per column dictionary,
+//so every column but DOUBLECOLUMN is a vector of int64_t
+enum ColumnType
+{
+    INTCOLUMN,
+    DOUBLECOLUMN,
+    STRINGCOLUMN,
+    DATECOLUMN
+};
+
+//How a date column was written in its source, so values print
+//back the way they were loaded.  A column whose values were written
+//in more than one format prints all of them as ISOFORMAT
+enum DateFormat
+{
+    DAYMONTHYEARFORMAT,            // 10-DEC-94
+    ISOFORMAT,                     // 1994-12-10
+    DAYMONTHFULLYEARFORMAT,        // 10-DEC-1994
+    LOWERDAYMONTHYEARFORMAT,       // 10-dec-94
+    LOWERDAYMONTHFULLYEARFORMAT,   // 10-dec-1994
+    TITLEDAYMONTHYEARFORMAT,       // 10-Dec-94
+    TITLEDAYMONTHFULLYEARFORMAT    // 10-Dec-1994
+};
+
+string ColumnTypeToStr(ColumnType type);
+bool StrToColumnType(string str, ColumnType &type);
+//str without leading and trailing spaces and tabs
+string StripSpaces(const string &str);
+
+bool ParseInt(const string &text, int64_t &value);
+bool ParseDouble(const string &text, double &value);
+bool ParseDate(const string &text, int64_t &days, DateFormat &format);
+string DateToStr(int64_t days, DateFormat format);
+
+
+//A read only window onto a column's storage.  Views hold raw
+//pointers into the column vectors, so they are cheap to copy and
+//hand to operators, and stay valid until the column is appended to
+class ColumnView
+{
+public:
+    ColumnType m_type;
+    DateFormat m_dateFormat;
+    const int64_t *m_ints;
+    const double *m_doubles;
+    const uint8_t *m_nulls;
+    const vector<string> *m_dictionary;
+    bool m_sortedDictionary;
+    size_t m_size;
+
+    //Accessors are not virtual so per row loops can inline them
+    ColumnView();
+    size_t size() const {return m_size;}
+    bool isNull(size_t row) const {return m_nulls && m_nulls[row];}
+    //Numeric value of a row, dates as days and strings as codes
+    double getNumeric(size_t row) const;
+    //Text of a row as it would appear in a Tuple
+    string getString(size_t row) const;
+    //Dictionary code of str, -1 when it is not in the column
+    int64_t findCode(const string &str) const;
+    //First code whose string is >= str, m_dictionary->size() if none.
+    //Only meaningful once the dictionary is sorted
+    int64_t lowerBoundCode(const string &str) const;
+};
+
+
+class Column
+{
+public:
+    string m_name;
+    ColumnType m_type;
+    DateFormat m_dateFormat;
+    //Whether m_dateFormat was taken from a value yet
+    bool m_hasDates;
+    vector<int64_t> m_ints;
+    vector<double> m_doubles;
+    vector<uint8_t> m_nulls;
+    vector<string> m_dictionary;
+    unordered_map<string, int64_t> m_codes;
+    bool m_hasNulls;
+    bool m_sortedDictionary;
+    //A column opened from a table file reads its values and nulls
+    //straight from the mapping, and copies them into the vectors
+    //above the first time it is changed
+    std::shared_ptr<MappedFile> m_mapping;
+    const char *m_mappedValues;
+    const uint8_t *m_mappedNulls;
+    size_t m_mappedRows;
+
+    Column(string name, ColumnType type);
+    //Parses value into the column's type, an empty value is a null
+    //for everything but strings
+    virtual void append(const string &value);
+    virtual void reserve(size_t rows);
+    //Appends every row of other, which must have the same type
+    virtual void append(const Column &other);
+    virtual size_t size() const {return m_mapping ? m_mappedRows : m_nulls.size();}
+    //Renumbers the dictionary so code order matches string order,
+    //which lets range predicates compare codes
+    virtual void sortDictionary();
+    virtual ColumnView view() const;
+
+private:
+    //Copies a mapped column into memory so it can be changed
+    void unmap();
+    //Keeps m_dateFormat as the format of every value so far, or
+    //ISOFORMAT once they disagree
+    void mergeDateFormat(DateFormat format);
+};
+
+
+#endif
@@ -0,0 +1,209 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoColumnarRelation.h"
+#include "rqoRelation.h"
+
+#if DORQO
+
+void Schema::addColumn(string name, ColumnType type, bool indexed)
+{
+    m_names.push_back(name);
+    m_types.push_back(type);
+    m_indexed.push_back(indexed);
+}
+
+int Schema::indexOf(string name) const
+{
+    for(size_t i = 0; i < m_names.size(); i++)
+    {
+        if(m_names[i] == name)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+ColumnarRelation::ColumnarRelation(string name, const Schema &schema)
+    : m_name(name),
+    m_schema(schema),
+    m_numRows(0)
+{
+    for(size_t i = 0; i < schema.size(); i++)
+    {
+        m_columns.push_back(Column(schema.m_names[i], schema.m_types[i]));
+    }
+}
+
+void ColumnarRelation::appendRow(const vector<string> &values)
+{
+    if(values.size() != m_columns.size())
+    {
+        cout << "Row with " << values.size() << " values appended to "
+            << m_name << " which has " << m_columns.size() << " columns" << endl;
+        throw;
+    }
+    for(size_t i = 0; i < values.size(); i++)
+    {
+        m_columns[i].append(values[i]);
+    }
+    ++m_numRows;
+}
+
+void ColumnarRelation::seal()
+{
+#pragma omp parallel for schedule(dynamic)
+    for(size_t i = 0; i < m_columns.size(); i++)
+    {
+        m_columns[i].sortDictionary();
+    }
+}
+
+ColumnView ColumnarRelation::getColumn(int index) const
+{
+    return m_columns.at(index).view();
+}
+
+ColumnView ColumnarRelation::getColumn(string name) const
+{
+    int index = m_schema.indexOf(name);
+    if(index == -1)
+    {
+        cout << "Relation " << m_name << " has no column " << name << endl;
+        throw;
+    }
+    return getColumn(index);
+}
+
+Tuple ColumnarRelation::getTuple(size_t row) const
+{
+    Tuple tuple;
+    for(size_t i = 0; i < m_columns.size(); i++)
+    {
+        tuple.addField(m_schema.m_names[i], m_columns[i].view().getString(row));
+    }
+    return tuple;
+}
+
+vector<Tuple> ColumnarRelation::getTuples() const
+{
+    vector<Tuple> tuples;
+    tuples.reserve(m_numRows);
+    for(size_t row = 0; row < m_numRows; row++)
+    {
+        tuples.push_back(getTuple(row));
+    }
+    return tuples;
+}
+
+void ColumnarRelation::printTable() const
+{
+    cout << m_name << " contains " << m_numRows << " rows with the following columns:" << endl;
+    for(size_t i = 0; i < m_columns.size(); i++)
+    {
+        cout << m_schema.m_names[i] << " of type " << ColumnTypeToStr(m_schema.m_types[i]) << endl;
+    }
+}
+
+//Value of the named field in tuple, expected at position hint
+static string FieldValue(Tuple &tuple, const string &name, size_t hint)
+{
+    if(hint < tuple.fields.size() && tuple.fields[hint].m_field == name)
+    {
+        return tuple.fields[hint].m_value;
+    }
+    for(auto &fvPair : tuple.fields)
+    {
+        if(fvPair.m_field == name)
+        {
+            return fvPair.m_value;
+        }
+    }
+    return "";
+}
+
+static ColumnType InferColumnType(Relation *relation, Attribute &attribute, size_t position)
+{
+    ColumnType type;
+    if(attribute.m_type != "string" && StrToColumnType(attribute.m_type, type))
+    {
+        return type;
+    }
+    bool allInts = true;
+    bool allDates = true;
+    bool anyValue = false;
+    for(auto &tuple : relation->tuples)
+    {
+        string value = FieldValue(tuple, attribute.m_name, position);
+        if(value.empty())
+        {
+            continue;
+        }
+        anyValue = true;
+        int64_t intVal;
+        int64_t days;
+        DateFormat format;
+        allInts = allInts && ParseInt(value, intVal);
+        allDates = allDates && ParseDate(value, days, format);
+    }
+    if(attribute.m_type == "number")
+    {
+        return allInts ? INTCOLUMN : DOUBLECOLUMN;
+    }
+    else if(attribute.m_type == "string")
+    {
+        return (anyValue && allDates) ? DATECOLUMN : STRINGCOLUMN;
+    }
+    cout << "Attribute " << attribute.m_name << " has unknown type " << attribute.m_type << endl;
+    throw;
+}
+
+ColumnarRelation* ColumnarRelation::fromRelation(Relation *relation)
+{
+    Schema schema;
+    for(size_t i = 0; i < relation->attributes.size(); i++)
+    {
+        Attribute &attribute = relation->attributes[i];
+        schema.addColumn(attribute.m_name, InferColumnType(relation, attribute, i), attribute.m_indexed);
+    }
+
+    ColumnarRelation *columnar = new ColumnarRelation(relation->getName(), schema);
+    for(auto &column : columnar->m_columns)
+    {
+        column.reserve(relation->tuples.size());
+    }
+    vector<string> values(schema.size());
+    for(auto &tuple : relation->tuples)
+    {
+        for(size_t i = 0; i < schema.size(); i++)
+        {
+            values[i] = FieldValue(tuple, schema.m_names[i], i);
+        }
+        columnar->appendRow(values);
+    }
+    columnar->seal();
+    return columnar;
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoColumn.h"
+#include "rqoTuple.h"
+
+#if DORQO
+
+
+
+class Relation;
+
+//Names and types of a relation's columns, held once per relation
+//instead of once per cell
+class Schema
+{
+public:
+    vector<string> m_names;
+    vector<ColumnType> m_types;
+    vector<bool> m_indexed;
+
+    virtual ~Schema() {}
+    virtual void addColumn(string name, ColumnType type, bool indexed);
+    //Position of the named column, -1 if there is none
+    virtual int indexOf(string name) const;
+    virtual size_t size() const {return m_names.size();}
+};
+
+
+//Typed, column-at-a-time storage for a relation.  Operators get
+//ColumnViews into it rather than copies of its rows
+class ColumnarRelation
+{
+public:
+    string m_name;
+    Schema m_schema;
+    vector<Column> m_columns;
+    size_t m_numRows;
+
+    ColumnarRelation(string name, const Schema &schema);
+    virtual ~ColumnarRelation() {}
+    //One value per schema column, in schema order
+    virtual void appendRow(const vector<string> &values);
+    //Call once loading is done, sorts the string dictionaries
+    virtual void seal();
+    virtual ColumnView getColumn(int index) const;
+    virtual ColumnView getColumn(string name) const;
+    virtual string getName() const {return m_name;}
+    virtual size_t getSize() const {return m_numRows;}
+    //Materializes rows for the operators that still work on tuples
+    virtual Tuple getTuple(size_t row) const;
+    virtual vector<Tuple> getTuples() const;
+    virtual void printTable() const;
+
+    //Converts a relation built with addAttribute/addTuple.  Attribute
+    //types "int", "double" and "date" are used as given.  A
+    //"number" column becomes int if every value is integral and double
+    //otherwise, and a "string" column whose values all parse as dates
+    //becomes a date column
+    static ColumnarRelation* fromRelation(Relation *relation);
+};
+
+
+#endif
@@ -0,0 +1,167 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoCostModel.h"
+#include "rqoJoin.h"
+#include "rqoRelation.h"
+#include "rqoStatistics.h"
+#include <cmath>
+
+#if DORQO
+
+//Predicate evaluation and copying out the rows that pass
+static Cost FilterCost(double rows, int clauses, size_t columns, double out)
+{
+    return rows * (columns * RQOCOLUMNBYTES * RQOSEQBYTECOST + clauses * RQOCLAUSECOST)
+        + out * RQOTUPLECOST;
+}
+
+Cost ScanCost(Relation *relation, string query)
+{
+    set<string> fields;
+    int clauses = CountClauses(query, fields);
+    return FilterCost(relation->getSize(), clauses, fields.size(), EstimateRows(relation, query));
+}
+
+//Fetching candidates by row id and filtering them
+static Cost FetchCost(Relation *relation, string query, double candidates)
+{
+    set<string> fields;
+    int clauses = CountClauses(query, fields);
+    return candidates * (RQORANDOMACCESSCOST + clauses * RQOCLAUSECOST)
+        + EstimateRows(relation, query) * RQOTUPLECOST;
+}
+
+Cost HashIndexCost(Relation *relation, string query, int index)
+{
+    string field = relation->attributes.at(index).m_name;
+    int lookups = CountFieldTerms(query, field, true);
+    if(!lookups)
+    {
+        return ScanCost(relation, query);
+    }
+    double candidates = relation->getSize() * EstimateFieldSelectivity(query, relation, field, true);
+    return lookups * RQORANDOMACCESSCOST + FetchCost(relation, query, candidates);
+}
+
+Cost OrderedIndexCost(Relation *relation, string query, int index)
+{
+    string field = relation->attributes.at(index).m_name;
+    int lookups = CountFieldTerms(query, field, false);
+    //Matches are put in key order either way
+    Cost order = SortCost(EstimateRows(relation, query), false);
+    if(!lookups)
+    {
+        return ScanCost(relation, query) + order;
+    }
+    double rows = std::max(2, relation->getSize());
+    double depth = std::ceil(std::log(rows) / std::log((double)RQOINDEXFANOUT));
+    double candidates = rows * EstimateFieldSelectivity(query, relation, field, false);
+    return lookups * depth * RQORANDOMACCESSCOST
+        + candidates * 2 * RQOCOLUMNBYTES * RQOSEQBYTECOST
+        + FetchCost(relation, query, candidates) + order;
+}
+
+Cost MultiIndexCost(Relation *relation, string query, const set<int> &indeces)
+{
+    double rows = relation->getSize();
+    double survivors = rows;
+    Cost cost = 0;
+    bool usedIndex = false;
+    for(auto index : indeces)
+    {
+        string field = relation->attributes.at(index).m_name;
+        int lookups = CountFieldTerms(query, field, true);
+        if(!lookups)
+        {
+            continue;
+        }
+        double selectivity = EstimateFieldSelectivity(query, relation, field, true);
+        //Row id lists are four bytes a row and intersected through a
+        //cache resident bitmap
+        cost += lookups * RQORANDOMACCESSCOST
+            + rows * selectivity * (4 * RQOSEQBYTECOST + RQOCACHEDACCESSCOST);
+        survivors *= selectivity;
+        usedIndex = true;
+    }
+    if(!usedIndex)
+    {
+        return ScanCost(relation, query);
+    }
+    return cost + FetchCost(relation, query, survivors);
+}
+
+Cost SortCost(double rows, bool ordered)
+{
+    Cost keys = rows * (RQOHASHCOST + RQOCOLUMNBYTES * RQOSEQBYTECOST);
+    if(ordered)
+    {
+        return keys;
+    }
+    //Each pass reads and writes a 16 byte key and row id through a
+    //cache resident histogram, and the final gather is random
+    return keys + rows * (RQORADIXPASSES * (2 * 16 * RQOSEQBYTECOST + RQOCACHEDACCESSCOST)
+                          + RQORANDOMACCESSCOST);
+}
+
+Cost NestedJoinCost(double left, double right, double out)
+{
+    return left * right * RQOCOMPARECOST + out * RQOTUPLECOST;
+}
+
+Cost HashJoinCost(double left, double right, double out)
+{
+    //Each key and row id is written once when partitioning and read
+    //once when building or probing
+    double partition = (left + right) * (RQOHASHCOST + 2 * 16 * RQOSEQBYTECOST);
+    return partition + (left + right) * RQOCACHEDACCESSCOST + out * RQOTUPLECOST;
+}
+
+Cost MergeJoinCost(double left, bool leftOrdered, double right, bool rightOrdered, double out)
+{
+    return SortCost(left, leftOrdered) + SortCost(right, rightOrdered)
+        + (left + right) * RQOCOMPARECOST + out * RQOTUPLECOST;
+}
+
+Cost CopyCost(double rows)
+{
+    return rows * RQOTUPLECOST;
+}
+
+double JoinRows(Join *join)
+{
+    double left = join->Input(0)->Outputs();
+    double right = join->Input(1)->Outputs();
+    double selectivity = 1;
+    for(size_t i = 0; i < join->m_in0Fields.size() && i < join->m_in1Fields.size(); i++)
+    {
+        double leftDistinct = EstimateDistinct(join->Input(0), join->m_in0Fields[i]);
+        double rightDistinct = EstimateDistinct(join->Input(1), join->m_in1Fields[i]);
+        //A key with no statistics is taken to be unique
+        selectivity *= EstimateJoinSelectivity(leftDistinct ? leftDistinct : left,
+                                               rightDistinct ? rightDistinct : right);
+    }
+    return left * right * selectivity;
+}
+
+#endif
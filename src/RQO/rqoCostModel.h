@@ -0,0 +1,85 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "costs.h"
+
+#if DORQO
+
+//Costs are estimated nanoseconds of work on one core
+//Streaming one byte from memory, about 10GB/s
+#define RQOSEQBYTECOST 0.1
+//A random read that misses in cache
+#define RQORANDOMACCESSCOST 80.0
+//A random read into a structure sized to stay in L2
+#define RQOCACHEDACCESSCOST 4.0
+//One batch predicate kernel applied to one row
+#define RQOCLAUSECOST 0.5
+//Hashing one join key
+#define RQOHASHCOST 2.0
+//Comparing the keys of two tuples in a sort or merge
+#define RQOCOMPARECOST 10.0
+//Copying one tuple into an operator's output
+#define RQOTUPLECOST 40.0
+//Bytes per column value, string codes included
+#define RQOCOLUMNBYTES 8
+//Radix passes of a sort, 8 bit digits over a typical 32 bit key range
+#define RQORADIXPASSES 4
+//Keys per B+-tree node, the fanout of an ordered index
+#define RQOINDEXFANOUT 16
+
+class Join;
+class Relation;
+
+//Batch predicate over the columns query reads, then copying out matches
+Cost ScanCost(Relation *relation, string query);
+//Hash index lookups for the equalities on column index, then fetching
+//and filtering the candidate rows.  A scan when the index cannot answer
+//every AND term
+Cost HashIndexCost(Relation *relation, string query, int index);
+//B+-tree descents for the clauses on column index, leaf scans over the
+//matching range, fetching and filtering the candidate rows, then
+//putting the matches in key order.  A scan and sort when the index
+//cannot answer every AND term
+Cost OrderedIndexCost(Relation *relation, string query, int index);
+//Hash index lookups on each usable column of indeces, intersecting the
+//row id lists, then fetching and filtering the survivors
+Cost MultiIndexCost(Relation *relation, string query, const set<int> &indeces);
+//Extracting typed keys, radix passes over keys and row ids, then
+//gathering the tuples in order.  Only the key extraction and order
+//check when the rows are already ordered
+Cost SortCost(double rows, bool ordered);
+Cost NestedJoinCost(double left, double right, double out);
+//Radix partitioning both inputs, building the smaller and probing
+Cost HashJoinCost(double left, double right, double out);
+//Sorting the inputs not already in key order and merging them
+Cost MergeJoinCost(double left, bool leftOrdered, double right, bool rightOrdered, double out);
+Cost CopyCost(double rows);
+//Estimated rows of the inner join of join's two inputs
+double JoinRows(Join *join);
+
+
+#endif
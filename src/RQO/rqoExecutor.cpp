@@ -0,0 +1,331 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoExecutor.h"
+#include "graphIter.h"
+#include "basePSet.h"
+#include "tunnel.h"
+#include "functions.h"
+#include "rqoHelperNodes.h"
+#include "rqoScan.h"
+#include "rqoIndexedNode.h"
+#include "rqoNIndexedNode.h"
+#include "rqoOrderedIndexNode.h"
+#include "rqoJoin.h"
+#include "nJoin.h"
+#include "hJoin.h"
+#include "mJoin.h"
+#include "lOuterJoin.h"
+#include "rOuterJoin.h"
+#include "outerJoin.h"
+#include "crossProduct.h"
+#include "rqoSort.h"
+#include "rqoUnion.h"
+#include "rqoProj.h"
+#include "rqoTrim.h"
+#include "rqoIndex.h"
+#include "rqoColumnarRelation.h"
+
+#if DORQO
+
+static void CheckRelation(Node *node, Relation *relation)
+{
+    if(!relation)
+    {
+        cout << "No relation set for " << node->GetNameStr(0) << endl;
+        throw;
+    }
+}
+
+static void ScanRelation(Node *node, Relation *relation, const string &query, BatchSink &sink)
+{
+    CheckRelation(node, relation);
+    queryNodes::OrNode *tree = createQuery(query);
+    PushScan(*relation, tree, node->DataType(0).m_fields, sink);
+    delete tree;
+}
+
+//Reads the rows through the hash indexes on columns, or the sorted
+//index on ordered when it is at least 0
+static void ReadIndex(Node *node, Relation *relation, const string &query,
+                      const set<int> &columns, int ordered, BatchSink &sink)
+{
+    CheckRelation(node, relation);
+    queryNodes::OrNode *tree = createQuery(query);
+    SelectionVector selection;
+    {
+        BatchPredicate predicate(tree, relation->getColumns());
+        if(ordered >= 0)
+        {
+            SortedIndexSelect(*relation, predicate, ordered, selection);
+        }
+        else
+        {
+            HashIndexSelect(*relation, predicate, columns, selection);
+        }
+    }
+    delete tree;
+    PushSelected(*relation, selection, node->DataType(0).m_fields, sink);
+}
+
+vector<Tuple> Executor::Run(GraphIter &iter)
+{
+    m_setOutputs.clear();
+    MapSets(iter);
+    if(iter.m_poss->m_outTuns.empty())
+    {
+        cout << "The plan has no output" << endl;
+        throw;
+    }
+    vector<Tuple> output = Materialize(iter.m_poss->m_outTuns[0]);
+    m_setOutputs.clear();
+    return output;
+}
+
+void Executor::MapSets(GraphIter &iter)
+{
+    Poss *poss = iter.m_poss;
+    for(unsigned int num = 0; num < poss->m_sets.size(); ++num)
+    {
+        BasePSet *set = poss->m_sets[num];
+        Poss *chosen = iter.m_setIters[num]->second;
+        for(unsigned int i = 0; i < set->m_outTuns.size(); ++i)
+        {
+            m_setOutputs[set->m_outTuns[i]] = chosen->m_outTuns[i];
+        }
+        MapSets(*(iter.m_subIters[num]));
+    }
+}
+
+Node* Executor::Resolve(const Node *node) const
+{
+    while(node->IsTunnel())
+    {
+        if(((const Tunnel*)node)->m_tunType == SETTUNOUT)
+        {
+            auto found = m_setOutputs.find(node);
+            if(found == m_setOutputs.end())
+            {
+                cout << "Set output has no chosen poss" << endl;
+                throw;
+            }
+            node = found->second;
+        }
+        else
+        {
+            node = node->Input(0);
+        }
+    }
+    return (Node*)node;
+}
+
+//The relation a leaf reads, NULL for other nodes
+static Relation* ReadRelation(Node *node)
+{
+    ClassType type = node->GetNodeClass();
+    if(type == Scan::GetClass())
+    {
+        return ((Scan*)node)->GetRelation();
+    }
+    else if(type == IndexedNode::GetClass())
+    {
+        return ((IndexedNode*)node)->GetRelation();
+    }
+    else if(type == NIndexedNode::GetClass())
+    {
+        return ((NIndexedNode*)node)->GetRelation();
+    }
+    else if(type == OrderedIndexedNode::GetClass())
+    {
+        return ((OrderedIndexedNode*)node)->GetRelation();
+    }
+    else if(type == InputNode::GetClass())
+    {
+        return ((InputNode*)node)->GetRelation();
+    }
+    return NULL;
+}
+
+bool Executor::FieldType(const Node *input, const string &field, ColumnType &type) const
+{
+    Node *node = Resolve(input);
+    Relation *relation = ReadRelation(node);
+    if(relation)
+    {
+        const Schema &schema = relation->getColumns()->m_schema;
+        int index = schema.indexOf(field);
+        if(index < 0)
+        {
+            return false;
+        }
+        type = schema.m_types[index];
+        return true;
+    }
+    for(unsigned int i = 0; i < node->m_inputs.size(); i++)
+    {
+        if(FieldType(node->Input(i), field, type))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Keys not read from any relation compare as text
+ColumnType Executor::KeyType(const Node *node, const string &field) const
+{
+    ColumnType type;
+    return FieldType(node, field, type) ? type : STRINGCOLUMN;
+}
+
+vector<Tuple> Executor::Materialize(const Node *node)
+{
+    CollectSink collect;
+    Produce(node, collect);
+    return std::move(collect.m_rows);
+}
+
+void Executor::Produce(const Node *input, BatchSink &sink)
+{
+    Node *node = Resolve(input);
+    ClassType type = node->GetNodeClass();
+    if(type == Scan::GetClass())
+    {
+        Scan *scan = (Scan*)node;
+        ScanRelation(node, scan->GetRelation(), scan->m_query, sink);
+    }
+    else if(type == IndexedNode::GetClass())
+    {
+        IndexedNode *index = (IndexedNode*)node;
+        set<int> columns;
+        columns.insert(index->m_index);
+        ReadIndex(node, index->GetRelation(), index->m_query, columns, -1, sink);
+    }
+    else if(type == NIndexedNode::GetClass())
+    {
+        NIndexedNode *index = (NIndexedNode*)node;
+        ReadIndex(node, index->GetRelation(), index->m_query, index->m_indeces, -1, sink);
+    }
+    else if(type == OrderedIndexedNode::GetClass())
+    {
+        OrderedIndexedNode *index = (OrderedIndexedNode*)node;
+        ReadIndex(node, index->GetRelation(), index->m_query, set<int>(), index->m_index, sink);
+    }
+    else if(type == InputNode::GetClass())
+    {
+        //Never refined, so read it with a scan
+        InputNode *in = (InputNode*)node;
+        ScanRelation(node, in->GetRelation(), in->m_query, sink);
+    }
+    else if(type == HJoin::GetClass())
+    {
+        //Input 0 is built, input 1 streams through the probe
+        HJoin *join = (HJoin*)node;
+        vector<Tuple> build = Materialize(node->Input(0));
+        JoinHashTable table(build, FieldIndex(build, join->m_in0Fields.at(0)),
+                            KeyType(node->Input(0), join->m_in0Fields.at(0)),
+                            KeyType(node->Input(1), join->m_in1Fields.at(0)));
+        HashProbeSink probe(build, table, join->m_in1Fields.at(0), sink);
+        Produce(node->Input(1), probe);
+    }
+    else if(type == NJoin::GetClass() || type == Join::GetClass())
+    {
+        Join *join = (Join*)node;
+        vector<Tuple> inner = Materialize(node->Input(1));
+        NestedLoopSink nested(inner, join->m_in0Fields.at(0), join->m_in1Fields.at(0), sink);
+        Produce(node->Input(0), nested);
+    }
+    else if(type == CrossProduct::GetClass())
+    {
+        vector<Tuple> right = Materialize(node->Input(1));
+        CrossProductSink cross(right, sink);
+        Produce(node->Input(0), cross);
+    }
+    else if(type == Trim::GetClass())
+    {
+        TrimSink trimSink(((Trim*)node)->m_inFields, sink);
+        Produce(node->Input(0), trimSink);
+    }
+    else if(type == Projection::GetClass())
+    {
+        ProjectionSink projectionSink(((Projection*)node)->m_inFields, sink);
+        Produce(node->Input(0), projectionSink);
+    }
+    else
+    {
+        vector<Tuple> rows = RunBreaker(node);
+        PushRows(rows, sink);
+    }
+}
+
+vector<Tuple> Executor::RunBreaker(Node *node)
+{
+    ClassType type = node->GetNodeClass();
+    if(node->IsJoin())
+    {
+        Join *join = (Join*)node;
+        vector<Tuple> left = Materialize(node->Input(0));
+        vector<Tuple> right = Materialize(node->Input(1));
+        int key0 = FieldIndex(left, join->m_in0Fields.at(0));
+        int key1 = FieldIndex(right, join->m_in1Fields.at(0));
+        if(type == MJoin::GetClass())
+        {
+            return mergeJoin(left, right, key0, key1,
+                             KeyType(node->Input(0), join->m_in0Fields.at(0)),
+                             KeyType(node->Input(1), join->m_in1Fields.at(0)));
+        }
+        else if(type == LeftOuterJoin::GetClass())
+        {
+            return leftOuterJoin(left, right, key0, key1);
+        }
+        else if(type == RightOuterJoin::GetClass())
+        {
+            return rightOuterJoin(left, right, key0, key1);
+        }
+        else if(type == OuterJoin::GetClass())
+        {
+            return fullOuterJoin(left, right, key0, key1);
+        }
+    }
+    else if(type == Sort::GetClass())
+    {
+        vector<Tuple> input = Materialize(node->Input(0));
+        return sortFunc(input, FieldIndex(input, ((Sort*)node)->m_sortBy));
+    }
+    else if(type == Union::GetClass())
+    {
+        Union *unionNode = (Union*)node;
+        vector<Tuple> left = Materialize(node->Input(0));
+        vector<Tuple> right = Materialize(node->Input(1));
+        string key = unionNode->m_sortBy;
+        if(key.empty() && !unionNode->m_fields.empty())
+        {
+            key = unionNode->m_fields.front();
+        }
+        return unionFunc(left, right, FieldIndex(left, key), FieldIndex(right, key));
+    }
+    cout << "The executor has no operator for " << type << " nodes" << endl;
+    throw;
+}
+
+#endif
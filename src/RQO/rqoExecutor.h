@@ -0,0 +1,64 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "base.h"
+#include "rqoTuple.h"
+#include "rqoPipeline.h"
+#include <map>
+
+#if DORQO
+
+class GraphIter;
+
+//Runs the plan a GraphIter currently points to, following tunnels
+//into the poss chosen for each set.  Scans, index reads, Trim,
+//Projection, the probe side of hash joins and the outer side of nested
+//loop joins and cross products push batches through fused pipelines.
+//Only pipeline breakers (hash build and nested loop inner sides, sorts,
+//merge and outer joins, unions) materialize, running their
+//functions.cpp operator
+class Executor
+{
+    public:
+        Executor() {}
+        vector<Tuple> Run(GraphIter &iter);
+
+    private:
+        //Set output tunnel to the output tunnel of the poss run for it
+        map<const Node*, const Node*> m_setOutputs;
+
+        void MapSets(GraphIter &iter);
+        Node* Resolve(const Node *node) const;
+        //Columnar type of field in the relation node reads it from,
+        //false when no relation under node has it
+        bool FieldType(const Node *node, const string &field, ColumnType &type) const;
+        ColumnType KeyType(const Node *node, const string &field) const;
+        void Produce(const Node *node, BatchSink &sink);
+        vector<Tuple> Materialize(const Node *node);
+        vector<Tuple> RunBreaker(Node *node);
+};
+
+#endif
@@ -0,0 +1,336 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoHashJoin.h"
+#include "rqoColumn.h"
+#include <unordered_map>
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+#if DORQO
+
+static int NumThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+//Murmur3 finalizer.  Partitions come from the low bits and table
+//slots from the bits above them
+static inline uint64_t HashKey(int64_t key)
+{
+    uint64_t hash = key;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void JoinIndex::orderByRight(size_t numRight)
+{
+    vector<size_t> starts(numRight + 1, 0);
+    for(auto row : m_rightRows)
+    {
+        ++starts[row + 1];
+    }
+    for(size_t row = 0; row < numRight; row++)
+    {
+        starts[row + 1] += starts[row];
+    }
+    vector<uint32_t> leftRows(size());
+    vector<uint32_t> rightRows(size());
+    for(size_t i = 0; i < size(); i++)
+    {
+        size_t pos = starts[m_rightRows[i]]++;
+        leftRows[pos] = m_leftRows[i];
+        rightRows[pos] = m_rightRows[i];
+    }
+    m_leftRows.swap(leftRows);
+    m_rightRows.swap(rightRows);
+}
+
+unsigned RadixHashJoin::RadixBits(size_t buildRows)
+{
+    unsigned bits = 0;
+    while(bits < HASHJOINMAXRADIXBITS && (buildRows >> bits) > HASHJOINPARTITIONROWS)
+    {
+        ++bits;
+    }
+    return bits;
+}
+
+//Scatters keys into partitions.  Each thread histograms and then
+//scatters its own contiguous chunk, so rows keep their input order
+//within a partition.  offsets gets numPartitions + 1 entries
+static void Partition(const int64_t *keys, size_t num, unsigned bits,
+                      vector<KeyRow> &out, vector<size_t> &offsets)
+{
+    int numPartitions = 1 << bits;
+    int numThreads = NumThreads();
+    size_t chunk = (num + numThreads - 1) / numThreads;
+    uint64_t partitionMask = numPartitions - 1;
+    vector<size_t> positions((size_t)numThreads * numPartitions, 0);
+
+#pragma omp parallel for schedule(static)
+    for(int thread = 0; thread < numThreads; thread++)
+    {
+        size_t *histogram = &positions[(size_t)thread * numPartitions];
+        size_t end = std::min(num, (thread + 1) * chunk);
+        for(size_t i = thread * chunk; i < end; i++)
+        {
+            ++histogram[HashKey(keys[i]) & partitionMask];
+        }
+    }
+
+    offsets.assign(numPartitions + 1, 0);
+    size_t running = 0;
+    for(int part = 0; part < numPartitions; part++)
+    {
+        offsets[part] = running;
+        for(int thread = 0; thread < numThreads; thread++)
+        {
+            size_t count = positions[(size_t)thread * numPartitions + part];
+            positions[(size_t)thread * numPartitions + part] = running;
+            running += count;
+        }
+    }
+    offsets[numPartitions] = running;
+
+    out.resize(num);
+#pragma omp parallel for schedule(static)
+    for(int thread = 0; thread < numThreads; thread++)
+    {
+        size_t *position = &positions[(size_t)thread * numPartitions];
+        size_t end = std::min(num, (thread + 1) * chunk);
+        for(size_t i = thread * chunk; i < end; i++)
+        {
+            KeyRow &keyRow = out[position[HashKey(keys[i]) & partitionMask]++];
+            keyRow.m_key = keys[i];
+            keyRow.m_row = i;
+        }
+    }
+}
+
+void RadixHashTable::build(const int64_t *keys, size_t num)
+{
+    if(num > HASHJOINMAXROWS)
+    {
+        cout << "Hash join inputs are limited to 2^32 - 1 rows" << endl;
+        throw;
+    }
+    m_bits = RadixHashJoin::RadixBits(num);
+    int numPartitions = 1 << m_bits;
+    Partition(keys, num, m_bits, m_rows, m_rowOffsets);
+
+    //Tables are at most half full
+    m_slotOffsets.assign(numPartitions + 1, 0);
+    for(int part = 0; part < numPartitions; part++)
+    {
+        size_t numRows = m_rowOffsets[part + 1] - m_rowOffsets[part];
+        size_t capacity = numRows ? 1 : 0;
+        while(capacity && capacity < 2 * numRows)
+        {
+            capacity <<= 1;
+        }
+        m_slotOffsets[part + 1] = m_slotOffsets[part] + capacity;
+    }
+    m_slotKeys.assign(m_slotOffsets[numPartitions], 0);
+    m_heads.assign(m_slotOffsets[numPartitions], 0);
+    m_next.assign(num, 0);
+
+#pragma omp parallel for schedule(dynamic)
+    for(int part = 0; part < numPartitions; part++)
+    {
+        size_t base = m_slotOffsets[part];
+        uint64_t slotMask = m_slotOffsets[part + 1] - base - 1;
+        //Inserted back to front so each chain lists rows in input order
+        for(size_t i = m_rowOffsets[part + 1]; i-- > m_rowOffsets[part];)
+        {
+            int64_t key = m_rows[i].m_key;
+            uint64_t slot = (HashKey(key) >> m_bits) & slotMask;
+            while(m_heads[base + slot] && m_slotKeys[base + slot] != key)
+            {
+                slot = (slot + 1) & slotMask;
+            }
+            m_next[i] = m_heads[base + slot];
+            m_heads[base + slot] = i + 1;
+            m_slotKeys[base + slot] = key;
+        }
+    }
+}
+
+inline uint32_t RadixHashTable::chain(int64_t key, uint64_t hash) const
+{
+    size_t part = hash & ((1 << m_bits) - 1);
+    size_t base = m_slotOffsets[part];
+    size_t capacity = m_slotOffsets[part + 1] - base;
+    if(!capacity)
+    {
+        return 0;
+    }
+    uint64_t slotMask = capacity - 1;
+    uint64_t slot = (hash >> m_bits) & slotMask;
+    while(m_heads[base + slot])
+    {
+        if(m_slotKeys[base + slot] == key)
+        {
+            return m_heads[base + slot];
+        }
+        slot = (slot + 1) & slotMask;
+    }
+    return 0;
+}
+
+void RadixHashTable::probe(const int64_t *keys, size_t num, const uint32_t *rows,
+                           vector<uint32_t> &buildRows, vector<uint32_t> &probeRows) const
+{
+    for(size_t i = 0; i < num; i++)
+    {
+        for(uint32_t entry = chain(keys[i], HashKey(keys[i])); entry; entry = m_next[entry - 1])
+        {
+            buildRows.push_back(m_rows[entry - 1].m_row);
+            probeRows.push_back(rows ? rows[i] : i);
+        }
+    }
+}
+
+void RadixHashTable::probe(const KeyRow *probeRows, size_t num,
+                           vector<uint32_t> &buildRows, vector<uint32_t> &probedRows) const
+{
+    for(size_t i = 0; i < num; i++)
+    {
+        int64_t key = probeRows[i].m_key;
+        for(uint32_t entry = chain(key, HashKey(key)); entry; entry = m_next[entry - 1])
+        {
+            buildRows.push_back(m_rows[entry - 1].m_row);
+            probedRows.push_back(probeRows[i].m_row);
+        }
+    }
+}
+
+void RadixHashJoin::join(const int64_t *leftKeys, size_t numLeft,
+                         const int64_t *rightKeys, size_t numRight,
+                         JoinIndex &index) const
+{
+    if(numLeft > HASHJOINMAXROWS || numRight > HASHJOINMAXROWS)
+    {
+        cout << "Hash join inputs are limited to 2^32 - 1 rows" << endl;
+        throw;
+    }
+    bool buildRight = numRight < numLeft;
+    const int64_t *buildKeys = buildRight ? rightKeys : leftKeys;
+    const int64_t *probeKeys = buildRight ? leftKeys : rightKeys;
+    size_t numBuild = buildRight ? numRight : numLeft;
+    size_t numProbe = buildRight ? numLeft : numRight;
+
+    RadixHashTable table;
+    table.build(buildKeys, numBuild);
+    unsigned bits = table.radixBits();
+    int numPartitions = 1 << bits;
+    vector<KeyRow> probe;
+    vector<size_t> probeOffsets;
+    Partition(probeKeys, numProbe, bits, probe, probeOffsets);
+
+    vector<vector<uint32_t>> buildRows(numPartitions);
+    vector<vector<uint32_t>> probeRows(numPartitions);
+#pragma omp parallel for schedule(dynamic)
+    for(int part = 0; part < numPartitions; part++)
+    {
+        table.probe(probe.data() + probeOffsets[part], probeOffsets[part + 1] - probeOffsets[part],
+                    buildRows[part], probeRows[part]);
+    }
+
+    vector<size_t> outOffsets(numPartitions + 1, 0);
+    for(int part = 0; part < numPartitions; part++)
+    {
+        outOffsets[part + 1] = outOffsets[part] + buildRows[part].size();
+    }
+    vector<uint32_t> &buildOut = buildRight ? index.m_rightRows : index.m_leftRows;
+    vector<uint32_t> &probeOut = buildRight ? index.m_leftRows : index.m_rightRows;
+    buildOut.resize(outOffsets[numPartitions]);
+    probeOut.resize(outOffsets[numPartitions]);
+#pragma omp parallel for schedule(static)
+    for(int part = 0; part < numPartitions; part++)
+    {
+        std::copy(buildRows[part].begin(), buildRows[part].end(), buildOut.begin() + outOffsets[part]);
+        std::copy(probeRows[part].begin(), probeRows[part].end(), probeOut.begin() + outOffsets[part]);
+    }
+}
+
+bool NumericJoinKeys(ColumnType type1, ColumnType type2)
+{
+    return type1 == INTCOLUMN && type2 == INTCOLUMN;
+}
+
+void JoinKeysFromTuples(const vector<Tuple> &left, int key1, ColumnType type1,
+                        const vector<Tuple> &right, int key2, ColumnType type2,
+                        vector<int64_t> &leftKeys, vector<int64_t> &rightKeys)
+{
+    leftKeys.resize(left.size());
+    rightKeys.resize(right.size());
+    bool numeric = NumericJoinKeys(type1, type2);
+    for(size_t i = 0; numeric && i < left.size(); i++)
+    {
+        numeric = ParseInt(left[i].fields.at(key1).m_value, leftKeys[i]);
+    }
+    for(size_t i = 0; numeric && i < right.size(); i++)
+    {
+        numeric = ParseInt(right[i].fields.at(key2).m_value, rightKeys[i]);
+    }
+    if(numeric)
+    {
+        return;
+    }
+
+    //Codes are at least 0, so right keys absent from left get -1 and
+    //match nothing
+    unordered_map<string, int64_t> codes;
+    for(size_t i = 0; i < left.size(); i++)
+    {
+        const string &value = left[i].fields.at(key1).m_value;
+        unordered_map<string, int64_t>::const_iterator iter = codes.find(value);
+        if(iter == codes.end())
+        {
+            int64_t code = codes.size();
+            codes.insert(pair<string, int64_t>(value, code));
+            leftKeys[i] = code;
+        }
+        else
+        {
+            leftKeys[i] = iter->second;
+        }
+    }
+    for(size_t i = 0; i < right.size(); i++)
+    {
+        unordered_map<string, int64_t>::const_iterator iter = codes.find(right[i].fields.at(key2).m_value);
+        rightKeys[i] = (iter == codes.end()) ? -1 : iter->second;
+    }
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoTuple.h"
+#include "rqoColumn.h"
+
+#if DORQO
+
+//Build rows per partition, sized so a partition's table, chains and
+//keys stay in L2
+#define HASHJOINPARTITIONROWS 4096
+//Partitioning is a single pass, more partitions than this thrash the TLB
+#define HASHJOINMAXRADIXBITS 10
+//Row ids are uint32_t and chain entries are row + 1
+#define HASHJOINMAXROWS UINT32_MAX
+
+//Row ids of matching left and right rows.  The join's output before
+//any payload is copied
+class JoinIndex
+{
+public:
+    vector<uint32_t> m_leftRows;
+    vector<uint32_t> m_rightRows;
+
+    virtual size_t size() const {return m_leftRows.size();}
+    //Stable counting sort of the pairs by right row
+    virtual void orderByRight(size_t numRight);
+};
+
+
+//A key and the row it came from
+struct KeyRow
+{
+    int64_t m_key;
+    uint32_t m_row;
+};
+
+
+//Build side of RadixHashJoin.  Keys are radix partitioned and each
+//partition gets an open addressing table whose slots hold distinct keys
+//and the head of a chain of every row with that key.  Built once, it
+//can be probed any number of times, so a pipelined join probes it a
+//batch at a time
+class RadixHashTable
+{
+public:
+    RadixHashTable() : m_bits(0) {}
+    virtual ~RadixHashTable() {}
+    virtual void build(const int64_t *keys, size_t num);
+    virtual unsigned radixBits() const {return m_bits;}
+    //Appends a pair for every build row matching a probe key.  Probe
+    //rows are taken in order and their matches come in build order.
+    //Probe row i is reported as rows[i], or i when rows is NULL
+    virtual void probe(const int64_t *keys, size_t num, const uint32_t *rows,
+                       vector<uint32_t> &buildRows, vector<uint32_t> &probeRows) const;
+    //The same for probe keys that were partitioned with radixBits()
+    virtual void probe(const KeyRow *probeRows, size_t num,
+                       vector<uint32_t> &buildRows, vector<uint32_t> &probedRows) const;
+
+private:
+    unsigned m_bits;
+    //Build rows grouped by partition, and where each partition starts
+    vector<KeyRow> m_rows;
+    vector<size_t> m_rowOffsets;
+    //Every partition's slots, and where each partition's slots start
+    vector<size_t> m_slotOffsets;
+    vector<int64_t> m_slotKeys;
+    //Entries of m_rows stored as entry + 1, so 0 is an empty slot or
+    //the end of a chain
+    vector<uint32_t> m_heads;
+    vector<uint32_t> m_next;
+
+    //Head of the chain of rows with key, 0 when there are none
+    inline uint32_t chain(int64_t key, uint64_t hash) const;
+};
+
+
+//Equi-join of two int64 key arrays.  Int and date columns pass their
+//values directly, other keys are first encoded by JoinKeysFromTuples.
+//The smaller side is built into a RadixHashTable, whose chains keep
+//every duplicate build row, so many-to-many joins are complete.  The
+//probe side is partitioned the same way and each partition is probed
+//against its build partition.  Partitioning, build and probe run
+//across OpenMP threads
+class RadixHashJoin
+{
+public:
+    virtual void join(const int64_t *leftKeys, size_t numLeft,
+                      const int64_t *rightKeys, size_t numRight,
+                      JoinIndex &index) const;
+    static unsigned RadixBits(size_t buildRows);
+};
+
+//True when keys of columns of type1 and type2 are joined on their
+//integer values.  Other keys are equal only when their text is, as
+//in nestedJoin, so "007" matches "7" in int columns only
+bool NumericJoinKeys(ColumnType type1, ColumnType type2);
+
+//Typed keys for field key1 of left and key2 of right, whose columns
+//have type1 and type2.  Keys stay numeric when NumericJoinKeys and
+//every key parses, otherwise they are coded through a dictionary
+//shared by both sides
+void JoinKeysFromTuples(const vector<Tuple> &left, int key1, ColumnType type1,
+                        const vector<Tuple> &right, int key2, ColumnType type2,
+                        vector<int64_t> &leftKeys, vector<int64_t> &rightKeys);
+
+
+#endif
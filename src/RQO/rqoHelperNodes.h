@@ -27,6 +27,8 @@
 #include "node.h"
 #include "rqoBasis.h"
 #include "rqoRelation.h"
+#include "rqoCostModel.h"
+#include "rqoStatistics.h"
 #include "transform.h"
 #include <climits>
 
@@ -66,8 +68,9 @@ class InputNode : public Node
   virtual void ClearDataTypeCache() {}
   virtual void BuildDataTypeCache() {}
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
-  virtual int Outputs() {return m_relation->getSize();}
+  virtual int Outputs() {return RowsToInt(EstimateRows(m_relation, m_query));}
   virtual void SetRelation(Relation *relation) {m_relation = relation;}
+  virtual Relation* GetRelation() {return m_relation;}
 };
 
 class OutputNode : public Node
@@ -0,0 +1,343 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoIndex.h"
+#include "rqoRelation.h"
+#include "rqoColumnarRelation.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#if DORQO
+
+int64_t DoubleKey(double value)
+{
+    if(value == 0)
+    {
+        value = 0;
+    }
+    int64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    //Negative doubles order backwards by their bits
+    return (bits >= 0) ? bits : (bits ^ INT64_MAX);
+}
+
+int64_t IndexKey(const ColumnView &column, size_t row)
+{
+    if(column.m_type == DOUBLECOLUMN)
+    {
+        return DoubleKey(column.m_doubles[row]);
+    }
+    return column.m_ints[row];
+}
+
+static bool Indexable(const ColumnView &column, size_t row)
+{
+    return !column.isNull(row)
+        && !(column.m_type == DOUBLECOLUMN && std::isnan(column.m_doubles[row]));
+}
+
+HashIndex::HashIndex(const ColumnView &column)
+{
+    for(size_t row = 0; row < column.size(); row++)
+    {
+        if(Indexable(column, row))
+        {
+            m_runs[IndexKey(column, row)].second++;
+        }
+    }
+    uint32_t first = 0;
+    for(auto &run : m_runs)
+    {
+        run.second.first = first;
+        first += run.second.second;
+        run.second.second = 0;
+    }
+    m_rows.resize(first);
+    for(size_t row = 0; row < column.size(); row++)
+    {
+        if(Indexable(column, row))
+        {
+            pair<uint32_t, uint32_t> &run = m_runs[IndexKey(column, row)];
+            m_rows[run.first + run.second++] = row;
+        }
+    }
+}
+
+bool HashIndex::lookup(int64_t low, int64_t high, SelectionVector &rows) const
+{
+    if(low != high)
+    {
+        return false;
+    }
+    auto found = m_runs.find(low);
+    if(found != m_runs.end())
+    {
+        const uint32_t *first = m_rows.data() + found->second.first;
+        rows.insert(rows.end(), first, first + found->second.second);
+    }
+    return true;
+}
+
+SortedIndex::SortedIndex(const ColumnView &column)
+{
+    vector<pair<int64_t, uint32_t>> entries;
+    entries.reserve(column.size());
+    for(size_t row = 0; row < column.size(); row++)
+    {
+        if(Indexable(column, row))
+        {
+            entries.push_back(pair<int64_t, uint32_t>(IndexKey(column, row), row));
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    m_keys.resize(entries.size());
+    m_rows.resize(entries.size());
+    for(size_t i = 0; i < entries.size(); i++)
+    {
+        m_keys[i] = entries[i].first;
+        m_rows[i] = entries[i].second;
+    }
+
+    const vector<int64_t> *below = &m_keys;
+    while(below->size() > RQOINDEXFANOUT)
+    {
+        vector<int64_t> level;
+        level.reserve(below->size() / RQOINDEXFANOUT + 1);
+        for(size_t i = 0; i < below->size(); i += RQOINDEXFANOUT)
+        {
+            level.push_back((*below)[i]);
+        }
+        m_levels.push_back(level);
+        below = &m_levels.back();
+    }
+}
+
+size_t SortedIndex::lowerBound(int64_t key) const
+{
+    //If pos keys of a level are < key, then below it the first key
+    //>= key lies in ((pos - 1) * fanout, pos * fanout]
+    size_t begin = 0;
+    size_t end = m_levels.empty() ? m_keys.size() : m_levels.back().size();
+    for(int l = (int)m_levels.size() - 1; l >= 0; l--)
+    {
+        const vector<int64_t> &level = m_levels[l];
+        size_t pos = std::lower_bound(level.begin() + begin, level.begin() + end, key) - level.begin();
+        size_t belowSize = l ? m_levels[l - 1].size() : m_keys.size();
+        begin = pos ? (pos - 1) * RQOINDEXFANOUT + 1 : 0;
+        end = std::min(belowSize, pos * RQOINDEXFANOUT);
+    }
+    return std::lower_bound(m_keys.begin() + begin, m_keys.begin() + end, key) - m_keys.begin();
+}
+
+bool SortedIndex::lookup(int64_t low, int64_t high, SelectionVector &rows) const
+{
+    if(low > high)
+    {
+        return true;
+    }
+    size_t first = lowerBound(low);
+    size_t last = (high == INT64_MAX) ? m_keys.size() : lowerBound(high + 1);
+    if(first < last)
+    {
+        rows.insert(rows.end(), m_rows.begin() + first, m_rows.begin() + last);
+    }
+    return true;
+}
+
+static bool SameColumn(const ColumnView &one, const ColumnView &two)
+{
+    return one.m_ints == two.m_ints && one.m_doubles == two.m_doubles && one.m_size == two.m_size;
+}
+
+//Key ranges of column covering every row term can match.  False when
+//term does not constrain column
+static bool TermKeys(const vector<ColumnKernel> &term, const ColumnView &column,
+                     vector<pair<int64_t, int64_t>> &ranges)
+{
+    ranges.clear();
+    int64_t low = INT64_MIN;
+    int64_t high = INT64_MAX;
+    bool constrained = false;
+    const ColumnKernel *in = NULL;
+    for(auto &kernel : term)
+    {
+        if(kernel.m_type == FALSEKERNEL)
+        {
+            return true;
+        }
+        if(!SameColumn(kernel.m_column, column))
+        {
+            continue;
+        }
+        if(kernel.m_type == INTRANGEKERNEL)
+        {
+            low = std::max(low, kernel.m_low);
+            high = std::min(high, kernel.m_high);
+            constrained = true;
+        }
+        else if(kernel.m_type == INTINKERNEL)
+        {
+            in = &kernel;
+            constrained = true;
+        }
+        else if(kernel.m_type == DOUBLECOMPAREKERNEL && kernel.m_op != NOTEQUALOP)
+        {
+            if(std::isnan(kernel.m_value))
+            {
+                return true;
+            }
+            int64_t key = DoubleKey(kernel.m_value);
+            if(kernel.m_op == EQUALOP || kernel.m_op == LESSEQUALOP)
+            {
+                high = std::min(high, key);
+            }
+            if(kernel.m_op == EQUALOP || kernel.m_op == GREATEREQUALOP)
+            {
+                low = std::max(low, key);
+            }
+            if(kernel.m_op == LESSOP)
+            {
+                high = std::min(high, key - 1);
+            }
+            if(kernel.m_op == GREATEROP)
+            {
+                low = std::max(low, key + 1);
+            }
+            constrained = true;
+        }
+    }
+    if(!constrained)
+    {
+        return false;
+    }
+    if(in)
+    {
+        vector<int64_t> values = in->m_inValues;
+        for(size_t i = 0; i < in->m_inTable.size(); i++)
+        {
+            if(in->m_inTable[i])
+            {
+                values.push_back(in->m_low + i);
+            }
+        }
+        for(auto value : values)
+        {
+            if(value >= low && value <= high)
+            {
+                ranges.push_back(pair<int64_t, int64_t>(value, value));
+            }
+        }
+    }
+    else if(low <= high)
+    {
+        ranges.push_back(pair<int64_t, int64_t>(low, high));
+    }
+    return true;
+}
+
+//Rows the index on column narrows predicate to, ascending and unique.
+//False when the index cannot answer some term
+static bool IndexCandidates(const BatchPredicate &predicate, const ColumnView &column,
+                            const ColumnIndex &index, SelectionVector &rows)
+{
+    rows.clear();
+    vector<pair<int64_t, int64_t>> ranges;
+    for(auto &term : predicate.m_terms)
+    {
+        if(!TermKeys(term, column, ranges))
+        {
+            return false;
+        }
+        for(auto &range : ranges)
+        {
+            if(!index.lookup(range.first, range.second, rows))
+            {
+                rows.clear();
+                return false;
+            }
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return true;
+}
+
+void HashIndexSelect(Relation &table, const BatchPredicate &predicate,
+                     const set<int> &columns, SelectionVector &rows)
+{
+    bool indexed = false;
+    SelectionVector candidates;
+    SelectionVector both;
+    for(auto index : columns)
+    {
+        ColumnView column = table.getColumns()->getColumn(index);
+        if(!IndexCandidates(predicate, column, table.getHashIndex(index), candidates))
+        {
+            continue;
+        }
+        if(!indexed)
+        {
+            rows.swap(candidates);
+            indexed = true;
+            continue;
+        }
+        both.clear();
+        std::set_intersection(rows.begin(), rows.end(), candidates.begin(), candidates.end(),
+                              std::back_inserter(both));
+        rows.swap(both);
+    }
+    if(!indexed)
+    {
+        predicate.select(rows);
+        return;
+    }
+    predicate.filter(rows);
+}
+
+void SortedIndexSelect(Relation &table, const BatchPredicate &predicate,
+                       int column, SelectionVector &rows)
+{
+    ColumnView view = table.getColumns()->getColumn(column);
+    if(IndexCandidates(predicate, view, table.getSortedIndex(column), rows))
+    {
+        predicate.filter(rows);
+    }
+    else
+    {
+        predicate.select(rows);
+    }
+    //Nulls first, as their empty values sort in a Tuple
+    std::stable_sort(rows.begin(), rows.end(),
+                     [&view](uint32_t one, uint32_t two)
+                     {
+                         if(view.isNull(one) || view.isNull(two))
+                         {
+                             return view.isNull(one) && !view.isNull(two);
+                         }
+                         return IndexKey(view, one) < IndexKey(view, two);
+                     });
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoColumn.h"
+#include "rqoBatchPredicate.h"
+#include "rqoCostModel.h"
+#include <unordered_map>
+
+#if DORQO
+
+class Relation;
+
+//Key of a row of column in an index.  Int, date and string columns
+//use their stored value or code, doubles are mapped through their bits
+//so that key order is value order
+int64_t IndexKey(const ColumnView &column, size_t row);
+int64_t DoubleKey(double value);
+
+//Row ids of one column by key, built once per relation and column.
+//Null rows, and NaN doubles, match no clause so are left out
+class ColumnIndex
+{
+public:
+    virtual ~ColumnIndex() {}
+    //Appends the rows with keys in [low, high].  False, appending
+    //nothing, when the index cannot answer that range
+    virtual bool lookup(int64_t low, int64_t high, SelectionVector &rows) const = 0;
+};
+
+//Point lookups in one probe.  Row ids are stored grouped by key, in
+//row order, so a key's rows are a single contiguous run
+class HashIndex : public ColumnIndex
+{
+public:
+    HashIndex(const ColumnView &column);
+    //Only single keys, low == high
+    virtual bool lookup(int64_t low, int64_t high, SelectionVector &rows) const;
+
+private:
+    //First row id in m_rows and number of rows of each key
+    unordered_map<int64_t, pair<uint32_t, uint32_t>> m_runs;
+    vector<uint32_t> m_rows;
+};
+
+//Keys and row ids sorted by key then row, under a static B+-tree of
+//separator keys.  Each level above m_keys keeps the first key of every
+//RQOINDEXFANOUT keys below it, so a search reads one node per level
+class SortedIndex : public ColumnIndex
+{
+public:
+    SortedIndex(const ColumnView &column);
+    //Rows come out in key order
+    virtual bool lookup(int64_t low, int64_t high, SelectionVector &rows) const;
+    //Position of the first key >= key
+    virtual size_t lowerBound(int64_t key) const;
+
+private:
+    vector<int64_t> m_keys;
+    vector<uint32_t> m_rows;
+    //m_levels[0] is directly above m_keys, the last level is the root
+    vector<vector<int64_t>> m_levels;
+};
+
+//Rows of table matching predicate, ascending.  The hash index of
+//every column in columns that narrows each term of predicate is
+//probed and the row ids intersected before the rest of predicate is
+//tested.  With no such column the whole table is evaluated
+void HashIndexSelect(Relation &table, const BatchPredicate &predicate,
+                     const set<int> &columns, SelectionVector &rows);
+//Rows of table matching predicate in order of column, ties in table
+//order.  Read from the sorted index when it narrows each term,
+//otherwise found by evaluating the table and sorted
+void SortedIndexSelect(Relation &table, const BatchPredicate &predicate,
+                       int column, SelectionVector &rows);
+
+#endif
@@ -29,7 +29,8 @@
 #if DORQO
 
 Join::Join()
-  : Sortable()
+  : Sortable(),
+    m_rows(-1)
 {
 
 }
@@ -38,6 +39,7 @@ Join::Join(string sortBy,
 	   vector<string> in0Fields, 
 	   vector<string> in1Fields)
   : Sortable(sortBy),
+    m_rows(-1),
     m_in0Fields(in0Fields),
     m_in1Fields(in1Fields)
 {
@@ -81,10 +83,19 @@ void Join::ClearDataTypeCache()
 
 void Join::BuildDataTypeCache()
 {
+  m_rows = -1;
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  m_dataTypeInfo.KeepOrder(InputDataType(0));
+}
+
+double Join::Rows()
+{
+  if (m_rows < 0)
+    m_rows = JoinRows(this);
+  return m_rows;
 }
 
 void Join::Prop()
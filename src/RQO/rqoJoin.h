@@ -35,7 +35,10 @@ class Join : public Sortable
 {
  protected:
   DataTypeInfo m_dataTypeInfo;
-  
+  //Estimated rows, -1 until asked for.  Estimates read their inputs'
+  //estimates, so caching them keeps a deep tree linear to cost, and
+  //they are dropped each time the data type cache is rebuilt
+  double m_rows;
 
  public:
   vector<string> m_in0Fields;
@@ -58,7 +61,8 @@ class Join : public Sortable
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
   virtual bool IsJoin() const {return true;}
   virtual Join* CreateCopyOfJoin() const;
-  virtual int Outputs() {return (Input(0)->Outputs() > Input(1)->Outputs()) ? Input(0)-> Outputs() : Input(1)->Outputs();}
+  virtual double Rows();
+  virtual int Outputs() {return RowsToInt(Rows());}
 };
 
 class SwapNodes : public SingleTrans
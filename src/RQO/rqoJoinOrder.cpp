@@ -0,0 +1,560 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoJoinOrder.h"
+#include "hJoin.h"
+#include "mJoin.h"
+#include "nJoin.h"
+#include "rqoCostModel.h"
+#include "rqoStatistics.h"
+#include <algorithm>
+
+#if DORQO
+
+static inline uint64_t Bit(int index)
+{
+    return ((uint64_t)1) << index;
+}
+
+//Bits 0 to count - 1
+static inline uint64_t LowBits(int count)
+{
+    return (count >= 64) ? ~((uint64_t)0) : (Bit(count) - 1);
+}
+
+static inline int LowestBit(uint64_t set)
+{
+    return __builtin_ctzll(set);
+}
+
+static inline int NumBits(uint64_t set)
+{
+    return __builtin_popcountll(set);
+}
+
+JoinGraph::JoinGraph(Join *root)
+{
+    addJoin(root);
+    m_neighbors.assign(m_leaves.size(), 0);
+    for(auto &predicate : m_predicates)
+    {
+        m_neighbors[predicate.m_left] |= Bit(predicate.m_right);
+        m_neighbors[predicate.m_right] |= Bit(predicate.m_left);
+    }
+}
+
+bool JoinGraph::InTree(const Node *node)
+{
+    return node->GetNodeClass() == Join::GetClass() && node->m_children.size() == 1
+        && node->m_children[0]->m_n->GetNodeClass() == Join::GetClass();
+}
+
+bool JoinGraph::IsRoot(const Node *node)
+{
+    return node->GetNodeClass() == Join::GetClass() && !InTree(node);
+}
+
+void JoinGraph::addJoin(Join *join)
+{
+    size_t begin = m_leaves.size();
+    size_t middle = begin;
+    for(ConnNum num = 0; num < 2; num++)
+    {
+        Node *input = join->Input(num);
+        if(InTree(input))
+        {
+            addJoin((Join*)input);
+        }
+        else if(m_leaves.size() < RQOJOINMAXRELATIONS)
+        {
+            const DataTypeInfo &type = join->InputDataType(num);
+            m_leaves.push_back(input);
+            m_leafConns.push_back(join->InputConnNum(num));
+            m_leafFields.push_back(type.m_fields);
+            m_leafOrders.push_back(type.m_orderedBy);
+        }
+        else
+        {
+            cout << "Join trees are limited to " << RQOJOINMAXRELATIONS << " inputs" << endl;
+            throw;
+        }
+        if(num == 0)
+        {
+            middle = m_leaves.size();
+        }
+    }
+    for(size_t i = 0; i < join->m_in0Fields.size(); i++)
+    {
+        JoinPredicate predicate;
+        predicate.m_leftField = join->m_in0Fields[i];
+        predicate.m_rightField = join->m_in1Fields.at(i);
+        predicate.m_left = findLeaf(predicate.m_leftField, begin, middle);
+        predicate.m_right = findLeaf(predicate.m_rightField, middle, m_leaves.size());
+        m_predicates.push_back(predicate);
+    }
+}
+
+int JoinGraph::findLeaf(const string &field, size_t begin, size_t end) const
+{
+    for(size_t leaf = begin; leaf < end; leaf++)
+    {
+        if(m_leafFields[leaf].find(field) != m_leafFields[leaf].end())
+        {
+            return leaf;
+        }
+    }
+    cout << "No input of the join has field " << field << endl;
+    throw;
+}
+
+uint64_t JoinGraph::neighborhood(uint64_t set) const
+{
+    uint64_t neighbors = 0;
+    for(uint64_t rest = set; rest; rest &= rest - 1)
+    {
+        neighbors |= m_neighbors[LowestBit(rest)];
+    }
+    return neighbors & ~set;
+}
+
+
+JoinEnumerator::JoinEnumerator(const JoinGraph &graph, string sortBy)
+    : m_graph(graph),
+      m_sortBy(sortBy)
+{
+    size_t numLeaves = m_graph.m_leaves.size();
+    m_all = LowBits(numLeaves);
+    for(size_t leaf = 0; leaf < numLeaves; leaf++)
+    {
+        m_leafRows.push_back(std::max(1, m_graph.m_leaves[leaf]->Outputs()));
+    }
+    //Each predicate's selectivity as JoinRows estimates it.  A key with
+    //no statistics is taken to be unique
+    for(auto &predicate : m_graph.m_predicates)
+    {
+        double leftDistinct = EstimateDistinct(m_graph.m_leaves[predicate.m_left], predicate.m_leftField);
+        double rightDistinct = EstimateDistinct(m_graph.m_leaves[predicate.m_right], predicate.m_rightField);
+        m_selectivity.push_back(EstimateJoinSelectivity(leftDistinct ? leftDistinct : m_leafRows[predicate.m_left],
+                                                        rightDistinct ? rightDistinct : m_leafRows[predicate.m_right]));
+    }
+}
+
+double JoinEnumerator::rows(uint64_t set)
+{
+    unordered_map<uint64_t, double>::const_iterator found = m_rows.find(set);
+    if(found != m_rows.end())
+    {
+        return found->second;
+    }
+    double estimate = 1;
+    for(uint64_t rest = set; rest; rest &= rest - 1)
+    {
+        estimate *= m_leafRows[LowestBit(rest)];
+    }
+    for(size_t i = 0; i < m_graph.m_predicates.size(); i++)
+    {
+        const JoinPredicate &predicate = m_graph.m_predicates[i];
+        if((set & Bit(predicate.m_left)) && (set & Bit(predicate.m_right)))
+        {
+            estimate *= m_selectivity[i];
+        }
+    }
+    m_rows[set] = estimate;
+    return estimate;
+}
+
+//The field pairs of the predicates between left and right, oriented so
+//in0Fields come from left.  False when there are none
+bool JoinEnumerator::joinFields(uint64_t left, uint64_t right,
+                                vector<string> &in0Fields, vector<string> &in1Fields) const
+{
+    in0Fields.clear();
+    in1Fields.clear();
+    for(auto &predicate : m_graph.m_predicates)
+    {
+        if((left & Bit(predicate.m_left)) && (right & Bit(predicate.m_right)))
+        {
+            in0Fields.push_back(predicate.m_leftField);
+            in1Fields.push_back(predicate.m_rightField);
+        }
+        else if((left & Bit(predicate.m_right)) && (right & Bit(predicate.m_left)))
+        {
+            in0Fields.push_back(predicate.m_rightField);
+            in1Fields.push_back(predicate.m_leftField);
+        }
+    }
+    return !in0Fields.empty();
+}
+
+//Whether rows of set in order could save a later sort: order is a
+//field of a predicate still to be applied, or the root's sort by
+bool JoinEnumerator::interesting(uint64_t set, const string &order) const
+{
+    if(order.empty())
+    {
+        return false;
+    }
+    if(set == m_all)
+    {
+        return order == m_sortBy;
+    }
+    for(auto &predicate : m_graph.m_predicates)
+    {
+        bool hasLeft = set & Bit(predicate.m_left);
+        bool hasRight = set & Bit(predicate.m_right);
+        if((hasLeft && !hasRight && predicate.m_leftField == order)
+            || (hasRight && !hasLeft && predicate.m_rightField == order))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Adds plan unless a plan as cheap has its order or plan's order is of
+//no use, then drops the plans plan dominates
+void JoinEnumerator::addPlan(uint64_t set, JoinPlan &plan)
+{
+    if(!interesting(set, plan.m_orderedBy))
+    {
+        plan.m_orderedBy = "";
+    }
+    vector<JoinPlan> &plans = m_plans[set];
+    for(auto &other : plans)
+    {
+        if(other.m_cost <= plan.m_cost
+            && (other.m_orderedBy == plan.m_orderedBy || plan.m_orderedBy.empty()))
+        {
+            return;
+        }
+    }
+    vector<JoinPlan> kept;
+    for(auto &other : plans)
+    {
+        if(!(plan.m_cost <= other.m_cost
+             && (other.m_orderedBy == plan.m_orderedBy || other.m_orderedBy.empty())))
+        {
+            kept.push_back(other);
+        }
+    }
+    kept.push_back(plan);
+    plans.swap(kept);
+}
+
+//Every plan of left joined with every plan of right, by each method
+void JoinEnumerator::joinSets(uint64_t left, uint64_t right)
+{
+    vector<string> in0Fields, in1Fields;
+    if(!joinFields(left, right, in0Fields, in1Fields))
+    {
+        return;
+    }
+    double leftRows = rows(left);
+    double rightRows = rows(right);
+    double out = rows(left | right);
+    //Copied since adding plans to the union can grow the table
+    vector<JoinPlan> leftPlans = m_plans[left];
+    vector<JoinPlan> rightPlans = m_plans[right];
+    for(size_t leftPlan = 0; leftPlan < leftPlans.size(); leftPlan++)
+    {
+        for(size_t rightPlan = 0; rightPlan < rightPlans.size(); rightPlan++)
+        {
+            const JoinPlan &in0 = leftPlans[leftPlan];
+            const JoinPlan &in1 = rightPlans[rightPlan];
+            JoinPlan plan;
+            plan.m_left = left;
+            plan.m_right = right;
+            plan.m_leftPlan = leftPlan;
+            plan.m_rightPlan = rightPlan;
+            Cost inputs = in0.m_cost + in1.m_cost;
+
+            //Orders follow each join node's BuildDataTypeCache
+            plan.m_method = HASHJOINMETHOD;
+            plan.m_cost = inputs + HashJoinCost(leftRows, rightRows, out);
+            plan.m_orderedBy = in1.m_orderedBy;
+            addPlan(left | right, plan);
+
+            plan.m_method = MERGEJOINMETHOD;
+            plan.m_cost = inputs + MergeJoinCost(leftRows, in0.m_orderedBy == in0Fields[0],
+                                                 rightRows, in1.m_orderedBy == in1Fields[0], out);
+            plan.m_orderedBy = in0Fields[0];
+            addPlan(left | right, plan);
+
+            plan.m_method = NESTEDJOINMETHOD;
+            plan.m_cost = inputs + NestedJoinCost(leftRows, rightRows, out);
+            plan.m_orderedBy = in0.m_orderedBy;
+            addPlan(left | right, plan);
+        }
+    }
+}
+
+void JoinEnumerator::enumerateCsgRec(uint64_t set, uint64_t excluded,
+                                     vector<pair<uint64_t, uint64_t>> &pairs) const
+{
+    uint64_t neighbors = m_graph.neighborhood(set) & ~excluded;
+    for(uint64_t subset = neighbors; subset && pairs.size() <= RQOJOINDPMAXPAIRS;
+        subset = (subset - 1) & neighbors)
+    {
+        emitCsg(set | subset, pairs);
+    }
+    for(uint64_t subset = neighbors; subset && pairs.size() <= RQOJOINDPMAXPAIRS;
+        subset = (subset - 1) & neighbors)
+    {
+        enumerateCsgRec(set | subset, excluded | neighbors, pairs);
+    }
+}
+
+//Finds the complements of the connected set, each connected and
+//joined to set by a predicate
+void JoinEnumerator::emitCsg(uint64_t set, vector<pair<uint64_t, uint64_t>> &pairs) const
+{
+    uint64_t excluded = set | LowBits(LowestBit(set) + 1);
+    uint64_t neighbors = m_graph.neighborhood(set) & ~excluded;
+    for(int leaf = m_graph.m_leaves.size() - 1; leaf >= 0; leaf--)
+    {
+        if(neighbors & Bit(leaf))
+        {
+            pairs.push_back(pair<uint64_t, uint64_t>(set, Bit(leaf)));
+            enumerateCmpRec(set, Bit(leaf), excluded | (LowBits(leaf + 1) & neighbors), pairs);
+        }
+    }
+}
+
+void JoinEnumerator::enumerateCmpRec(uint64_t set1, uint64_t set2, uint64_t excluded,
+                                     vector<pair<uint64_t, uint64_t>> &pairs) const
+{
+    uint64_t neighbors = m_graph.neighborhood(set2) & ~excluded;
+    for(uint64_t subset = neighbors; subset && pairs.size() <= RQOJOINDPMAXPAIRS;
+        subset = (subset - 1) & neighbors)
+    {
+        pairs.push_back(pair<uint64_t, uint64_t>(set1, set2 | subset));
+    }
+    for(uint64_t subset = neighbors; subset && pairs.size() <= RQOJOINDPMAXPAIRS;
+        subset = (subset - 1) & neighbors)
+    {
+        enumerateCmpRec(set1, set2 | subset, excluded | neighbors, pairs);
+    }
+}
+
+//False, joining nothing, when there are too many pairs
+bool JoinEnumerator::enumerateDP()
+{
+    vector<pair<uint64_t, uint64_t>> pairs;
+    for(int leaf = m_graph.m_leaves.size() - 1; leaf >= 0 && pairs.size() <= RQOJOINDPMAXPAIRS; leaf--)
+    {
+        emitCsg(Bit(leaf), pairs);
+        enumerateCsgRec(Bit(leaf), LowBits(leaf + 1), pairs);
+    }
+    if(pairs.size() > RQOJOINDPMAXPAIRS)
+    {
+        return false;
+    }
+    //Smaller unions first, so both sides of a pair are final when it
+    //is joined
+    std::stable_sort(pairs.begin(), pairs.end(),
+                     [](const pair<uint64_t, uint64_t> &a, const pair<uint64_t, uint64_t> &b)
+                     {return NumBits(a.first | a.second) < NumBits(b.first | b.second);});
+    for(auto &setPair : pairs)
+    {
+        joinSets(setPair.first, setPair.second);
+        joinSets(setPair.second, setPair.first);
+    }
+    return true;
+}
+
+void JoinEnumerator::enumerateGreedy()
+{
+    vector<uint64_t> parts;
+    for(size_t leaf = 0; leaf < m_graph.m_leaves.size(); leaf++)
+    {
+        parts.push_back(Bit(leaf));
+    }
+    while(parts.size() > 1)
+    {
+        size_t bestLeft = 0;
+        size_t bestRight = 0;
+        Cost bestCost = -1;
+        for(size_t left = 0; left < parts.size(); left++)
+        {
+            for(size_t right = left + 1; right < parts.size(); right++)
+            {
+                uint64_t set = parts[left] | parts[right];
+                if(!(m_graph.neighborhood(parts[left]) & parts[right]))
+                {
+                    continue;
+                }
+                if(m_plans.find(set) == m_plans.end())
+                {
+                    joinSets(parts[left], parts[right]);
+                    joinSets(parts[right], parts[left]);
+                }
+                Cost cost = m_plans[set].front().m_cost;
+                for(auto &plan : m_plans[set])
+                {
+                    cost = std::min(cost, plan.m_cost);
+                }
+                if(bestCost < 0 || cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestLeft = left;
+                    bestRight = right;
+                }
+            }
+        }
+        if(bestCost < 0)
+        {
+            cout << "Join graph is not connected" << endl;
+            throw;
+        }
+        parts[bestLeft] |= parts[bestRight];
+        parts.erase(parts.begin() + bestRight);
+    }
+}
+
+int JoinEnumerator::buildTree(uint64_t set, size_t index, JoinTree &tree) const
+{
+    const JoinPlan &plan = m_plans.at(set).at(index);
+    if(!plan.m_left)
+    {
+        return ~LowestBit(set);
+    }
+    JoinStep step;
+    step.m_left = buildTree(plan.m_left, plan.m_leftPlan, tree);
+    step.m_right = buildTree(plan.m_right, plan.m_rightPlan, tree);
+    step.m_method = plan.m_method;
+    joinFields(plan.m_left, plan.m_right, step.m_in0Fields, step.m_in1Fields);
+    tree.push_back(step);
+    return tree.size() - 1;
+}
+
+void JoinEnumerator::enumerate(vector<JoinTree> &trees)
+{
+    m_plans.clear();
+    for(size_t leaf = 0; leaf < m_graph.m_leaves.size(); leaf++)
+    {
+        JoinPlan plan;
+        plan.m_cost = 0;
+        plan.m_orderedBy = m_graph.m_leafOrders[leaf];
+        plan.m_method = HASHJOINMETHOD;
+        plan.m_left = 0;
+        plan.m_right = 0;
+        plan.m_leftPlan = 0;
+        plan.m_rightPlan = 0;
+        addPlan(Bit(leaf), plan);
+    }
+    if(!enumerateDP())
+    {
+        enumerateGreedy();
+    }
+
+    const vector<JoinPlan> &plans = m_plans[m_all];
+    vector<size_t> order(plans.size());
+    for(size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&plans](size_t a, size_t b) {return plans[a].m_cost < plans[b].m_cost;});
+    trees.clear();
+    for(auto index : order)
+    {
+        trees.push_back(JoinTree());
+        buildTree(m_all, index, trees.back());
+    }
+}
+
+
+int EnumerateJoins::CanApply(const Node *node, void **cache) const
+{
+    if(node->GetNodeClass() != Join::GetClass())
+    {
+        throw;
+    }
+    if(!JoinGraph::IsRoot(node))
+    {
+        return 0;
+    }
+    Join *root = (Join*)node;
+    JoinGraph graph(root);
+    JoinEnumerator enumerator(graph, root->m_sortBy);
+    vector<JoinTree> *trees = new vector<JoinTree>;
+    enumerator.enumerate(*trees);
+    *cache = trees;
+    return trees->size();
+}
+
+//The node a step input refers to, a leaf or an earlier join
+static Node* StepInput(int input, const JoinGraph &graph, const vector<Join*> &joins, ConnNum &num)
+{
+    if(input < 0)
+    {
+        num = graph.m_leafConns[~input];
+        return graph.m_leaves[~input];
+    }
+    num = 0;
+    return joins[input];
+}
+
+void EnumerateJoins::Apply(int num, Node *node, void **cache) const
+{
+    const JoinTree &tree = ((vector<JoinTree>*)(*cache))->at(num);
+    Join *root = (Join*)node;
+    //Leaves are found in the same order in this copy of the poss
+    JoinGraph graph(root);
+    vector<Join*> joins;
+    for(size_t i = 0; i < tree.size(); i++)
+    {
+        const JoinStep &step = tree[i];
+        string sortBy = (i + 1 == tree.size()) ? root->m_sortBy : "";
+        Join *join;
+        if(step.m_method == HASHJOINMETHOD)
+        {
+            join = new HJoin(sortBy, step.m_in0Fields, step.m_in1Fields);
+        }
+        else if(step.m_method == MERGEJOINMETHOD)
+        {
+            join = new MJoin(sortBy, step.m_in0Fields, step.m_in1Fields);
+        }
+        else
+        {
+            join = new NJoin(sortBy, step.m_in0Fields, step.m_in1Fields);
+        }
+        node->m_poss->AddNode(join);
+        ConnNum inputNum;
+        Node *input = StepInput(step.m_left, graph, joins, inputNum);
+        join->AddInput(input, inputNum);
+        input = StepInput(step.m_right, graph, joins, inputNum);
+        join->AddInput(input, inputNum);
+        joins.push_back(join);
+    }
+    node->RedirectChildren(joins.back());
+    node->m_poss->DeleteChildAndCleanUp(node);
+}
+
+void EnumerateJoins::CleanCache(void **cache) const
+{
+    delete (vector<JoinTree>*)(*cache);
+    *cache = NULL;
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoJoin.h"
+#include "transform.h"
+#include <unordered_map>
+
+#if DORQO
+
+//Relation sets are bits of a uint64_t
+#define RQOJOINMAXRELATIONS 64
+//Connected subgraph and complement pairs dynamic programming may join
+//before giving way to greedy joining.  A chain of 64 relations has
+//about 44000, a star of 14 about 53000
+#define RQOJOINDPMAXPAIRS 50000
+
+enum JoinMethod
+{
+    HASHJOINMETHOD,
+    MERGEJOINMETHOD,
+    NESTEDJOINMETHOD
+};
+
+//One join of a chosen tree.  Inputs are ~leaf for a leaf of the
+//JoinGraph or the index of an earlier step.  The last step is the root
+class JoinStep
+{
+public:
+    int m_left;
+    int m_right;
+    JoinMethod m_method;
+    vector<string> m_in0Fields;
+    vector<string> m_in1Fields;
+};
+
+typedef vector<JoinStep> JoinTree;
+
+
+//An equality between a field of one leaf and a field of another
+class JoinPredicate
+{
+public:
+    int m_left;
+    int m_right;
+    string m_leftField;
+    string m_rightField;
+};
+
+//The inputs under a tree of logical Join nodes and the predicates
+//between them.  Leaves are in left to right order, and each of a
+//join's field pairs is bound to the leftmost leaf on each side that
+//has the field, which is the field the executor would find
+class JoinGraph
+{
+public:
+    vector<Node*> m_leaves;
+    vector<ConnNum> m_leafConns;
+    vector<set<string>> m_leafFields;
+    vector<string> m_leafOrders;
+    vector<JoinPredicate> m_predicates;
+    vector<uint64_t> m_neighbors;
+
+    JoinGraph(Join *root);
+    virtual ~JoinGraph() {}
+    //Leaves outside set joined by a predicate to one of set's leaves
+    virtual uint64_t neighborhood(uint64_t set) const;
+    //A logical join that only feeds another logical join is part of
+    //that join's tree
+    static bool InTree(const Node *node);
+    static bool IsRoot(const Node *node);
+
+private:
+    void addJoin(Join *join);
+    int findLeaf(const string &field, size_t begin, size_t end) const;
+};
+
+
+//Join orders for a JoinGraph.  Dynamic programming over connected
+//subgraph and complement pairs (DPccp), so cross products are never
+//considered and each pair is generated once.  Every pair is tried
+//both ways around with each join method, costed with the operator
+//cost model.  For each relation set the plans kept are the Pareto
+//front over cost and output order, where only orders a later merge
+//join or the root's sort by could use count.  Graphs with too many
+//pairs are joined greedily, cheapest join first
+class JoinEnumerator
+{
+public:
+    JoinEnumerator(const JoinGraph &graph, string sortBy);
+    virtual ~JoinEnumerator() {}
+    //The Pareto optimal trees of all the leaves, cheapest first
+    virtual void enumerate(vector<JoinTree> &trees);
+
+private:
+    class JoinPlan
+    {
+    public:
+        Cost m_cost;
+        string m_orderedBy;
+        JoinMethod m_method;
+        //Zero for a leaf
+        uint64_t m_left;
+        uint64_t m_right;
+        size_t m_leftPlan;
+        size_t m_rightPlan;
+    };
+
+    const JoinGraph &m_graph;
+    string m_sortBy;
+    uint64_t m_all;
+    vector<double> m_leafRows;
+    vector<double> m_selectivity;
+    unordered_map<uint64_t, vector<JoinPlan>> m_plans;
+    unordered_map<uint64_t, double> m_rows;
+
+    double rows(uint64_t set);
+    bool joinFields(uint64_t left, uint64_t right,
+                    vector<string> &in0Fields, vector<string> &in1Fields) const;
+    bool interesting(uint64_t set, const string &order) const;
+    void addPlan(uint64_t set, JoinPlan &plan);
+    void joinSets(uint64_t left, uint64_t right);
+    bool enumerateDP();
+    void enumerateGreedy();
+    void enumerateCsgRec(uint64_t set, uint64_t excluded, vector<pair<uint64_t, uint64_t>> &pairs) const;
+    void emitCsg(uint64_t set, vector<pair<uint64_t, uint64_t>> &pairs) const;
+    void enumerateCmpRec(uint64_t set1, uint64_t set2, uint64_t excluded,
+                         vector<pair<uint64_t, uint64_t>> &pairs) const;
+    int buildTree(uint64_t set, size_t index, JoinTree &tree) const;
+};
+
+
+//Replaces a tree of logical joins with each of the trees
+//JoinEnumerator keeps, made of hash, merge and nested loop joins
+class EnumerateJoins : public VarTrans
+{
+public:
+    virtual string GetType() const {return "Enumerate Join Orders";}
+    virtual int CanApply(const Node *node, void **cache) const;
+    virtual void Apply(int num, Node *node, void **cache) const;
+    virtual void CleanCache(void **cache) const;
+};
+
+#endif
@@ -0,0 +1,659 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoLoader.h"
+#include "rqoTableStore.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+#if DORQO
+
+static string ToLower(string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    return str;
+}
+
+ColumnType SQLTypeToColumnType(string type, const vector<int> &args)
+{
+    type = ToLower(type);
+    if(type == "int" || type == "integer" || type == "smallint" || type == "bigint")
+    {
+        return INTCOLUMN;
+    }
+    //Whole numbers of up to 18 digits fit an int64
+    if(type == "number" || type == "numeric" || type == "decimal")
+    {
+        bool whole = !args.empty() && args[0] <= 18 && (args.size() < 2 || args[1] == 0);
+        return whole ? INTCOLUMN : DOUBLECOLUMN;
+    }
+    if(type == "float" || type == "real" || type == "double" || type == "binary_double")
+    {
+        return DOUBLECOLUMN;
+    }
+    if(type == "char" || type == "varchar" || type == "varchar2" || type == "nchar"
+        || type == "nvarchar2" || type == "text")
+    {
+        return STRINGCOLUMN;
+    }
+    if(type == "date")
+    {
+        return DATECOLUMN;
+    }
+    cout << "Unsupported SQL type " << type << endl;
+    throw;
+}
+
+//Splits a script into statements, dropping -- and /* */ comments
+static vector<string> SplitStatements(const string &script)
+{
+    vector<string> statements;
+    string current;
+    bool quoted = false;
+    for(size_t i = 0; i < script.size(); i++)
+    {
+        char c = script[i];
+        if(quoted)
+        {
+            current += c;
+            //A doubled quote is a quote inside the string
+            if(c == '\'' && !(i + 1 < script.size() && script[i + 1] == '\''))
+            {
+                quoted = false;
+            }
+            else if(c == '\'')
+            {
+                current += script[++i];
+            }
+        }
+        else if(c == '-' && i + 1 < script.size() && script[i + 1] == '-')
+        {
+            i = script.find('\n', i);
+            if(i == string::npos)
+            {
+                break;
+            }
+            current += '\n';
+        }
+        else if(c == '/' && i + 1 < script.size() && script[i + 1] == '*')
+        {
+            i = script.find("*/", i + 2);
+            if(i == string::npos)
+            {
+                break;
+            }
+            ++i;
+            current += ' ';
+        }
+        else if(c == ';')
+        {
+            statements.push_back(current);
+            current.clear();
+        }
+        else
+        {
+            quoted = c == '\'';
+            current += c;
+        }
+    }
+    if(!StripSpaces(current).empty())
+    {
+        statements.push_back(current);
+    }
+    return statements;
+}
+
+class SQLToken
+{
+public:
+    string m_text;
+    //A '' string rather than a word, number or punctuation
+    bool m_quoted;
+
+    SQLToken(string text, bool quoted) : m_text(text), m_quoted(quoted) {}
+    //Case insensitive match of an unquoted token
+    bool is(const string &word) const {return !m_quoted && ToLower(m_text) == word;}
+};
+
+static vector<SQLToken> Tokenize(const string &statement)
+{
+    vector<SQLToken> tokens;
+    size_t i = 0;
+    while(i < statement.size())
+    {
+        char c = statement[i];
+        if(isspace((unsigned char)c))
+        {
+            ++i;
+        }
+        else if(c == '\'')
+        {
+            string text;
+            for(++i; i < statement.size(); ++i)
+            {
+                if(statement[i] == '\'')
+                {
+                    if(i + 1 < statement.size() && statement[i + 1] == '\'')
+                    {
+                        ++i;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                text += statement[i];
+            }
+            ++i;
+            tokens.push_back(SQLToken(text, true));
+        }
+        else if(c == '"')
+        {
+            size_t end = statement.find('"', i + 1);
+            if(end == string::npos)
+            {
+                end = statement.size();
+            }
+            tokens.push_back(SQLToken(statement.substr(i + 1, end - i - 1), false));
+            i = end + 1;
+        }
+        else if(isalnum((unsigned char)c) || c == '_' || c == '.'
+                || ((c == '-' || c == '+') && i + 1 < statement.size()
+                    && (isdigit((unsigned char)statement[i + 1]) || statement[i + 1] == '.')))
+        {
+            size_t end = i + 1;
+            while(end < statement.size()
+                  && (isalnum((unsigned char)statement[end]) || statement[end] == '_'
+                      || statement[end] == '.' || statement[end] == '$' || statement[end] == '#'))
+            {
+                ++end;
+            }
+            tokens.push_back(SQLToken(statement.substr(i, end - i), false));
+            i = end;
+        }
+        else
+        {
+            tokens.push_back(SQLToken(string(1, c), false));
+            ++i;
+        }
+    }
+    return tokens;
+}
+
+//Comma separated items of the parenthesized list opening at tokens[pos],
+//with pos left after the closing parenthesis
+static vector<vector<SQLToken>> ParseList(const vector<SQLToken> &tokens, size_t &pos)
+{
+    if(pos >= tokens.size() || !tokens[pos].is("("))
+    {
+        cout << "Expected ( in SQL statement" << endl;
+        throw;
+    }
+    vector<vector<SQLToken>> items(1);
+    int depth = 1;
+    for(++pos; pos < tokens.size(); ++pos)
+    {
+        const SQLToken &token = tokens[pos];
+        if(token.is("("))
+        {
+            ++depth;
+        }
+        else if(token.is(")") && --depth == 0)
+        {
+            ++pos;
+            return items;
+        }
+        else if(token.is(",") && depth == 1)
+        {
+            items.push_back(vector<SQLToken>());
+            continue;
+        }
+        items.back().push_back(token);
+    }
+    cout << "Unclosed ( in SQL statement" << endl;
+    throw;
+}
+
+//CREATE TABLE name (column type [(args)] [constraints], ..., [table constraints])
+static ColumnarRelation* ParseCreateTable(const vector<SQLToken> &tokens)
+{
+    if(tokens.size() < 4)
+    {
+        cout << "Incomplete CREATE TABLE statement" << endl;
+        throw;
+    }
+    string name = tokens[2].m_text;
+    size_t pos = 3;
+    Schema schema;
+    vector<string> keys;
+    for(auto &item : ParseList(tokens, pos))
+    {
+        if(item.empty())
+        {
+            continue;
+        }
+        size_t start = 0;
+        if(item[0].is("constraint"))
+        {
+            start = 2;
+        }
+        if(start < item.size() && item[start].is("primary"))
+        {
+            size_t keyPos = start + 2;
+            for(auto &key : ParseList(item, keyPos))
+            {
+                keys.push_back(key.at(0).m_text);
+            }
+            continue;
+        }
+        if(start > 0 || item[0].is("foreign") || item[0].is("unique") || item[0].is("check"))
+        {
+            continue;
+        }
+        if(item.size() < 2)
+        {
+            cout << "Column " << item[0].m_text << " of " << name << " has no type" << endl;
+            throw;
+        }
+        vector<int> args;
+        size_t next = 2;
+        if(next < item.size() && item[next].is("("))
+        {
+            for(auto &arg : ParseList(item, next))
+            {
+                args.push_back(arg.empty() ? 0 : atoi(arg[0].m_text.c_str()));
+            }
+        }
+        //A two word type, double precision
+        else if(item[1].is("double") && next < item.size() && item[next].is("precision"))
+        {
+            ++next;
+        }
+        bool indexed = false;
+        for(size_t i = next; i + 1 < item.size(); i++)
+        {
+            indexed = indexed || (item[i].is("primary") && item[i + 1].is("key"));
+        }
+        schema.addColumn(item[0].m_text, SQLTypeToColumnType(item[1].m_text, args), indexed);
+    }
+    for(auto &key : keys)
+    {
+        int index = schema.indexOf(key);
+        if(index == -1)
+        {
+            cout << "Primary key " << key << " is not a column of " << name << endl;
+            throw;
+        }
+        schema.m_indexed[index] = true;
+    }
+    return new ColumnarRelation(name, schema);
+}
+
+//Text of a literal as a column value, with null as ""
+static string LiteralValue(const vector<SQLToken> &value)
+{
+    if(value.size() == 1 && (value[0].m_quoted || !value[0].is("null")))
+    {
+        return value[0].m_text;
+    }
+    if(value.size() == 1)
+    {
+        return "";
+    }
+    std::ostringstream text;
+    for(auto &token : value)
+    {
+        text << token.m_text;
+    }
+    cout << "Unsupported value " << text.str() << " in INSERT statement" << endl;
+    throw;
+}
+
+//INSERT INTO name [(columns)] VALUES (values)[, (values)...]
+static void ParseInsert(const vector<SQLToken> &tokens, const vector<ColumnarRelation*> &tables)
+{
+    if(tokens.size() < 4)
+    {
+        cout << "Incomplete INSERT statement" << endl;
+        throw;
+    }
+    ColumnarRelation *table = NULL;
+    for(auto candidate : tables)
+    {
+        if(ToLower(candidate->getName()) == ToLower(tokens[2].m_text))
+        {
+            table = candidate;
+        }
+    }
+    if(!table)
+    {
+        cout << "INSERT into " << tokens[2].m_text << " which the script does not create" << endl;
+        throw;
+    }
+    const Schema &schema = table->m_schema;
+    size_t pos = 3;
+    //Position in the schema of each listed value
+    vector<int> positions;
+    if(tokens[pos].is("("))
+    {
+        for(auto &column : ParseList(tokens, pos))
+        {
+            int index = schema.indexOf(column.at(0).m_text);
+            if(index == -1)
+            {
+                cout << "INSERT names " << column[0].m_text << " which is not a column of "
+                    << table->getName() << endl;
+                throw;
+            }
+            positions.push_back(index);
+        }
+    }
+    else
+    {
+        for(size_t i = 0; i < schema.size(); i++)
+        {
+            positions.push_back(i);
+        }
+    }
+    if(pos >= tokens.size() || !tokens[pos].is("values"))
+    {
+        cout << "Only INSERT ... VALUES is supported" << endl;
+        throw;
+    }
+    ++pos;
+    vector<string> row(schema.size());
+    while(pos < tokens.size())
+    {
+        vector<vector<SQLToken>> values = ParseList(tokens, pos);
+        if(values.size() != positions.size())
+        {
+            cout << "INSERT into " << table->getName() << " has " << values.size()
+                << " values for " << positions.size() << " columns" << endl;
+            throw;
+        }
+        std::fill(row.begin(), row.end(), "");
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            row[positions[i]] = LiteralValue(values[i]);
+        }
+        table->appendRow(row);
+        if(pos < tokens.size() && tokens[pos].is(","))
+        {
+            ++pos;
+        }
+    }
+}
+
+vector<ColumnarRelation*> ReadSQLScript(string path)
+{
+    std::ifstream in(path.c_str());
+    if(!in)
+    {
+        cout << "Cannot read SQL script " << path << endl;
+        throw;
+    }
+    std::stringstream script;
+    script << in.rdbuf();
+
+    vector<ColumnarRelation*> tables;
+    for(auto &statement : SplitStatements(script.str()))
+    {
+        vector<SQLToken> tokens = Tokenize(statement);
+        if(tokens.size() < 2)
+        {
+            continue;
+        }
+        if(tokens[0].is("create") && tokens[1].is("table"))
+        {
+            tables.push_back(ParseCreateTable(tokens));
+        }
+        else if(tokens[0].is("insert") && tokens[1].is("into"))
+        {
+            ParseInsert(tokens, tables);
+        }
+    }
+    return tables;
+}
+
+//Splits the record in [begin, end) into values.  The record holds no
+//line break
+static void SplitRecord(const char *begin, const char *end, char delimiter, vector<string> &values)
+{
+    values.clear();
+    const char *pos = begin;
+    while(true)
+    {
+        values.push_back(string());
+        string &value = values.back();
+        while(pos < end && (*pos == ' ' || *pos == '\t') && *pos != delimiter)
+        {
+            ++pos;
+        }
+        if(pos < end && *pos == '"')
+        {
+            for(++pos; pos < end; ++pos)
+            {
+                if(*pos == '"')
+                {
+                    if(pos + 1 < end && pos[1] == '"')
+                    {
+                        ++pos;
+                    }
+                    else
+                    {
+                        ++pos;
+                        break;
+                    }
+                }
+                value += *pos;
+            }
+            while(pos < end && *pos != delimiter)
+            {
+                ++pos;
+            }
+        }
+        else
+        {
+            const char *fieldEnd = std::find(pos, end, delimiter);
+            value.assign(pos, fieldEnd);
+            value = StripSpaces(value);
+            pos = fieldEnd;
+        }
+        if(pos >= end)
+        {
+            return;
+        }
+        ++pos;
+    }
+}
+
+//End of the line starting at pos, without any \r
+static const char* LineEnd(const char *pos, const char *end, const char *&next)
+{
+    const char *lineEnd = std::find(pos, end, '\n');
+    next = lineEnd < end ? lineEnd + 1 : end;
+    if(lineEnd > pos && lineEnd[-1] == '\r')
+    {
+        --lineEnd;
+    }
+    return lineEnd;
+}
+
+//Appends the records in [begin, end), which starts at a line start,
+//to part
+static void ParseCSVPiece(const char *begin, const char *end, char delimiter,
+                          const string &path, const char *file, ColumnarRelation *part)
+{
+    vector<string> values;
+    const char *next;
+    for(const char *pos = begin; pos < end; pos = next)
+    {
+        const char *lineEnd = LineEnd(pos, end, next);
+        if(lineEnd == pos)
+        {
+            continue;
+        }
+        SplitRecord(pos, lineEnd, delimiter, values);
+        if(values.size() != part->m_schema.size())
+        {
+            cout << "Record at byte " << (pos - file) << " of " << path << " has " << values.size()
+                << " values, " << part->getName() << " has " << part->m_schema.size() << " columns" << endl;
+            throw;
+        }
+        part->appendRow(values);
+    }
+}
+
+void LoadCSV(string path, ColumnarRelation *table, char delimiter)
+{
+    MappedFile file(path);
+    const char *begin = file.data();
+    const char *end = begin + file.size();
+    if(!file.size())
+    {
+        return;
+    }
+
+    //Skip a header line
+    const char *next;
+    const char *lineEnd = LineEnd(begin, end, next);
+    vector<string> values;
+    SplitRecord(begin, lineEnd, delimiter, values);
+    bool header = values.size() == table->m_schema.size();
+    for(size_t i = 0; header && i < values.size(); i++)
+    {
+        header = ToLower(values[i]) == ToLower(table->m_schema.m_names[i]);
+    }
+    if(header)
+    {
+        begin = next;
+    }
+
+    //Pieces start after the first line break at or past every chunk
+    //boundary, so each holds whole records
+#ifdef _OPENMP
+    size_t threads = omp_get_max_threads();
+#else
+    size_t threads = 1;
+#endif
+    size_t chunkBytes = std::max((size_t)RQOCSVMINCHUNKBYTES, (size_t)(end - begin) / (4 * threads) + 1);
+    vector<const char*> starts(1, begin);
+    while(end - starts.back() > (ptrdiff_t)chunkBytes)
+    {
+        const char *start = std::find(starts.back() + chunkBytes, end, '\n');
+        if(start == end)
+        {
+            break;
+        }
+        starts.push_back(start + 1);
+    }
+    starts.push_back(end);
+
+    size_t numPieces = starts.size() - 1;
+    vector<ColumnarRelation*> parts(numPieces);
+#pragma omp parallel for schedule(dynamic)
+    for(size_t i = 0; i < numPieces; i++)
+    {
+        parts[i] = new ColumnarRelation(table->getName(), table->m_schema);
+        ParseCSVPiece(starts[i], starts[i + 1], delimiter, path, file.data(), parts[i]);
+    }
+
+    //Pieces are appended in file order, a column per thread
+    size_t rows = 0;
+    for(auto part : parts)
+    {
+        rows += part->getSize();
+    }
+#pragma omp parallel for schedule(dynamic)
+    for(size_t i = 0; i < table->m_columns.size(); i++)
+    {
+        Column &column = table->m_columns[i];
+        column.reserve(column.size() + rows);
+        for(auto part : parts)
+        {
+            column.append(part->m_columns[i]);
+        }
+    }
+    table->m_numRows += rows;
+    for(auto part : parts)
+    {
+        delete part;
+    }
+}
+
+//Modification time of path, 0 if it does not exist
+static time_t ModifiedTime(string path)
+{
+    struct stat info;
+    if(stat(path.c_str(), &info) == -1)
+    {
+        return 0;
+    }
+    return info.st_mtime;
+}
+
+vector<Relation*> LoadTables(string script, string csvDir, string tableDir)
+{
+    vector<Relation*> relations;
+    for(auto table : ReadSQLScript(script))
+    {
+        string name = table->getName();
+        string csv = csvDir.empty() ? "" : csvDir + "/" + name + ".csv";
+        time_t csvTime = csv.empty() ? 0 : ModifiedTime(csv);
+        if(!tableDir.empty())
+        {
+            time_t savedTime = ModifiedTime(TableHeaderPath(tableDir, name));
+            if(savedTime && savedTime >= ModifiedTime(script) && savedTime >= csvTime)
+            {
+                ColumnarRelation *saved = OpenTable(tableDir, name);
+                if(saved)
+                {
+                    delete table;
+                    relations.push_back(new Relation(saved));
+                    continue;
+                }
+            }
+        }
+        if(csvTime)
+        {
+            LoadCSV(csv, table, ',');
+        }
+        table->seal();
+        if(!tableDir.empty())
+        {
+            SaveTable(*table, tableDir);
+        }
+        relations.push_back(new Relation(table));
+    }
+    return relations;
+}
+
+
+#endif
@@ -0,0 +1,62 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoColumnarRelation.h"
+#include "rqoRelation.h"
+
+#if DORQO
+
+//Smallest piece of a CSV file parsed as one task.  Files are cut
+//into about four pieces per thread, at line ends
+#define RQOCSVMINCHUNKBYTES (1 << 20)
+
+
+//Column type of a SQL column type such as number(6,2) or
+//varchar2(30).  args are the numbers in parentheses
+ColumnType SQLTypeToColumnType(string type, const vector<int> &args);
+
+//Tables created by the CREATE TABLE statements of a SQL script, with
+//the rows its INSERT statements add.  Primary key columns are indexed.
+//Other statements are skipped.  The tables are not yet sealed
+vector<ColumnarRelation*> ReadSQLScript(string path);
+
+//Appends the records of a CSV file to table, parsing pieces of the
+//file in parallel.  A first line naming the table's columns is
+//skipped.  Unquoted fields have spaces stripped, quoted fields may
+//hold delimiters and doubled quotes but not line breaks, and empty
+//fields are nulls.  Seal the table once loading is done
+void LoadCSV(string path, ColumnarRelation *table, char delimiter = ',');
+
+//Relations for the tables of a SQL script.  Each is filled from its
+//INSERT statements and from csvDir/<table>.csv when that exists.
+//With a tableDir, tables are saved there and later calls map them
+//instead of loading again, as long as they are newer than the script
+//and the CSV.  Either directory may be ""
+vector<Relation*> LoadTables(string script, string csvDir, string tableDir);
+
+
+#endif
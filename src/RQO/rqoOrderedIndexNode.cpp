@@ -63,6 +63,17 @@ const DataTypeInfo& OrderedIndexedNode::DataType(ConnNum num) const
   return m_dataTypeInfo;
 }
 
+void OrderedIndexedNode::SetRelation(Relation *relation)
+{
+  m_relation = relation;
+  //Rows come out of the index in key order
+  string field = relation->attributes.at(m_index).m_name;
+  if (m_dataTypeInfo.m_fields.find(field) != m_dataTypeInfo.m_fields.end())
+    m_dataTypeInfo.m_orderedBy = field;
+  else
+    m_dataTypeInfo.m_orderedBy = "";
+}
+
 void OrderedIndexedNode::Prop()
 {
   InputNode::Prop();
@@ -0,0 +1,388 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoPipeline.h"
+#include "rqoColumn.h"
+#include "rqoColumnarRelation.h"
+#include "functions.h"
+
+#if DORQO
+
+void CollectSink::push(vector<Tuple> &batch)
+{
+    if(m_rows.empty())
+    {
+        m_rows.swap(batch);
+        return;
+    }
+    m_rows.reserve(m_rows.size() + batch.size());
+    for(auto &tuple : batch)
+    {
+        m_rows.push_back(std::move(tuple));
+    }
+    batch.clear();
+}
+
+void TrimSink::push(vector<Tuple> &batch)
+{
+    for(auto &tuple : batch)
+    {
+        for(auto &field : m_fields)
+        {
+            tuple.removeField(field);
+        }
+    }
+    m_next.push(batch);
+}
+
+void ProjectionSink::push(vector<Tuple> &batch)
+{
+    if(m_fields.empty())
+    {
+        batch.clear();
+        return;
+    }
+    size_t kept = 0;
+    for(size_t i = 0; i < batch.size(); i++)
+    {
+        size_t found = 0;
+        for(auto &fvPair : batch[i].fields)
+        {
+            found += m_fields.count(fvPair.m_field);
+        }
+        if(found >= m_fields.size())
+        {
+            if(kept != i)
+            {
+                batch[kept] = std::move(batch[i]);
+            }
+            kept++;
+        }
+    }
+    batch.resize(kept);
+    if(kept)
+    {
+        m_next.push(batch);
+    }
+}
+
+JoinHashTable::JoinHashTable(const vector<Tuple> &rows, int key,
+                             ColumnType buildType, ColumnType probeType)
+    : m_numeric(NumericJoinKeys(buildType, probeType))
+{
+    vector<int64_t> keys(rows.size());
+    for(size_t i = 0; m_numeric && i < rows.size(); i++)
+    {
+        m_numeric = ParseInt(rows[i].fields.at(key).m_value, keys[i]);
+    }
+    if(!m_numeric)
+    {
+        for(size_t i = 0; i < rows.size(); i++)
+        {
+            const string &value = rows[i].fields.at(key).m_value;
+            auto found = m_codes.find(value);
+            if(found == m_codes.end())
+            {
+                int64_t code = m_codes.size();
+                m_codes.insert(pair<string, int64_t>(value, code));
+                keys[i] = code;
+            }
+            else
+            {
+                keys[i] = found->second;
+            }
+        }
+    }
+    m_table.build(keys.data(), keys.size());
+}
+
+void JoinHashTable::probe(const vector<Tuple> &batch, int probeKey,
+                          vector<uint32_t> &buildRows, vector<uint32_t> &batchRows) const
+{
+    //Probe values that cannot match any build key are left out
+    vector<int64_t> keys;
+    vector<uint32_t> rows;
+    keys.reserve(batch.size());
+    rows.reserve(batch.size());
+    for(size_t i = 0; i < batch.size(); i++)
+    {
+        const string &value = batch[i].fields.at(probeKey).m_value;
+        int64_t key;
+        if(m_numeric)
+        {
+            if(!ParseInt(value, key))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            auto found = m_codes.find(value);
+            if(found == m_codes.end())
+            {
+                continue;
+            }
+            key = found->second;
+        }
+        keys.push_back(key);
+        rows.push_back(i);
+    }
+    m_table.probe(keys.data(), keys.size(), rows.data(), buildRows, batchRows);
+}
+
+HashProbeSink::HashProbeSink(const vector<Tuple> &build, const JoinHashTable &table,
+                             const string &probeField, BatchSink &next)
+    : m_build(build),
+      m_table(table),
+      m_probeField(probeField),
+      m_probeKey(-1),
+      m_next(next)
+{
+}
+
+void HashProbeSink::push(vector<Tuple> &batch)
+{
+    if(batch.empty())
+    {
+        return;
+    }
+    if(m_probeKey < 0)
+    {
+        m_probeKey = FieldIndex(batch, m_probeField);
+    }
+    vector<uint32_t> buildRows, batchRows;
+    m_table.probe(batch, m_probeKey, buildRows, batchRows);
+    vector<Tuple> output;
+    output.reserve(buildRows.size());
+    for(size_t i = 0; i < buildRows.size(); i++)
+    {
+        output.push_back(joinTuples(m_build[buildRows[i]], batch[batchRows[i]], m_probeKey));
+    }
+    if(!output.empty())
+    {
+        m_next.push(output);
+    }
+}
+
+NestedLoopSink::NestedLoopSink(const vector<Tuple> &inner, const string &outerField,
+                               const string &innerField, BatchSink &next)
+    : m_inner(inner),
+      m_outerField(outerField),
+      m_outerKey(-1),
+      m_innerKey(FieldIndex(inner, innerField)),
+      m_next(next)
+{
+}
+
+void NestedLoopSink::push(vector<Tuple> &batch)
+{
+    if(batch.empty())
+    {
+        return;
+    }
+    if(m_outerKey < 0)
+    {
+        m_outerKey = FieldIndex(batch, m_outerField);
+    }
+    vector<Tuple> output;
+    for(auto &outer : batch)
+    {
+        const string &value = outer.fields.at(m_outerKey).m_value;
+        for(auto &inner : m_inner)
+        {
+            if(inner.fields.at(m_innerKey).m_value == value)
+            {
+                output.push_back(joinTuples(outer, inner, m_innerKey));
+            }
+        }
+    }
+    if(!output.empty())
+    {
+        m_next.push(output);
+    }
+}
+
+void CrossProductSink::push(vector<Tuple> &batch)
+{
+    vector<Tuple> output;
+    output.reserve(batch.size() * m_right.size());
+    for(auto &left : batch)
+    {
+        for(auto &right : m_right)
+        {
+            Tuple toAdd;
+            toAdd.fields.reserve(left.fields.size() + right.fields.size());
+            toAdd.fields.insert(toAdd.fields.end(), left.fields.begin(), left.fields.end());
+            toAdd.fields.insert(toAdd.fields.end(), right.fields.begin(), right.fields.end());
+            output.push_back(std::move(toAdd));
+        }
+    }
+    if(!output.empty())
+    {
+        m_next.push(output);
+    }
+}
+
+int FieldIndex(const vector<Tuple> &rows, const string &field)
+{
+    if(rows.empty())
+    {
+        return 0;
+    }
+    const vector<FieldValuePair> &fields = rows.front().fields;
+    for(size_t i = 0; i < fields.size(); i++)
+    {
+        if(fields[i].m_field == field)
+        {
+            return i;
+        }
+    }
+    cout << "Field " << field << " is not in the input of a plan node" << endl;
+    throw;
+}
+
+//Copies tuple with only fields into batch
+static void AppendRow(const Tuple &tuple, const set<string> &fields, vector<Tuple> &batch)
+{
+    Tuple row;
+    for(auto &fvPair : tuple.fields)
+    {
+        if(fields.count(fvPair.m_field))
+        {
+            row.fields.push_back(fvPair);
+        }
+    }
+    batch.push_back(std::move(row));
+}
+
+//Reads rows of a relation with only the kept fields, from its tuples
+//or, for a relation that is only held as columns, straight from the
+//columns so it is never materialized whole
+class RowReader
+{
+public:
+    const vector<Tuple> *m_tuples;
+    const set<string> &m_fields;
+    vector<ColumnView> m_columns;
+    vector<string> m_names;
+
+    RowReader(Relation &table, const set<string> &fields)
+        : m_tuples(NULL),
+        m_fields(fields)
+    {
+        if(table.hasTuples())
+        {
+            m_tuples = &table.getTuples();
+            return;
+        }
+        ColumnarRelation *columns = table.getColumns();
+        const Schema &schema = columns->m_schema;
+        for(size_t i = 0; i < schema.size(); i++)
+        {
+            if(fields.count(schema.m_names[i]))
+            {
+                m_columns.push_back(columns->getColumn(i));
+                m_names.push_back(schema.m_names[i]);
+            }
+        }
+    }
+
+    void append(size_t row, vector<Tuple> &batch) const
+    {
+        if(m_tuples)
+        {
+            AppendRow((*m_tuples)[row], m_fields, batch);
+            return;
+        }
+        Tuple tuple;
+        tuple.fields.reserve(m_columns.size());
+        for(size_t i = 0; i < m_columns.size(); i++)
+        {
+            tuple.addField(m_names[i], m_columns[i].getString(row));
+        }
+        batch.push_back(std::move(tuple));
+    }
+};
+
+//Selection and the trimming of unused fields are fused into the scan,
+//so only qualifying rows are copied and only with the kept fields
+void PushScan(Relation &table, queryNodes::OrNode *query, const set<string> &fields, BatchSink &sink)
+{
+    BatchPredicate predicate(query, table.getColumns());
+    RowReader reader(table, fields);
+    size_t numRows = table.getSize();
+    SelectionVector selection;
+    vector<Tuple> batch;
+    for(size_t begin = 0; begin < numRows; begin += RQOBATCHROWS)
+    {
+        size_t end = std::min(begin + RQOBATCHROWS, numRows);
+        selection.clear();
+        predicate.selectBlock(begin, end, selection);
+        if(selection.empty())
+        {
+            continue;
+        }
+        batch.clear();
+        batch.reserve(selection.size());
+        for(auto row : selection)
+        {
+            reader.append(row, batch);
+        }
+        sink.push(batch);
+    }
+    sink.finish();
+}
+
+void PushSelected(Relation &table, const SelectionVector &selection, const set<string> &fields, BatchSink &sink)
+{
+    RowReader reader(table, fields);
+    vector<Tuple> batch;
+    for(size_t begin = 0; begin < selection.size(); begin += RQOBATCHROWS)
+    {
+        size_t end = std::min(begin + RQOBATCHROWS, selection.size());
+        batch.clear();
+        batch.reserve(end - begin);
+        for(size_t i = begin; i < end; i++)
+        {
+            reader.append(selection[i], batch);
+        }
+        sink.push(batch);
+    }
+    sink.finish();
+}
+
+void PushRows(vector<Tuple> &rows, BatchSink &sink)
+{
+    vector<Tuple> batch;
+    for(size_t begin = 0; begin < rows.size(); begin += RQOBATCHROWS)
+    {
+        size_t end = std::min(begin + RQOBATCHROWS, rows.size());
+        batch.assign(std::make_move_iterator(rows.begin() + begin),
+                     std::make_move_iterator(rows.begin() + end));
+        sink.push(batch);
+    }
+    rows.clear();
+    sink.finish();
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoTuple.h"
+#include "rqoRelation.h"
+#include "queryNodes.h"
+#include "rqoBatchPredicate.h"
+#include "rqoHashJoin.h"
+#include <unordered_map>
+
+#if DORQO
+
+//Rows a source pushes at a time, one predicate block
+#define RQOBATCHROWS PREDICATEBLOCKROWS
+
+//Consumer of the row batches an operator pushes.  A pipeline is a
+//chain of sinks fed by one source, ending in a sink that materializes
+class BatchSink
+{
+public:
+    virtual ~BatchSink() {}
+    //May take the rows out of batch
+    virtual void push(vector<Tuple> &batch) = 0;
+    //Called once after the last batch
+    virtual void finish() {}
+};
+
+//End of a pipeline, keeps every row pushed to it
+class CollectSink : public BatchSink
+{
+public:
+    vector<Tuple> m_rows;
+
+    virtual void push(vector<Tuple> &batch);
+};
+
+//Removes m_fields from every row, as trim does
+class TrimSink : public BatchSink
+{
+public:
+    TrimSink(const set<string> &fields, BatchSink &next) : m_fields(fields), m_next(next) {}
+    virtual void push(vector<Tuple> &batch);
+    virtual void finish() {m_next.finish();}
+
+private:
+    const set<string> &m_fields;
+    BatchSink &m_next;
+};
+
+//Keeps the rows holding every one of m_fields, as projection does
+class ProjectionSink : public BatchSink
+{
+public:
+    ProjectionSink(const set<string> &fields, BatchSink &next) : m_fields(fields), m_next(next) {}
+    virtual void push(vector<Tuple> &batch);
+    virtual void finish() {m_next.finish();}
+
+private:
+    const set<string> &m_fields;
+    BatchSink &m_next;
+};
+
+//Build side of a pipelined hash join, a RadixHashTable built once
+//from a materialized input.  Keys are compared as integers when
+//NumericJoinKeys for the build and probe key types and every build
+//key is one, otherwise through codes of the build keys, as
+//JoinKeysFromTuples does
+class JoinHashTable
+{
+public:
+    JoinHashTable(const vector<Tuple> &rows, int key, ColumnType buildType, ColumnType probeType);
+    //Pairs of build row and batch row for every match of the probeKey
+    //field of batch, by batch row and then in build order
+    virtual void probe(const vector<Tuple> &batch, int probeKey,
+                       vector<uint32_t> &buildRows, vector<uint32_t> &batchRows) const;
+
+private:
+    bool m_numeric;
+    unordered_map<string, int64_t> m_codes;
+    RadixHashTable m_table;
+};
+
+//Probe side of a hash join.  Matches for a probe row come out in build
+//order, giving hashJoin's output order
+class HashProbeSink : public BatchSink
+{
+public:
+    HashProbeSink(const vector<Tuple> &build, const JoinHashTable &table,
+                  const string &probeField, BatchSink &next);
+    virtual void push(vector<Tuple> &batch);
+    virtual void finish() {m_next.finish();}
+
+private:
+    const vector<Tuple> &m_build;
+    const JoinHashTable &m_table;
+    string m_probeField;
+    int m_probeKey;
+    BatchSink &m_next;
+};
+
+//Outer side of a nested loop join against a materialized inner,
+//matching nestedJoin
+class NestedLoopSink : public BatchSink
+{
+public:
+    NestedLoopSink(const vector<Tuple> &inner, const string &outerField,
+                   const string &innerField, BatchSink &next);
+    virtual void push(vector<Tuple> &batch);
+    virtual void finish() {m_next.finish();}
+
+private:
+    const vector<Tuple> &m_inner;
+    string m_outerField;
+    int m_outerKey;
+    int m_innerKey;
+    BatchSink &m_next;
+};
+
+//Left side of a cross product against a materialized right
+class CrossProductSink : public BatchSink
+{
+public:
+    CrossProductSink(const vector<Tuple> &right, BatchSink &next) : m_right(right), m_next(next) {}
+    virtual void push(vector<Tuple> &batch);
+    virtual void finish() {m_next.finish();}
+
+private:
+    const vector<Tuple> &m_right;
+    BatchSink &m_next;
+};
+
+//Position of field within the tuples of rows, 0 when rows is empty
+int FieldIndex(const vector<Tuple> &rows, const string &field);
+//Streams the rows of table satisfying query, keeping only fields
+void PushScan(Relation &table, queryNodes::OrNode *query, const set<string> &fields, BatchSink &sink);
+//Streams the rows of table in selection, in selection order, keeping
+//only fields.  For row ids found through an index
+void PushSelected(Relation &table, const SelectionVector &selection, const set<string> &fields, BatchSink &sink);
+//Streams an already materialized result
+void PushRows(vector<Tuple> &rows, BatchSink &sink);
+
+#endif
@@ -73,6 +73,7 @@ void Projection::BuildDataTypeCache()
 {
   m_dataTypeInfo.m_sortedBy = m_sortBy;
   m_dataTypeInfo.m_fields = m_inFields;
+  m_dataTypeInfo.KeepOrder(InputDataType(0));
 }
 
 void Projection::Prop()
@@ -34,13 +34,13 @@
 
 class Projection : public Sortable
 {
-  set<string> m_inFields;
-
  protected:
   DataTypeInfo m_dataTypeInfo;
 
 
  public:
+  set<string> m_inFields;
+
   Projection();
   Projection(string sortBy, set<string> &inFields);
   virtual NodeType GetType() const;
@@ -50,7 +50,7 @@ class Projection : public Sortable
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs();}
+  virtual Cost GetCost() {return CopyCost(Input(0)->Outputs());}
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "projection";}
   virtual void ClearDataTypeCache();
@@ -0,0 +1,309 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoRadixSort.h"
+#include "rqoColumn.h"
+#include "rqoIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+#if DORQO
+
+struct SortRow
+{
+    uint64_t m_key;
+    uint32_t m_row;
+};
+
+static int NumThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+unsigned RadixSorter::Passes(uint64_t range)
+{
+    unsigned passes = 0;
+    while(passes * RADIXSORTDIGITBITS < 64 && (range >> (passes * RADIXSORTDIGITBITS)) != 0)
+    {
+        ++passes;
+    }
+    return passes;
+}
+
+//One stable counting pass on the digit at shift.  False, leaving out
+//untouched, when every key has the same digit and the pass can be skipped
+static bool ScatterDigit(const vector<SortRow> &in, vector<SortRow> &out, unsigned shift)
+{
+    const int numBuckets = 1 << RADIXSORTDIGITBITS;
+    const uint64_t digitMask = numBuckets - 1;
+    size_t num = in.size();
+    int numThreads = NumThreads();
+    size_t chunk = (num + numThreads - 1) / numThreads;
+    vector<size_t> positions((size_t)numThreads * numBuckets, 0);
+
+#pragma omp parallel for schedule(static)
+    for(int thread = 0; thread < numThreads; thread++)
+    {
+        size_t *histogram = &positions[(size_t)thread * numBuckets];
+        size_t end = std::min(num, (thread + 1) * chunk);
+        for(size_t i = thread * chunk; i < end; i++)
+        {
+            ++histogram[(in[i].m_key >> shift) & digitMask];
+        }
+    }
+
+    size_t running = 0;
+    for(int bucket = 0; bucket < numBuckets; bucket++)
+    {
+        size_t bucketStart = running;
+        for(int thread = 0; thread < numThreads; thread++)
+        {
+            size_t count = positions[(size_t)thread * numBuckets + bucket];
+            positions[(size_t)thread * numBuckets + bucket] = running;
+            running += count;
+        }
+        if(running - bucketStart == num)
+        {
+            return false;
+        }
+    }
+
+#pragma omp parallel for schedule(static)
+    for(int thread = 0; thread < numThreads; thread++)
+    {
+        size_t *position = &positions[(size_t)thread * numBuckets];
+        size_t end = std::min(num, (thread + 1) * chunk);
+        for(size_t i = thread * chunk; i < end; i++)
+        {
+            out[position[(in[i].m_key >> shift) & digitMask]++] = in[i];
+        }
+    }
+    return true;
+}
+
+bool RadixSorter::sort(const int64_t *keys, size_t num, vector<uint32_t> &perm) const
+{
+    if(num > UINT32_MAX)
+    {
+        cout << "Sorts are limited to 2^32 rows" << endl;
+        throw;
+    }
+    perm.resize(num);
+    std::iota(perm.begin(), perm.end(), 0);
+    if(num < 2)
+    {
+        return false;
+    }
+
+    int64_t low = keys[0];
+    int64_t high = keys[0];
+    bool ordered = true;
+    for(size_t i = 1; i < num; i++)
+    {
+        ordered = ordered && keys[i - 1] <= keys[i];
+        low = std::min(low, keys[i]);
+        high = std::max(high, keys[i]);
+    }
+    if(ordered)
+    {
+        return false;
+    }
+    if(num < RADIXSORTMINROWS)
+    {
+        std::stable_sort(perm.begin(), perm.end(),
+                         [keys](uint32_t a, uint32_t b) {return keys[a] < keys[b];});
+        return true;
+    }
+
+    //Keys are offset by low so a narrow range needs few passes
+    vector<SortRow> rows(num);
+    vector<SortRow> scratch(num);
+#pragma omp parallel for schedule(static)
+    for(int64_t i = 0; i < (int64_t)num; i++)
+    {
+        rows[i].m_key = (uint64_t)keys[i] - (uint64_t)low;
+        rows[i].m_row = i;
+    }
+    unsigned passes = Passes((uint64_t)high - (uint64_t)low);
+    for(unsigned pass = 0; pass < passes; pass++)
+    {
+        if(ScatterDigit(rows, scratch, pass * RADIXSORTDIGITBITS))
+        {
+            rows.swap(scratch);
+        }
+    }
+#pragma omp parallel for schedule(static)
+    for(int64_t i = 0; i < (int64_t)num; i++)
+    {
+        perm[i] = rows[i].m_row;
+    }
+    return true;
+}
+
+//Parses text as a key of type, INTCOLUMN, DOUBLECOLUMN or DATECOLUMN
+static bool ParseKey(ColumnType type, const string &text, int64_t &key)
+{
+    if(type == INTCOLUMN)
+    {
+        return ParseInt(text, key);
+    }
+    else if(type == DOUBLECOLUMN)
+    {
+        double value;
+        if(!ParseDouble(text, value))
+        {
+            return false;
+        }
+        key = DoubleKey(value);
+        return true;
+    }
+    DateFormat format;
+    return ParseDate(text, key, format);
+}
+
+//Encodes values with the first type every non empty value parses as,
+//falling back to ranks in the sorted distinct values, which ranked
+//forces.  Nulls get a key just below the smallest so they do not
+//widen the radix range
+static void EncodeKeys(const vector<const string*> &values, vector<int64_t> &keys, bool ranked)
+{
+    size_t num = values.size();
+    keys.resize(num);
+    const ColumnType types[] = {INTCOLUMN, DOUBLECOLUMN, DATECOLUMN};
+    bool typed = false;
+    for(int type = 0; !ranked && !typed && type < 3; type++)
+    {
+        typed = true;
+        for(size_t i = 0; typed && i < num; i++)
+        {
+            typed = values[i]->empty() || ParseKey(types[type], *values[i], keys[i]);
+        }
+    }
+
+    if(!typed)
+    {
+        unordered_map<string, int64_t> codes;
+        for(auto value : values)
+        {
+            if(!value->empty())
+            {
+                codes.insert(pair<string, int64_t>(*value, 0));
+            }
+        }
+        vector<string> dictionary;
+        dictionary.reserve(codes.size());
+        for(auto &code : codes)
+        {
+            dictionary.push_back(code.first);
+        }
+        std::sort(dictionary.begin(), dictionary.end());
+        for(size_t code = 0; code < dictionary.size(); code++)
+        {
+            codes[dictionary[code]] = code;
+        }
+        for(size_t i = 0; i < num; i++)
+        {
+            if(!values[i]->empty())
+            {
+                keys[i] = codes[*values[i]];
+            }
+        }
+    }
+
+    bool hasNull = false;
+    int64_t low = INT64_MAX;
+    for(size_t i = 0; i < num; i++)
+    {
+        if(values[i]->empty())
+        {
+            hasNull = true;
+        }
+        else
+        {
+            low = std::min(low, keys[i]);
+        }
+    }
+    if(hasNull)
+    {
+        int64_t nullKey = (low > INT64_MIN) ? low - 1 : INT64_MIN;
+        for(size_t i = 0; i < num; i++)
+        {
+            if(values[i]->empty())
+            {
+                keys[i] = nullKey;
+            }
+        }
+    }
+}
+
+void SortKeysFromTuples(const vector<Tuple> &rows, int key, vector<int64_t> &keys)
+{
+    vector<const string*> values(rows.size());
+    for(size_t i = 0; i < rows.size(); i++)
+    {
+        values[i] = &rows[i].fields.at(key).m_value;
+    }
+    EncodeKeys(values, keys, false);
+}
+
+void SortKeysFromTuples(const vector<Tuple> &left, int key1,
+                        const vector<Tuple> &right, int key2,
+                        vector<int64_t> &leftKeys, vector<int64_t> &rightKeys,
+                        bool ranked)
+{
+    vector<const string*> values;
+    values.reserve(left.size() + right.size());
+    for(auto &row : left)
+    {
+        values.push_back(&row.fields.at(key1).m_value);
+    }
+    for(auto &row : right)
+    {
+        values.push_back(&row.fields.at(key2).m_value);
+    }
+    vector<int64_t> keys;
+    EncodeKeys(values, keys, ranked);
+    leftKeys.assign(keys.begin(), keys.begin() + left.size());
+    rightKeys.assign(keys.begin() + left.size(), keys.end());
+}
+
+vector<Tuple> PermuteTuples(vector<Tuple> &rows, const vector<uint32_t> &perm)
+{
+    vector<Tuple> output(perm.size());
+#pragma omp parallel for schedule(static)
+    for(int64_t i = 0; i < (int64_t)perm.size(); i++)
+    {
+        output[i] = std::move(rows[perm[i]]);
+    }
+    return output;
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoTuple.h"
+
+#if DORQO
+
+//Below this many rows a comparison sort beats the radix passes
+#define RADIXSORTMINROWS 2048
+//Bits of the key sorted per pass, so a pass's histogram stays in L1
+#define RADIXSORTDIGITBITS 8
+
+
+//Stable sort of int64 keys into a permutation of row ids, so tuples
+//are moved once, after the order is known.  A parallel LSD radix sort
+//on key - min, with only as many passes as the key range needs.  Each
+//thread histograms and scatters its own contiguous chunk, which keeps
+//every pass stable
+class RadixSorter
+{
+public:
+    //Fills perm so keys[perm[0]] <= keys[perm[1]] <= ...  False, with
+    //perm the identity, when the keys were already in order
+    virtual bool sort(const int64_t *keys, size_t num, vector<uint32_t> &perm) const;
+    //Passes needed for keys spanning range
+    static unsigned Passes(uint64_t range);
+};
+
+//Order preserving keys for field key of rows.  Keys are the values
+//when every value is an integer, likewise doubles and dates, and
+//otherwise ranks in the sorted set of values.  Empty values are nulls
+//and sort first
+void SortKeysFromTuples(const vector<Tuple> &rows, int key, vector<int64_t> &keys);
+//Keys for two inputs encoded together, so they compare across inputs.
+//With ranked, keys are always ranks, so equal keys are equal text
+void SortKeysFromTuples(const vector<Tuple> &left, int key1,
+                        const vector<Tuple> &right, int key2,
+                        vector<int64_t> &leftKeys, vector<int64_t> &rightKeys,
+                        bool ranked = false);
+//rows in perm order.  rows is moved from
+vector<Tuple> PermuteTuples(vector<Tuple> &rows, const vector<uint32_t> &perm);
+
+
+#endif
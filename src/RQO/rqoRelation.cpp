@@ -22,9 +22,124 @@
 
 
 #include "rqoRelation.h"
+#include "rqoColumnarRelation.h"
+#include "rqoStatistics.h"
+#include "rqoIndex.h"
 
 #if DORQO
 
+Relation::Relation(const Relation &orig)
+    : attributes(orig.attributes),
+    tuples(orig.hasTuples() ? orig.tuples : orig.m_columnar->getTuples()),
+    m_name(orig.m_name),
+    indeces(orig.indeces),
+    m_columnar(NULL),
+    m_statistics(NULL)
+{
+}
+
+Relation::Relation(ColumnarRelation *columns)
+    : m_name(columns->getName()),
+    m_columnar(columns),
+    m_statistics(NULL)
+{
+    const Schema &schema = columns->m_schema;
+    for(size_t i = 0; i < schema.size(); i++)
+    {
+        addAttribute(schema.m_names[i], ColumnTypeToStr(schema.m_types[i]), schema.m_indexed[i]);
+    }
+}
+
+Relation::~Relation()
+{
+    clearIndexes();
+    delete m_columnar;
+    delete m_statistics;
+}
+
+const vector<Tuple>& Relation::getTuples()
+{
+    if(!hasTuples())
+    {
+        tuples = m_columnar->getTuples();
+    }
+    return tuples;
+}
+
+bool Relation::hasTuples() const
+{
+    return !m_columnar || tuples.size() == m_columnar->getSize();
+}
+
+int Relation::getSize()
+{
+    return m_columnar ? m_columnar->getSize() : tuples.size();
+}
+
+void Relation::addTuple(Tuple tuple)
+{
+    getTuples();
+    tuples.push_back(tuple);
+    clearIndexes();
+    delete m_columnar;
+    m_columnar = NULL;
+    delete m_statistics;
+    m_statistics = NULL;
+}
+
+ColumnarRelation* Relation::getColumns()
+{
+    if(!m_columnar)
+    {
+        m_columnar = ColumnarRelation::fromRelation(this);
+    }
+    return m_columnar;
+}
+
+const RelationStatistics& Relation::getStatistics()
+{
+    if(!m_statistics)
+    {
+        m_statistics = new RelationStatistics;
+        m_statistics->collect(getColumns());
+    }
+    return *m_statistics;
+}
+
+const HashIndex& Relation::getHashIndex(int index)
+{
+    HashIndex *&hashIndex = m_hashIndexes[index];
+    if(!hashIndex)
+    {
+        hashIndex = new HashIndex(getColumns()->getColumn(index));
+    }
+    return *hashIndex;
+}
+
+const SortedIndex& Relation::getSortedIndex(int index)
+{
+    SortedIndex *&sortedIndex = m_sortedIndexes[index];
+    if(!sortedIndex)
+    {
+        sortedIndex = new SortedIndex(getColumns()->getColumn(index));
+    }
+    return *sortedIndex;
+}
+
+void Relation::clearIndexes()
+{
+    for(auto &entry : m_hashIndexes)
+    {
+        delete entry.second;
+    }
+    m_hashIndexes.clear();
+    for(auto &entry : m_sortedIndexes)
+    {
+        delete entry.second;
+    }
+    m_sortedIndexes.clear();
+}
+
 void Relation::addAttribute(string name, string type, bool indexable)
 {
     Attribute temp(name, type, indexable);
@@ -44,7 +159,7 @@ void Relation::printTable()
     {
         cout << attri.m_name << " of type " << attri.m_type << endl;
     }
-    for(auto tuple : tuples)
+    for(auto tuple : getTuples())
     {
         tuple.printTuple();
     }
@@ -52,20 +167,8 @@ void Relation::printTable()
 
 double Relation::getSelectivity(int key)
 {
-    unordered_map<string, Tuple> hash;
-    unordered_map<string, Tuple>::const_iterator iter = hash.begin();
-
-    for(auto tup : tuples)
-    {
-        iter = hash.find(tup.getValueAt(key));
-        if(iter == hash.end())
-        {
-            hash.insert(pair<string, Tuple>(
-            tup.getValueAt(key), tup));
-        }
-    }
-
-    return 1/hash.size();
+    const ColumnStatistics &column = getStatistics().m_columns.at(key);
+    return column.m_distinct ? 1.0 / column.m_distinct : 1;
 }
 
 #endif
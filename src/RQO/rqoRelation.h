@@ -31,6 +31,11 @@
 
 #if DORQO
 
+class ColumnarRelation;
+class RelationStatistics;
+class HashIndex;
+class SortedIndex;
+
 
 
 class Relation
@@ -40,14 +45,35 @@ public:
     vector<Tuple> tuples;
     string m_name;
     set<int> indeces;
+    //Typed copy of tuples, built on first use
+    ColumnarRelation *m_columnar;
+    //Collected from m_columnar on first use
+    RelationStatistics *m_statistics;
+    //Built from m_columnar on first use, keyed by attribute index
+    map<int, HashIndex*> m_hashIndexes;
+    map<int, SortedIndex*> m_sortedIndexes;
 
-    Relation(string name) {m_name = name;}
+    Relation(string name) {m_name = name; m_columnar = NULL; m_statistics = NULL;}
+    //Takes ownership of columns, e.g. a table opened from disk.  Its
+    //tuples are only built if an operator asks for them
+    Relation(ColumnarRelation *columns);
+    //The columnar copy and statistics are owned, so copies start without them
+    Relation(const Relation &orig);
+    virtual ~Relation();
     virtual void addAttribute(string name, string type, bool indexable);
-    virtual void addTuple(Tuple tuple) {tuples.push_back(tuple);}
+    virtual void addTuple(Tuple tuple);
     virtual void printTable();
-    virtual vector<Tuple> getTuples() {return tuples;}
+    virtual const vector<Tuple>& getTuples();
+    //False while a relation built from columns has not materialized
+    //its tuples
+    virtual bool hasTuples() const;
+    virtual ColumnarRelation* getColumns();
+    virtual const RelationStatistics& getStatistics();
+    virtual const HashIndex& getHashIndex(int index);
+    virtual const SortedIndex& getSortedIndex(int index);
+    virtual void clearIndexes();
     virtual string getName() {return m_name;}
-    virtual int getSize() {return tuples.size();}
+    virtual int getSize();
     virtual double getSelectivity(int key);
 };
 
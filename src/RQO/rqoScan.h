@@ -52,15 +52,16 @@ class Scan : public InputNode
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return m_relation->getSize() * m_relation->getSize();}
+  virtual Cost GetCost() {return ScanCost(m_relation, m_query);}
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "scan";}
   virtual Name GetName(ConnNum num) const;
   virtual void ClearDataTypeCache() {}
   virtual void BuildDataTypeCache() {}
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
-  virtual int Outputs() {return m_relation->getSize();}
+  virtual int Outputs() {return RowsToInt(EstimateRows(m_relation, m_query));}
   virtual void SetRelation(Relation *relation) {m_relation = relation;}
+  virtual Relation* GetRelation() {return m_relation;}
 };
 
 #endif
\ No newline at end of file
@@ -52,6 +52,11 @@ void Sort::Duplicate(const Node *orig, bool shallow, bool possMerging)
   Node::Duplicate(orig, shallow, possMerging);
 }
 
+Cost Sort::GetCost()
+{
+  return SortCost(Input(0)->Outputs(), InputDataType(0).m_orderedBy == m_sortBy);
+}
+
 const DataTypeInfo& Sort::DataType(ConnNum num) const
 {
   return m_dataTypeInfo;
@@ -66,6 +71,7 @@ void Sort::BuildDataTypeCache()
 {
   m_dataTypeInfo = InputDataType(0);
   m_dataTypeInfo.m_sortedBy = m_sortBy;
+  m_dataTypeInfo.m_orderedBy = m_sortBy;
 }
 
 void Sort::Prop()
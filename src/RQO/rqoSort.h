@@ -48,7 +48,7 @@ class Sort : public Sortable
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs() * log(Input(0)->Outputs());}
+  virtual Cost GetCost();
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "sort";}
   virtual void ClearDataTypeCache();
@@ -0,0 +1,511 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoStatistics.h"
+#include "rqoRelation.h"
+#include "rqoHelperNodes.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+
+#if DORQO
+
+using namespace queryNodes;
+
+//Used when a clause's constant cannot be read as the column's type
+#define DEFAULTSELECTIVITY 0.1
+//Used for string ranges over an unsorted dictionary
+#define DEFAULTRANGESELECTIVITY (1.0 / 3)
+
+ColumnStatistics::ColumnStatistics()
+    : m_type(STRINGCOLUMN),
+    m_rows(0),
+    m_nulls(0),
+    m_distinct(0),
+    m_min(0),
+    m_max(0),
+    m_histogramMin(0)
+{
+}
+
+void ColumnStatistics::collect(const ColumnView &column)
+{
+    m_type = column.m_type;
+    m_rows = column.size();
+    m_nulls = 0;
+    vector<double> values;
+    values.reserve(m_rows);
+    for(size_t row = 0; row < m_rows; row++)
+    {
+        if(column.isNull(row))
+        {
+            ++m_nulls;
+        }
+        else
+        {
+            values.push_back(column.getNumeric(row));
+        }
+    }
+    std::sort(values.begin(), values.end());
+
+    m_frequentValues.clear();
+    m_frequentRows.clear();
+    m_bounds.clear();
+    m_bucketRows.clear();
+    m_bucketDistinct.clear();
+    m_distinct = 0;
+    if(values.empty())
+    {
+        return;
+    }
+    m_min = values.front();
+    m_max = values.back();
+
+    size_t depth = (values.size() + HISTOGRAMBUCKETS - 1) / HISTOGRAMBUCKETS;
+    vector<double> rest;
+    rest.reserve(values.size());
+    size_t start = 0;
+    while(start < values.size())
+    {
+        size_t end = start + 1;
+        while(end < values.size() && values[end] == values[start])
+        {
+            ++end;
+        }
+        ++m_distinct;
+        if(end - start >= depth && depth > 1)
+        {
+            m_frequentValues.push_back(values[start]);
+            m_frequentRows.push_back(end - start);
+        }
+        else
+        {
+            rest.insert(rest.end(), values.begin() + start, values.begin() + end);
+        }
+        start = end;
+    }
+    if(rest.empty())
+    {
+        return;
+    }
+    m_histogramMin = rest.front();
+
+    //A value's rows are never split across buckets
+    depth = (rest.size() + HISTOGRAMBUCKETS - 1) / HISTOGRAMBUCKETS;
+    start = 0;
+    while(start < rest.size())
+    {
+        size_t end = std::min(rest.size(), start + depth);
+        while(end < rest.size() && rest[end] == rest[end - 1])
+        {
+            ++end;
+        }
+        size_t distinct = 1;
+        for(size_t i = start + 1; i < end; i++)
+        {
+            if(rest[i] != rest[i - 1])
+            {
+                ++distinct;
+            }
+        }
+        m_bounds.push_back(rest[end - 1]);
+        m_bucketRows.push_back(end - start);
+        m_bucketDistinct.push_back(distinct);
+        start = end;
+    }
+}
+
+double ColumnStatistics::nonNullFraction() const
+{
+    return m_rows ? (double)(m_rows - m_nulls) / m_rows : 0;
+}
+
+double ColumnStatistics::fractionEqual(double value) const
+{
+    for(size_t i = 0; i < m_frequentValues.size(); i++)
+    {
+        if(m_frequentValues[i] == value)
+        {
+            return (double)m_frequentRows[i] / m_rows;
+        }
+    }
+    if(m_bounds.empty() || value < m_histogramMin || value > m_bounds.back())
+    {
+        return 0;
+    }
+    size_t bucket = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+    return (double)m_bucketRows[bucket] / m_bucketDistinct[bucket] / m_rows;
+}
+
+double ColumnStatistics::fractionBelow(double value, bool inclusive) const
+{
+    double below = 0;
+    for(size_t i = 0; i < m_frequentValues.size(); i++)
+    {
+        if(m_frequentValues[i] < value || (inclusive && m_frequentValues[i] == value))
+        {
+            below += m_frequentRows[i];
+        }
+    }
+    for(size_t bucket = 0; bucket < m_bounds.size(); bucket++)
+    {
+        double high = m_bounds[bucket];
+        if(high < value)
+        {
+            below += m_bucketRows[bucket];
+            continue;
+        }
+        //Values are taken to be spread evenly through the bucket, less
+        //the rows equal to value itself
+        double low = bucket ? m_bounds[bucket - 1] : m_histogramMin;
+        double rows = m_bucketRows[bucket];
+        double equal = rows / m_bucketDistinct[bucket];
+        if(value > low || (bucket == 0 && value == low))
+        {
+            double spread = (high > low) ? (value - low) / (high - low) : 0;
+            below += std::min(rows * spread, rows - equal);
+            if(inclusive)
+            {
+                below += equal;
+            }
+        }
+        break;
+    }
+    return m_rows ? std::min(below / m_rows, nonNullFraction()) : 0;
+}
+
+RelationStatistics::RelationStatistics()
+    : m_rows(0)
+{
+}
+
+void RelationStatistics::collect(const ColumnarRelation *relation)
+{
+    m_rows = relation->getSize();
+    m_names = relation->m_schema.m_names;
+    m_columns.assign(m_names.size(), ColumnStatistics());
+    for(size_t i = 0; i < m_names.size(); i++)
+    {
+        m_columns[i].collect(relation->getColumn(i));
+    }
+}
+
+const ColumnStatistics* RelationStatistics::getColumn(string name) const
+{
+    for(size_t i = 0; i < m_names.size(); i++)
+    {
+        if(m_names[i] == name)
+        {
+            return &(m_columns[i]);
+        }
+    }
+    return NULL;
+}
+
+//Selectivity of a clause on a column with a numeric domain
+static double NumericSelectivity(const ColumnStatistics &stats, const string &op, double value, bool integral)
+{
+    bool fractional = integral && value != std::floor(value);
+    if(op == "=")
+    {
+        return fractional ? 0 : stats.fractionEqual(value);
+    }
+    else if(op == "!=")
+    {
+        return stats.nonNullFraction() - (fractional ? 0 : stats.fractionEqual(value));
+    }
+    else if(op == "<")
+    {
+        return stats.fractionBelow(value, false);
+    }
+    else if(op == "<=")
+    {
+        return stats.fractionBelow(value, true);
+    }
+    else if(op == ">")
+    {
+        return stats.nonNullFraction() - stats.fractionBelow(value, true);
+    }
+    else if(op == ">=")
+    {
+        return stats.nonNullFraction() - stats.fractionBelow(value, false);
+    }
+    return 1;
+}
+
+//Selectivity of a clause on a string column, through its dictionary
+static double StringSelectivity(const ColumnStatistics &stats, const ColumnView &column,
+                                const string &op, const string &value)
+{
+    if(!column.m_sortedDictionary)
+    {
+        if(op == "=")
+        {
+            return stats.m_distinct ? 1.0 / stats.m_distinct : 0;
+        }
+        return (op == "!=") ? 1 : DEFAULTRANGESELECTIVITY;
+    }
+    int64_t lower = column.lowerBoundCode(value);
+    bool found = lower < (int64_t)column.m_dictionary->size() && column.m_dictionary->at(lower) == value;
+    int64_t upper = lower + (found ? 1 : 0);
+    if(op == "=")
+    {
+        return found ? stats.fractionEqual(lower) : 0;
+    }
+    else if(op == "!=")
+    {
+        return stats.nonNullFraction() - (found ? stats.fractionEqual(lower) : 0);
+    }
+    else if(op == "<")
+    {
+        return stats.fractionBelow(lower, false);
+    }
+    else if(op == "<=")
+    {
+        return stats.fractionBelow(upper, false);
+    }
+    else if(op == ">")
+    {
+        return stats.nonNullFraction() - stats.fractionBelow(upper, false);
+    }
+    else if(op == ">=")
+    {
+        return stats.nonNullFraction() - stats.fractionBelow(lower, false);
+    }
+    return 1;
+}
+
+static double ClauseSelectivity(const FieldValue &clause, Relation *relation)
+{
+    string field = StripSpaces(clause.m_field);
+    string op = StripSpaces(clause.m_relation);
+    string value = StripSpaces(clause.m_value);
+    const ColumnStatistics *stats = relation->getStatistics().getColumn(field);
+    if(!stats)
+    {
+        return DEFAULTSELECTIVITY;
+    }
+    switch(stats->m_type)
+    {
+    case(INTCOLUMN):
+    case(DOUBLECOLUMN):
+    {
+        double number;
+        if(ParseDouble(value, number))
+        {
+            return NumericSelectivity(*stats, op, number, stats->m_type == INTCOLUMN);
+        }
+        break;
+    }
+    case(DATECOLUMN):
+    {
+        int64_t days;
+        DateFormat format;
+        if(ParseDate(value, days, format))
+        {
+            return NumericSelectivity(*stats, op, days, true);
+        }
+        break;
+    }
+    case(STRINGCOLUMN):
+        return StringSelectivity(*stats, relation->getColumns()->getColumn(field), op, value);
+    }
+    return DEFAULTSELECTIVITY;
+}
+
+//Combines clause selectivities as OR of ANDs.  Only clauses on field
+//are used when it is not empty, others counting as 1
+//Combines clause selectivities as OR of ANDs.  Only clauses on field
+//are used when it is not empty, others counting as 1
+static double CombineSelectivity(OrNode *query, Relation *relation, const string &field, bool equalityOnly)
+{
+    double noneMatch = 1;
+    for(auto &andNode : query->getAnds())
+    {
+        double termSelectivity = 1;
+        //Fraction of rows under the tightest upper and over the
+        //tightest lower bound of each column, -1 when it has none
+        map<string, pair<double, double>> bounds;
+        for(auto &clause : andNode.getClauses())
+        {
+            string clauseField = StripSpaces(clause.m_field);
+            string op = StripSpaces(clause.m_relation);
+            if(!field.empty() && clauseField != field)
+            {
+                continue;
+            }
+            if(equalityOnly && op != "=")
+            {
+                continue;
+            }
+            double selectivity = ClauseSelectivity(clause, relation);
+            bool upper = (op == "<" || op == "<=");
+            bool lower = (op == ">" || op == ">=");
+            if(!upper && !lower)
+            {
+                termSelectivity *= selectivity;
+                continue;
+            }
+            if(bounds.find(clauseField) == bounds.end())
+            {
+                bounds[clauseField] = pair<double, double>(-1, -1);
+            }
+            double &bound = upper ? bounds[clauseField].first : bounds[clauseField].second;
+            bound = (bound < 0) ? selectivity : std::min(bound, selectivity);
+        }
+        for(auto &columnBounds : bounds)
+        {
+            double upper = columnBounds.second.first;
+            double lower = columnBounds.second.second;
+            if(upper < 0 || lower < 0)
+            {
+                termSelectivity *= std::max(upper, lower);
+                continue;
+            }
+            //Rows below the upper bound less those not above the lower
+            const ColumnStatistics *stats = relation->getStatistics().getColumn(columnBounds.first);
+            double nonNull = stats ? stats->nonNullFraction() : 1;
+            termSelectivity *= std::max(0.0, upper + lower - nonNull);
+        }
+        noneMatch *= 1 - std::max(0.0, std::min(1.0, termSelectivity));
+    }
+    return 1 - noneMatch;
+}
+
+double EstimateSelectivity(OrNode *query, Relation *relation)
+{
+    return CombineSelectivity(query, relation, "", false);
+}
+
+double EstimateSelectivity(string query, Relation *relation)
+{
+    if(StripSpaces(query).empty())
+    {
+        return 1;
+    }
+    OrNode *parsed = createQuery(query);
+    double selectivity = EstimateSelectivity(parsed, relation);
+    delete parsed;
+    return selectivity;
+}
+
+double EstimateFieldSelectivity(string query, Relation *relation, string field, bool equalityOnly)
+{
+    if(StripSpaces(query).empty())
+    {
+        return 1;
+    }
+    OrNode *parsed = createQuery(query);
+    double selectivity = CombineSelectivity(parsed, relation, field, equalityOnly);
+    delete parsed;
+    return selectivity;
+}
+
+int CountFieldTerms(string query, string field, bool equalityOnly)
+{
+    if(StripSpaces(query).empty())
+    {
+        return 0;
+    }
+    OrNode *parsed = createQuery(query);
+    int terms = 0;
+    for(auto &andNode : parsed->getAnds())
+    {
+        bool onField = false;
+        for(auto &clause : andNode.getClauses())
+        {
+            onField = onField || (StripSpaces(clause.m_field) == field
+                && (!equalityOnly || StripSpaces(clause.m_relation) == "="));
+        }
+        if(!onField)
+        {
+            terms = 0;
+            break;
+        }
+        ++terms;
+    }
+    delete parsed;
+    return terms;
+}
+
+int CountClauses(string query, set<string> &fields)
+{
+    if(StripSpaces(query).empty())
+    {
+        return 0;
+    }
+    OrNode *parsed = createQuery(query);
+    int clauses = 0;
+    for(auto &andNode : parsed->getAnds())
+    {
+        for(auto &clause : andNode.getClauses())
+        {
+            fields.insert(StripSpaces(clause.m_field));
+            ++clauses;
+        }
+    }
+    delete parsed;
+    return clauses;
+}
+
+double EstimateRows(Relation *relation, string query)
+{
+    return relation->getSize() * EstimateSelectivity(query, relation);
+}
+
+double EstimateDistinct(Node *node, string field)
+{
+    InputNode *input = dynamic_cast<InputNode*>(node);
+    double rows = std::max(1, node->Outputs());
+    if(input)
+    {
+        const ColumnStatistics *stats = input->GetRelation()->getStatistics().getColumn(field);
+        return stats ? std::min((double)stats->m_distinct, rows) : 0;
+    }
+    for(ConnNum num = 0; num < node->m_inputs.size(); num++)
+    {
+        double distinct = EstimateDistinct(node->Input(num), field);
+        if(distinct > 0)
+        {
+            return std::min(distinct, rows);
+        }
+    }
+    return 0;
+}
+
+double EstimateJoinSelectivity(double leftDistinct, double rightDistinct)
+{
+    return 1 / std::max(1.0, std::max(leftDistinct, rightDistinct));
+}
+
+int RowsToInt(double rows)
+{
+    if(rows >= INT_MAX)
+    {
+        return INT_MAX;
+    }
+    return (int)std::ceil(std::max(0.0, rows));
+}
+
+#endif
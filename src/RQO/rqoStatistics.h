@@ -0,0 +1,114 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoColumnarRelation.h"
+#include "queryNodes.h"
+
+#if DORQO
+
+//Equi-depth buckets per column histogram
+#define HISTOGRAMBUCKETS 32
+
+class Node;
+
+//Summary of one column.  Values are in the column's numeric domain:
+//dates as days and strings as codes of the sorted dictionary, so
+//string ranges are code ranges
+class ColumnStatistics
+{
+public:
+    ColumnType m_type;
+    size_t m_rows;
+    size_t m_nulls;
+    size_t m_distinct;
+    double m_min;
+    double m_max;
+    //Values filling at least a bucket on their own, with exact counts.
+    //These are left out of the histogram
+    vector<double> m_frequentValues;
+    vector<size_t> m_frequentRows;
+    //Bucket i holds m_bucketRows[i] values, m_bucketDistinct[i] of
+    //them distinct, all in (m_bounds[i - 1], m_bounds[i]].  The first
+    //bucket starts at m_histogramMin
+    double m_histogramMin;
+    vector<double> m_bounds;
+    vector<size_t> m_bucketRows;
+    vector<size_t> m_bucketDistinct;
+
+    ColumnStatistics();
+    virtual void collect(const ColumnView &column);
+    //Fraction of all rows that are not null and below value
+    virtual double fractionBelow(double value, bool inclusive) const;
+    //Fraction of all rows equal to value
+    virtual double fractionEqual(double value) const;
+    virtual double nonNullFraction() const;
+};
+
+
+class RelationStatistics
+{
+public:
+    size_t m_rows;
+    vector<string> m_names;
+    vector<ColumnStatistics> m_columns;
+
+    RelationStatistics();
+    virtual ~RelationStatistics() {}
+    virtual void collect(const ColumnarRelation *relation);
+    //NULL when the relation has no such column
+    virtual const ColumnStatistics* getColumn(string name) const;
+};
+
+
+//Fraction of relation's rows satisfying a predicate.  Bounds on one
+//column within an AND are combined into a range, otherwise clauses
+//are assumed independent: an AND multiplies and an OR adds the chance
+//of the rest not matching
+double EstimateSelectivity(queryNodes::OrNode *query, Relation *relation);
+double EstimateSelectivity(string query, Relation *relation);
+//Selectivity of just the clauses on field, only its equalities when
+//equalityOnly.  AND terms without such a clause contribute 1, so this
+//is what an index on field can narrow the relation to
+double EstimateFieldSelectivity(string query, Relation *relation, string field, bool equalityOnly);
+//Number of AND terms of query with such a clause on field, the number
+//of index lookups it takes.  0 when some term has none, since the
+//index then cannot find all matches
+int CountFieldTerms(string query, string field, bool equalityOnly);
+//Number of clauses in query, with the fields they read added to fields
+int CountClauses(string query, set<string> &fields);
+//Rows relation contributes after applying query
+double EstimateRows(Relation *relation, string query);
+//Distinct values of field in the output of node, 0 when no input of
+//node produces field
+double EstimateDistinct(Node *node, string field);
+//Selectivity of an equi-join on keys with the given distinct counts
+double EstimateJoinSelectivity(double leftDistinct, double rightDistinct);
+//Rounds an estimate to the int Node::Outputs returns
+int RowsToInt(double rows);
+
+
+#endif
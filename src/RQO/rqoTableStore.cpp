@@ -0,0 +1,299 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoTableStore.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if DORQO
+
+MappedFile::MappedFile(string path)
+    : m_path(path),
+    m_data(NULL),
+    m_size(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd == -1)
+    {
+        cout << "Cannot open " << path << ": " << strerror(errno) << endl;
+        throw;
+    }
+    struct stat info;
+    if(fstat(fd, &info) == -1)
+    {
+        close(fd);
+        cout << "Cannot stat " << path << ": " << strerror(errno) << endl;
+        throw;
+    }
+    m_size = info.st_size;
+    //mmap refuses empty mappings, and an empty file needs none
+    if(m_size)
+    {
+        void *data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED)
+        {
+            close(fd);
+            cout << "Cannot map " << path << ": " << strerror(errno) << endl;
+            throw;
+        }
+        m_data = (const char*)data;
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if(m_data)
+    {
+        munmap((void*)m_data, m_size);
+    }
+}
+
+string TableHeaderPath(string dir, string name)
+{
+    return dir + "/" + name + ".rqt";
+}
+
+string TableColumnPath(string dir, string name, string column)
+{
+    return dir + "/" + name + "." + column + ".rqc";
+}
+
+template<class T>
+static void WriteValue(std::ofstream &out, T value)
+{
+    out.write((const char*)&value, sizeof(T));
+}
+
+static void WriteString(std::ofstream &out, const string &str)
+{
+    WriteValue<uint32_t>(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+static void CloseFile(std::ofstream &out, const string &path)
+{
+    out.close();
+    if(out.fail())
+    {
+        cout << "Writing " << path << " failed" << endl;
+        throw;
+    }
+}
+
+static void SaveColumn(const Column &column, string path)
+{
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    ColumnView values = column.view();
+    size_t rows = values.size();
+    if(values.m_type == DOUBLECOLUMN)
+    {
+        out.write((const char*)values.m_doubles, rows * sizeof(double));
+    }
+    else
+    {
+        out.write((const char*)values.m_ints, rows * sizeof(int64_t));
+    }
+    if(values.m_type == STRINGCOLUMN)
+    {
+        int64_t offset = 0;
+        WriteValue<int64_t>(out, offset);
+        for(auto &str : column.m_dictionary)
+        {
+            offset += str.size();
+            WriteValue<int64_t>(out, offset);
+        }
+        for(auto &str : column.m_dictionary)
+        {
+            out.write(str.data(), str.size());
+        }
+    }
+    if(values.m_nulls)
+    {
+        out.write((const char*)values.m_nulls, rows);
+    }
+    CloseFile(out, path);
+}
+
+void SaveTable(const ColumnarRelation &table, string dir)
+{
+    if(mkdir(dir.c_str(), 0777) == -1 && errno != EEXIST)
+    {
+        cout << "Cannot create " << dir << ": " << strerror(errno) << endl;
+        throw;
+    }
+    for(auto &column : table.m_columns)
+    {
+        SaveColumn(column, TableColumnPath(dir, table.m_name, column.m_name));
+    }
+
+    string path = TableHeaderPath(dir, table.m_name);
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(RQOTABLEMAGIC, strlen(RQOTABLEMAGIC));
+    WriteValue<uint32_t>(out, RQOTABLEVERSION);
+    WriteValue<uint64_t>(out, table.m_numRows);
+    WriteValue<uint32_t>(out, table.m_columns.size());
+    for(size_t i = 0; i < table.m_columns.size(); i++)
+    {
+        const Column &column = table.m_columns[i];
+        WriteString(out, column.m_name);
+        WriteValue<uint8_t>(out, column.m_type);
+        WriteValue<uint8_t>(out, column.m_dateFormat);
+        WriteValue<uint8_t>(out, table.m_schema.m_indexed[i]);
+        WriteValue<uint8_t>(out, column.view().m_nulls != NULL);
+        WriteValue<uint8_t>(out, column.m_sortedDictionary);
+        WriteValue<uint64_t>(out, column.m_dictionary.size());
+    }
+    CloseFile(out, path);
+}
+
+//Reads a table header, failing on anything past its end
+class HeaderReader
+{
+public:
+    const MappedFile &m_file;
+    size_t m_pos;
+
+    HeaderReader(const MappedFile &file) : m_file(file), m_pos(0) {}
+
+    const char* take(size_t bytes)
+    {
+        if(m_pos + bytes > m_file.size())
+        {
+            cout << "Table header " << m_file.m_path << " is truncated" << endl;
+            throw;
+        }
+        const char *data = m_file.data() + m_pos;
+        m_pos += bytes;
+        return data;
+    }
+
+    template<class T>
+    T read()
+    {
+        T value;
+        memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    string readString()
+    {
+        uint32_t length = read<uint32_t>();
+        return string(take(length), length);
+    }
+};
+
+//Points column at its file, after checking the file has the size
+//the header implies
+static void MapColumn(Column &column, string path, size_t rows, bool hasNulls, size_t dictionarySize)
+{
+    std::shared_ptr<MappedFile> file(new MappedFile(path));
+    size_t expected = rows * sizeof(int64_t) + (hasNulls ? rows : 0);
+    const int64_t *offsets = NULL;
+    const char *chars = NULL;
+    if(column.m_type == STRINGCOLUMN)
+    {
+        expected += (dictionarySize + 1) * sizeof(int64_t);
+        if(file->size() >= expected)
+        {
+            offsets = (const int64_t*)(file->data() + rows * sizeof(int64_t));
+            chars = (const char*)(offsets + dictionarySize + 1);
+            expected += offsets[dictionarySize];
+        }
+    }
+    if(file->size() != expected)
+    {
+        cout << "Column file " << path << " has " << file->size()
+            << " bytes, expected " << expected << endl;
+        throw;
+    }
+    column.m_dictionary.reserve(dictionarySize);
+    for(size_t i = 0; i < dictionarySize; i++)
+    {
+        column.m_dictionary.push_back(string(chars + offsets[i], offsets[i + 1] - offsets[i]));
+    }
+    column.m_hasNulls = hasNulls;
+    column.m_mappedValues = rows ? file->data() : NULL;
+    column.m_mappedNulls = hasNulls ? (const uint8_t*)(file->data() + file->size() - rows) : NULL;
+    column.m_mappedRows = rows;
+    column.m_mapping = file;
+}
+
+ColumnarRelation* OpenTable(string dir, string name)
+{
+    string path = TableHeaderPath(dir, name);
+    if(access(path.c_str(), R_OK) == -1)
+    {
+        return NULL;
+    }
+    MappedFile file(path);
+    HeaderReader header(file);
+    if(memcmp(header.take(strlen(RQOTABLEMAGIC)), RQOTABLEMAGIC, strlen(RQOTABLEMAGIC))
+        || header.read<uint32_t>() != RQOTABLEVERSION)
+    {
+        cout << path << " is not a version " << RQOTABLEVERSION << " table" << endl;
+        throw;
+    }
+    size_t rows = header.read<uint64_t>();
+    uint32_t numColumns = header.read<uint32_t>();
+
+    Schema schema;
+    vector<uint8_t> dateFormats, hasNulls, sortedDictionaries;
+    vector<size_t> dictionarySizes;
+    for(uint32_t i = 0; i < numColumns; i++)
+    {
+        string columnName = header.readString();
+        ColumnType type = (ColumnType)header.read<uint8_t>();
+        if(type > DATECOLUMN)
+        {
+            cout << "Column " << columnName << " of " << path << " has a bad type" << endl;
+            throw;
+        }
+        dateFormats.push_back(header.read<uint8_t>());
+        bool indexed = header.read<uint8_t>();
+        hasNulls.push_back(header.read<uint8_t>());
+        sortedDictionaries.push_back(header.read<uint8_t>());
+        dictionarySizes.push_back(header.read<uint64_t>());
+        schema.addColumn(columnName, type, indexed);
+    }
+
+    ColumnarRelation *table = new ColumnarRelation(name, schema);
+    for(uint32_t i = 0; i < numColumns; i++)
+    {
+        Column &column = table->m_columns[i];
+        column.m_dateFormat = (DateFormat)dateFormats[i];
+        column.m_hasDates = rows > 0;
+        column.m_sortedDictionary = sortedDictionaries[i];
+        MapColumn(column, TableColumnPath(dir, name, column.m_name), rows, hasNulls[i], dictionarySizes[i]);
+    }
+    table->m_numRows = rows;
+    return table;
+}
+
+
+#endif
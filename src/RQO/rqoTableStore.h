@@ -0,0 +1,75 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.               
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "rqoBasis.h"
+#include "rqoColumnarRelation.h"
+
+#if DORQO
+
+//First bytes of a table header, followed by RQOTABLEVERSION
+#define RQOTABLEMAGIC "RQOTABLE"
+#define RQOTABLEVERSION 1
+
+
+//A file mapped read only into memory for as long as the object
+//lives.  Pages are read in by the OS as they are touched, so opening
+//a large file costs nothing up front
+class MappedFile
+{
+public:
+    string m_path;
+    const char *m_data;
+    size_t m_size;
+
+    MappedFile(string path);
+    virtual ~MappedFile();
+    virtual const char* data() const {return m_data;}
+    virtual size_t size() const {return m_size;}
+
+private:
+    MappedFile(const MappedFile &orig);
+    MappedFile& operator=(const MappedFile &orig);
+};
+
+
+//A table is stored in dir as a header, name.rqt, holding the row
+//count and the schema, and one file per column, name.column.rqc.  A
+//column file holds the row values as int64s (doubles for double
+//columns), then for string columns the dictionary as num + 1 int64
+//offsets and the characters, then a null byte per row when the
+//column has nulls.  Values are stored in host byte order
+string TableHeaderPath(string dir, string name);
+string TableColumnPath(string dir, string name, string column);
+
+//Writes a sealed table to dir.  The header goes last, so a table is
+//only found once all of its columns are written
+void SaveTable(const ColumnarRelation &table, string dir);
+//Maps the table saved as name in dir, NULL when there is none.
+//Values are used in place and only the string dictionaries are read
+ColumnarRelation* OpenTable(string dir, string name);
+
+
+#endif
@@ -0,0 +1,288 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "rqoTestSuites.h"
+#include "functions.h"
+#include "queryNodes.h"
+#include "rqoExecutor.h"
+#include "rqoColumnarRelation.h"
+#include "universe.h"
+#include "userInput.h"
+#include "linearization/graphIter.h"
+#include <algorithm>
+
+#if DORQO
+
+//Rows of the generated tables.  The left table is the hash join's
+//build side and is sorted, so it is past HASHJOINPARTITIONROWS and
+//RADIXSORTMINROWS
+#define DIFFTESTLEFTROWS 5000
+#define DIFFTESTRIGHTROWS 4500
+
+//Keys have four digits, so tuple at a time selection, which compares
+//strings, agrees with the typed batch comparisons.  No other value
+//equals a key, as joinTuples drops every field equal to the key
+static Relation* BuildLeftTable()
+{
+    Relation *left = new Relation("difftest_left");
+    left->addAttribute("id", "number", true);
+    left->addAttribute("key", "number", true);
+    left->addAttribute("tag", "string", false);
+    for(int i = 0; i < DIFFTESTLEFTROWS; i++)
+    {
+        Tuple tuple;
+        tuple.addField("id", std::to_string(100000 + i));
+        tuple.addField("key", std::to_string(1000 + (i * 7919) % 1000));
+        tuple.addField("tag", "t" + std::to_string(i % 13));
+        left->addTuple(tuple);
+    }
+    return left;
+}
+
+static Relation* BuildRightTable()
+{
+    Relation *right = new Relation("difftest_right");
+    right->addAttribute("key", "number", true);
+    right->addAttribute("val", "number", false);
+    for(int i = 0; i < DIFFTESTRIGHTROWS; i++)
+    {
+        Tuple tuple;
+        tuple.addField("key", std::to_string(1000 + (i * 104729) % 1200));
+        tuple.addField("val", std::to_string(10000 + i));
+        right->addTuple(tuple);
+    }
+    return right;
+}
+
+//String keys that are integers with and without leading zeros, so a
+//join on their integer values would match rows nestedJoin does not
+static Relation* BuildPaddedKeyTable(string name, int numRows, int numZeros, int numKeys)
+{
+    Relation *table = new Relation(name);
+    table->addAttribute("code", "string", true);
+    table->addAttribute(name + "_row", "number", false);
+    for(int i = 0; i < numRows; i++)
+    {
+        Tuple tuple;
+        tuple.addField("code", string(i % numZeros, '0') + std::to_string(i % numKeys));
+        tuple.addField(name + "_row", std::to_string(i));
+        table->addTuple(tuple);
+    }
+    return table;
+}
+
+//Columnar type of the named column of table
+static ColumnType KeyType(Relation &table, string name)
+{
+    const Schema &schema = table.getColumns()->m_schema;
+    return schema.m_types[schema.indexOf(name)];
+}
+
+//A tuple as its sorted field=value pairs, so rows compare equal
+//whatever order their fields come in
+static string RowString(const Tuple &tuple)
+{
+    vector<string> pairs;
+    for(const FieldValuePair &pair : tuple.fields)
+    {
+        pairs.push_back(pair.m_field + "=" + pair.m_value);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    string row;
+    for(const string &pair : pairs)
+    {
+        row += pair + "|";
+    }
+    return row;
+}
+
+static vector<string> RowStrings(const vector<Tuple> &tuples, bool sortRows)
+{
+    vector<string> rows;
+    rows.reserve(tuples.size());
+    for(const Tuple &tuple : tuples)
+    {
+        rows.push_back(RowString(tuple));
+    }
+    if(sortRows)
+    {
+        std::sort(rows.begin(), rows.end());
+    }
+    return rows;
+}
+
+//With inOrder, rows must also come out in the same order
+static void CheckSameRows(const vector<Tuple> &expected, const vector<Tuple> &actual,
+                          string test, bool inOrder)
+{
+    if(RowStrings(expected, !inOrder) != RowStrings(actual, !inOrder))
+    {
+        cout << "ERROR: " << test << " gives " << actual.size() << " rows, the reference gives "
+             << expected.size() << (inOrder ? " or a different order" : "") << endl;
+        throw;
+    }
+    cout << "Passed " << test << ", " << actual.size() << " rows" << endl;
+}
+
+//Tuple at a time selection keeping only fields
+static vector<Tuple> ReferenceSelect(Relation &table, string query, const set<string> &fields)
+{
+    queryNodes::OrNode *tree = createQuery(query);
+    vector<Tuple> output;
+    for(const Tuple &tuple : table.getTuples())
+    {
+        if(tree->evaluate(tuple, -1))
+        {
+            output.push_back(tuple);
+        }
+    }
+    delete tree;
+    vector<string> removed;
+    for(auto attribute : table.attributes)
+    {
+        if(fields.find(attribute.m_name) == fields.end())
+        {
+            removed.push_back(attribute.m_name);
+        }
+    }
+    return trim(output, removed);
+}
+
+static void CheckSelections(Relation &left)
+{
+    vector<string> allFields;
+    set<string> fieldSet;
+    for(auto attribute : left.attributes)
+    {
+        allFields.push_back(attribute.m_name);
+        fieldSet.insert(attribute.m_name);
+    }
+    int keyColumn = 1;
+    set<int> keyAndId;
+    keyAndId.insert(0);
+    keyAndId.insert(keyColumn);
+
+    vector<string> queries;
+    queries.push_back("key > 1200 AND key < 1500");
+    queries.push_back("key = 1337 OR key >= 1900");
+    queries.push_back("tag = t3 AND key <= 1400");
+    for(const string &query : queries)
+    {
+        vector<Tuple> expected = ReferenceSelect(left, query, fieldSet);
+        queryNodes::OrNode *tree = createQuery(query);
+        CheckSameRows(expected, scanFunc(left, tree, allFields), "scan of " + query, true);
+        CheckSameRows(expected, indexFunc(left, tree, keyColumn, allFields),
+                      "hash index read of " + query, false);
+        CheckSameRows(expected, nindexFunc(left, tree, keyAndId, allFields),
+                      "multi hash index read of " + query, false);
+        CheckSameRows(expected, orderedindexFunc(left, tree, keyColumn, allFields),
+                      "sorted index read of " + query, false);
+        delete tree;
+    }
+}
+
+//Joins field key1 of left with field key2 of right, with the types of
+//their columns
+static void CheckJoins(Relation &left, int key1, Relation &right, int key2, string test)
+{
+    vector<Tuple> leftTuples = left.getTuples();
+    vector<Tuple> rightTuples = right.getTuples();
+    ColumnType type1 = KeyType(left, left.attributes[key1].m_name);
+    ColumnType type2 = KeyType(right, right.attributes[key2].m_name);
+    vector<Tuple> expected = nestedJoin(leftTuples, rightTuples, key1, key2);
+    CheckSameRows(expected, hashJoin(leftTuples, rightTuples, key1, key2, type1, type2),
+                  "radix hash join" + test, false);
+    CheckSameRows(expected, mergeJoin(leftTuples, rightTuples, key1, key2, type1, type2),
+                  "merge join" + test, false);
+}
+
+//"007" and "7" are different string keys
+static void CheckPaddedKeyJoins()
+{
+    Relation *left = BuildPaddedKeyTable("padded_left", DIFFTESTLEFTROWS, 3, 700);
+    Relation *right = BuildPaddedKeyTable("padded_right", DIFFTESTRIGHTROWS, 2, 900);
+    if(KeyType(*left, "code") != STRINGCOLUMN)
+    {
+        cout << "ERROR: padded keys are not a string column" << endl;
+        throw;
+    }
+    CheckJoins(*left, 0, *right, 0, " on padded string keys");
+    delete left;
+    delete right;
+}
+
+//sortFunc is stable, so it must match a stable sort on the key
+static void CheckSort(Relation &left)
+{
+    vector<Tuple> tuples = left.getTuples();
+    vector<Tuple> expected = tuples;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Tuple &one, const Tuple &two)
+                     {
+                         return one.fields[1].m_value < two.fields[1].m_value;
+                     });
+    CheckSameRows(expected, sortFunc(tuples, 1), "radix sort", true);
+}
+
+void RunOperatorDifferentialTests()
+{
+    Relation *left = BuildLeftTable();
+    Relation *right = BuildRightTable();
+    CheckSelections(*left);
+    CheckJoins(*left, 1, *right, 0, "");
+    CheckPaddedKeyJoins();
+    CheckSort(*left);
+    delete left;
+    delete right;
+}
+
+void RunExamplePlanDifferentialTests(Universe &uni)
+{
+    //The selections and join ExampleFunc builds
+    set<string> orderFields = {"ono", "cno", "eno"};
+    set<string> detailFields = {"ono", "pno", "qty"};
+    vector<Tuple> orders = ReferenceSelect(*getRelationByName("orders"),
+                                           "ono > 1000 AND ono < 1023", orderFields);
+    vector<Tuple> details = ReferenceSelect(*getRelationByName("odetails"),
+                                            "ono > 1000", detailFields);
+    vector<Tuple> expected = nestedJoin(orders, details, 0, 0);
+
+    GraphNum plan = 1;
+    for(auto poss : uni.m_pset->m_posses)
+    {
+        GraphIter iter(poss.second);
+        do
+        {
+            Executor executor;
+            CheckSameRows(expected, executor.Run(iter), "plan " + std::to_string(plan), false);
+            ++plan;
+        } while(!iter.Increment());
+    }
+    if(plan - 1 != uni.TotalCount())
+    {
+        cout << "ERROR: ran " << plan - 1 << " of " << uni.TotalCount() << " plans" << endl;
+        throw;
+    }
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+    This file is part of DxTer.
+    DxTer is a prototype using the Design by Transformation (DxT)
+    approach to program generation.
+
+    Copyright (C) 2015, The University of Texas and Bryan Marker
+
+    DxTer is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DxTer is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DxTer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#pragma once
+
+#include "layers.h"
+#include "base.h"
+
+#if DORQO
+
+class Universe;
+
+//Checks the batch selections, indexes, radix hash and merge joins and
+//radix sort against tuple at a time selection, nestedJoin and a
+//stable sort, on generated tables big enough to partition and radix
+//sort, and joins on string keys with leading zeros.  Throws on the
+//first difference
+void RunOperatorDifferentialTests();
+
+//Runs every plan in uni through the Executor and checks each gives
+//the rows nestedJoin gives for ExampleFunc's query on the example
+//tables.  Throws on the first difference
+void RunExamplePlanDifferentialTests(Universe &uni);
+
+#endif
@@ -33,13 +33,13 @@
 
 class Trim : public Sortable
 {
-  set<string> m_inFields;
-
  protected:
   DataTypeInfo m_dataTypeInfo;
 
 
  public:
+  set<string> m_inFields;
+
   Trim();
   Trim(string sortBy, set<string> &inFields);
   virtual NodeType GetType() const;
@@ -49,7 +49,7 @@ class Trim : public Sortable
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs();}
+  virtual Cost GetCost() {return CopyCost(Input(0)->Outputs());}
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "trim";}
   virtual void ClearDataTypeCache();
@@ -61,6 +61,15 @@ void Union::Duplicate(const Node *orig, bool shallow, bool possMerging)
   Node::Duplicate(orig, shallow, possMerging);
 }
 
+Cost Union::GetCost()
+{
+  const string &key = m_dataTypeInfo.m_orderedBy;
+  bool leftOrdered = !key.empty() && InputDataType(0).m_orderedBy == key;
+  bool rightOrdered = !key.empty() && InputDataType(1).m_orderedBy == key;
+  return SortCost(Input(0)->Outputs(), leftOrdered)
+    + SortCost(Input(1)->Outputs(), rightOrdered) + CopyCost(Outputs());
+}
+
 const DataTypeInfo& Union::DataType(ConnNum num) const
 {
   return m_dataTypeInfo;
@@ -77,6 +86,13 @@ void Union::BuildDataTypeCache()
   m_dataTypeInfo.m_fields = InputDataType(0).m_fields;
   m_dataTypeInfo.m_fields.insert(InputDataType(1).m_fields.begin(),
 				 InputDataType(1).m_fields.end());
+  //unionFunc merges on the sort by field, or the first field without one
+  if (!m_sortBy.empty())
+    m_dataTypeInfo.m_orderedBy = m_sortBy;
+  else if (!m_fields.empty())
+    m_dataTypeInfo.m_orderedBy = m_fields.front();
+  else
+    m_dataTypeInfo.m_orderedBy = "";
 }
 
 void Union::Prop()
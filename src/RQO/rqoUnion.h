@@ -51,13 +51,14 @@ class Union : public Sortable
   virtual const DataTypeInfo& DataType(ConnNum num) const;
   virtual void Prop();
   virtual void PrintCode(IndStream &out);
-  virtual Cost GetCost() {return Input(0)->Outputs() * log(Input(0)->Outputs());}
+  //Both inputs are sorted and merged
+  virtual Cost GetCost();
   virtual ClassType GetNodeClass() const {return GetClass();}
   static ClassType GetClass() {return "union";}
   virtual void ClearDataTypeCache();
   virtual void BuildDataTypeCache();
   virtual bool Overwrites(const Node *input, ConnNum num) const {return false;}
-  virtual int Outputs() {return Input(0)->Outputs();}
+  virtual int Outputs() {return RowsToInt((double)Input(0)->Outputs() + Input(1)->Outputs());}
 };
 
 
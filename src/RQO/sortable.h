@@ -26,6 +26,8 @@
 #include "layers.h"
 #include "rqoNode.h"
 #include "rqoBasis.h"
+#include "rqoCostModel.h"
+#include "rqoStatistics.h"
 
 #if DORQO
 
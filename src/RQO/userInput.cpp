@@ -20,6 +20,8 @@
 */
 
 #include "userInput.h"
+#include "rqoColumnarRelation.h"
+#include "rqoStatistics.h"
 
 
 #if DORQO
@@ -30,6 +32,17 @@ void BuildUserTables()
 	
 }
 
+//Converts every relation in userRDB to typed column storage and
+//collects the statistics plans are costed with
+void BuildColumnarTables()
+{
+  for(auto relation : userRDB)
+  {
+    relation->getColumns();
+    relation->getStatistics();
+  }
+}
+
 //Write User Code in this function
 RealPSet* UserFunction()
 {
@@ -290,6 +303,41 @@ RealPSet* ExampleFunc()
   return pset;
 }
 
+bool HasExampleTables()
+{
+  map<string, vector<string>> needed;
+  needed["orders"] = {"ono", "cno", "eno"};
+  needed["odetails"] = {"ono", "pno", "qty"};
+  bool found = true;
+  for(auto &table : needed)
+  {
+    Relation *relation = NULL;
+    for(auto rel : userRDB)
+    {
+      if(rel->getName() == table.first)
+      {
+        relation = rel;
+      }
+    }
+    if(!relation)
+    {
+      cout << "ERROR: the example query needs a table named " << table.first << endl;
+      found = false;
+      continue;
+    }
+    for(auto &column : table.second)
+    {
+      if(relation->getColumns()->m_schema.indexOf(column) < 0)
+      {
+        cout << "ERROR: the example query needs column " << column
+          << " in table " << table.first << endl;
+        found = false;
+      }
+    }
+  }
+  return found;
+}
+
 vector<Relation*> getuserRelations()
 {
 	return userRDB;
@@ -47,7 +47,11 @@
 	/*Example Functions*/
 	void BuildUserTables();
 	void BuildExampleTables();
+	void BuildColumnarTables();
 	RealPSet* ExampleFunc();
+	//Whether userRDB has the tables and columns ExampleFunc reads,
+	//printing what is missing when it does not
+	bool HasExampleTables();
 	RealPSet* UserFunction();
 	vector<Relation*> getUserRelations();
 	Relation* getRelationByName(string name);
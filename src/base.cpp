@@ -731,6 +731,47 @@ string BoolToStr(bool boolVal)
     return "FALSE";
 }
 
+#if DOLLDLA
+bool IsComplex(Type type)
+{
+  return type == COMPLEX_SINGLE || type == COMPLEX_DOUBLE;
+}
+
+Type ComponentType(Type type)
+{
+  switch(type) {
+  case(REAL_SINGLE):
+  case(COMPLEX_SINGLE):
+    return REAL_SINGLE;
+  case(REAL_DOUBLE):
+  case(COMPLEX_DOUBLE):
+    return REAL_DOUBLE;
+  default:
+    cout << "ERROR: Bad type in ComponentType" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+
+string ElemTypeName(Type type)
+{
+  switch(type) {
+  case(REAL_SINGLE):
+    return "float";
+  case(REAL_DOUBLE):
+    return "double";
+  case(COMPLEX_SINGLE):
+    return "float _Complex";
+  case(COMPLEX_DOUBLE):
+    return "double _Complex";
+  default:
+    cout << "ERROR: Bad type in ElemTypeName" << endl;
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+}
+#endif // DOLLDLA
+
 string DiagToStr(Diag diag)
 {
   if (diag == UNIT)
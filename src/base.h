@@ -89,7 +89,8 @@ enum TriStruct { HERM,
 #if DOLLDLA
 enum Type { REAL_SINGLE,
 	    REAL_DOUBLE,
-	    COMPLEX };
+	    COMPLEX_SINGLE,
+	    COMPLEX_DOUBLE };
 #else
 enum Type { REAL,
 	    COMPLEX };
@@ -133,6 +134,16 @@ string DiagToStr(Diag diag);
 
 bool IsTrans(Trans trans);
 
+#if DOLLDLA
+//Complex elements are stored interleaved, real part first,
+// the same as C99 float _Complex and double _Complex
+bool IsComplex(Type type);
+//Type of the real and imaginary parts of a complex element
+Type ComponentType(Type type);
+//C type of one element in generated code
+string ElemTypeName(Type type);
+#endif
+
 
 #if DOELEM
 enum DistType { UNKNOWN, 
@@ -154,12 +154,16 @@ Type CharToType(char c)
     return REAL_SINGLE;
  case('D'):
     return REAL_DOUBLE;
+ case('C'):
+    return COMPLEX_SINGLE;
+ case('Z'):
+    return COMPLEX_DOUBLE;
 #else
   case('R'):
     return REAL;
-#endif // DOLLDLA
   case('C'):
     return COMPLEX;
+#endif // DOLLDLA
   default:
     LOG_FAIL("replacement for throw call");
     throw;
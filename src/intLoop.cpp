@@ -49,6 +49,8 @@ BSSize LLDLA3MuSingle(USELLDLA3MUSINGLE);
 BSSize LLDLAMuDouble(USELLDLAMUDOUBLE);
 BSSize LLDLA2MuDouble(USELLDLA2MUDOUBLE);
 BSSize LLDLA3MuDouble(USELLDLA3MUDOUBLE);
+BSSize LLDLAMuComplexSingle(USELLDLAMUCOMPLEXSINGLE);
+BSSize LLDLAMuComplexDouble(USELLDLAMUCOMPLEXDOUBLE);
 
 #endif
 BSSize BadBS(BADBSSIZE);
@@ -77,6 +79,9 @@ string BSSize::VarName() const
     case (USELLDLA3MUDOUBLE):
       return "(" + std::to_string((long long int) m_multiple) + 
 	"*(3*" + (string)(MU_VAR_NAME) + "))";
+    case (USELLDLAMUCOMPLEXSINGLE):
+    case (USELLDLAMUCOMPLEXDOUBLE):
+      return "(" + std::to_string((long long int) m_multiple) + "*" + MU_VAR_NAME + ")";
 #elif DOTENSORS
     case (USETENSORBS):
       return "tensor bs name here";
@@ -234,6 +239,10 @@ bool IntLoop<PSetType>::CanMerge(BasePSet *pset) const
 #if DOBLIS
   if (loop->m_comm != CORECOMM || m_comm != CORECOMM)
     return false;
+#endif
+#if DOLLDLA
+  if (loop->GetParallelism() != SEQUENTIALLOOP || GetParallelism() != SEQUENTIALLOOP)
+    return false;
 #endif
   if (GetType() != loop->GetType())
     return false;
@@ -562,6 +571,11 @@ template<class PSetType>
   TunVecIter iter = poss->m_inTuns.begin();
   for(; iter != poss->m_inTuns.end(); ++iter) {
     if (((LoopTunnel*)(*iter))->IsSplit()) {
+#if DOLLDLA
+      //Parallel loops set their partitions inside the loop body
+      if (GetParallelism() != SEQUENTIALLOOP)
+	continue;
+#endif
       ((SplitBase*)(*iter))->PrintVarDeclarations(size, out);
     }
   }
@@ -710,6 +724,8 @@ template<class PSetType>
     case (USELLDLAMUDOUBLE):
     case (USELLDLA2MUDOUBLE):
     case (USELLDLA3MUDOUBLE):
+    case (USELLDLAMUCOMPLEXSINGLE):
+    case (USELLDLAMUCOMPLEXDOUBLE):
       break;
     default:
       LOG_FAIL("replacement for throw call");
@@ -743,6 +759,21 @@ template<class PSetType>
 
     string loopLevel = split->GetLoopLevel();
     string lcv = "lcv" + loopLevel;
+    switch(GetParallelism())
+      {
+      case (STATICPARALLELLOOP):
+	out.Indent();
+	*out << "#pragma omp parallel for schedule(static) num_threads("
+	     << numThreads << ")\n";
+	break;
+      case (DYNAMICPARALLELLOOP):
+	out.Indent();
+	*out << "#pragma omp parallel for schedule(dynamic, 1) num_threads("
+	     << numThreads << ")\n";
+	break;
+      default:
+	break;
+      }
     out.Indent();
     *out << "for( " << lcv << " = ";
   
@@ -751,7 +782,8 @@ template<class PSetType>
       throw;
     }
 
-    bool needMin = false;
+    //A size-generic loop can't tell if its last block is full
+    bool needMin = sizeGeneric;
     if (split->m_dir == PARTDOWN) {
       *out << split->InputDataType(0).m_numRowsVar;
       if (!split->GetInputM(0)->EvenlyDivisibleBy(GetBSSize().GetSize()))
@@ -845,6 +877,10 @@ template<class PSetType>
   for(; iter != poss->m_inTuns.end(); ++iter) {
     LoopTunnel *tun = (LoopTunnel*)(*iter);
     if (tun->IsSplit()) {
+#if DOLLDLA
+      if (GetParallelism() != SEQUENTIALLOOP)
+	continue;
+#endif
       SplitBase *split = (SplitBase*)tun;
       split->PrintIncrementAtEndOfLoop(GetBSSize(), out);
     }
@@ -58,6 +58,13 @@ enum UpStat { FULLUP,
 	      NOTUP,
 	      BADUP };
 
+#if DOLLDLA
+// How the iterations of a loop are distributed over threads
+enum LoopParallelism { SEQUENTIALLOOP,
+		       STATICPARALLELLOOP,
+		       DYNAMICPARALLELLOOP };
+#endif
+
 enum Quad { TL, TR,
 	     BL, BR,
 	     LASTQUAD };
@@ -79,6 +86,8 @@ enum BSSizeEnum {
   USELLDLAMUDOUBLE,
   USELLDLA2MUDOUBLE,
   USELLDLA3MUDOUBLE,
+  USELLDLAMUCOMPLEXSINGLE,
+  USELLDLAMUCOMPLEXDOUBLE,
 #endif
   USEUNITBS,
   BADBSSIZE 
@@ -133,8 +142,9 @@ class BSSize
 
   inline Size GetSize() const {
     //Just a sanity check; upperbound can be changed
+    //Cache blocks are large multiples of the register width
 #if DOLLDLA
-    if (m_multiple == 0 || m_multiple > 32) {
+    if (m_multiple == 0 || m_multiple > 1024) {
       LOG_FAIL("replacement for throw call");
       throw;
     }
@@ -169,6 +179,10 @@ class BSSize
 	return m_multiple*2*arch->DVecRegWidth();
       case (USELLDLA3MUDOUBLE):
 	return m_multiple*3*arch->DVecRegWidth();
+      case (USELLDLAMUCOMPLEXSINGLE):
+	return m_multiple*(arch->SVecRegWidth() / 2);
+      case (USELLDLAMUCOMPLEXDOUBLE):
+	return m_multiple*(arch->DVecRegWidth() / 2);
 #endif
       case (USEUNITBS):
 #if DOLLDLA
@@ -199,6 +213,8 @@ extern BSSize LLDLA3MuSingle;
 extern BSSize LLDLAMuDouble;
 extern BSSize LLDLA2MuDouble;
 extern BSSize LLDLA3MuDouble;
+extern BSSize LLDLAMuComplexSingle;
+extern BSSize LLDLAMuComplexDouble;
 #endif
 extern BSSize BadBS;
 extern BSSize UnitBS;
@@ -224,9 +240,12 @@ class LoopInterface
   virtual bool CanMerge(BasePSet *pset) const = 0;
   virtual bool WorthFusing(BasePSet *pset) = 0;
   virtual unsigned int LoopLevel() const = 0;
-#if DOBLIS
+#if DOBLIS||DOLLDLA
   virtual bool HasIndepIters() const = 0;
 #endif
+#if DOLLDLA
+  virtual LoopParallelism GetParallelism() const = 0;
+#endif
 };
 
 template <class PSetType>
@@ -216,6 +216,18 @@ void GraphIter::EvalRoot(IndStream &out, GraphNum &graphNum, GraphNum whichGraph
   }
 }
 
+#if DOLLDLA
+//The cost of a set's current poss is summed over all of the
+// loop's iterations; a parallel loop spreads those over threads
+static Cost SetCost(const BasePSet *set, Cost possCost)
+{
+  const RealPSet *real = set->GetReal();
+  if (real->IsLoop() && ((RealLoop*)real)->IsParallel())
+    return ((RealLoop*)real)->ParallelCost(possCost);
+  return possCost;
+}
+#endif
+
 //Update Eval()
 Cost GraphIter::Eval(TransConstVec &transList)
 {
@@ -236,7 +248,11 @@ Cost GraphIter::Eval(TransConstVec &transList)
   }
 
   for(unsigned int i = 0; i < numPSets; ++i) {
+#if DOLLDLA
+    tot += SetCost(m_poss->m_sets[i], m_subIters[i]->Eval(transList));
+#else
     tot += m_subIters[i]->Eval(transList);
+#endif
   }
 
   m_cost = tot;
@@ -262,7 +278,11 @@ Cost GraphIter::Eval()
   }
 
   for(unsigned int i = 0; i < numPSets; ++i) {
+#if DOLLDLA
+    tot += SetCost(m_poss->m_sets[i], m_subIters[i]->Eval());
+#else
     tot += m_subIters[i]->Eval();
+#endif
   }
 
   m_cost = tot;
@@ -298,7 +318,11 @@ Cost GraphIter::EvalAndSetBest()
 	optCost = tmpCost;
       }
     }
+#if DOLLDLA
+    tot += SetCost(m_poss->m_sets[i], optCost);
+#else
     tot += optCost;
+#endif
   }
 
   m_cost = tot;
@@ -375,6 +399,8 @@ void GraphIter::Print(IndStream &out, BasePSet *owner, StrSet liveSet, Cost curr
   lin.m_lin.EnforceMemConstraint(currCost+lin.m_alwaysLiveCost, 1e10, liveSet, lin.m_alwaysLive, highWater);
   //#endif //PRINTMEMCOSTS
 
+#elif DOLLDLA
+  lin.FindRegPressureLinearization();
 #else
   lin.FindAnyLinearization();
 #endif
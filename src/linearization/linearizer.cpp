@@ -27,6 +27,9 @@
 #include "node.h"
 #include "helperNodes.h"
 #include "rqoHelperNodes.h"
+#if DOLLDLA
+#include "registerPressure.h"
+#endif // DOLLDLA
 
 #define ADDUP 1
 
@@ -42,11 +45,17 @@ Linearizer::Linearizer()
 {
   m_shallow = true;
   m_alwaysLiveCost = 0;
+#if DOLLDLA
+  m_regPressureScheduled = false;
+#endif // DOLLDLA
 }
 
 Linearizer::Linearizer(const Poss *poss)
 {
   m_alwaysLiveCost = 0;
+#if DOLLDLA
+  m_regPressureScheduled = false;
+#endif // DOLLDLA
   PtrToLinElemMap map;
   for(auto node : poss->m_possNodes) {
     FindOrAdd(node, map);
@@ -60,6 +69,9 @@ Linearizer::Linearizer(const Poss *poss, bool shallow)
  :m_shallow(shallow)
 {
   m_alwaysLiveCost = 0;
+#if DOLLDLA
+  m_regPressureScheduled = false;
+#endif // DOLLDLA
   PtrToLinElemMap map;
   for(auto node : poss->m_possNodes) {
     FindOrAdd(node, map);
@@ -80,6 +92,9 @@ void Linearizer::Clear()
     delete elem;
   m_elems.clear();
   m_lin.Clear();
+#if DOLLDLA
+  m_regPressureScheduled = false;
+#endif // DOLLDLA
 }
 
 void Linearizer::Start(const Poss *poss)
@@ -657,9 +672,123 @@ void Linearizer::FindAnyLinearization()
   }
 }
 
+#if DOLLDLA
+//List schedule the elements, greedily keeping the number of live
+// vector registers down and, while there are registers to spare,
+// putting independent work between register arithmetic and its consumers
+void Linearizer::FindRegPressureLinearization()
+{
+  ClearCurrLinearization();
+
+  unsigned int numElems = m_elems.size();
+  vector<StrSet> uses(numElems), defs(numElems);
+  std::map<const LinElem*, unsigned int> index;
+  std::map<string, unsigned int> remainingUses;
+  for (unsigned int i = 0; i < numElems; ++i) {
+    index[m_elems[i]] = i;
+    VecRegUsesAndDefs(m_elems[i], uses[i], defs[i]);
+    for (auto name : uses[i])
+      ++remainingUses[name];
+  }
+
+  int numRegs = arch->NumVecRegs();
+  StrSet live;
+  std::map<string, unsigned int> availableAt;
+  
+  vector<bool> ready(numElems, false);
+  for (unsigned int i = 0; i < numElems; ++i) {
+    if (m_elems[i]->CanAddToLinearOrder())
+      ready[i] = true;
+  }
+
+  for (unsigned int slot = 0; slot < numElems; ++slot) {
+    int best = -1;
+    int bestDelta = 0;
+    unsigned int bestStall = 0;
+    for (unsigned int i = 0; i < numElems; ++i) {
+      if (!ready[i])
+        continue;
+      int delta = 0;
+      unsigned int stall = 0;
+      for (auto name : defs[i])
+        if (live.find(name) == live.end() && uses[i].find(name) == uses[i].end())
+          ++delta;
+      for (auto name : uses[i]) {
+        if (remainingUses[name] == 1)
+          --delta;
+        auto find = availableAt.find(name);
+        if (find != availableAt.end() && find->second > slot)
+          stall = max(stall, find->second - slot);
+      }
+      if (best < 0) {
+        best = i;
+        bestDelta = delta;
+        bestStall = stall;
+        continue;
+      }
+      bool tight = (int)live.size() + max(delta, bestDelta) > numRegs;
+      bool better;
+      if (tight)
+        better = delta < bestDelta || (delta == bestDelta && stall < bestStall);
+      else
+        better = stall < bestStall || (stall == bestStall && delta < bestDelta);
+      if (better) {
+        best = i;
+        bestDelta = delta;
+        bestStall = stall;
+      }
+    }
+    if (best < 0) {
+      for (unsigned int i = 0; i < numElems; ++i) {
+        if (m_elems[i]->CanAddToLinearOrder()) {
+          ready[i] = true;
+          best = i;
+        }
+      }
+      if (best < 0) {
+        PrintConnections();
+        throw;
+      }
+    }
+
+    LinElem *elem = m_elems[best];
+    ready[best] = false;
+    m_lin.m_order.push_back(elem);
+    elem->SetAdded();
+
+    for (auto name : uses[best]) {
+      if (--remainingUses[name] == 0)
+        live.erase(name);
+    }
+    unsigned int latency = VecRegResultLatencySlots(elem);
+    for (auto name : defs[best]) {
+      if (remainingUses[name])
+        live.insert(name);
+      availableAt[name] = slot + 1 + latency;
+    }
+
+    if (elem->m_succ && elem->m_succ->CanAddToLinearOrder())
+      ready[index[elem->m_succ]] = true;
+    for(auto child : elem->m_children) {
+      if (child->CanAddToLinearOrder())
+        ready[index[child]] = true;
+      else {
+        for (auto inToChild : child->m_inputs)
+          if (inToChild->CanAddToLinearOrder())
+            ready[index[inToChild]] = true;
+      }
+    }
+  }
+  m_regPressureScheduled = true;
+}
+#endif // DOLLDLA
+
 void Linearizer::ClearCurrLinearization()
 {
   m_lin.Clear();
+#if DOLLDLA
+  m_regPressureScheduled = false;
+#endif // DOLLDLA
   for(auto elem : m_elems) {
     elem->ClearCache();
     elem->ClearAdded();
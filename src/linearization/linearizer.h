@@ -42,6 +42,9 @@ class Linearizer
   StrSet m_alwaysLive;
   Cost m_alwaysLiveCost;
   bool m_shallow;
+#if DOLLDLA
+  bool m_regPressureScheduled;
+#endif // DOLLDLA
 
   Linearizer();
   Linearizer(const Poss *poss);
@@ -55,6 +58,9 @@ class Linearizer
   bool HasCurrLinearization() const;
 
   void FindAnyLinearization();
+#if DOLLDLA
+  void FindRegPressureLinearization();
+#endif // DOLLDLA
   void FindOptimalLinearization(const StrSet &stillLive);
 
   void RecursivelyFindOpt(Linearization &curr, const LinElemSet &readyToAdd, Linearization &opt, const StrSet &stillLive) const;
@@ -73,6 +73,13 @@ void SetLinElem::Print(IndStream &out, GraphIter *graphIter, Poss *poss)
       !((RealLoop*)real)->IsUnrolled()) {
     real->PrePrint(out,poss);
     ++out;
+#if DOLLDLA
+    if (real->IsLoop() && ((RealLoop*)real)->IsParallel()) {
+      VarSet bodyVars;
+      graphIter->AddCurrPossVars(bodyVars);
+      ((RealLoop*)real)->PrintParallelIterSetup(out, poss, bodyVars);
+    }
+#endif
     graphIter->Print(out, m_set, m_live, m_cost);
     --out;
     real->PostPrint(out,poss);
@@ -566,6 +566,9 @@ bool CompactlyUnrollLoop::CanApply(const Node *node) const
 
   if (loop->m_flags & SETLOOPISUNROLLED)
     return false;
+
+  if (split->GetMyLoop()->GetParallelism() != SEQUENTIALLOOP)
+    return false;
   
   unsigned int numExecs = split->NumberOfLoopExecs();
   if (!numExecs) {
@@ -647,6 +650,9 @@ bool PartiallyUnrollLoop::CanApply(const Node *node) const
 
   if (loop->m_flags & SETLOOPISUNROLLED)
     return false;
+
+  if (loopInt->GetParallelism() != SEQUENTIALLOOP)
+    return false;
   
   unsigned int numExecs = split->NumberOfLoopExecs();
   if (!numExecs) {
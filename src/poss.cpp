@@ -32,6 +32,9 @@
 #include "twoSidedTrxm.h"
 #include "pack.h"
 #include "critSect.h"
+#if DOLLDLA
+#include "registerPressure.h"
+#endif // DOLLDLA
 
 #define CHECKFORLOOPS
 
@@ -745,6 +748,12 @@ Cost Poss::Prop()
     m_lin.Start(this);
     m_lin.FindAnyLinearization();
   }
+#if DOLLDLA
+  //Register scheduling needs the data type cache, which might not
+  // have been built when BuildDataTypeCache linearized this poss
+  if (!m_lin.m_regPressureScheduled)
+    m_lin.FindRegPressureLinearization();
+#endif // DOLLDLA
   
   for (auto linElem : m_lin.m_lin.m_order) {
     if (linElem->IsNode()) {
@@ -763,6 +772,9 @@ Cost Poss::Prop()
 	throw;
     }
   }
+#if DOLLDLA
+  m_cost += VecRegSpillCost(m_lin.m_lin);
+#endif // DOLLDLA
 #else
   for (auto node : m_possNodes) {
     node->Prop();
@@ -28,6 +28,9 @@
 #include "pack.h"
 #include "critSect.h"
 #include "blis.h"
+#if DOLLDLA
+#include "costModel.h"
+#endif
 
 #if DOLOOPS
 
@@ -41,6 +44,8 @@ RealLoop::RealLoop()
   m_type(UNKNOWNLOOP),
 #if DOBLIS
  m_comm(CORECOMM),
+#elif DOLLDLA
+ m_parallelism(SEQUENTIALLOOP),
 #endif
   m_currIter(0)
 {
@@ -56,6 +61,8 @@ RealLoop::RealLoop(LoopType type)
   m_type(type)
 #if DOBLIS
 , m_comm(CORECOMM)
+#elif DOLLDLA
+, m_parallelism(SEQUENTIALLOOP)
 #endif
   , m_currIter(0)
 
@@ -78,6 +85,8 @@ RealLoop::RealLoop(LoopType type, Poss *poss, BSSize bsSize)
  m_type(type), m_bsSize(bsSize)
 #if DOBLIS
 , m_comm(CORECOMM)
+#elif DOLLDLA
+, m_parallelism(SEQUENTIALLOOP)
 #endif
   , m_currIter(0)
 {
@@ -129,6 +138,8 @@ void RealLoop::Duplicate(const BasePSet *orig, NodeMap &map, bool possMerging, b
   m_type = loop->m_type;
 #if DOBLIS
   m_comm = loop->m_comm;
+#elif DOLLDLA
+  m_parallelism = loop->m_parallelism;
 #endif
 #if TWOD
   m_dim = loop->m_dim;
@@ -160,6 +171,8 @@ void RealLoop::FlattenCore(ofstream &out) const
   WRITE(m_bsSize);
 #if DOBLIS
   WRITE(m_comm);
+#elif DOLLDLA
+  WRITE(m_parallelism);
 #endif
 #if TWOD
   WRITE(m_dim);
@@ -178,6 +191,8 @@ void RealLoop::UnflattenCore(ifstream &in, SaveInfo &info)
   READ(m_bsSize);
 #if DOBLIS
   READ(m_comm);
+#elif DOLLDLA
+  READ(m_parallelism);
 #endif
 #if TWOD
   READ(m_dim);
@@ -465,6 +480,100 @@ bool RealLoop::HasIndepIters() const
   }
   return true;
 }
+#elif DOLLDLA
+bool RealLoop::HasIndepIters() const
+{
+  for (auto in : m_inTuns) {
+    const LoopTunnel *tun = (LoopTunnel*)in;
+    if (!tun->IndepIters()) {
+      return false;
+    }
+    //An operand that is passed whole into the loop and updated
+    // there carries a value from one iteration to the next
+    if (!tun->IsSplit()) {
+      const LoopTunnel *possIn = (LoopTunnel*)(tun->Child(0));
+      if (possIn->GetMatchingOutTun()->Input(0) != possIn) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+void RealLoop::Parallelize(LoopParallelism parallelism)
+{
+  if (parallelism != SEQUENTIALLOOP && !HasIndepIters()) {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  m_parallelism = parallelism;
+}
+
+//Each execution of the loop forks a team, splits its iterations
+// over the team, and joins.  Iterations are assumed to cost the same
+Cost RealLoop::ParallelCost(Cost seqCost) const
+{
+  const SplitSingleIter *control = (SplitSingleIter*)GetControl();
+  unsigned int numExecs = control->NumberOfLoopExecs();
+  unsigned int totalIters = 0;
+  for (unsigned int i = 0; i < numExecs; ++i) {
+    totalIters += control->NumIters(i);
+  }
+  if (!totalIters) {
+    return seqCost;
+  }
+
+  unsigned int threads = min(numThreads, (unsigned int) arch->NumCores());
+  if (threads < 1) {
+    threads = 1;
+  }
+  Cost iterCost = seqCost / totalIters;
+
+  Cost cost = 0;
+  for (unsigned int i = 0; i < numExecs; ++i) {
+    unsigned int iters = control->NumIters(i);
+    unsigned int rounds = (iters + threads - 1) / threads;
+    cost += rounds * iterCost + costModel->ForkJoinCost(min(threads, iters));
+    if (m_parallelism == DYNAMICPARALLELLOOP) {
+      cost += rounds * costModel->DynamicChunkCost();
+    }
+  }
+  return cost;
+}
+
+//Called inside the body of the parallel loop.  Everything the
+// body declares is redeclared so each thread gets its own copy,
+// and each partition starts at the current iteration's block
+void RealLoop::PrintParallelIterSetup(IndStream &out, Poss *poss, VarSet &bodyVars) const
+{
+  const SplitSingleIter *control = (SplitSingleIter*)GetControl();
+  string lcv = "lcv" + control->GetLoopLevel();
+
+  //The loop counter is OpenMP's iteration variable
+  Var lcvVar(DirectVarDeclType, "int " + lcv + ";\n", control->GetDataType());
+  bodyVars.erase(lcvVar);
+  for (const Var &var : bodyVars) {
+    var.PrintDecl(out);
+  }
+
+  string dimLen;
+  if (control->m_dir == PARTDOWN) {
+    dimLen = control->InputDataType(0).m_numRowsVar;
+  }
+  else if (control->m_dir == PARTRIGHT) {
+    dimLen = control->InputDataType(0).m_numColsVar;
+  }
+  else {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  string offset = "(" + dimLen + " - " + lcv + ")";
+  for (auto in : poss->m_inTuns) {
+    if (in->GetNodeClass() == SplitSingleIter::GetClass()) {
+      ((SplitSingleIter*)in)->PrintParallelIterStart(offset, out);
+    }
+  }
+}
 #endif
 
 #if TWOD
@@ -492,6 +601,8 @@ ShadowPSet* RealLoop::GetNewShadow()
   real->m_label = m_label;
 #if DOBLIS
   real->m_comm = m_comm;
+#elif DOLLDLA
+  real->m_parallelism = m_parallelism;
 #endif
   return (BasePSet*)real;
 }
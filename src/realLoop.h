@@ -50,6 +50,8 @@ class RealLoop : public IntLoop<RealPSet>
   BSSize m_bsSize;
 #if DOBLIS
   Comm m_comm;
+#elif DOLLDLA
+  LoopParallelism m_parallelism;
 #endif
   int m_currIter;
   
@@ -86,6 +88,13 @@ class RealLoop : public IntLoop<RealPSet>
   void Parallelize(Comm comm);
   virtual bool HasIndepIters() const;
   bool IsParallel() const {return m_comm!=CORECOMM;}
+#elif DOLLDLA
+  void Parallelize(LoopParallelism parallelism);
+  virtual bool HasIndepIters() const;
+  virtual LoopParallelism GetParallelism() const {return m_parallelism;}
+  bool IsParallel() const {return m_parallelism!=SEQUENTIALLOOP;}
+  Cost ParallelCost(Cost seqCost) const;
+  void PrintParallelIterSetup(IndStream &out, Poss *poss, VarSet &bodyVars) const;
 #endif
   int GetCurrIter() const {return m_currIter;}
   void SetCurrIter(int iter) {m_currIter = iter;}
@@ -80,6 +80,16 @@ bool IsParallel() const
 {
   return m_realPSet->IsParallel();
 }
+#elif DOLLDLA
+bool ShadowLoop::HasIndepIters() const
+{
+  return ((RealLoop*)m_realPSet)->HasIndepIters();
+}
+
+LoopParallelism ShadowLoop::GetParallelism() const
+{
+  return ((RealLoop*)m_realPSet)->GetParallelism();
+}
 #endif
 
 
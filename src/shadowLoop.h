@@ -46,6 +46,9 @@ class ShadowLoop : public IntLoop<ShadowPSet>
 #if DOBLIS
   bool HasIndepIters() const;
   bool IsParallel() const {return m_comm!=CORECOMM;}
+#elif DOLLDLA
+  bool HasIndepIters() const;
+  virtual LoopParallelism GetParallelism() const;
 #endif
 
   virtual const IntSet& GetLabel() const;
@@ -292,3 +292,61 @@ const SizeList* SizesCache::GetCachedSplitSize(bool start,
   else
     return endSizes;
 }
+
+//Like GetCachedSplitSize, but the start partition is
+// exactly startSize instead of a multiple of it
+const SizeList* SizesCache::GetCachedExactSplitSize(bool start,
+						    const SizeList *parent,
+						    int startSize)
+{
+  SizesT<int> val;
+  val.parent = parent;
+  val.size = startSize;
+  if (start) {
+    SizesIntMapIter find = m_exactSplitMapStart.find(val);
+    if (find != m_exactSplitMapStart.end())
+      return find->second;
+  }
+  else {
+    SizesIntMapIter find = m_exactSplitMapEnd.find(val);
+    if (find != m_exactSplitMapEnd.end())
+      return find->second;
+  }
+
+  SizeList *startSizes = new SizeList();
+  SizeList *endSizes = new SizeList();
+
+  for (auto entry : parent->m_entries) {
+    if (entry->m_type != REPEATEDSIZES) {
+      LOG_FAIL("havne't implement other splitting code");
+      throw;
+    }
+    int numIterations = entry->NumSizesPerRepeat();
+    Size sizeOfEachIteration = entry->m_valA;
+    if (sizeOfEachIteration < startSize) {
+      LOG_FAIL("exact split is larger than the size being split");
+      throw;
+    }
+    Size sizeOfEndIterations = sizeOfEachIteration - startSize;
+
+    auto startEnt = new SizeEntry();
+    startEnt->SetRepeatedSizes(startSize, numIterations);
+    startEnt->m_repeats = entry->m_repeats;
+    startSizes->m_entries.push_back(startEnt);
+
+    auto endEnt = new SizeEntry();
+    endEnt->SetRepeatedSizes(sizeOfEndIterations, numIterations);
+    endEnt->m_repeats = entry->m_repeats;
+    endSizes->m_entries.push_back(endEnt);
+  }
+
+  m_exactSplitMapStart[val] = startSizes;
+  m_exactSplitMapEnd[val] = endSizes;
+  startSizes->SetCached();
+  endSizes->SetCached();
+
+  if (start)
+    return startSizes;
+  else
+    return endSizes;
+}
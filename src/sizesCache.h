@@ -148,6 +148,8 @@ class SizesCache
   RepeatedMap m_constRepMap; // repeated sizes
   SizesIntMap m_splitMapStart; //split sizes start
   SizesIntMap m_splitMapEnd; // split sizes end
+  SizesIntMap m_exactSplitMapStart; //exact split sizes start
+  SizesIntMap m_exactSplitMapEnd; // exact split sizes end
 
 #if DOTENSORS
   DistSizesMap m_distSizesMap; // sizes with distribution coefficient
@@ -178,6 +180,9 @@ class SizesCache
   const SizeList* GetCachedSplitSize(bool start,
 				     const SizeList *parent,
 				     int splitFactor);
+  const SizeList* GetCachedExactSplitSize(bool start,
+					  const SizeList *parent,
+					  int startSize);
 
 #if DOTENSORS
   const SizeList* GetCachedDistSize(const SizeList *parent,
@@ -1223,6 +1223,8 @@ void SplitSingleIter::AddVariables(VarSet &set) const
     //    cout << "Var " << name << " has type is float\n";
   } else if (GetDataType() == REAL_DOUBLE) {
     //    cout << "Var " << name << " has type is double\n";
+  } else if (IsComplex(GetDataType())) {
+    //    cout << "Var " << name << " has complex type\n";
   } else {
     cout << "Error: Bad type, var " << name << " in SplitSingleIter::AddVariables\n";
     LOG_FAIL("replacement for throw call");
@@ -1259,6 +1261,9 @@ void SplitSingleIter::AddVariables(VarSet &set) const
       } else if (GetDataType() == REAL_SINGLE) {
 	Var varS(DirectVarDeclType, "float *" + LLDLAPartVarName(name, 1) + "_iter" + std::to_string((long long int) i) + ";", GetDataType());
 	set.insert(varS);
+      } else if (IsComplex(GetDataType())) {
+	Var varC(DirectVarDeclType, ElemTypeName(GetDataType()) + " *" + LLDLAPartVarName(name, 1) + "_iter" + std::to_string((long long int) i) + ";", GetDataType());
+	set.insert(varC);
       }
       }
       }
@@ -1554,6 +1559,35 @@ void SplitSingleIter::PrintIncrementAtEndOfLoop(BSSize bs, IndStream &out) const
 #endif
 }
 
+#if DOLLDLA
+//Parallel loops have no running pointer to increment, so
+// each iteration starts its partition offset elements in
+void SplitSingleIter::PrintParallelIterStart(const string &offset, IndStream &out) const
+{
+  if (m_tunType != POSSTUNIN) {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  out.Indent();
+  const DataTypeInfo &type = InputDataType(0);
+  *out << LLDLAPartVarName(GetInputNameStr(0),1) << " = "
+       << GetInputNameStr(0) << " + ";
+  if (m_dir == PARTDOWN) {
+    if (!IsUnitStride(type.m_rowStride))
+      *out << type.m_rowStrideVar << " * ";
+  }
+  else if (m_dir == PARTRIGHT) {
+    if (!IsUnitStride(type.m_colStride))
+      *out << type.m_colStrideVar << " * ";
+  }
+  else {
+    LOG_FAIL("replacement for throw call");
+    throw;
+  }
+  *out << offset << ";\n";
+}
+#endif
+
 #if DOLLDLA
 void SplitSingleIter::BuildDataTypeCache()
 {
@@ -1562,12 +1596,22 @@ void SplitSingleIter::BuildDataTypeCache()
     return;
   if (m_tunType == SETTUNIN) {
     m_info = InputDataType(0);
+#if DOLLDLA
+    //Every block starts a multiple of the block size from the start
+    Size bs = GetMyLoop()->GetBS();
+#endif
     switch (m_dir) {
     case (PARTDOWN):
       m_info.m_numRowsVar = "numRows" + GetNameStr(1);
+#if DOLLDLA
+      m_info.m_alignment = InputDataType(0).RowOffsetAlignment(bs);
+#endif
       break;
     case (PARTRIGHT):
       m_info.m_numColsVar = "numCols" + GetNameStr(1);
+#if DOLLDLA
+      m_info.m_alignment = InputDataType(0).ColOffsetAlignment(bs);
+#endif
       break;
     default:
       LOG_FAIL("replacement for throw call");
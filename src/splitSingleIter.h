@@ -102,6 +102,9 @@ class SplitSingleIter : public SplitBase
   virtual void AddVariables(VarSet &set) const;
 
   virtual void PrintIncrementAtEndOfLoop(BSSize bs, IndStream &out) const;
+#if DOLLDLA
+  void PrintParallelIterStart(const string &offset, IndStream &out) const;
+#endif
 
 #if DOLLDLA
   virtual void BuildDataTypeCache();
@@ -38,6 +38,8 @@ class Transformation
   virtual bool IsSingle() const {return false;}
   virtual bool IsRef() const {return false;}
   virtual bool IsVarRef() const {return false;}
+  //Only a MultiTrans holds more than one transformation to count
+  virtual bool IsMultiRef() const {return false;}
 };
 
 //Holds one transformation
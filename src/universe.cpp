@@ -348,7 +348,7 @@ void Universe::AddTrans(const ClassType &classType, Transformation *trans, int p
   else
     LOG_FAIL("replacement for throw call");
   if (phase == SIMP) {
-    if (trans->IsSingle()) 
+    if (trans->IsSingle() || !trans->IsMultiRef()) 
       M_transCount[NUMPHASES]++;
     else 
       M_transCount[NUMPHASES] += ((MultiTrans*)trans)->NumTransformations();
@@ -365,7 +365,7 @@ void Universe::AddTrans(const ClassType &classType, Transformation *trans, int p
   else if (phase < 0 || phase >= NUMPHASES) {
     LOG_FAIL("replacement for throw call");
   } else {
-    if (trans->IsSingle()) 
+    if (trans->IsSingle() || !trans->IsMultiRef()) 
       M_transCount[phase]++;
     else 
       M_transCount[phase] += ((MultiTrans*)trans)->NumTransformations();
@@ -706,18 +706,23 @@ void Universe::PrintStats()
   cout << "\t" << M_transCount[NUMPHASES] << " simplifiers\n";
 }
 
-unique_ptr<ImplementationMap> Universe::ImpStrMap(bool includeIters, unsigned int numGraphs) {
+unique_ptr<ImplementationMap> Universe::ImpStrMap(bool includeIters, unsigned int numGraphs,
+						  std::function<Cost(GraphIter&)> score) {
   if (m_pset->m_posses.size() != 1)
     throw;
+  if (!score)
+    score = [](GraphIter &iter) { return iter.Eval(); };
   Cost maxCost = -1;
+  bool cull = false;
   if (numGraphs > 0 && TotalCount() > numGraphs) {
+    cull = true;
     std::priority_queue<Cost> queue;
     GraphIter iter((m_pset->m_posses.begin())->second);
-    Cost cost = iter.Eval();
+    Cost cost = score(iter);
     Cost currMax = cost;
     queue.push(cost);
     while (!iter.Increment()) {
-      cost = iter.Eval();
+      cost = score(iter);
       if (cost <= currMax) {
 	queue.push(cost);
 	if (queue.size() > numGraphs) {
@@ -741,7 +746,7 @@ unique_ptr<ImplementationMap> Universe::ImpStrMap(bool includeIters, unsigned in
   GraphNum i = 1;
   GraphIter iter((m_pset->m_posses.begin())->second);
   do {
-    if (maxCost == -1 || iter.Eval() <= maxCost) {
+    if (!cull || score(iter) <= maxCost) {
       std::stringbuf sbuf;
       std::ostream out(&sbuf);
       IndStream istream = IndStream(&out, LLDLASTREAM);
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <vector>
+#include <functional>
 #include <memory>
 #include "base.h"
 #include "realPSet.h"
@@ -91,7 +92,10 @@ class Universe
 
   void ClearTransformations();
 
-  unique_ptr<ImplementationMap> ImpStrMap(bool includeIters, unsigned int numGraphs = 0);
+  //With numGraphs, only the numGraphs graphs that score lowest are
+  // kept; graphs are scored by their cost unless score is given
+  unique_ptr<ImplementationMap> ImpStrMap(bool includeIters, unsigned int numGraphs = 0,
+					  std::function<Cost(GraphIter&)> score = nullptr);
 
   static void RegCons(ClassType type, ConstructorFunc func);
   static Node* GetBlankClassInst(ClassType type);
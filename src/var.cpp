@@ -483,6 +483,8 @@ void Var::PrintDecl(IndStream &out) const
 	  *out << "float *" << m_part << ";\n";
 	} else if (m_dataType == REAL_DOUBLE) {
 	  *out << "double *" << m_part << ";\n";
+	} else if (IsComplex(m_dataType)) {
+	  *out << ElemTypeName(m_dataType) << " *" << m_part << ";\n";
 	} else {
 	  cout << "ERROR: Var " << m_part << " has invalid m_dataType\n";
 	  LOG_FAIL("replacement for throw call");
@@ -496,6 +498,8 @@ void Var::PrintDecl(IndStream &out) const
 	  *out << "float *" << m_part << ";\n";
 	} else if (m_dataType == REAL_DOUBLE) {
 	  *out << "double *" << m_part << ";\n";
+	} else if (IsComplex(m_dataType)) {
+	  *out << ElemTypeName(m_dataType) << " *" << m_part << ";\n";
 	} else {
 	  cout << "ERROR: Var " << m_part << " has invalid m_dataType\n";
 	  LOG_FAIL("replacement for throw call");